@@ -0,0 +1,187 @@
+/*************
+* com_stimconv.c
+************/
+
+/*
+ * stimconv infile outfile
+ *
+ * Convert a stimulus table from text to the binary stimulus file read
+ * by 'pwl file=' of the V and I sources and by the file_source and
+ * d_source code models, see ngspice/stimfile.h.
+ * Each line of the text holds the time and the values of the channels,
+ * separated by white space or commas; lines starting with '#', ';' or
+ * '*' are comments.  Numbers may carry scale factors.  The d_source
+ * states 0s, 1s, Us, 0r ... Uu are stored as their codes 0 to 11.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/wordlist.h"
+#include "ngspice/cpextern.h"
+#include "ngspice/fteext.h"
+#include "ngspice/stimfile.h"
+
+#include "com_stimconv.h"
+
+#include <errno.h>
+
+
+static char *digital_states[] = {
+    "0s", "1s", "Us", "0r", "1r", "Ur", "0z", "1z", "Uz", "0u", "1u", "Uu"
+};
+
+
+/* read a line of any length into *buf */
+static char *
+read_line(FILE *fp, char **buf, size_t *size)
+{
+    size_t len = 0;
+
+    while (fgets(*buf + len, (int) (*size - len), fp)) {
+        len += strlen(*buf + len);
+        if ((*buf)[len - 1] == '\n' || len + 1 < *size)
+            return *buf;
+        *size *= 2;
+        *buf = TREALLOC(char, *buf, *size);
+    }
+
+    return len ? *buf : NULL;
+}
+
+
+static bool
+get_value(char *word, int column, double *value)
+{
+    double *d;
+    char *end;
+    int i;
+
+    if (column > 0)
+        for (i = 0; i < (int) NUMELEMS(digital_states); i++)
+            if (eq(word, digital_states[i])) {
+                *value = i;
+                return TRUE;
+            }
+
+    /* plain numbers rounded correctly, others may have scale factors */
+    *value = strtod(word, &end);
+    if (end != word && *end == '\0')
+        return TRUE;
+
+    d = ft_numparse(&word, FALSE);
+    if (!d)
+        return FALSE;
+    *value = *d;
+    return TRUE;
+}
+
+
+void
+com_stimconv(wordlist *wl)
+{
+    char *inname, *outname;
+    FILE *in = NULL, *out = NULL;
+    size_t size = 256, rows = 0;
+    char *buf = TMALLOC(char, size);
+    int rowsize = 16, columns = 0, lineno = 0, n;
+    double *row = TMALLOC(double, rowsize);
+    bool ok = FALSE, created = FALSE;
+
+    inname = cp_unquote(wl->wl_word);
+    outname = cp_unquote(wl->wl_next->wl_word);
+
+    if ((in = fopen(inname, "r")) == NULL) {
+        fprintf(cp_err, "Error: can't open %s: %s\n", inname, strerror(errno));
+        goto done;
+    }
+    if ((out = fopen(outname, "wb")) == NULL) {
+        fprintf(cp_err, "Error: can't open %s: %s\n", outname, strerror(errno));
+        goto done;
+    }
+    created = TRUE;
+
+    /* the size of the table is filled in at the end */
+    if (stim_write_header(out, 0, 0) != 0)
+        goto write_error;
+
+    while (read_line(in, &buf, &size)) {
+        char *s = buf;
+
+        lineno++;
+        while (isspace((unsigned char) *s))
+            s++;
+        if (*s == '\0' || *s == '#' || *s == ';' || *s == '*')
+            continue;
+
+        for (n = 0; ; n++) {
+            char *word;
+            while (isspace((unsigned char) *s) || *s == ',')
+                s++;
+            if (*s == '\0')
+                break;
+            word = s;
+            while (*s && !isspace((unsigned char) *s) && *s != ',')
+                s++;
+            if (*s)
+                *s++ = '\0';
+            if (n == rowsize) {
+                rowsize *= 2;
+                row = TREALLOC(double, row, rowsize);
+            }
+            if (!get_value(word, n, &row[n])) {
+                fprintf(cp_err, "Error: %s line %d: bad value %s\n",
+                        inname, lineno, word);
+                goto done;
+            }
+        }
+
+        if (columns == 0) {
+            if (n < 2) {
+                fprintf(cp_err, "Error: %s line %d: time and values expected\n",
+                        inname, lineno);
+                goto done;
+            }
+            columns = n;
+        } else if (n != columns) {
+            fprintf(cp_err, "Error: %s line %d: %d columns, %d expected\n",
+                    inname, lineno, n, columns);
+            goto done;
+        }
+
+        if (fwrite(row, sizeof(double), (size_t) n, out) != (size_t) n)
+            goto write_error;
+        rows++;
+    }
+
+    if (rows == 0) {
+        fprintf(cp_err, "Error: no data in %s\n", inname);
+        goto done;
+    }
+
+    if (fseek(out, 0L, SEEK_SET) != 0 ||
+        stim_write_header(out, columns, rows) != 0)
+        goto write_error;
+
+    ok = (fclose(out) == 0);
+    out = NULL;
+    if (!ok)
+        goto write_error;
+
+    fprintf(cp_out, "%s: %lu time points, %d channels\n",
+            outname, (unsigned long) rows, columns - 1);
+    goto done;
+
+write_error:
+    fprintf(cp_err, "Error: writing %s: %s\n", outname, strerror(errno));
+
+done:
+    if (in)
+        fclose(in);
+    if (out)
+        fclose(out);
+    if (!ok && created)
+        remove(outname);
+    tfree(row);
+    tfree(buf);
+    tfree(inname);
+    tfree(outname);
+}
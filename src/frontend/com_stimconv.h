@@ -0,0 +1,10 @@
+/*************
+* Header file for com_stimconv.c
+************/
+
+#ifndef ngspice_COM_STIMCONV_H
+#define ngspice_COM_STIMCONV_H
+
+void com_stimconv(wordlist *wl);
+
+#endif
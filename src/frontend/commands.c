@@ -54,6 +54,7 @@
 #include "com_echo.h"
 #include "com_rehash.h"
 #include "com_shell.h"
+#include "com_stimconv.h"
 #include "com_shift.h"
 #include "com_unset.h"
 #include "fourier.h"
@@ -484,6 +485,10 @@ struct comm spcp_coms[] = {
       { 1, 1, 1, 1 }, E_DEFHMASK, 0, LOTS,
       NULL,
       "[args] : Fork a shell, or execute the command." } ,
+    { "stimconv", com_stimconv, FALSE, FALSE,
+      { 1, 1, 1, 1 }, E_DEFHMASK, 2, 2,
+      NULL,
+      "infile outfile : Convert a stimulus table to a binary stimulus file." } ,
     { "rusage", com_rusage, FALSE, FALSE,
       { 02000, 02000, 02000, 02000 }, E_DEFHMASK, 0, LOTS,
       NULL,
@@ -883,6 +888,10 @@ struct comm nutcp_coms[] = {
       { 1, 1, 1, 1 }, E_DEFHMASK, 0, LOTS,
       NULL,
       "[args] : Fork a shell, or execute the command." } ,
+    { "stimconv", com_stimconv, FALSE, FALSE,
+      { 1, 1, 1, 1 }, E_DEFHMASK, 2, 2,
+      NULL,
+      "infile outfile : Convert a stimulus table to a binary stimulus file." } ,
     { "rusage", com_rusage, FALSE, FALSE,
       { 02000, 02000, 02000, 02000 }, E_DEFHMASK, 0, LOTS,
       NULL,
@@ -261,6 +261,8 @@ com_diff(wordlist *wl)
         if (!v1->v_link2)
             continue;
         v2 = v1->v_link2;
+        raw_vec_load(v1);
+        raw_vec_load(v2);
         if (v1->v_type == SV_VOLTAGE)
             tol = vntol;
         else
@@ -20,17 +20,35 @@ Author: 1985 Wayne A. Christopher, U. C. Berkeley CAD Group
 
 #include "fourier.h"
 #include "variable.h"
+#include "ngspice/fftext.h"
+
+#ifdef HAVE_LIBFFTW3
+#include "fftw3.h"
+#endif
 
 
 static char *pnum(double num);
 static int CKTfour(int ndata, int numFreq, double *thd, double *Time, double *Value,
                    double FundFreq, double *Freq, double *Mag, double *Phase, double *nMag,
-                   double *nPhase);
+                   double *nPhase, int method);
+static void four_recurrence(int ndata, int numFreq, double *Value, double *S, double *C);
+static int four_fft(int ndata, int numFreq, double *Value, double *S, double *C);
 
 
 
 #define DEF_FOURGRIDSIZE 200
 
+/* How CKTfour sums up the harmonics, set by the variable fourmethod */
+enum {
+    FOUR_AUTO,          /* recurrence for a few harmonics, else fft */
+    FOUR_DFT,           /* sin() and cos() for every sample and harmonic */
+    FOUR_RECURRENCE,    /* rotating phasor for each harmonic */
+    FOUR_FFT            /* all harmonics from one fft */
+};
+
+/* samples between exact phasors in four_recurrence() */
+#define FOUR_RESYNC 64
+
 
 /* CKTfour(ndata, numFreq, thd, Time, Value, FundFreq, Freq, Mag, Phase, nMag, nPhase)
  *         len    10       ?    inp   inp    inp       out   out  out    out   out
@@ -42,7 +60,8 @@ fourier(wordlist *wl, struct plot *current_plot)
     struct dvec *time, *vec;
     struct pnode *pn, *names;
     double *ff, fundfreq, *data = NULL;
-    int nfreqs, fourgridsize, polydegree;
+    int nfreqs, fourgridsize, polydegree, method;
+    char methodname[BSIZE_SP];
     double *freq, *mag, *phase, *nmag, *nphase;  /* Outputs from CKTfour */
     double thd, *timescale = NULL;
     char *s;
@@ -72,6 +91,19 @@ fourier(wordlist *wl, struct plot *current_plot)
     if (!cp_getvar("fourgridsize", CP_NUM, &fourgridsize) || fourgridsize < 1)
         fourgridsize = DEF_FOURGRIDSIZE;
 
+    method = FOUR_AUTO;
+    if (cp_getvar("fourmethod", CP_STRING, methodname)) {
+        if (eq(methodname, "dft"))
+            method = FOUR_DFT;
+        else if (eq(methodname, "recurrence"))
+            method = FOUR_RECURRENCE;
+        else if (eq(methodname, "fft"))
+            method = FOUR_FFT;
+        else if (!eq(methodname, "auto"))
+            fprintf(cp_err, "Warning: unknown fourmethod %s, using auto\n",
+                    methodname);
+    }
+
     time = current_plot->pl_scale;
     if (!isreal(time)) {
         fprintf(cp_err, "Error: fourier needs real time scale\n");
@@ -143,7 +175,7 @@ fourier(wordlist *wl, struct plot *current_plot)
 
             err = CKTfour(fourgridsize, nfreqs, &thd, timescale,
                           data, fundfreq, freq, mag, phase, nmag,
-                          nphase);
+                          nphase, method);
             if (err != OK) {
                 ft_sperror(err, "fourier");
                 goto done;
@@ -291,8 +323,9 @@ CKTfour(int ndata,              /* number of entries in the Time and
         double *Phase,          /* the Phase of the fourier transform */
         double *nMag,           /* the normalized magnitude of the
                                    transform: nMag(fund)=1*/
-        double *nPhase)         /* the normalized phase of the
+        double *nPhase,         /* the normalized phase of the
                                    transform: Nphase(fund)=0 */
+        int method)             /* FOUR_AUTO, FOUR_DFT, ... */
 {
     /* Note: we can consider these as a set of arrays.  The sizes are:
      * Time[ndata], Value[ndata], Freq[numFreq], Mag[numfreq],
@@ -319,11 +352,30 @@ CKTfour(int ndata,              /* number of entries in the Time and
         Phase[i] = 0;
     }
 
-    for (i = 0; i < ndata; i++)
-        for (j = 0; j < numFreq; j++) {
-            Mag[j]   += Value[i] * sin(j*2.0*M_PI*i/((double)ndata));
-            Phase[j] += Value[i] * cos(j*2.0*M_PI*i/((double)ndata));
-        }
+    /* The fft pays off once there are more harmonics than about
+     * log2(ndata), four times that if it can't be done in one go. */
+    if (method == FOUR_AUTO) {
+        double cost = log((double) ndata) / log(2.0);
+#ifndef HAVE_LIBFFTW3
+        if (ndata & (ndata - 1))
+            cost *= 4;
+#endif
+        method = (numFreq > cost) ? FOUR_FFT : FOUR_RECURRENCE;
+    }
+
+    /* Mag and Phase get the sums of Value times sin() and cos() */
+    if (method == FOUR_FFT && four_fft(ndata, numFreq, Value, Mag, Phase) != OK)
+        method = FOUR_RECURRENCE;
+
+    if (method == FOUR_RECURRENCE) {
+        four_recurrence(ndata, numFreq, Value, Mag, Phase);
+    } else if (method == FOUR_DFT) {
+        for (i = 0; i < ndata; i++)
+            for (j = 0; j < numFreq; j++) {
+                Mag[j]   += Value[i] * sin(j*2.0*M_PI*i/((double)ndata));
+                Phase[j] += Value[i] * cos(j*2.0*M_PI*i/((double)ndata));
+            }
+    }
 
     Mag[0] = Phase[0]/ndata;
     Phase[0] = nMag[0] = nPhase[0] = Freq[0] = 0;
@@ -342,3 +394,172 @@ CKTfour(int ndata,              /* number of entries in the Time and
     *thd = 100*sqrt(*thd);
     return (OK);
 }
+
+
+/* Sums of Value times sin() and cos() of all harmonics j < numFreq,
+ * each by rotating a phasor from sample to sample.  The phasor is set
+ * to its exact value every FOUR_RESYNC samples, which keeps the
+ * rounding error at the level of the direct sum.  */
+static void
+four_recurrence(int ndata, int numFreq, double *Value, double *S, double *C)
+{
+    int i, i0, iend, j;
+
+    for (j = 0; j < numFreq; j++) {
+        double s = 0.0, c = 0.0;
+        double dr = cos(2.0 * M_PI * j / ndata);
+        double di = sin(2.0 * M_PI * j / ndata);
+
+        for (i0 = 0; i0 < ndata; i0 = iend) {
+            double arg = 2.0 * M_PI * fmod((double) j * i0, (double) ndata) / ndata;
+            double wr = cos(arg), wi = sin(arg), t;
+
+            iend = MIN(i0 + FOUR_RESYNC, ndata);
+            for (i = i0; i < iend; i++) {
+                c += Value[i] * wr;
+                s += Value[i] * wi;
+                t = wr * dr - wi * di;
+                wi = wr * di + wi * dr;
+                wr = t;
+            }
+        }
+
+        S[j] = s;
+        C[j] = c;
+    }
+}
+
+
+/* The same sums from the spectrum of Value, X[j] = C[j] - i S[j].
+ * Without FFTW an ndata which is no power of 2 is transformed with
+ * Bluestein's algorithm: a convolution with a chirp, done with power
+ * of 2 ffts of at least 2*ndata-1 points.  */
+static int
+four_fft(int ndata, int numFreq, double *Value, double *S, double *C)
+{
+    int j, k;
+
+#ifdef HAVE_LIBFFTW3
+
+    double *in;
+    fftw_complex *out;
+    fftw_plan plan;
+
+    in = fftw_malloc(sizeof(double) * (size_t) ndata);
+    out = fftw_malloc(sizeof(fftw_complex) * (size_t) (ndata / 2 + 1));
+    if (!in || !out) {
+        fftw_free(in);
+        fftw_free(out);
+        return (E_NOMEM);
+    }
+
+    plan = fftw_plan_dft_r2c_1d(ndata, in, out, FFTW_ESTIMATE);
+    memcpy(in, Value, sizeof(double) * (size_t) ndata);
+    fftw_execute(plan);
+
+    for (j = 0; j < numFreq; j++) {
+        k = j % ndata;
+        if (k <= ndata / 2) {
+            C[j] = out[k][0];
+            S[j] = -out[k][1];
+        } else {
+            C[j] = out[ndata - k][0];
+            S[j] = out[ndata - k][1];
+        }
+    }
+
+    fftw_destroy_plan(plan);
+    fftw_free(in);
+    fftw_free(out);
+
+#else /* Green's FFT */
+
+    double *a, *b;
+    int M, N;
+
+    if ((ndata & (ndata - 1)) == 0) {
+
+        /* real fft, Re(x[0]), Re(x[N/2]), Re(x[1]), Im(x[1]), ... */
+        for (M = 0; (1 << M) < ndata; M++)
+            ;
+        if (ndata < 2 || fftInit(M))
+            return (E_NOMEM);
+
+        a = TMALLOC(double, ndata);
+        memcpy(a, Value, sizeof(double) * (size_t) ndata);
+        rffts(a, M, 1);
+        fftFree();
+
+        for (j = 0; j < numFreq; j++) {
+            k = j % ndata;
+            if (k == 0) {
+                C[j] = a[0];
+                S[j] = 0.0;
+            } else if (k == ndata / 2) {
+                C[j] = a[1];
+                S[j] = 0.0;
+            } else if (k < ndata / 2) {
+                C[j] = a[2 * k];
+                S[j] = -a[2 * k + 1];
+            } else {
+                C[j] = a[2 * (ndata - k)];
+                S[j] = a[2 * (ndata - k) + 1];
+            }
+        }
+
+        tfree(a);
+        return (OK);
+    }
+
+    /* Bluestein: X[k] = w*(k) sum_n (x[n] w*(n)) w(k-n), w(n) = exp(i pi n^2/ndata) */
+    for (M = 0; (1 << M) < 2 * ndata - 1; M++)
+        ;
+    N = 1 << M;
+    if (fftInit(M))
+        return (E_NOMEM);
+
+    a = TMALLOC(double, 2 * N);
+    b = TMALLOC(double, 2 * N);
+
+    for (k = 0; k < ndata; k++) {
+        /* n^2 mod 2*ndata keeps the argument exact */
+        double arg = M_PI * fmod((double) k * k, 2.0 * ndata) / ndata;
+        double wr = cos(arg), wi = sin(arg);
+        a[2 * k]     = Value[k] * wr;
+        a[2 * k + 1] = -Value[k] * wi;
+        b[2 * k]     = wr;
+        b[2 * k + 1] = wi;
+        if (k) {
+            b[2 * (N - k)]     = wr;
+            b[2 * (N - k) + 1] = wi;
+        }
+    }
+
+    ffts(a, M, 1);
+    ffts(b, M, 1);
+    for (k = 0; k < N; k++) {
+        double re = a[2 * k] * b[2 * k] - a[2 * k + 1] * b[2 * k + 1];
+        double im = a[2 * k] * b[2 * k + 1] + a[2 * k + 1] * b[2 * k];
+        a[2 * k] = re;
+        a[2 * k + 1] = im;
+    }
+    iffts(a, M, 1);
+    fftFree();
+
+    for (j = 0; j < numFreq; j++) {
+        double arg, wr, wi;
+        k = j % ndata;
+        arg = M_PI * fmod((double) k * k, 2.0 * ndata) / ndata;
+        wr = cos(arg);
+        wi = sin(arg);
+        C[j] = a[2 * k] * wr + a[2 * k + 1] * wi;
+        S[j] = -(a[2 * k + 1] * wr - a[2 * k] * wi);
+    }
+
+    tfree(a);
+    tfree(b);
+
+#endif
+
+    return (OK);
+}
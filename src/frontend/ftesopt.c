@@ -23,6 +23,7 @@ struct FTEparm {
 static struct FTEparm FTEOPTtbl[] = {
     { "decklineno",   FTEOPT_NLDECK, CP_NUM,  "Number of lines in the deck" },
     { "netloadtime",  FTEOPT_NLT,    CP_REAL, "Netlist loading time"        },
+    { "netexpandtime", FTEOPT_NXT,   CP_REAL, "Netlist expansion time"      },
     { "netparsetime", FTEOPT_NPT,    CP_REAL, "Netlist parsing time"        }
 };
 
@@ -84,6 +85,9 @@ getFTEstat(struct circ *ft_curckt, int id)
     case FTEOPT_NLT:
         v->va_real = ft_curckt->FTEstats->FTESTATnetLoadTime;
         break;
+    case FTEOPT_NXT:
+        v->va_real = ft_curckt->FTEstats->FTESTATnetExpandTime;
+        break;
     case FTEOPT_NPT:
         v->va_real = ft_curckt->FTEstats->FTESTATnetParseTime;
         break;
@@ -315,7 +315,7 @@ inp_spsource(FILE *fp, bool comfile, char *filename, bool intfile)
     FILE *lastin, *lastout, *lasterr;
     double temperature_value;
 
-    double startTime, endTime;
+    double startTime, endTime, expandTime = 0.0;
 
     /* read in the deck from a file */
     char *dir_name = ngdirname(filename ? filename : ".");
@@ -520,13 +520,16 @@ inp_spsource(FILE *fp, bool comfile, char *filename, bool intfile)
             SetAnalyse("Prepare Deck", 0);
 #endif
             /* Now expand subcircuit macros and substitute numparams.*/
-            if (!cp_getvar("nosubckt", CP_BOOL, NULL))
+            if (!cp_getvar("nosubckt", CP_BOOL, NULL)) {
+                expandTime = seconds();
                 if ((deck->li_next = inp_subcktexpand(deck->li_next)) == NULL) {
                     line_free(realdeck, TRUE);
                     line_free(deck->li_actual, TRUE);
                     tfree(tt);
                     return;
                 }
+                expandTime = seconds() - expandTime;
+            }
 
             /* Now handle translation of spice2c6 POLYs. */
 #ifdef XSPICE
@@ -625,6 +628,7 @@ inp_spsource(FILE *fp, bool comfile, char *filename, bool intfile)
             ft_curckt->ci_meas  = NULL;
             /* PN add here stats*/
             ft_curckt->FTEstats->FTESTATnetLoadTime = endTime - startTime;
+            ft_curckt->FTEstats->FTESTATnetExpandTime = expandTime;
         }
 
         for (dd = deck; dd; dd = dd->li_next) {
@@ -0,0 +1,476 @@
+/*************
+ * inpcache.c
+ ************/
+
+/*
+ * Deck cache, set deck_cache=<directory>
+ *
+ * inp_readall() stores the deck it has prepared (.include and .lib
+ * files read, continuation lines stitched, the numparam and
+ * compatibility transformations done) in a file of the cache
+ * directory.  The file is named by a hash of the text of the input
+ * deck, its directory, the compatibility mode and the variables used
+ * while preparing it.  It lists the .include and .lib files read, with
+ * their size and a hash of their contents, and the file each .include
+ * and .lib file name was resolved to.  When a deck is read again,
+ * nothing of this has changed and each name still resolves to the same
+ * file, the prepared deck is taken from the cache file.
+ * Subcircuit expansion and numparam evaluation are still done for each
+ * run, their symbol tables are needed later by .measure and 'listing
+ * param'.
+ * Messages printed while preparing a deck are not repeated when it
+ * comes from the cache.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cpdefs.h"
+#include "ngspice/ftedefs.h"
+#include "ngspice/fteinp.h"
+
+#include "inpcache.h"
+#include "inpcom.h"
+#include "variable.h"
+
+#include <errno.h>
+
+
+#define CACHE_MAGIC     "NGDECK\r\n"
+#define CACHE_VERSION   2
+
+#define HASH_INIT       0xcbf29ce484222325ULL
+#define HASH_MUL        0x100000001b3ULL
+
+#define NOSTRING        0xffffffffUL
+
+extern void line_free_x(struct line *deck, bool recurse);
+
+/* a .include or .lib file name, resolved in the directory dir */
+struct cache_resolve {
+    char *name;
+    char *dir;
+    char *real;                 /* real path of the file found */
+    struct cache_resolve *next;
+};
+
+struct inp_cache {
+    char *file;                 /* the cache file of the deck */
+    unsigned long long key;
+    wordlist *deps;             /* the .include and .lib files read */
+    wordlist *deps_end;
+    struct cache_resolve *resolves;
+    struct cache_resolve **resolves_end;
+};
+
+/* reading a cache file */
+struct cache_in {
+    FILE *fp;
+    long left;                  /* bytes not read yet */
+    bool ok;
+};
+
+
+/* a fast hash, not a cryptographic one, for telling files apart */
+static unsigned long long
+hash_bytes(unsigned long long h, const void *p, size_t n)
+{
+    const unsigned char *s = (const unsigned char *) p;
+
+    for (; n >= 8; s += 8, n -= 8) {
+        unsigned long long w;
+        memcpy(&w, s, 8);
+        h = (h ^ w) * HASH_MUL;
+        h ^= h >> 32;
+    }
+
+    while (n--)
+        h = (h ^ *s++) * HASH_MUL;
+
+    return h;
+}
+
+
+static unsigned long long
+hash_str(unsigned long long h, const char *s)
+{
+    size_t n = s ? strlen(s) : NOSTRING;
+
+    h = hash_bytes(h, &n, sizeof(n));
+    return s ? hash_bytes(h, s, n) : h;
+}
+
+
+/* size and hash of the contents of the file path */
+static bool
+hash_file(char *path, unsigned long long *size, unsigned long long *hash)
+{
+    static char buf[65536];     /* a multiple of 8 */
+    FILE *fp = fopen(path, "rb");
+    size_t n;
+
+    if (!fp)
+        return FALSE;
+
+    *size = 0;
+    *hash = HASH_INIT;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+        *hash = hash_bytes(*hash, buf, n);
+        *size += n;
+    }
+
+    n = (size_t) ferror(fp);
+    fclose(fp);
+    return n == 0;
+}
+
+
+/* the cache for the deck with lines, read from directory dir_name
+   (its real path) in compatibility mode compat */
+struct inp_cache *
+inp_cache_new(char *cachedir, char **lines, int nlines, char *dir_name, int compat)
+{
+    struct inp_cache *cache;
+    struct variable *v;
+    char buf[BSIZE_SP];
+    unsigned long long h = HASH_INIT;
+    int i;
+
+    h = hash_str(h, CACHE_MAGIC);
+    h = hash_bytes(h, &nlines, sizeof(nlines));
+    for (i = 0; i < nlines; i++)
+        h = hash_str(h, lines[i]);
+
+    h = hash_str(h, dir_name);
+    h = hash_bytes(h, &compat, sizeof(compat));
+
+    /* the variables looked at by inp_readall() */
+    h = hash_str(h, cp_getvar("addcontrol", CP_BOOL, NULL) ? "addcontrol" : NULL);
+    h = hash_str(h, cp_getvar("mingwpath", CP_BOOL, NULL) ? "mingwpath" : NULL);
+    h = hash_str(h, cp_getvar("rawfile", CP_STRING, buf) ? buf : NULL);
+    if (cp_getvar("sourcepath", CP_LIST, &v))
+        for (; v; v = v->va_next)
+            switch (v->va_type) {
+            case CP_STRING:
+                h = hash_str(h, v->va_string);
+                break;
+            case CP_NUM:
+                h = hash_bytes(h, &v->va_num, sizeof(v->va_num));
+                break;
+            case CP_REAL:
+                h = hash_bytes(h, &v->va_real, sizeof(v->va_real));
+                break;
+            default:
+                break;
+            }
+
+    cache = TMALLOC(struct inp_cache, 1);
+    cache->key = h;
+    cache->resolves_end = &cache->resolves;
+    cache->file = tprintf("%s%s%016llx.ngdeck", cachedir, DIR_PATHSEP, h);
+
+    return cache;
+}
+
+
+/* the file path has been read for the deck */
+void
+inp_cache_depend(struct inp_cache *cache, char *path)
+{
+    wordlist *wl;
+
+    for (wl = cache->deps; wl; wl = wl->wl_next)
+        if (eq(wl->wl_word, path))
+            return;
+
+    wl_append_word(&cache->deps, &cache->deps_end, copy(path));
+}
+
+
+/* the file name, looked for in the directory dir, has been found at
+   the real path real.  Another file may be found for it later, e.g. if
+   one is created in a directory searched before, so the search is done
+   again when the deck is taken from the cache. */
+void
+inp_cache_resolve(struct inp_cache *cache, char *name, char *dir, char *real)
+{
+    struct cache_resolve *r;
+
+    for (r = cache->resolves; r; r = r->next)
+        if (eq(r->name, name) && (r->dir ? dir && eq(r->dir, dir) : !dir))
+            return;
+
+    r = TMALLOC(struct cache_resolve, 1);
+    r->name = copy(name);
+    r->dir = copy(dir);
+    r->real = copy(real);
+    *cache->resolves_end = r;
+    cache->resolves_end = &r->next;
+}
+
+
+void
+inp_cache_free(struct inp_cache *cache)
+{
+    struct cache_resolve *r, *next;
+
+    if (!cache)
+        return;
+
+    for (r = cache->resolves; r; r = next) {
+        next = r->next;
+        tfree(r->name);
+        tfree(r->dir);
+        tfree(r->real);
+        tfree(r);
+    }
+    wl_free(cache->deps);
+    tfree(cache->file);
+    tfree(cache);
+}
+
+
+static void
+get_bytes(struct cache_in *in, void *p, size_t n)
+{
+    if (!in->ok || (long) n > in->left || fread(p, 1, n, in->fp) != n) {
+        in->ok = FALSE;
+        memset(p, 0, n);
+        return;
+    }
+    in->left -= (long) n;
+}
+
+
+static unsigned long
+get_u32(struct cache_in *in)
+{
+    unsigned int v;
+
+    get_bytes(in, &v, 4);
+    return v;
+}
+
+
+static unsigned long long
+get_u64(struct cache_in *in)
+{
+    unsigned long long v;
+
+    get_bytes(in, &v, 8);
+    return v;
+}
+
+
+static char *
+get_str(struct cache_in *in)
+{
+    unsigned long n = get_u32(in);
+    char *s;
+
+    if (!in->ok || n == NOSTRING)
+        return NULL;
+
+    if ((long) n > in->left) {
+        in->ok = FALSE;
+        return NULL;
+    }
+
+    s = TMALLOC(char, n + 1);
+    get_bytes(in, s, n);
+    s[n] = '\0';
+    return s;
+}
+
+
+static struct line *
+get_cards(struct cache_in *in)
+{
+    struct line *deck = NULL, *end = NULL;
+    unsigned long n = get_u32(in);
+
+    for (; in->ok && n > 0; n--) {
+        struct line *x = TMALLOC(struct line, 1);
+        x->li_linenum = (int) get_u32(in);
+        x->li_linenum_orig = (int) get_u32(in);
+        x->li_line = get_str(in);
+        x->li_error = get_str(in);
+        x->li_actual = get_cards(in);
+        if (end)
+            end->li_next = x;
+        else
+            deck = x;
+        end = x;
+        if (!x->li_line)
+            in->ok = FALSE;
+    }
+
+    return deck;
+}
+
+
+/* the prepared deck, if the cache has it and it is valid */
+struct line *
+inp_cache_load(struct inp_cache *cache, bool *temper)
+{
+    struct cache_in in;
+    struct line *deck = NULL;
+    char magic[8];
+    unsigned long n;
+
+    in.fp = fopen(cache->file, "rb");
+    if (!in.fp)
+        return NULL;
+
+    in.ok = (fseek(in.fp, 0L, SEEK_END) == 0 && (in.left = ftell(in.fp)) >= 0 &&
+             fseek(in.fp, 0L, SEEK_SET) == 0);
+
+    get_bytes(&in, magic, 8);
+    if (memcmp(magic, CACHE_MAGIC, 8) != 0 ||
+        get_u32(&in) != CACHE_VERSION ||
+        get_u64(&in) != cache->key)
+        in.ok = FALSE;
+
+    /* the .include and .lib files must be the same */
+    for (n = get_u32(&in); in.ok && n > 0; n--) {
+        char *path = get_str(&in);
+        unsigned long long size = get_u64(&in), hash = get_u64(&in);
+        unsigned long long fsize, fhash;
+        if (!in.ok || !path || !hash_file(path, &fsize, &fhash) ||
+            fsize != size || fhash != hash)
+            in.ok = FALSE;
+        tfree(path);
+    }
+
+    /* and each file name must still lead to the same file */
+    for (n = get_u32(&in); in.ok && n > 0; n--) {
+        char *name = get_str(&in);
+        char *dir = get_str(&in);
+        char *real = get_str(&in);
+        char *now = NULL;
+        if (!in.ok || !name || !real ||
+            (now = inp_pathresolve_real(name, dir)) == NULL || !eq(now, real))
+            in.ok = FALSE;
+        tfree(name);
+        tfree(dir);
+        tfree(real);
+        tfree(now);
+    }
+
+    *temper = (get_u32(&in) != 0);
+
+    if (in.ok)
+        deck = get_cards(&in);
+
+    if (!in.ok || in.left != 0) {
+        line_free_x(deck, TRUE);
+        deck = NULL;
+    }
+
+    fclose(in.fp);
+
+    return deck;
+}
+
+
+static void
+put_u32(FILE *fp, unsigned long v)
+{
+    unsigned int u = (unsigned int) v;
+
+    fwrite(&u, 4, 1, fp);
+}
+
+
+static void
+put_u64(FILE *fp, unsigned long long v)
+{
+    fwrite(&v, 8, 1, fp);
+}
+
+
+static void
+put_str(FILE *fp, const char *s)
+{
+    if (!s) {
+        put_u32(fp, NOSTRING);
+        return;
+    }
+
+    put_u32(fp, (unsigned long) strlen(s));
+    fputs(s, fp);
+}
+
+
+static void
+put_cards(FILE *fp, struct line *deck)
+{
+    struct line *c;
+    unsigned long n = 0;
+
+    for (c = deck; c; c = c->li_next)
+        n++;
+
+    put_u32(fp, n);
+
+    for (c = deck; c; c = c->li_next) {
+        put_u32(fp, (unsigned long) c->li_linenum);
+        put_u32(fp, (unsigned long) c->li_linenum_orig);
+        put_str(fp, c->li_line);
+        put_str(fp, c->li_error);
+        put_cards(fp, c->li_actual);
+    }
+}
+
+
+/* store the prepared deck.  The file is written under a temporary name
+   and renamed, so that runs sharing the cache never see half of it. */
+void
+inp_cache_save(struct inp_cache *cache, struct line *deck, bool temper)
+{
+    char *tmp = tprintf("%s.%d", cache->file, (int) getpid());
+    FILE *fp = fopen(tmp, "wb");
+    wordlist *wl;
+    struct cache_resolve *r;
+    unsigned long n = 0;
+    bool ok;
+
+    if (!fp) {
+        fprintf(cp_err, "Warning: can't write deck cache %s: %s\n", tmp, strerror(errno));
+        tfree(tmp);
+        return;
+    }
+
+    fwrite(CACHE_MAGIC, 1, 8, fp);
+    put_u32(fp, CACHE_VERSION);
+    put_u64(fp, cache->key);
+
+    put_u32(fp, (unsigned long) wl_length(cache->deps));
+    for (wl = cache->deps; wl; wl = wl->wl_next) {
+        unsigned long long size = 0, hash = 0;
+        if (!hash_file(wl->wl_word, &size, &hash))
+            break;
+        put_str(fp, wl->wl_word);
+        put_u64(fp, size);
+        put_u64(fp, hash);
+    }
+
+    for (r = cache->resolves; r; r = r->next)
+        n++;
+    put_u32(fp, n);
+    for (r = cache->resolves; r; r = r->next) {
+        put_str(fp, r->name);
+        put_str(fp, r->dir);
+        put_str(fp, r->real);
+    }
+
+    put_u32(fp, temper ? 1UL : 0UL);
+    put_cards(fp, deck);
+
+    ok = !wl && !ferror(fp);
+    if (fclose(fp) != 0)
+        ok = FALSE;
+
+    if (!ok || rename(tmp, cache->file) != 0)
+        remove(tmp);
+
+    tfree(tmp);
+}
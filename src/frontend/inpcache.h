@@ -0,0 +1,18 @@
+/*************
+ * Header file for inpcache.c
+ ************/
+
+#ifndef ngspice_INPCACHE_H
+#define ngspice_INPCACHE_H
+
+struct inp_cache;
+
+struct inp_cache *inp_cache_new(char *cachedir, char **lines, int nlines,
+                                char *dir_name, int compat);
+struct line *inp_cache_load(struct inp_cache *cache, bool *temper);
+void inp_cache_depend(struct inp_cache *cache, char *path);
+void inp_cache_resolve(struct inp_cache *cache, char *name, char *dir, char *real);
+void inp_cache_save(struct inp_cache *cache, struct line *deck, bool temper);
+void inp_cache_free(struct inp_cache *cache);
+
+#endif
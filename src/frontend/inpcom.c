@@ -29,9 +29,15 @@ Author: 1985 Wayne A. Christopher
 #endif
 
 #include "inpcom.h"
+#include "inpcache.h"
 #include "variable.h"
 #include "subckt.h"
 #include "../misc/util.h" /* ngdirname() */
+#include "../misc/mapfile.h"
+
+#ifdef USE_OMP
+#include <omp.h>
+#endif
 #include "ngspice/stringutil.h"
 #include "ngspice/wordlist.h"
 
@@ -103,9 +109,49 @@ long dynsubst; /* spicenum.c 221 */
 bool expr_w_temper = FALSE;
 
 
+/* the lines of an input file, taken from a mapping of the file if possible,
+   or from the lines read ahead by inp_read_ahead() */
+struct inp_source {
+    FILE *fp;
+    bool own;                   /* fp opened by inp_source_open() */
+    struct mapfile *map;
+    size_t pos;                 /* next line in map */
+    bool tried;                 /* mapping has been tried */
+    bool ahead;                 /* lines are read ahead */
+    char **lines;
+    int nlines, next;
+};
+
+/* a file found and read by inp_read_ahead() */
+struct inp_file {
+    char *path;                 /* as resolved for .include or .lib */
+    char *realpath;             /* the key */
+    char *dir;                  /* directory for its .include statements */
+    char *libdir;               /* directory for its .lib references */
+    char **lines;
+    int nlines;
+    bool read;                  /* lines are valid */
+};
+
+static struct inp_file *inp_files = NULL;
+static int num_inp_files = 0;
+
+/* the deck cache, see inpcache.c, and whether the deck may be stored */
+static struct inp_cache *inp_cache_cur = NULL;
+static bool inp_cache_ok;
+
 static char *readline(FILE *fd);
+static void inp_source_init(struct inp_source *src, FILE *fp);
+static bool inp_source_open(struct inp_source *src, char *path);
+static char *inp_getline(struct inp_source *src);
+static void inp_source_close(struct inp_source *src);
+static void inp_source_slurp_deck(struct inp_source *src);
+static void inp_read_ahead(struct inp_source *src, char *dir_name);
+static void inp_read_ahead_free(void);
+static char *inp_realpath(char *path);
+static struct inp_file *inp_file_find(char *real);
+static void inp_cache_note(char *name, char *dir, char *path);
 static int  get_number_terminals(char *c);
-static void inp_stripcomments_deck(struct line *deck, bool cs);
 static void inp_stripcomments_line(char *s, bool cs);
 static void inp_fix_for_numparam(struct names *subckt_w_params, struct line *deck);
 static void inp_remove_excess_ws(struct line *deck);
@@ -160,7 +206,7 @@ struct inp_read_t
     int line_number;
 };
 
-static struct inp_read_t inp_read(FILE *fp, int call_depth, char *dir_name, bool comfile, bool intfile);
+static struct inp_read_t inp_read(struct inp_source *src, int call_depth, char *dir_name, bool comfile, bool intfile);
 
 
 #ifndef XSPICE
@@ -273,9 +319,12 @@ read_a_lib(char *y, char *dir_name)
 
     if (!y_resolved) {
         fprintf(cp_err, "Error: Could not find library file %s\n", y);
+        inp_cache_ok = FALSE;
         return NULL;
     }
 
+    inp_cache_note(y, dir_name, y_resolved);
+
 #if defined(__MINGW32__) || defined(_MSC_VER)
     yy = _fullpath(NULL, y_resolved, 0);
 #else
@@ -291,10 +340,11 @@ read_a_lib(char *y, char *dir_name)
 
     if (!lib) {
 
-        FILE *newfp = fopen(y_resolved, "r");
+        struct inp_source src;
 
-        if (!newfp) {
+        if (!inp_source_open(&src, y_resolved)) {
             fprintf(cp_err, "Error: Could not open library file %s\n", y);
+            inp_cache_ok = FALSE;
             return NULL;
         }
 
@@ -304,9 +354,9 @@ read_a_lib(char *y, char *dir_name)
         lib->realpath = strdup(yy);
         lib->habitat = ngdirname(yy);
 
-        lib->deck = inp_read(newfp, 1 /*dummy*/, lib->habitat, FALSE, FALSE) . cc;
+        lib->deck = inp_read(&src, 1 /*dummy*/, lib->habitat, FALSE, FALSE) . cc;
 
-        fclose(newfp);
+        inp_source_close(&src);
     }
 
     free(yy);
@@ -342,16 +392,28 @@ delete_names(struct names *p)
    ---->
    line1 line 2
    Proccedure: store regular card in prev, skip comment lines (*..) and some others
+   All end-of-line comments are stripped in the same pass, each card before it
+   is looked at.  For cf == TRUE (script files, command files like spinit,
+   .spiceinit) and for .control sections only '$ ' is accepted as end-of-line
+   comment, to avoid conflict with $variable definition, otherwise we accept '$'.
    */
 
 static void
-inp_stitch_continuation_lines(struct line *working)
+inp_stitch_continuation_lines(struct line *working, bool cf)
 {
     struct line *prev = NULL;
+    bool found_control = FALSE;
 
     while (working) {
         char *s, c, *buffer;
 
+        /* exclude lines between .control and .endc from removing white spaces */
+        if (ciprefix(".control", working->li_line))
+            found_control = TRUE;
+        if (ciprefix(".endc", working->li_line))
+            found_control = FALSE;
+        inp_stripcomments_line(working->li_line, found_control|cf);
+
         for (s = working->li_line; (c = *s) != '\0' && c <= ' '; s++)
             ;
 
@@ -487,13 +549,56 @@ inp_readall(FILE *fp, char *dir_name, bool comfile, bool intfile)
 {
     struct line *cc;
     struct inp_read_t rv;
+    struct inp_source src;
+    char cachedir[BSIZE_SP];
+    bool from_file = !comfile && !intfile;
 
     num_libraries = 0;
     inp_compat_mode = ngspice_compat_mode();
 
-    rv = inp_read(fp, 0, dir_name, comfile, intfile);
+    inp_source_init(&src, fp);
+
+#ifdef XSPICE
+    if (g_ipc.enabled)
+        from_file = FALSE;
+#endif
+
+    /* take the prepared deck from the cache, if it is there */
+    if (from_file && cp_getvar("deck_cache", CP_STRING, cachedir)) {
+        char *real = inp_realpath(dir_name ? dir_name : ".");
+        bool temper;
+
+        inp_source_slurp_deck(&src);
+        inp_cache_cur = inp_cache_new(cachedir, src.lines, src.nlines,
+                                      real ? real : dir_name, (int) inp_compat_mode);
+        inp_cache_ok = TRUE;
+        tfree(real);
+
+        cc = inp_cache_load(inp_cache_cur, &temper);
+        if (cc) {
+            struct line *t;
+            if (temper)
+                expr_w_temper = TRUE;
+            dynmaxline = 0;
+            for (t = cc; t; t = t->li_next)
+                dynmaxline++;
+            inp_source_close(&src);
+            inp_cache_free(inp_cache_cur);
+            inp_cache_cur = NULL;
+            return cc;
+        }
+    }
+
+    /* find and read the .include and .lib files first, in parallel */
+    if (from_file && cp_getvar("parallel_read", CP_BOOL, NULL))
+        inp_read_ahead(&src, dir_name);
+
+    rv = inp_read(&src, 0, dir_name, comfile, intfile);
     cc = rv . cc;
 
+    inp_source_close(&src);
+    inp_read_ahead_free();
+
     /* The following processing of an input file is not required for command files
        like spinit or .spiceinit, so return command files here. */
 
@@ -566,12 +671,12 @@ inp_readall(FILE *fp, char *dir_name, bool comfile, bool intfile)
             dynmaxline++;
             /* renumber the lines of the processed input deck */
             tmp_ptr1->li_linenum = dynmaxline;
-            if (max_line_length < strlen(tmp_ptr1->li_line))
-                max_line_length = strlen(tmp_ptr1->li_line);
-            /* count '{' */
+            /* count '{', and the length on the way */
             for (s = tmp_ptr1->li_line; *s; s++)
                 if (*s == '{')
                     braces_per_line++;
+            if (max_line_length < (size_t) (s - tmp_ptr1->li_line))
+                max_line_length = (size_t) (s - tmp_ptr1->li_line);
             if (no_braces <  braces_per_line)
                 no_braces = braces_per_line;
         }
@@ -598,15 +703,21 @@ inp_readall(FILE *fp, char *dir_name, bool comfile, bool intfile)
             fprintf(stdout, "max line length %d, max subst. per line %d, number of lines %d\n",
                     (int) max_line_length, no_braces, dynmaxline);
         }
+
+        if (inp_cache_cur && inp_cache_ok)
+            inp_cache_save(inp_cache_cur, cc, expr_w_temper);
     }
 
+    inp_cache_free(inp_cache_cur);
+    inp_cache_cur = NULL;
+
     return cc;
 }
 
 
 struct inp_read_t
-inp_read(FILE *fp, int call_depth, char *dir_name, bool comfile, bool intfile)
-/* fp: in, pointer to file to be read,
+inp_read(struct inp_source *src, int call_depth, char *dir_name, bool comfile, bool intfile)
+/* src: in, the file to be read, see inp_source_init(),
    call_depth: in, nested call to fcn
    dir_name: in, name of directory of file to be read
    comfile: in, TRUE if command file (e.g. spinit, .spiceinit)
@@ -651,12 +762,12 @@ inp_read(FILE *fp, int call_depth, char *dir_name, bool comfile, bool intfile)
 
             /* If IPC is not enabled, do equivalent of what SPICE did before */
             if (! g_ipc.enabled) {
-                if (call_depth == 0 && line_count == 0) {
+                if (call_depth == 0 && line_count == 0 && !src->ahead) {
                     line_count++;
-                    if (fgets(big_buff, 5000, fp))
+                    if (fgets(big_buff, 5000, src->fp))
                         buffer = copy(big_buff);
                 } else {
-                    buffer = readline(fp);
+                    buffer = inp_getline(src);
                     if (!buffer)
                         break;
                 }
@@ -683,7 +794,7 @@ inp_read(FILE *fp, int call_depth, char *dir_name, bool comfile, bool intfile)
             /* gtri - end - 12/12/90 */
 #else
 
-            buffer = readline(fp);
+            buffer = inp_getline(src);
             if(!buffer)
                 break;
 
@@ -703,12 +814,12 @@ inp_read(FILE *fp, int call_depth, char *dir_name, bool comfile, bool intfile)
         if ((strcmp(buffer, "\n") == 0) || (strcmp(buffer, "\r\n") == 0))
             if (call_depth != 0 || (call_depth == 0 && cc != NULL)) {
                 line_number_orig++;
-                tfree(buffer);  /* was allocated by readline() */
+                tfree(buffer);  /* was allocated by inp_getline() */
                 continue;
             }
 
         if (*buffer == '@') {
-            tfree(buffer);      /* was allocated by readline() */
+            tfree(buffer);      /* was allocated by inp_getline() */
             break;
         }
 
@@ -762,38 +873,39 @@ inp_read(FILE *fp, int call_depth, char *dir_name, bool comfile, bool intfile)
 
             if (!y) {
                 fprintf(cp_err, "Error: .include filename missing\n");
-                tfree(buffer);  /* was allocated by readline() */
+                tfree(buffer);  /* was allocated by inp_getline() */
                 controlled_exit(EXIT_FAILURE);
             }
 
             {
                 char *y_resolved = inp_pathresolve_at(y, dir_name);
                 char *y_dir_name;
-                FILE *newfp;
+                struct inp_source newsrc;
 
                 if (!y_resolved) {
                     fprintf(cp_err, "Error: Could not find include file %s\n", y);
+                    inp_cache_ok = FALSE;
                     rv . line_number = line_number;
                     rv . cc = NULL;
                     return rv;
                 }
 
-                newfp = fopen(y_resolved, "r");
+                inp_cache_note(y, dir_name, y_resolved);
 
-                if (!newfp) {
+                if (!inp_source_open(&newsrc, y_resolved)) {
                     fprintf(cp_err, "Error: .include statement failed.\n");
-                    tfree(buffer);          /* allocated by readline() above */
+                    tfree(buffer);          /* allocated by inp_getline() above */
                     controlled_exit(EXIT_FAILURE);
                 }
 
                 y_dir_name = ngdirname(y_resolved);
 
-                newcard = inp_read(newfp, call_depth+1, y_dir_name, FALSE, FALSE) . cc;  /* read stuff in include file into netlist */
+                newcard = inp_read(&newsrc, call_depth+1, y_dir_name, FALSE, FALSE) . cc;  /* read stuff in include file into netlist */
 
                 tfree(y_dir_name);
                 tfree(y_resolved);
 
-                (void) fclose(newfp);
+                inp_source_close(&newsrc);
             }
 
             /* Make the .include a comment */
@@ -843,6 +955,7 @@ inp_read(FILE *fp, int call_depth, char *dir_name, bool comfile, bool intfile)
                  !ciprefix("echo", buffer) &&
                  !ciprefix("shell", buffer) &&
                  !ciprefix("source", buffer) &&
+                 !ciprefix("stimconv", buffer) &&
                  !ciprefix("load", buffer)
                 )
             {
@@ -882,7 +995,8 @@ inp_read(FILE *fp, int call_depth, char *dir_name, bool comfile, bool intfile)
         shell_eol_continuation = chk_for_line_continuation(buffer);
 
         {
-            struct line *x = xx_new_line(NULL, copy(buffer), line_number++, line_number_orig++);
+            /* the card takes over buffer */
+            struct line *x = xx_new_line(NULL, buffer, line_number++, line_number_orig++);
 
             if (end)
                 end->li_next = x;
@@ -891,9 +1005,7 @@ inp_read(FILE *fp, int call_depth, char *dir_name, bool comfile, bool intfile)
 
             end = x;
         }
-
-        tfree(buffer);
-    }  /* end while ((buffer = readline(fp)) != NULL) */
+    }  /* end while ((buffer = inp_getline(src)) != NULL) */
 
     if (!end) /* No stuff here */
     {
@@ -932,14 +1044,12 @@ inp_read(FILE *fp, int call_depth, char *dir_name, bool comfile, bool intfile)
         cc->li_line = new_title;
     }
 
-    /* Strip or convert end-of-line comments.
-       Afterwards stitch the continuation lines.
+    /* Strip or convert end-of-line comments and stitch the continuation
+       lines, in a single pass over the deck.
        If the line only contains an end-of-line comment then it is converted
        into a normal comment with a '*' at the start.  Some special handling
        if this is a command file or called from within a .control section. */
-    inp_stripcomments_deck(cc->li_next, comfile || is_control);
-
-    inp_stitch_continuation_lines(cc->li_next);
+    inp_stitch_continuation_lines(cc->li_next, comfile || is_control);
 
     rv . line_number = line_number;
     rv . cc = cc;
@@ -1145,6 +1255,427 @@ readline(FILE *fd)
 }
 
 
+/* a source for inp_read() reading from the stream fp */
+static void
+inp_source_init(struct inp_source *src, FILE *fp)
+{
+    src->fp = fp;
+    src->own = FALSE;
+    src->map = NULL;
+    src->pos = 0;
+    src->tried = FALSE;
+    src->ahead = FALSE;
+    src->lines = NULL;
+    src->nlines = 0;
+    src->next = 0;
+}
+
+
+/* a source for the file path, FALSE if it can't be opened.
+   The lines read ahead for the file are taken if there are any. */
+static bool
+inp_source_open(struct inp_source *src, char *path)
+{
+    struct inp_file *f = NULL;
+    char *real = NULL;
+
+    if (num_inp_files > 0 || inp_cache_cur)
+        real = inp_realpath(path);
+
+    if (real && num_inp_files > 0)
+        f = inp_file_find(real);
+
+    /* the deck depends on this file */
+    if (inp_cache_cur) {
+        if (real)
+            inp_cache_depend(inp_cache_cur, real);
+        else
+            inp_cache_ok = FALSE;
+    }
+    tfree(real);
+
+    if (f && f->read) {
+        inp_source_init(src, NULL);
+        src->ahead = TRUE;
+        src->lines = f->lines;
+        src->nlines = f->nlines;
+        /* taken, another .include of the file reads it again */
+        f->lines = NULL;
+        f->nlines = 0;
+        f->read = FALSE;
+        return TRUE;
+    }
+
+    inp_source_init(src, fopen(path, "r"));
+    src->own = TRUE;
+    return src->fp != NULL;
+}
+
+
+/*-------------------------------------------------------------------------*
+ *  Same as readline(), but the lines are cut from a mapping of the file,  *
+ *  found with memchr() and copied once into a string of their size.       *
+ *  The file is mapped at the first call, from the current position of     *
+ *  the stream on.  Streams which can't be mapped (pipes, terminals) are   *
+ *  read with readline().                                                  *
+ *-------------------------------------------------------------------------*/
+
+static char *
+inp_getline(struct inp_source *src)
+{
+    char *s, *end, *eol, *line;
+    size_t len;
+
+    if (src->ahead)
+        return (src->next < src->nlines) ? src->lines[src->next++] : NULL;
+
+    if (!src->tried) {
+        long pos = ftell(src->fp);
+        src->tried = TRUE;
+        if (pos >= 0)
+            src->map = mapfile_fmap(src->fp);
+        if (src->map && (size_t) pos > src->map->size) {
+            mapfile_close(src->map);
+            src->map = NULL;
+        }
+        src->pos = (size_t) pos;
+    }
+
+    if (!src->map)
+        return readline(src->fp);
+
+    s = src->map->data + src->pos;
+    end = src->map->data + src->map->size;
+
+    while (s < end && (*s == '\t' || *s == ' ')) /* Leading spaces away */
+        s++;
+
+    if (s == end) {
+        src->pos = src->map->size;
+        return NULL;
+    }
+
+    eol = memchr(s, '\n', (size_t) (end - s));
+    len = eol ? (size_t) (eol - s) + 1 : (size_t) (end - s);
+
+    line = TMALLOC(char, len + 1);
+    memcpy(line, s, len);
+    line[len] = '\0';
+
+    src->pos = (size_t) (s - src->map->data) + len;
+
+    return line;
+}
+
+
+/* read all lines of src ahead, up to and including a line starting
+   with '@', where inp_read() stops.  first, if given, is taken as the
+   first line. */
+static void
+inp_source_slurp(struct inp_source *src, char *first)
+{
+    char **lines = NULL, *line = first;
+    int n = 0, size = 0;
+
+    if (!line)
+        line = inp_getline(src);
+
+    for (; line; line = inp_getline(src)) {
+        if (n == size) {
+            size = size ? 2 * size : 256;
+            lines = TREALLOC(char *, lines, size);
+        }
+        lines[n++] = line;
+        if (*line == '@')
+            break;
+    }
+
+    src->ahead = TRUE;
+    src->lines = lines;
+    src->nlines = n;
+    src->next = 0;
+}
+
+
+/* read the lines of the deck itself ahead */
+static void
+inp_source_slurp_deck(struct inp_source *src)
+{
+    char *first = NULL;
+
+#ifdef XSPICE
+    {
+        /* the first line as taken by inp_read() */
+        char big_buff[5000];
+        if (fgets(big_buff, 5000, src->fp))
+            first = copy(big_buff);
+    }
+#endif
+
+    inp_source_slurp(src, first);
+}
+
+
+/* leave the stream behind the last line read,
+   drop the lines read ahead but not taken */
+static void
+inp_source_close(struct inp_source *src)
+{
+    if (src->ahead) {
+        while (src->next < src->nlines)
+            tfree(src->lines[src->next++]);
+        tfree(src->lines);
+        src->ahead = FALSE;
+    }
+
+    if (src->map) {
+        fseek(src->fp, (long) src->pos, SEEK_SET);
+        mapfile_close(src->map);
+        src->map = NULL;
+    }
+
+    if (src->own && src->fp)
+        fclose(src->fp);
+    src->fp = NULL;
+}
+
+
+/*
+ * Reading ahead, set parallel_read
+ *
+ * The deck is read first, then all files referenced by its .include
+ * and .lib lines, then the files referenced by these, and so on.  The
+ * files of each round are read and cut into lines in parallel (with
+ * OpenMP).  inp_read() then processes the deck as usual, but takes the
+ * lines of a file from here when it opens it, see inp_source_open().
+ * So the result, line numbers and error messages included, is the same
+ * as without reading ahead.  Files are found and resolved the way
+ * inp_read() and expand_section_references() do, a file found
+ * differently there is simply read again.
+ */
+
+static char *
+inp_realpath(char *path)
+{
+    char *r, *real;
+
+#if defined(__MINGW32__) || defined(_MSC_VER)
+    r = _fullpath(NULL, path, 0);
+#else
+    r = realpath(path, NULL);
+#endif
+
+    real = copy(r);
+    free(r);
+
+    return real;
+}
+
+
+/* the real path of the file name, referenced from a file with
+   directory dir, NULL if it isn't found.  For the deck cache. */
+char *
+inp_pathresolve_real(char *name, char *dir)
+{
+    char *path = inp_pathresolve_at(name, dir);
+    char *real;
+
+    if (!path)
+        return NULL;
+
+    real = inp_realpath(path);
+    tfree(path);
+    return real;
+}
+
+
+/* the deck depends on name, referenced from a file with directory dir,
+   being found at path */
+static void
+inp_cache_note(char *name, char *dir, char *path)
+{
+    char *real;
+
+    if (!inp_cache_cur)
+        return;
+
+    real = inp_realpath(path);
+    if (real)
+        inp_cache_resolve(inp_cache_cur, name, dir, real);
+    else
+        inp_cache_ok = FALSE;
+    tfree(real);
+}
+
+
+static struct inp_file *
+inp_file_find(char *real)
+{
+    int i;
+
+    for (i = 0; i < num_inp_files; i++)
+        if (eq(inp_files[i].realpath, real))
+            return &inp_files[i];
+
+    return NULL;
+}
+
+
+/* add the file name, referenced from a file with directory dir for
+   .include and libdir for .lib, unless it is there already */
+static void
+inp_read_ahead_add(char *name, char *dir, char *libdir, bool lib)
+{
+    char *path, *real;
+    struct inp_file *f;
+
+    path = inp_pathresolve_at(name, lib ? libdir : dir);
+    if (!path)
+        return;
+
+    real = inp_realpath(path);
+    if (!real || inp_file_find(real)) {
+        tfree(path);
+        tfree(real);
+        return;
+    }
+
+    inp_files = TREALLOC(struct inp_file, inp_files, num_inp_files + 1);
+    f = &inp_files[num_inp_files++];
+
+    f->path = path;
+    f->realpath = real;
+    /* a library is read at its real path, see read_a_lib() */
+    f->dir = ngdirname(lib ? real : path);
+    f->libdir = copy(lib ? f->dir : libdir);
+    f->lines = NULL;
+    f->nlines = 0;
+    f->read = FALSE;
+}
+
+
+/* add the files referenced in lines */
+static void
+inp_read_ahead_refs(char **lines, int nlines, char *dir, char *libdir)
+{
+    int i;
+
+    for (i = 0; i < nlines; i++) {
+
+        char *line = lines[i], *s, *y = NULL, *z = NULL;
+        bool lib;
+
+        if (ciprefix(".inc", line))
+            lib = FALSE;
+        else if (ciprefix(".lib", line))
+            lib = (inp_compat_mode != COMPATMODE_PS);
+        else
+            continue;
+
+        /* library references are expanded in these modes only */
+        if (lib &&
+            inp_compat_mode != COMPATMODE_ALL &&
+            inp_compat_mode != COMPATMODE_HS &&
+            inp_compat_mode != COMPATMODE_NATIVE)
+            continue;
+
+        line = copy(line);
+        inp_stripcomments_line(line, FALSE);
+
+        s = skip_non_ws(line);
+        s = get_quoted_token(s, &y);
+
+        /* `.lib <library-file> <section-name>', not `.lib <section-name>' */
+        if (y && lib)
+            get_quoted_token(s, &z);
+
+        if (y && (!lib || z))
+            inp_read_ahead_add(y, dir, libdir, lib);
+
+        tfree(line);
+    }
+}
+
+
+/* read the file f into lines, called in parallel */
+static void
+inp_read_ahead_file(struct inp_file *f)
+{
+    struct inp_source src;
+    FILE *fp = fopen(f->path, "r");
+
+    if (!fp)
+        return;
+
+    inp_source_init(&src, fp);
+    src.own = TRUE;
+    inp_source_slurp(&src, NULL);
+    f->lines = src.lines;
+    f->nlines = src.nlines;
+    f->read = TRUE;
+
+    src.ahead = FALSE;
+    inp_source_close(&src);
+}
+
+
+static void
+inp_read_ahead(struct inp_source *src, char *dir_name)
+{
+    int done, i;
+#ifdef USE_OMP
+    int nthreads;
+
+    if (!cp_getvar("num_threads", CP_NUM, &nthreads) || nthreads < 1)
+        nthreads = omp_get_max_threads();
+#endif
+
+    if (!src->ahead)
+        inp_source_slurp_deck(src);
+
+    inp_read_ahead_refs(src->lines, src->nlines, dir_name, dir_name);
+
+    for (done = 0; done < num_inp_files; ) {
+
+        int n = num_inp_files;
+
+#ifdef USE_OMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1)
+#endif
+        for (i = done; i < n; i++)
+            inp_read_ahead_file(&inp_files[i]);
+
+        for (i = done; i < n; i++)
+            if (inp_files[i].read)
+                inp_read_ahead_refs(inp_files[i].lines, inp_files[i].nlines,
+                                    inp_files[i].dir, inp_files[i].libdir);
+
+        done = n;
+    }
+}
+
+
+static void
+inp_read_ahead_free(void)
+{
+    int i, k;
+
+    for (i = 0; i < num_inp_files; i++) {
+        struct inp_file *f = &inp_files[i];
+        for (k = 0; k < f->nlines; k++)
+            tfree(f->lines[k]);
+        tfree(f->lines);
+        tfree(f->path);
+        tfree(f->realpath);
+        tfree(f->dir);
+        tfree(f->libdir);
+    }
+
+    tfree(inp_files);
+    num_inp_files = 0;
+}
+
+
 /* replace "gnd" by " 0 "
    Delimiters of gnd may be ' ' or ',' or '(' or ')' */
 
@@ -1966,25 +2497,6 @@ inp_casefix(char *string)
 }
 
 
-/* Strip all end-of-line comments from a deck
-   For cf == TRUE (script files, command files like spinit, .spiceinit)
-   and for .control sections only '$ ' is accepted as end-of-line comment,
-   to avoid conflict with $variable definition, otherwise we accept '$'. */
-static void
-inp_stripcomments_deck(struct line *c, bool cf)
-{
-    bool found_control = FALSE;
-    for (; c; c = c->li_next) {
-        /* exclude lines between .control and .endc from removing white spaces */
-        if (ciprefix(".control", c->li_line))
-            found_control = TRUE;
-        if (ciprefix(".endc", c->li_line))
-            found_control = FALSE;
-        inp_stripcomments_line(c->li_line, found_control|cf);
-    }
-}
-
-
 /*
  * Support for end-of-line comments that begin with any of the following:
  *   ';'
@@ -6,5 +6,6 @@
 #ifndef ngspice_INPCOM_H
 #define ngspice_INPCOM_H
 
+char *inp_pathresolve_real(char *name, char *dir);
 
 #endif
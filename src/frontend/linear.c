@@ -90,6 +90,7 @@ com_linearize(wordlist *wl)
         for (v = old->pl_dvecs; v; v = v->v_next) {
             if (v == old->pl_scale)
                 continue;
+            raw_vec_load(v);
             lincopy(v, newtime->v_realdata, len, oldtime);
         }
     }
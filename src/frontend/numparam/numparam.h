@@ -46,6 +46,7 @@ typedef struct {                /* the input scanner data structure */
     char **dynrefptr;
     char *dyncategory;
     int hs_compatibility;       /* allow extra keywords */
+    NGHASHPTR fcode;            /* compiled formulas, keyed by their text */
 } dico_t;
 
 
@@ -62,3 +63,4 @@ dico_t *nupa_fetchinstance(void);
 char getidtype(dico_t *, char *s);
 entry_t *attrib(dico_t *, NGHASHPTR htable, char *t, char op);
 void del_attrib(void *);
+void del_fcode(void *);
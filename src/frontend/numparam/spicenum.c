@@ -472,6 +472,8 @@ nupa_del_dicoS(void)
     dispose(dicoS->dyncategory);
     dispose(dicoS->inst_name);
     nghash_free(dicoS->symbols[0], del_attrib, NULL);
+    if (dicoS->fcode)
+        nghash_free(dicoS->fcode, del_fcode, NULL);
     dispose(dicoS->symbols);
     dispose(dicoS);
     dicoS = NULL;
@@ -265,6 +265,8 @@ initdico(dico_t *dico)
 
     dico->inst_symbols = NULL;          /* instance qualified are lazily allocated */
 
+    dico->fcode = NULL;                 /* compiled formulas, see cachedformula() */
+
     compat_mode = ngspice_compat_mode();
 
     if (compat_mode == COMPATMODE_HS)
@@ -940,6 +942,27 @@ operate(char op, double x, double y)
 }
 
 
+static double
+applyfunction(unsigned char fu, double v, double w, double u)
+{
+    /* function fu of the arguments v, w, u (u is the last one) */
+    if ((fu == XFU_TERNARY_FCN))
+        return ternary_fcn(v, w, u);
+    else if ((fu == XFU_AGAUSS))
+        return agauss(v, w, u);
+    else if ((fu == XFU_GAUSS))
+        return gauss(v, w, u);
+    else if ((fu == XFU_UNIF))
+        return unif(v, u);
+    else if ((fu == XFU_AUNIF))
+        return aunif(v, u);
+    else if ((fu == XFU_LIMIT))
+        return limit(v, u);
+    else
+        return mathfunction(fu, v, u);
+}
+
+
 static double
 formula(dico_t *dico, const char *s, const char *s_end, bool *perror)
 {
@@ -1033,22 +1056,8 @@ formula(dico_t *dico, const char *s, const char *s_end, bool *perror)
                 }
                 u = formula(dico, s, kptr - 1, &error);
                 state = S_atom;
-                if (fu > 0) {
-                    if ((fu == XFU_TERNARY_FCN))
-                        u = ternary_fcn(v, w, u);
-                    else if ((fu == XFU_AGAUSS))
-                        u = agauss(v, w, u);
-                    else if ((fu == XFU_GAUSS))
-                        u = gauss(v, w, u);
-                    else if ((fu == XFU_UNIF))
-                        u = unif(v, u);
-                    else if ((fu == XFU_AUNIF))
-                        u = aunif(v, u);
-                    else if ((fu == XFU_LIMIT))
-                        u = limit(v, u);
-                    else
-                        u = mathfunction(fu, v, u);
-                }
+                if (fu > 0)
+                    u = applyfunction(fu, v, w, u);
             }
             s = kptr;
             fu = 0;
@@ -1162,6 +1171,442 @@ formula(dico_t *dico, const char *s, const char *s_end, bool *perror)
 }
 
 
+/* -----------------------------------------------------------------
+ * Compiled formulas.
+ *
+ * Subcircuit calls evaluate the same few expression texts over and
+ * over again, once per instance.  formulacode() scans a text once and
+ * builds a tree of what formula() computes, its identifiers collected
+ * in a symbol table.  Further evaluations of the same text just look
+ * up the symbols in the current scope and walk the tree.
+ *
+ * The tree is built by the state machine of formula(), with trees in
+ * place of the accumulated values.  So precedence, the quirks of the
+ * ternary operator and the order in which the random functions are
+ * called all stay the same.  A text formula() would report an error
+ * for is not compiled, and a compiled text using an undefined symbol
+ * is not evaluated from its tree: formula() deals with both, and
+ * prints its messages.
+ * ----------------------------------------------------------------- */
+
+typedef struct fnode_s {
+    char tp;            /* C)onstant S)ymbol O)perator F)unction !)not ?)ternary */
+    char op;            /* operator, see operate() */
+    unsigned char fu;   /* function number, 0 for a plain (...) */
+    int slot;           /* symbol table index */
+    double vl;          /* constant value */
+    struct fnode_s *arg[3];
+    struct fnode_s *next;   /* chain of all nodes */
+} fnode_t;
+
+
+typedef struct {
+    fnode_t *tree;      /* NULL: text is left to formula() */
+    fnode_t *nodes;
+    int nsym;
+    char **symbol;
+    double *vl;         /* symbol values of the current evaluation */
+} fcode_t;
+
+
+static fnode_t *
+fnode(fcode_t *code, char tp)
+{
+    fnode_t *n = TMALLOC(fnode_t, 1);
+    n->tp = tp;
+    n->next = code->nodes;
+    code->nodes = n;
+    return n;
+}
+
+
+static fnode_t *
+fconst(fcode_t *code, double vl)
+{
+    fnode_t *n = fnode(code, 'C');
+    n->vl = vl;
+    return n;
+}
+
+
+static fnode_t *
+fsymbol(fcode_t *code, const char *t)
+{
+    fnode_t *n = fnode(code, 'S');
+    int k;
+
+    for (k = 0; k < code->nsym; k++)
+        if (strcmp(code->symbol[k], t) == 0)
+            break;
+
+    if (k == code->nsym) {
+        code->symbol = TREALLOC(char *, code->symbol, k + 1);
+        code->vl = TREALLOC(double, code->vl, k + 1);
+        code->symbol[k] = copy(t);
+        code->nsym++;
+    }
+
+    n->slot = k;
+    return n;
+}
+
+
+static fnode_t *
+foperator(fcode_t *code, char op, fnode_t *x, fnode_t *y)
+{
+    /* the tree of operate(op, x, y) */
+    fnode_t *n;
+
+    if (op == ' ')
+        return y;
+
+    /* a misplaced ternary, which formula() would not even complain about */
+    if ((op == '?') || (op == ':') || (op == 'x'))
+        return NULL;
+
+    n = fnode(code, 'O');
+    n->op = op;
+    n->arg[0] = x;
+    n->arg[1] = y;
+    return n;
+}
+
+
+static fnode_t *
+formulacode(dico_t *dico, fcode_t *code, const char *s, const char *s_end)
+{
+    /* same as formula(), but builds the tree, NULL on error */
+    enum {nprece = 9}; /* maximal nb of precedence levels */
+    bool error = 0;
+    bool negate = 0;
+    unsigned char state, oldstate, topop, ustack, level, fu;
+    fnode_t *u = NULL, *zero;
+    fnode_t *accu[nprece + 1];
+    fnode_t *open = NULL;       /* innermost ternary of accu[nprece] */
+    char oper[nprece + 1];
+    char uop[nprece + 1];
+    int i, natom;
+    bool ok;
+    SPICE_DSTRING tstr;
+
+    spice_dstring_init(&tstr);
+
+    zero = fconst(code, 0.0);
+    for (i = 0; i <= nprece; i++) {
+        accu[i] = zero;
+        oper[i] = ' ';
+    }
+
+    /* trim trailing whitespace */
+    while ((s_end > s) && (s_end[-1] <= ' '))
+        s_end--;
+
+    state = S_init;
+    natom = 0;
+    ustack = 0;
+    topop = 0;
+    oldstate = S_init;
+    fu = 0;
+    level = 0;
+
+    while ((s < s_end) && !error) {
+        char c = *s;
+        if (c == '(') {
+            /* sub-formula or math function */
+            fnode_t *v = NULL, *w = NULL;
+            const char *kptr = ++s;
+            const char *arg2 = NULL;
+            const char *arg3 = NULL;
+            char d;
+
+            level = 1;
+            do
+            {
+                d = *kptr++;
+                if (kptr > s_end)
+                    d = '\0';
+
+                if (d == '(')
+                    level++;
+                else if (d == ')')
+                    level--;
+
+                if ((d == ',') && (level == 1)) {
+                    if (arg2 == NULL)
+                        arg2 = kptr;
+                    else
+                        arg3 = kptr;
+                }
+
+            } while ((kptr <= s_end) && !((d == ')') && (level <= 0)));
+
+            if (kptr > s_end) {
+                error = 1;
+            } else {
+                if (arg2 > s) {
+                    v = formulacode(dico, code, s, arg2 - 1);
+                    error = error || !v;
+                    s = arg2;
+                }
+                if (arg3 > s) {
+                    w = formulacode(dico, code, s, arg3 - 1);
+                    error = error || !w;
+                    s = arg3;
+                }
+                u = formulacode(dico, code, s, kptr - 1);
+                error = error || !u;
+                state = S_atom;
+                if ((fu > 0) || v || w) {
+                    fnode_t *f = fnode(code, 'F');
+                    f->fu = fu;
+                    f->arg[0] = v;
+                    f->arg[1] = w;
+                    f->arg[2] = u;
+                    u = f;
+                }
+            }
+            s = kptr;
+            fu = 0;
+        } else if (alfa(c)) {
+            s = fetchid(&tstr, s_end, s); /* user id, but sort out keywords */
+            state = S_atom;
+            fu = keyword(fmathS, spice_dstring_value(&tstr)); /* numeric function? */
+            if (fu == 0)
+                u = fsymbol(code, spice_dstring_value(&tstr));
+            else
+                state = S_init;  /* S_init means: ignore for the moment */
+        } else if (((c == '.') || ((c >= '0') && (c <= '9')))) {
+            double x;
+            if (1 != sscanf(s, "%lG", &x)) {
+                error = 1;      /* fetchnumber() would complain */
+                break;
+            }
+            x = fetchnumber(dico, &s, &error);
+            if (negate) {
+                x = -1 * x;
+                negate = 0;
+            }
+            u = fconst(code, x);
+            state = S_atom;
+        } else {
+            /* anything else fetchoperator() complains about */
+            char d = (s + 1 < s_end) ? s[1] : '\0';
+            if ((c > ' ') && !strchr("+-*/%\\^=<>#!?:", c) &&
+                !(((c == '&') || (c == '|')) && (d == c)))
+            {
+                error = 1;
+                break;
+            }
+            c = fetchoperator(dico, s_end, &s, &state, &level, &error);
+        }
+
+        ok = (oldstate == S_init) || (state == S_init) ||
+            ((oldstate == S_atom) && (state == S_binop)) ||
+            ((oldstate != S_atom) && (state != S_binop));
+
+        if (oldstate == S_binop && state == S_binop && c == '-') {
+            negate = 1;
+            continue;
+        }
+
+        if (!ok || error) {
+            error = 1;
+            break;
+        }
+
+        if (state == S_unop) {
+            /* push unary operator */
+            if (ustack >= nprece) {
+                error = 1;
+                break;
+            }
+            uop[++ustack] = c;
+        } else if (state == S_atom) {
+            /* atom pending */
+            natom++;
+            if (s >= s_end) {
+                state = S_stop;
+                level = topop;
+            } /* close all ops below */
+
+            while (ustack > 0) {
+                fnode_t *n = fnode(code, '!');
+                n->op = uop[ustack--];
+                n->arg[0] = u;
+                u = n;
+            }
+
+            accu[0] = u;        /* done: all pending unary operators */
+        }
+
+        if ((state == S_binop) || (state == S_stop)) {
+            /* do pending binaries of priority Upto "level" */
+            for (i = 1; i <= level; i++) {
+                if (i < level && oper[i] == ':' && (oper[i+1] == '?' || oper[i+1] == 'x')) {
+                    /* a ternary, continuing the one left by a preceding
+                       ternary: a ? b : c ? d : e is a ? b : (c ? d : e) */
+                    fnode_t *t = fnode(code, '?');
+                    t->arg[1] = accu[i];
+                    t->arg[2] = accu[i-1];
+                    if (open) {
+                        t->arg[0] = open->arg[2];
+                        open->arg[2] = t;
+                    } else {
+                        t->arg[0] = accu[i+1];
+                        accu[i+1] = t;
+                    }
+                    open = t;
+                    accu[i-1] = zero;
+                    oper[i] = ' ';
+                    i++;
+                    accu[i-1] = zero;
+                    oper[i] = ' ';
+                } else {
+                    accu[i] = foperator(code, oper[i], accu[i], accu[i-1]);
+                    if (!accu[i]) {
+                        error = 1;
+                        break;
+                    }
+                    if (i == nprece)
+                        open = NULL;
+                    accu[i-1] = zero;
+                    oper[i] = ' ';
+                }
+            }
+            oper[level] = c;
+
+            if (topop < level)
+                topop = level;
+        }
+
+        if (state != S_init)
+            oldstate = state;
+    }
+
+    if ((natom == 0) || (oldstate != S_stop))
+        error = 1;
+
+    if (negate == 1)
+        error = 1;
+
+    spice_dstring_free(&tstr);
+
+    if (error)
+        return NULL;
+    else
+        return accu[topop];
+}
+
+
+static double
+fnodeeval(fnode_t *n, double *vl)
+{
+    double x, y, z;
+
+    switch (n->tp)
+    {
+    case 'C':
+        return n->vl;
+    case 'S':
+        return vl[n->slot];
+    case '!':
+        x = fnodeeval(n->arg[0], vl);
+        return operate(n->op, x, x);
+    case 'O':
+        x = fnodeeval(n->arg[0], vl);
+        y = fnodeeval(n->arg[1], vl);
+        return operate(n->op, x, y);
+    case 'F':
+        /* argument defaults as in formula() */
+        x = n->arg[0] ? fnodeeval(n->arg[0], vl) : 1.0;
+        y = n->arg[1] ? fnodeeval(n->arg[1], vl) : 0.0;
+        z = fnodeeval(n->arg[2], vl);
+        return (n->fu > 0) ? applyfunction(n->fu, x, y, z) : z;
+    default:
+        /* ternary, all three are evaluated, as by formula() */
+        x = fnodeeval(n->arg[0], vl);
+        y = fnodeeval(n->arg[1], vl);
+        z = fnodeeval(n->arg[2], vl);
+        return (x != 0.0) ? y : z;
+    }
+}
+
+
+static void
+fcode_nodes_free(fcode_t *code)
+{
+    while (code->nodes) {
+        fnode_t *n = code->nodes;
+        code->nodes = n->next;
+        tfree(n);
+    }
+}
+
+
+/* user defined delete function for the compiled formulas,
+ * called by nghash_free() in nupa_del_dicoS()
+ */
+void
+del_fcode(void *code_p)
+{
+    fcode_t *code = (fcode_t *) code_p;
+    int k;
+
+    if (code) {
+        fcode_nodes_free(code);
+        for (k = 0; k < code->nsym; k++)
+            tfree(code->symbol[k]);
+        tfree(code->symbol);
+        tfree(code->vl);
+        tfree(code);
+    }
+}
+
+
+static double
+cachedformula(dico_t *dico, const char *t, bool *perror)
+{
+    /* formula() of the whole text t, compiled on first use */
+    fcode_t *code;
+    int k;
+
+    if (!dico->fcode)
+        dico->fcode = nghash_init(NGHASH_MIN_SIZE);
+
+    code = (fcode_t *) nghash_find(dico->fcode, (void *) t);
+
+    if (!code) {
+        code = TMALLOC(fcode_t, 1);
+        code->tree = formulacode(dico, code, t, t + strlen(t));
+        if (!code->tree)
+            fcode_nodes_free(code);
+        nghash_insert(dico->fcode, (void *) t, code);
+    }
+
+    if (code->tree) {
+        /* bind the symbols in the current scope */
+        for (k = 0; k < code->nsym; k++) {
+            entry_t *entry = entrynb(dico, code->symbol[k]);
+
+            while (entry && (entry->tp == 'P'))
+                entry = entry->pointer;
+
+            if (!entry || (entry->tp != 'R'))
+                break;
+
+            code->vl[k] = entry->vl;
+        }
+
+        if (k == code->nsym) {
+            *perror = 0;
+            return fnodeeval(code->tree, code->vl);
+        }
+    }
+
+    return formula(dico, t, t + strlen(t), perror);
+}
+
+
 static bool
 evaluate(dico_t *dico, SPICE_DSTRINGPTR qstr_p, char *t, unsigned char mode)
 {
@@ -1223,7 +1668,7 @@ evaluate(dico_t *dico, SPICE_DSTRINGPTR qstr_p, char *t, unsigned char mode)
                           "\"%s\" not evaluated.%s\n", t,
                           nolookup ? " Lookup failure." : "");
     } else {
-        u = formula(dico, t, t + strlen(t), &err);
+        u = cachedformula(dico, t, &err);
         numeric = 1;
     }
 
@@ -1580,7 +2025,7 @@ nupa_assignment(dico_t *dico, char *s, char mode)
 
             if (dtype == 'R') {
                 const char *tmp = spice_dstring_value(&ustr);
-                rval = formula(dico, tmp, tmp + strlen(tmp), &error);
+                rval = cachedformula(dico, tmp, &error);
                 if (error)
                     message(dico,
                             " Formula() error.\n"
@@ -31,6 +31,11 @@ Modified: 2000 AlansFixes
 #include "runcoms.h"
 #include "plotting/graf.h"
 #include "../misc/misc_time.h"
+#include "../misc/dtoa.h"
+
+#ifdef RAWFILE_THREAD
+#include <pthread.h>
+#endif
 
 extern char *spice_analysis_get_name(int index);
 extern char *spice_analysis_get_description(int index);
@@ -48,6 +53,11 @@ static void fileAddRealValue(FILE *fp, bool bin, double value);
 static void fileAddComplexValue(FILE *fp, bool bin, IFcomplex value);
 static void fileEndPoint(FILE *fp, bool bin);
 static void fileEnd(runDesc *run);
+static bool fileError(FILE *fp);
+static void rawbufOpen(FILE *fp);
+static void rawbufWrite(const void *data, size_t len);
+static void rawbufFlush(void);
+static void rawbufClose(void);
 static void plotInit(runDesc *run);
 static void plotAddRealValue(dataDesc *desc, double value);
 static void plotAddComplexValue(dataDesc *desc, IFcomplex value);
@@ -65,6 +75,7 @@ static int InterpPlotAdd(runDesc *plotPtr, IFvalue *refValue, IFvalue *valuePtr)
 #elif defined SHARED_MODULE
 extern int sh_ExecutePerLoop(void);
 extern void sh_vecinit(runDesc *run);
+extern void sh_stream_end(void);
 #endif
 
 /*Suppressing progress info in -o option */
@@ -85,6 +96,29 @@ static clock_t lastclock, currclock;
 static double *rowbuf;
 static size_t column, rowbuflen;
 
+/* Rawfile data is not written value by value, but collected in blocks
+ * of RAWBUF_SIZE bytes which go to the file with a single fwrite.  With
+ * RAWFILE_THREAD a full block is handed over to a writer thread and the
+ * simulation continues to fill the second block meanwhile.
+ */
+
+#define RAWBUF_SIZE    (1 << 20)
+
+static FILE *rawbuf_fp;
+static char *rawbuf;
+static size_t rawbuf_len;
+static bool rawbuf_error;
+
+#ifdef RAWFILE_THREAD
+static pthread_t rawbuf_thread;
+static char *rawbuf_spare;
+static pthread_mutex_t rawbuf_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t rawbuf_cond = PTHREAD_COND_INITIALIZER;
+static char *rawbuf_full;       /* block waiting for or being written */
+static size_t rawbuf_full_len;
+static bool rawbuf_threaded, rawbuf_quit;
+#endif
+
 static bool shouldstop = FALSE; /* Tell simulator to stop next time it asks. */
 
 static bool interpolated = FALSE;
@@ -590,7 +624,7 @@ OUTpData(runDesc *plotPtr, IFvalue *refValue, IFvalue *valuePtr)
 
         /*  Check that the write to disk completed successfully, otherwise abort  */
 
-        if (ferror(run->fp)) {
+        if (fileError(run->fp)) {
             fprintf(stderr, "Warning: rawfile write error !!\n");
             shouldstop = TRUE;
         }
@@ -706,6 +740,23 @@ OUTwEnd(runDesc *plotPtr)
 }
 
 
+/* Tell whether the plot saves device or model parameters.  Those are
+ * read from the circuit by OUTpData(), not taken from the data vector.
+ */
+
+bool
+OUTpHasSpecial(runDesc *plotPtr)
+{
+    int i;
+
+    for (i = 0; i < plotPtr->numData; i++)
+        if (!plotPtr->data[i].regular)
+            return TRUE;
+
+    return FALSE;
+}
+
+
 int
 OUTendPlot(runDesc *plotPtr)
 {
@@ -723,6 +774,10 @@ OUTendPlot(runDesc *plotPtr)
         plotEnd(run);
     }
 
+#ifdef SHARED_MODULE
+    sh_stream_end();
+#endif
+
     freeRun(run);
 
     return (OK);
@@ -923,14 +978,24 @@ fileInit_pass2(runDesc *run)
         // fIXME rowbuflen = 0;
         rowbuf = NULL;
     }
+
+    rawbufOpen(run->fp);
 }
 
 
 static void
 fileStartPoint(FILE *fp, bool bin, int num)
 {
-    if (!bin)
-        fprintf(fp, "%d\t", num - 1);
+    /* an interrupted analysis has closed the buffer, see OUTrawClose() */
+    if (!rawbuf)
+        rawbufOpen(fp);
+
+    if (!bin) {
+        char buf[DTOA_BUFSIZE];
+        int n = itoa_decimal(buf, num - 1);
+        buf[n++] = '\t';
+        rawbufWrite(buf, (size_t) n);
+    }
 
     /*  reset buffer pointer to zero  */
 
@@ -941,22 +1006,38 @@ fileStartPoint(FILE *fp, bool bin, int num)
 static void
 fileAddRealValue(FILE *fp, bool bin, double value)
 {
-    if (bin)
+    NG_IGNORE(fp);
+
+    if (bin) {
         rowbuf[column++] = value;
-    else
-        fprintf(fp, "\t%.*e\n", DOUBLE_PRECISION, value);
+    } else {
+        char buf[DTOA_BUFSIZE + 2];
+        int n = 1;
+        buf[0] = '\t';
+        n += dtoa_shortest(buf + n, value);
+        buf[n++] = '\n';
+        rawbufWrite(buf, (size_t) n);
+    }
 }
 
 
 static void
 fileAddComplexValue(FILE *fp, bool bin, IFcomplex value)
 {
+    NG_IGNORE(fp);
+
     if (bin) {
         rowbuf[column++] = value.real;
         rowbuf[column++] = value.imag;
     } else {
-        fprintf(fp, "\t%.*e,%.*e\n", DOUBLE_PRECISION, value.real,
-                DOUBLE_PRECISION, value.imag);
+        char buf[2 * DTOA_BUFSIZE + 2];
+        int n = 1;
+        buf[0] = '\t';
+        n += dtoa_shortest(buf + n, value.real);
+        buf[n++] = ',';
+        n += dtoa_shortest(buf + n, value.imag);
+        buf[n++] = '\n';
+        rawbufWrite(buf, (size_t) n);
     }
 }
 
@@ -965,11 +1046,22 @@ fileAddComplexValue(FILE *fp, bool bin, IFcomplex value)
 static void
 fileEndPoint(FILE *fp, bool bin)
 {
+    NG_IGNORE(fp);
+
     /*  write row buffer to file  */
     /* otherwise the data has already been written */
 
     if (bin)
-        fwrite(rowbuf, sizeof(double), rowbuflen, fp);
+        rawbufWrite(rowbuf, sizeof(double) * rowbuflen);
+}
+
+
+/* Check for a failed write, either to fp directly or by the writer */
+
+static bool
+fileError(FILE *fp)
+{
+    return rawbuf_error || ferror(fp);
 }
 
 
@@ -978,6 +1070,9 @@ fileEndPoint(FILE *fp, bool bin)
 static void
 fileEnd(runDesc *run)
 {
+    /* all data has to be in the file before the header is patched */
+    rawbufClose();
+
     if (run->fp != stdout) {
         long place = ftell(run->fp);
         fseek(run->fp, run->pointPos, SEEK_SET);
@@ -998,6 +1093,158 @@ fileEnd(runDesc *run)
 }
 
 
+/* The rawfile output blocks. */
+
+#ifdef RAWFILE_THREAD
+
+static void *
+rawbufWriter(void *arg)
+{
+    NG_IGNORE(arg);
+
+    pthread_mutex_lock(&rawbuf_mutex);
+
+    for (;;) {
+        while (!rawbuf_full && !rawbuf_quit)
+            pthread_cond_wait(&rawbuf_cond, &rawbuf_mutex);
+        if (!rawbuf_full)
+            break;
+
+        pthread_mutex_unlock(&rawbuf_mutex);
+        if (fwrite(rawbuf_full, 1, rawbuf_full_len, rawbuf_fp) != rawbuf_full_len)
+            rawbuf_error = TRUE;
+        pthread_mutex_lock(&rawbuf_mutex);
+
+        rawbuf_full = NULL;
+        pthread_cond_broadcast(&rawbuf_cond);
+    }
+
+    pthread_mutex_unlock(&rawbuf_mutex);
+    return NULL;
+}
+
+#endif
+
+
+static void
+rawbufOpen(FILE *fp)
+{
+    /* a block still pending from an earlier plot goes to its own file */
+    if (rawbuf)
+        rawbufClose();
+
+    rawbuf_fp = fp;
+    rawbuf_len = 0;
+    rawbuf_error = FALSE;
+    rawbuf = TMALLOC(char, RAWBUF_SIZE);
+
+#ifdef RAWFILE_THREAD
+    /* the header is written directly, it must not overtake the data */
+    fflush(fp);
+    rawbuf_full = NULL;
+    rawbuf_quit = FALSE;
+    rawbuf_threaded = FALSE;
+    if (fp != stdout) {
+        rawbuf_spare = TMALLOC(char, RAWBUF_SIZE);
+        if (pthread_create(&rawbuf_thread, NULL, rawbufWriter, NULL) == 0)
+            rawbuf_threaded = TRUE;
+        else
+            tfree(rawbuf_spare);
+    }
+#endif
+}
+
+
+static void
+rawbufWrite(const void *data, size_t len)
+{
+    const char *p = (const char *) data;
+
+    while (len > 0) {
+        size_t n = RAWBUF_SIZE - rawbuf_len;
+        if (n > len)
+            n = len;
+        memcpy(rawbuf + rawbuf_len, p, n);
+        rawbuf_len += n;
+        p += n;
+        len -= n;
+        if (rawbuf_len == RAWBUF_SIZE)
+            rawbufFlush();
+    }
+}
+
+
+/* Pass the current block on to the file, or to the writer thread */
+
+static void
+rawbufFlush(void)
+{
+    if (rawbuf_len == 0)
+        return;
+
+#ifdef RAWFILE_THREAD
+    if (rawbuf_threaded) {
+        char *tmp;
+
+        pthread_mutex_lock(&rawbuf_mutex);
+        while (rawbuf_full)
+            pthread_cond_wait(&rawbuf_cond, &rawbuf_mutex);
+        rawbuf_full = rawbuf;
+        rawbuf_full_len = rawbuf_len;
+        pthread_cond_broadcast(&rawbuf_cond);
+        pthread_mutex_unlock(&rawbuf_mutex);
+
+        tmp = rawbuf;
+        rawbuf = rawbuf_spare;
+        rawbuf_spare = tmp;
+        rawbuf_len = 0;
+        return;
+    }
+#endif
+
+    if (fwrite(rawbuf, 1, rawbuf_len, rawbuf_fp) != rawbuf_len)
+        rawbuf_error = TRUE;
+    rawbuf_len = 0;
+}
+
+
+static void
+rawbufClose(void)
+{
+    if (!rawbuf)
+        return;
+
+    rawbufFlush();
+
+#ifdef RAWFILE_THREAD
+    if (rawbuf_threaded) {
+        pthread_mutex_lock(&rawbuf_mutex);
+        rawbuf_quit = TRUE;
+        pthread_cond_broadcast(&rawbuf_cond);
+        pthread_mutex_unlock(&rawbuf_mutex);
+        pthread_join(rawbuf_thread, NULL);
+        rawbuf_threaded = FALSE;
+    }
+    tfree(rawbuf_spare);
+#endif
+
+    tfree(rawbuf);
+    rawbuf_fp = NULL;
+}
+
+
+/* Write out all buffered rawfile data and stop the writer thread.  An
+ * analysis which is aborted or interrupted does not reach OUTendPlot(),
+ * so this has to be called before the rawfile is closed.
+ */
+
+void
+OUTrawClose(void)
+{
+    rawbufClose();
+}
+
+
 /* The plot maintenance routines. */
 
 static void
@@ -1052,17 +1299,41 @@ plotInit(runDesc *run)
 }
 
 
+/* Vectors of an in-memory plot grow geometrically, so that appending a
+ * timepoint is amortized O(1) instead of a realloc (and copy) of every
+ * vector for every point.  The slack is given back in plotEnd().
+ */
+
+#define PLOT_VEC_MINALLOC 64
+
+static void
+plotVecGrow(dataDesc *desc)
+{
+    struct dvec *v = desc->vec;
+
+    if (v->v_length < desc->vecAlloc)
+        return;
+
+    desc->vecAlloc = MAX(2 * desc->vecAlloc, PLOT_VEC_MINALLOC);
+
+    if (isreal(v))
+        v->v_realdata = TREALLOC(double, v->v_realdata, desc->vecAlloc);
+    else
+        v->v_compdata = TREALLOC(ngcomplex_t, v->v_compdata, desc->vecAlloc);
+}
+
+
 static void
 plotAddRealValue(dataDesc *desc, double value)
 {
     struct dvec *v = desc->vec;
 
+    plotVecGrow(desc);
+
     if (isreal(v)) {
-        v->v_realdata = TREALLOC(double, v->v_realdata, v->v_length + 1);
         v->v_realdata[v->v_length] = value;
     } else {
         /* a real parading as a VF_COMPLEX */
-        v->v_compdata = TREALLOC(ngcomplex_t, v->v_compdata, v->v_length + 1);
         v->v_compdata[v->v_length].cx_real = value;
         v->v_compdata[v->v_length].cx_imag = 0.0;
     }
@@ -1077,7 +1348,8 @@ plotAddComplexValue(dataDesc *desc, IFcomplex value)
 {
     struct dvec *v = desc->vec;
 
-    v->v_compdata = TREALLOC(ngcomplex_t, v->v_compdata, v->v_length + 1);
+    plotVecGrow(desc);
+
     v->v_compdata[v->v_length].cx_real = value.real;
     v->v_compdata[v->v_length].cx_imag = value.imag;
 
@@ -1086,10 +1358,31 @@ plotAddComplexValue(dataDesc *desc, IFcomplex value)
 }
 
 
-/* ARGSUSED */ /* until some code gets written */
 static void
 plotEnd(runDesc *run)
 {
+    int i;
+
+    /* shrink the vectors to their final length */
+    for (i = 0; i < run->numData; i++) {
+        dataDesc *desc = &run->data[i];
+        struct dvec *v = desc->vec;
+
+        if (!v || v->v_length >= desc->vecAlloc)
+            continue;
+
+        if (v->v_length == 0) {
+            tfree(v->v_realdata);
+            tfree(v->v_compdata);
+        } else if (isreal(v)) {
+            v->v_realdata = TREALLOC(double, v->v_realdata, v->v_length);
+        } else {
+            v->v_compdata = TREALLOC(ngcomplex_t, v->v_compdata, v->v_length);
+        }
+
+        desc->vecAlloc = v->v_length;
+    }
+
     fprintf(stderr, "\n");
     fprintf(stdout, "\nNo. of Data Rows : %d\n", run->pointCount);
 }
@@ -1439,7 +1732,7 @@ InterpFileAdd(runDesc *run, IFvalue *refValue, IFvalue *valuePtr)
     fileEndPoint(run->fp, run->binary);
 
     /*  Check that the write to disk completed successfully, otherwise abort  */
-    if (ferror(run->fp)) {
+    if (fileError(run->fp)) {
         fprintf(stderr, "Warning: rawfile write error !!\n");
         shouldstop = TRUE;
     }
@@ -22,6 +22,7 @@ typedef struct dataDesc {
     GENinstance *specFast;
     int refIndex;               /* The index of our ref vector. */
     struct dvec *vec;
+    int vecAlloc;               /* Allocated length of vec's data. */
 } dataDesc;
 
 
@@ -58,10 +59,12 @@ int OUTwReference(void *plotPtr, IFvalue *valuePtr, void **refPtr);
 int OUTwData(runDesc *plotPtr, int dataIndex, IFvalue *valuePtr, void *refPtr);
 int OUTwEnd(runDesc *plotPtr);
 int OUTendPlot(runDesc *plotPtr);
+bool OUTpHasSpecial(runDesc *plotPtr);
 int OUTbeginDomain(runDesc *plotPtr, IFuid refName, int refType, IFvalue *outerRefValue);
 int OUTendDomain(runDesc *plotPtr);
 int OUTattributes(runDesc *plotPtr, IFuid varName, int param, IFvalue *value);
 int OUTstopnow(void);
+void OUTrawClose(void);
 void OUTerror(int flags, char *format, IFuid *names);
 
 #ifdef __GNUC__
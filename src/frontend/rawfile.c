@@ -17,9 +17,30 @@ Author: 1986 Wayne A. Christopher, U. C. Berkeley CAD Group
 #include "rawfile.h"
 #include "variable.h"
 #include "../misc/misc_time.h"
+#include "../misc/mapfile.h"
+
+
+/* The data of a vector from a binary rawfile which has not been
+ * read yet: length values, the first at data, stride bytes apart.
+ * All of them are kept in a list, so a rawfile can be read in before
+ * it is written again.
+ */
+
+struct dvec_lazy {
+    struct mapfile *map;
+    const char *data;
+    size_t stride;
+    int length;
+    struct dvec *vec;
+    struct dvec_lazy *prev, *next;
+};
+
+static struct dvec_lazy *lazy_vecs = NULL;
 
 
 static void fixdims(struct dvec *v, char *s);
+static bool raw_lazy(struct plot *pl, FILE *fp, char *name,
+                     struct mapfile **map, int npoints, int flags);
 
 
 int raw_prec = -1;        /* How many sigfigs to use, default 15 (max).  */
@@ -57,6 +78,12 @@ raw_write(char *name, struct plot *pl, bool app, bool binary)
         return;
     }
 
+    for (v = pl->pl_dvecs; v; v = v->v_next)
+        raw_vec_load(v);
+
+    /* the file may still hold the data of another plot */
+    raw_vec_load_file(name);
+
     if (raw_prec != -1)
         prec = raw_prec;
     else
@@ -304,6 +331,7 @@ raw_read(char *name) {
     struct variable *vv;
     wordlist *wl, *nwl;
     FILE *fp, *lastin, *lastout, *lasterr;
+    struct mapfile *map = NULL;
 
 
     if ((fp = fopen(name, "rb")) == NULL) {
@@ -534,14 +562,6 @@ raw_read(char *name) {
                     for (j = 0; j < numdims; j++)
                         v->v_dims[j] = dims[j];
                 }
-                /* And allocate the data array. We would use
-                 * the desired vector length, but this would
-                 * be dangerous if the file is invalid.
-                 */
-                if (isreal(v))
-                    v->v_realdata = TMALLOC(double, npoints);
-                else
-                    v->v_compdata = TMALLOC(ngcomplex_t, npoints);
             }
 
         } else if (ciprefix("values:", buf) || ciprefix("binary:", buf)) {
@@ -582,6 +602,20 @@ raw_read(char *name) {
             else
                 is_ascii = FALSE;
 
+            /* Binary data is left in the file until it is used */
+            if (!is_ascii && raw_lazy(curpl, fp, name, &map, npoints, flags))
+                continue;
+
+            /* Allocate the data arrays.  We would use the desired
+             * vector length, but this would be dangerous if the file
+             * is invalid.
+             */
+            for (v = curpl->pl_dvecs; v; v = v->v_next)
+                if (isreal(v))
+                    v->v_realdata = TMALLOC(double, npoints);
+                else
+                    v->v_compdata = TMALLOC(ngcomplex_t, npoints);
+
             for (i = 0; i < npoints; i++) {
                 if (is_ascii) {
                     /* It's an ASCII file. */
@@ -670,10 +704,170 @@ raw_read(char *name) {
     cp_curout = lastout;
     cp_curerr = lasterr;
     (void) fclose(fp);
+    mapfile_close(map);
     return (plots);
 }
 
 
+/* Let the vectors of pl refer to their rows in a memory mapping of the
+ * rawfile instead of reading the binary data now.  A vector is read from
+ * the mapping by raw_vec_load() when it is first used, only the scale is
+ * read right away.  Returns FALSE if the file can't be mapped or the data
+ * isn't a plain npoints x vectors table, it then has to be read from fp.
+ */
+
+static bool
+raw_lazy(struct plot *pl, FILE *fp, char *name, struct mapfile **map,
+         int npoints, int flags)
+{
+    struct dvec *v;
+    size_t size = (flags & VF_REAL) ? sizeof(double) : 2 * sizeof(double);
+    size_t offset, column, rowsize = 0;
+    long pos;
+
+    if (npoints <= 0 || !pl->pl_dvecs)
+        return FALSE;
+
+    /* unpadded or truncated vectors */
+    for (v = pl->pl_dvecs; v; v = v->v_next) {
+        if (v->v_length != npoints)
+            return FALSE;
+        rowsize += size;
+    }
+
+    if ((pos = ftell(fp)) < 0)
+        return FALSE;
+
+    if (!*map && (*map = mapfile_open(name)) == NULL)
+        return FALSE;
+
+    /* a truncated file is reported by the stdio path */
+    offset = (size_t) pos;
+    if (offset > (*map)->size ||
+        (size_t) npoints > ((*map)->size - offset) / rowsize)
+        return FALSE;
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    if (_fseeki64(fp, (__int64) (offset + rowsize * (size_t) npoints), SEEK_SET))
+        return FALSE;
+#else
+    if (offset + rowsize * (size_t) npoints > (size_t) LONG_MAX ||
+        fseek(fp, (long) (offset + rowsize * (size_t) npoints), SEEK_SET))
+        return FALSE;
+#endif
+
+    for (v = pl->pl_dvecs, column = 0; v; v = v->v_next, column += size) {
+        struct dvec_lazy *lazy = TMALLOC(struct dvec_lazy, 1);
+        lazy->map = *map;
+        lazy->data = (*map)->data + offset + column;
+        lazy->stride = rowsize;
+        lazy->length = npoints;
+        lazy->vec = v;
+        lazy->prev = NULL;
+        lazy->next = lazy_vecs;
+        if (lazy_vecs)
+            lazy_vecs->prev = lazy;
+        lazy_vecs = lazy;
+        (*map)->refs++;
+        v->v_lazy = lazy;
+    }
+
+    if (pl->pl_scale)
+        raw_vec_load(pl->pl_scale);
+
+    return TRUE;
+}
+
+
+/* Read the data of a vector set up by raw_lazy() from the mapping.
+ * Pages of a file changed since it was loaded may be gone, reading
+ * them would raise SIGBUS, so the vector is zeroed instead.
+ */
+
+void
+raw_vec_load(struct dvec *v)
+{
+    struct dvec_lazy *lazy = v->v_lazy;
+    const char *p;
+    int i;
+
+    if (!lazy)
+        return;
+
+    if (mapfile_changed(lazy->map)) {
+        fprintf(cp_err,
+                "Error: rawfile changed since it was loaded, data of %s lost\n",
+                v->v_name);
+        if (isreal(v))
+            v->v_realdata = TMALLOC(double, lazy->length);
+        else
+            v->v_compdata = TMALLOC(ngcomplex_t, lazy->length);
+        raw_vec_free(v);
+        return;
+    }
+
+    p = lazy->data;
+    if (isreal(v)) {
+        v->v_realdata = TMALLOC(double, lazy->length);
+        for (i = 0; i < lazy->length; i++, p += lazy->stride)
+            memcpy(&v->v_realdata[i], p, sizeof(double));
+    } else {
+        v->v_compdata = TMALLOC(ngcomplex_t, lazy->length);
+        for (i = 0; i < lazy->length; i++, p += lazy->stride) {
+            memcpy(&realpart(v->v_compdata[i]), p, sizeof(double));
+            memcpy(&imagpart(v->v_compdata[i]), p + sizeof(double), sizeof(double));
+        }
+    }
+
+    raw_vec_free(v);
+}
+
+
+/* Read all vectors still left in the rawfile name, before it is
+ * written.
+ */
+
+void
+raw_vec_load_file(char *name)
+{
+    struct dvec_lazy *lazy, *next;
+    struct mapfile *map = NULL;
+    bool same = FALSE;
+
+    for (lazy = lazy_vecs; lazy; lazy = next) {
+        next = lazy->next;
+        if (lazy->map != map) {
+            map = lazy->map;
+            same = mapfile_is(map, name);
+        }
+        if (same)
+            raw_vec_load(lazy->vec);
+    }
+}
+
+
+/* Drop the reference of v to the mapped rawfile. */
+
+void
+raw_vec_free(struct dvec *v)
+{
+    struct dvec_lazy *lazy = v->v_lazy;
+
+    if (!lazy)
+        return;
+
+    if (lazy->prev)
+        lazy->prev->next = lazy->next;
+    else
+        lazy_vecs = lazy->next;
+    if (lazy->next)
+        lazy->next->prev = lazy->prev;
+
+    mapfile_close(lazy->map);
+    tfree(v->v_lazy);
+}
+
+
 /* s is a string of the form d1,d2,d3... */
 
 static void
@@ -720,6 +914,12 @@ spar_write(char *name, struct plot *pl, double Rbaseval)
         return;
     }
 
+    for (v = pl->pl_dvecs; v; v = v->v_next)
+        raw_vec_load(v);
+
+    /* the file may still hold the data of another plot */
+    raw_vec_load_file(name);
+
     if (raw_prec != -1)
         prec = raw_prec;
     else
@@ -20,6 +20,7 @@ Modified: 2000 AlansFixes
 #include "runcoms.h"
 #include "variable.h"
 #include "spiceif.h"
+#include "outitf.h"
 #include "runcoms2.h"
 
 #ifdef XSPICE
@@ -256,6 +257,9 @@ dosim(
     ft_intrpt = FALSE;
     /* command "run" is given with rawfile name in wl */
     if (dofile) {
+        /* a loaded plot may still have its data in that file */
+        if (*wl->wl_word)
+            raw_vec_load_file(wl->wl_word);
         if (!*wl->wl_word)
             rawfileFp = stdout;
 #if defined(__MINGW32__) || defined(_MSC_VER)
@@ -338,6 +342,7 @@ dosim(
     }
     /* close the rawfile */
     if (rawfileFp) {
+        OUTrawClose();
         if (ftell(rawfileFp) == 0) {
             (void) fclose(rawfileFp);
             (void) unlink(wl->wl_word);
@@ -102,6 +102,9 @@ com_resume(wordlist *wl)
     }
 
     if (dofile) {
+        /* a loaded plot may still have its data in that file */
+        if (last_used_rawfile)
+            raw_vec_load_file(last_used_rawfile);
         if (!last_used_rawfile)
             rawfileFp = stdout;
 #if defined(__MINGW32__) || defined(_MSC_VER)
@@ -142,6 +145,7 @@ com_resume(wordlist *wl)
 
     /*close rawfile saj*/
     if (rawfileFp) {
+        OUTrawClose();
         if (ftell(rawfileFp) == 0) {
             (void) fclose(rawfileFp);
             (void) unlink(last_used_rawfile);
@@ -58,6 +58,7 @@ CDHW*/
 #include "circuits.h"
 #include "spiceif.h"
 #include "variable.h"
+#include "../misc/misc_time.h" /* seconds */
 
 
 #ifdef XSPICE
@@ -98,6 +99,7 @@ if_inpdeck(struct line *deck, INPtables **tab)
     IFuid taskUid;
     IFuid optUid;
     int which = -1;
+    double startTime;
 
     for (i = 0, ll = deck; ll; ll = ll->li_next)
         i++;
@@ -158,18 +160,24 @@ if_inpdeck(struct line *deck, INPtables **tab)
 
     /* reset the model table, will be filled in anew in INPpas1() */
     modtab = NULL;
+    startTime = seconds();
     INPpas1(ckt, (card *) deck->li_next, *tab);
+    ckt->CKTstat->STATpass1Time = seconds() - startTime;
     /* store the new model table in the current circuit */
     ft_curckt->ci_modtab = modtab;
+    startTime = seconds();
     INPpas2(ckt, (card *) deck->li_next, *tab, ft_curckt->ci_defTask);
+    ckt->CKTstat->STATpass2Time = seconds() - startTime;
 
     /* INPpas2 has been modified to ignore .NODESET and .IC
      * cards. These are left till INPpas3 so that we can check for
      * nodeset/ic of non-existant nodes.  */
 
+    startTime = seconds();
     INPpas3(ckt, (card *) deck->li_next,
             *tab, ft_curckt->ci_defTask, ft_sim->nodeParms,
             ft_sim->numNodeParms);
+    ckt->CKTstat->STATpass3Time = seconds() - startTime;
 
 #ifdef XSPICE
     /* gtri - begin - wbk - 6/6/91 - Finish initialization of event driven structures */
@@ -1529,7 +1537,12 @@ void com_snload(wordlist *wl)
 //    _foo(ckt->CKTtimePoints, double, -1);
 //    _foo(ckt->CKTdeltaList, double, -1);
 
+    /* CKTbreaks may point into CKTbreakBuf, read into a block of its own */
+    FREE(ckt->CKTbreakBuf);
+    ckt->CKTbreaks = NULL;
     _foo(ckt->CKTbreaks, double, ckt->CKTbreakSize);
+    ckt->CKTbreakBuf = ckt->CKTbreaks;
+    ckt->CKTbreakBufSize = ckt->CKTbreakSize;
 
     {   /* avoid invalid lvalue assignment errors in the macro _foo() */
         TSKtask *lname = NULL;
@@ -59,6 +59,7 @@ Modified: 2000 AlansFixes
 #include "ngspice/cpdefs.h"
 #include "ngspice/ftedefs.h"
 #include "ngspice/fteinp.h"
+#include "ngspice/hash.h"
 
 #include <stdarg.h>
 
@@ -86,16 +87,17 @@ extern void line_free_x(struct line * deck, bool recurse);
 struct subs;
 static struct line *doit(struct line *deck, wordlist *modnames);
 static int translate(struct line *deck, char *formal, char *actual, char *scname,
-                     const char *subname, struct subs *subs, wordlist const *modnames);
+                     const char *subname, NGHASHPTR subtab);
 struct bxx_buffer;
 static void finishLine(struct bxx_buffer *dst, char *src, char *scname);
 static int settrans(char *formal, char *actual, const char *subname);
 static char *gettrans(const char *name, const char *name_end);
-static int numnodes(char *name, struct subs *subs, wordlist const *modnames);
+static int numnodes(char *name, NGHASHPTR subtab);
 static int  numdevs(char *s);
 static wordlist *modtranslate(struct line *deck, char *subname, wordlist *new_modnames);
 static void devmodtranslate(struct line *deck, char *subname, wordlist * const orig_modnames);
 static int inp_numnodes(char c);
+static void modnames_enter(const char *name, int incr);
 
 /*---------------------------------------------------------------------
  * table is used in settrans and gettrans -- it holds the netnames used
@@ -134,6 +136,13 @@ static char start[32], sbend[32], invoke[32], model[32];
 static char *global_nodes[128];
 static int num_global_nodes;
 
+/* modnames_tab counts the names held in the modnames list, modnames_bin
+ * counts the base names of the binned ones among them (e.g. "nch" for
+ * "nch.12"), so numnodes() can look up a model without scanning the list,
+ * which grows with every subcircuit instance holding a .model card.
+ */
+static NGHASHPTR modnames_tab, modnames_bin;
+
 
 static void
 collect_global_nodes(struct line *c)
@@ -259,6 +268,8 @@ inp_subcktexpand(struct line *deck) {
     /* Get all the model names so we can deal with BJTs, etc.
      *  Stick all the model names into the doubly-linked wordlist modnames.
      */
+    modnames_tab = nghash_init(NGHASH_MIN_SIZE);
+    modnames_bin = nghash_init(NGHASH_MIN_SIZE);
     {
         int nest = 0;
         for (c = deck; c; c = c->li_next) {
@@ -274,6 +285,7 @@ inp_subcktexpand(struct line *deck) {
                 char *s = c->li_line;
                 txfree(gettok(&s)); /* discard the model keyword */
                 modnames = wl_cons(gettok(&s), modnames);
+                modnames_enter(modnames->wl_word, 1);
             } /* model name finding routine */
         }
     }
@@ -353,6 +365,9 @@ inp_subcktexpand(struct line *deck) {
 
     free_global_nodes();
     wl_free(modnames);
+    nghash_free(modnames_tab, NULL, NULL);
+    nghash_free(modnames_bin, NULL, NULL);
+    modnames_tab = modnames_bin = NULL;
 
     /* Count numbers of line in deck after expansion */
     if (deck) {
@@ -439,6 +454,7 @@ doit(struct line *deck, wordlist *modnames) {
 
     /* Save all the old stuff... */
     struct subs *subs = NULL;
+    NGHASHPTR subtab;
     wordlist *xmodnames = modnames;
 
 #ifdef TRACE
@@ -543,10 +559,20 @@ doit(struct line *deck, wordlist *modnames) {
     if (!subs)            /* we have found no subckts.  Just return.  */
         return (deck);
 
+    /* Index the definitions by name.  A later definition of the same name
+     * is found first in `subs', and shadows the earlier ones.
+     */
+    subtab = nghash_init(NGHASH_MIN_SIZE);
+    for (sss = subs; sss; sss = sss->su_next)
+        if (!nghash_find(subtab, sss->su_name))
+            nghash_insert(subtab, sss->su_name, sss);
+
     /* Otherwise, expand sub-subcircuits recursively. */
     for (sss = subs; sss; sss = sss->su_next)  /* iterate through the list of subcircuits */
-        if ((sss->su_def = doit(sss->su_def, modnames)) == NULL)
+        if ((sss->su_def = doit(sss->su_def, modnames)) == NULL) {
+            nghash_free(subtab, NULL, NULL);
             return (NULL);
+        }
 
 #ifdef TRACE
     /* SDB debug statement */
@@ -593,10 +619,8 @@ doit(struct line *deck, wordlist *modnames) {
                     s--;
                 s++;
 
-                /* iterate through .subckt list and look for .subckt name invoked */
-                for (sss = subs; sss; sss = sss->su_next)
-                    if (eq(sss->su_name, s))
-                        break;
+                /* look up the .subckt name invoked */
+                sss = (struct subs *) nghash_find(subtab, s);
 
 
                 /* At this point, sss points to the .subckt invoked,
@@ -626,7 +650,7 @@ doit(struct line *deck, wordlist *modnames) {
                     /* now invoke translate, which handles the remainder of the
                      * translation.
                      */
-                    if (!translate(su_deck, sss->su_args, t, scname, sss->su_name, subs, modnames))
+                    if (!translate(su_deck, sss->su_args, t, scname, sss->su_name, subtab))
                         error = 1;
 
                     /* Now splice the decks together. */
@@ -677,7 +701,13 @@ doit(struct line *deck, wordlist *modnames) {
     }
 #endif
 
+    {
+        wordlist *w;
+        for (w = modnames; w != xmodnames; w = w->wl_next)
+            modnames_enter(w->wl_word, -1);
+    }
     wl_delete_slice(modnames, xmodnames);
+    nghash_free(subtab, NULL, NULL);
 
     if (error)
         return NULL;    /* error message already reported; should free() */
@@ -882,7 +912,7 @@ bxx_buffer(struct bxx_buffer *t)
  * subname = copy of the subcircuit name
  *-------------------------------------------------------------------------------------------*/
 static int
-translate(struct line *deck, char *formal, char *actual, char *scname, const char *subname, struct subs *subs, wordlist const *modnames)
+translate(struct line *deck, char *formal, char *actual, char *scname, const char *subname, NGHASHPTR subtab)
 {
     struct line *c;
     struct bxx_buffer buffer;
@@ -1069,7 +1099,7 @@ translate(struct line *deck, char *formal, char *actual, char *scname, const cha
             tfree(t);
 
             /* Next iterate over all nodes (netnames) found and translate them. */
-            nnodes = numnodes(c->li_line, subs, modnames);
+            nnodes = numnodes(c->li_line, subtab);
 
             while (nnodes-- > 0) {
                 name = gettok_node(&s);
@@ -1213,7 +1243,7 @@ translate(struct line *deck, char *formal, char *actual, char *scname, const cha
             tfree(nametofree);
 
             /* Next iterate over all nodes (netnames) found and translate them. */
-            nnodes = numnodes(c->li_line, subs, modnames);
+            nnodes = numnodes(c->li_line, subtab);
             while (nnodes-- > 0) {
                 name = gettok_node(&s);
                 if (name == NULL) {
@@ -1460,7 +1490,7 @@ gettrans(const char *name, const char *name_end)
 /*-------------------------------------------------------------------*/
 /*-------------------------------------------------------------------*/
 static int
-numnodes(char *name, struct subs *subs, wordlist const *modnames)
+numnodes(char *name, NGHASHPTR subtab)
 {
     /* gtri - comment - wbk - 10/23/90 - Do not modify this routine for */
     /* 'A' type devices since the callers will not know how to find the */
@@ -1470,7 +1500,6 @@ numnodes(char *name, struct subs *subs, wordlist const *modnames)
     char c;
     struct subs *sss;
     char *s, *t, buf[4 * BSIZE_SP];
-    const wordlist *wl;
     int n, i, gotit;
 
     while (*name && isspace(*name))
@@ -1491,9 +1520,9 @@ numnodes(char *name, struct subs *subs, wordlist const *modnames)
         while ((*s != ' ') && (*s != '\t'))
             s--;
         s++;
-        for (sss = subs; sss; sss = sss->su_next)
-            if (eq(sss->su_name, s))
-                return (sss->su_numargs);
+        sss = (struct subs *) nghash_find(subtab, s);
+        if (sss)
+            return (sss->su_numargs);
         /*
          * number of nodes not known so far.
          * lets count the nodes ourselves,
@@ -1530,11 +1559,8 @@ numnodes(char *name, struct subs *subs, wordlist const *modnames)
         txfree(gettok(&s));          /* Skip component name */
         while ((i < n) && (*s) && !gotit) {
             t = gettok_node(&s);       /* get nodenames . . .  */
-            for (wl = modnames; wl; wl = wl->wl_next)
-                if (model_name_match(t, wl->wl_word)) {
-                    gotit = 1;
-                    break;
-                }
+            if (nghash_find(modnames_tab, t) || nghash_find(modnames_bin, t))
+                gotit = 1;
             i++;
             tfree(t);
         } /* while . . . . */
@@ -1565,9 +1591,9 @@ numnodes(char *name, struct subs *subs, wordlist const *modnames)
 
     /* Now, is this a model? */
     t = gettok(&s);
-    wl = wl_find(t, modnames);
+    gotit = (nghash_find(modnames_tab, t) != NULL);
     tfree(t);
-    return wl ? 3 : 4;
+    return gotit ? 3 : 4;
 }
 
 
@@ -1643,6 +1669,7 @@ modtranslate(struct line *c, char *subname, wordlist *new_modnames)
             /* remember the translation */
             orig_modnames = wl_cons(model_name, orig_modnames);
             new_modnames = wl_cons(new_model_name, new_modnames);
+            modnames_enter(new_model_name, 1);
 
             /* perform the actual translation of this .model line */
             t = tprintf(".model %s %s", new_model_name, t);
@@ -2112,3 +2139,40 @@ inp_numnodes(char c)
         return (2);
     }
 }
+
+
+/* the hash data is the number of occurrences of the name */
+static void
+modnames_count(NGHASHPTR tab, char *name, int incr)
+{
+    intptr_t n = (intptr_t) nghash_delete(tab, name) + incr;
+
+    if (n > 0)
+        nghash_insert(tab, name, (void *) n);
+}
+
+
+/*-------------------------------------------------------------------*
+ *  modnames_enter adds (incr = 1) or removes (incr = -1) one
+ *  occurrence of a model name to or from modnames_tab, and of its
+ *  base name to or from modnames_bin if it is a binned model name.
+ *-------------------------------------------------------------------*/
+static void
+modnames_enter(const char *name, int incr)
+{
+    const char *dot = strrchr(name, '.');
+
+    modnames_count(modnames_tab, (char *) name, incr);
+
+    if (dot && dot[1]) {
+        const char *p;
+        for (p = dot + 1; *p; p++)
+            if (!isdigit(*p))
+                return;
+        {
+            char *base = copy_substring(name, dot);
+            modnames_count(modnames_bin, base, incr);
+            tfree(base);
+        }
+    }
+}
@@ -367,7 +367,7 @@ vec_remove(char *name)
 struct dvec *
 vec_fromplot(char *word, struct plot *plot)
 {
-    struct dvec *d;
+    struct dvec *d, *v;
     char buf[BSIZE_SP], buf2[BSIZE_SP], cc, *s;
 
     d = findvec(word, plot);
@@ -395,6 +395,13 @@ vec_fromplot(char *word, struct plot *plot)
         d = findvec(buf, plot);
     }
 
+    /* Vectors of a loaded binary rawfile are read when used first. */
+    for (v = d; v; v = v->v_link2) {
+        raw_vec_load(v);
+        if (v->v_scale)
+            raw_vec_load(v->v_scale);
+    }
+
     return (d);
 }
 
@@ -687,6 +694,8 @@ vec_copy(struct dvec *v)
     if (!v)
         return (NULL);
 
+    raw_vec_load(v);
+
     nv = alloc(struct dvec);
     nv->v_name = copy(v->v_name);
     nv->v_type = v->v_type;
@@ -865,9 +874,10 @@ vec_free_x(struct dvec *v)
                         v->v_name);
         }
         if (pl->pl_scale == v) {
-            if (pl->pl_dvecs)
+            if (pl->pl_dvecs) {
                 pl->pl_scale = pl->pl_dvecs;    /* Random one... */
-            else
+                raw_vec_load(pl->pl_scale);
+            } else
                 pl->pl_scale = NULL;
         }
     }
@@ -878,6 +888,7 @@ vec_free_x(struct dvec *v)
         tfree(v->v_realdata);
     if (v->v_compdata)
         tfree(v->v_compdata);
+    raw_vec_free(v);
 
     tfree(v);
 }
@@ -198,6 +198,8 @@ struct CKTcircuit {
     double CKTsaveDelta;        /* ??? */
     double CKTminBreak;         /* ??? */
     double *CKTbreaks;          /* List of breakpoints ??? */
+    double *CKTbreakBuf;        /* storage holding CKTbreaks[] */
+    int CKTbreakBufSize;        /* allocated size of CKTbreakBuf */
     double CKTabstol;           /* --- */
     double CKTpivotAbsTol;      /* --- */
     double CKTpivotRelTol;      /* --- */
@@ -285,6 +287,8 @@ struct CKTcircuit {
                                    contains only linear elements */
     unsigned int CKTnoopac:1; /* flag to indicate that OP will not be evaluated
                                  during AC simulation */
+    unsigned int CKTcscSolver:1; /* flag to indicate that the real matrix is
+                                    refactored in compressed column form */
     int CKTsoaCheck;    /* flag to indicate that in certain device models
                            a safe operating area (SOA) check is executed */
     int CKTsoaMaxWarns; /* specifies the maximum number of SOA warnings */
@@ -293,6 +297,14 @@ struct CKTcircuit {
     NGHASHPTR MODnameHash;
 
     GENinstance *noise_input;   /* identify the input vsrc/isrc during noise analysis */
+
+    CKTstamp *CKTstampScratch;  /* stamp buffer for the serial two-phase load */
+#ifdef USE_OMP
+    int CKTstampCount;          /* instances evaluated in the parallel load phase */
+    GENinstance **CKTstampInst; /* these instances, grouped by device type */
+    CKTstamp *CKTstamps;        /* and their stamp buffers */
+    int *CKTstampFirst;         /* first entry of each device type in CKTstampInst */
+#endif
 };
 
 
@@ -311,6 +323,7 @@ extern int CKTaskNodQst(CKTcircuit *, CKTnode *, int , IFvalue *, IFvalue *);
 extern int CKTbindNode(CKTcircuit *, GENinstance *, int , CKTnode *);
 extern void CKTbreakDump(CKTcircuit *);
 extern int CKTclrBreak(CKTcircuit *);
+extern int CKTinitBreak(CKTcircuit *);
 extern int CKTconvTest(CKTcircuit *);
 extern int CKTcrtElt(CKTcircuit *, GENmodel *, GENinstance **, IFuid);
 extern int CKTdelTask(CKTcircuit *, TSKtask *);
@@ -429,6 +442,7 @@ extern int NIconvTest(CKTcircuit *);
 extern void NIdestroy(CKTcircuit *);
 extern int NIinit(CKTcircuit  *);
 extern int NIintegrate(CKTcircuit *, double *, double *, double , int);
+extern int NIintegrateVec(CKTcircuit *, int, double *, double *, double *, int *);
 extern int NIiter(CKTcircuit * , int);
 extern int NIpzMuller(PZtrial **, PZtrial *);
 extern int NIpzComplex(PZtrial **, PZtrial *);
@@ -0,0 +1,39 @@
+/*
+ * Instances of a linear device model in plain arrays
+ */
+
+#ifndef ngspice_CKTLINEAR_H
+#define ngspice_CKTLINEAR_H
+
+#include "ngspice/typedefs.h"
+
+
+/*
+ * The load of resistors, capacitors, inductors and linear controlled
+ * sources does not walk the instance list.  Each model keeps a copy of
+ * what the load needs of its instances in the arrays below, in list
+ * order, and the load runs over these.  The copy is dropped by setup,
+ * temperature update, parameter changes and instance deletion, and is
+ * made anew by the next load.
+ */
+
+struct CKTlinear {
+    int count;              /* number of instances */
+    int nelt;               /* matrix elements per instance */
+    double **elt;           /* these elements, instance by instance */
+    double *val;            /* value loaded by each instance */
+    double *par;            /* device specific parameter of each instance */
+    double *init;           /* initial condition of each instance */
+    int *posNode;           /* nodes or branch equation of each instance */
+    int *negNode;
+    int *state;             /* first state vector entry of each instance */
+    double *geq;            /* results of the integration */
+    double *ceq;
+};
+
+
+extern CKTlinear *CKTlinearNew(int count, int nelt);
+extern void CKTlinearFree(CKTlinear **);
+extern void CKTlinearStamp(CKTlinear *);
+
+#endif
@@ -0,0 +1,53 @@
+/*
+ * Two-phase device load: per instance stamp buffers
+ */
+
+#ifndef ngspice_CKTSTAMP_H
+#define ngspice_CKTSTAMP_H
+
+#include "ngspice/typedefs.h"
+
+
+/*
+ * A device which provides DEVloadInst evaluates one instance at a time
+ * into a CKTstamp instead of adding directly into the matrix and the rhs.
+ * The contributions are recorded in the order the load code produces
+ * them, so scattering them afterwards gives bit-identical sums, no matter
+ * whether the evaluation happened serially or in parallel.
+ */
+
+struct CKTstamp {
+    int nmat;               /* matrix contributions recorded */
+    int nrhs;               /* rhs contributions recorded */
+    double **matPtr;        /* target matrix elements */
+    double *matVal;         /* values to be added to them */
+    int *rhsNode;           /* target rhs rows */
+    double *rhsVal;         /* values to be added to them */
+    int noncon;             /* instance did not converge */
+    int error;              /* error code returned by DEVloadInst */
+};
+
+
+#define CKTstampMat(st, ptr, val)               \
+    do {                                        \
+        (st)->matPtr[(st)->nmat] = (ptr);       \
+        (st)->matVal[(st)->nmat++] = (val);     \
+    } while(0)
+
+#define CKTstampRhs(st, node, val)              \
+    do {                                        \
+        (st)->rhsNode[(st)->nrhs] = (node);     \
+        (st)->rhsVal[(st)->nrhs++] = (val);     \
+    } while(0)
+
+
+extern int  CKTstampSetup(CKTcircuit *);
+extern void CKTstampDestroy(CKTcircuit *);
+extern int  CKTstampLoad(GENmodel *, CKTcircuit *);
+extern void CKTstampScatter(CKTcircuit *, GENinstance *, CKTstamp *);
+#ifdef USE_OMP
+extern void CKTstampEval(CKTcircuit *);
+extern int  CKTstampLoadDev(CKTcircuit *, int);
+#endif
+
+#endif
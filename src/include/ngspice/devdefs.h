@@ -12,6 +12,7 @@ Author: 1985 Thomas L. Quarles
 #include "ngspice/cktdefs.h"
 #include "ngspice/noisedef.h"
 #include "ngspice/complex.h"
+#include "ngspice/cktstamp.h"
 
 double DEVlimvds(double,double);
 double DEVpnjlim(double,double,double,double,int*);
@@ -21,6 +22,8 @@ void DEVcmeyer(double,double,double,double,double,double,double,double,double,
 void DEVqmeyer(double,double,double,double,double,double*,double*,double*,
         double,double);
 double DEVpred(CKTcircuit*,int);
+int DEVpwlFind(double*,int,int,double,double,int,int,int*,int*);
+int DEVpwlFile(char*,int,double**,int*);
 
 /* Cider integration */
 double limitResistorVoltage( double, double, int * );
@@ -114,6 +117,11 @@ typedef struct SPICEdev {
     int *DEVinstSize;    /* size of an instance */
     int *DEVmodSize;     /* size of a model */
 
+    int (*DEVloadInst)(GENinstance*,CKTcircuit*,CKTstamp*);
+        /* two-phase load: evaluate a single instance into a stamp buffer */
+    int DEVstampMat;     /* max. number of matrix stamps of an instance */
+    int DEVstampRhs;     /* max. number of rhs stamps of an instance */
+
 } SPICEdev;  /* instance of structure for each possible type of device */
 
 
@@ -57,6 +57,7 @@ struct dvec {
     struct dvec *v_next;	/* Link for list of plot vectors. */
     struct dvec *v_link2;	/* Extra link for things like print. */
     struct dvec *v_scale;	/* If this has a non-standard scale... */
+    struct dvec_lazy *v_lazy;	/* Data still in a mapped rawfile. */
 } ;
 
 #define isreal(v)   ((v)->v_flags & VF_REAL)
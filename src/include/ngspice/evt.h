@@ -135,8 +135,10 @@ typedef struct {
     int               *modified_index; /* Indexes of modified instances */
     Mif_Boolean_t     *modified;       /* Flags used to prevent multiple entries */
     int               num_pending;     /* Count of number of pending events in lists */
-    int               *pending_index;  /* Indexes of pending events */
+    int               *pending_index;  /* Indexes of pending events, heap ordered */
     Mif_Boolean_t     *pending;        /* Flags used to prevent multiple entries */
+    int               *pending_pos;    /* Position of each index in pending_index */
+    double            *pending_time;   /* Time of the event at 'current' */
     int               num_to_call;     /* Count of number of instances that need to be called */
     int               *to_call_index;  /* Indexes of instances to be called */
     Mif_Boolean_t     *to_call;        /* Flags used to prevent multiple entries */
@@ -177,8 +179,10 @@ typedef struct {
     int                 *modified_index; /* Indexes of modified outputs */
     Mif_Boolean_t       *modified;       /* Flags used to prevent multiple entries */
     int                 num_pending;     /* Count of number of pending events in lists */
-    int                 *pending_index;  /* Indexes of pending events */
+    int                 *pending_index;  /* Indexes of pending events, heap ordered */
     Mif_Boolean_t       *pending;        /* Flags used to prevent multiple entries */
+    int                 *pending_pos;    /* Position of each index in pending_index */
+    double              *pending_time;   /* Time of the event at 'current' */
     int                 num_changed;     /* Count of number of outputs that changed */
     int                 *changed_index;  /* Indexes of outputs that changed */
     Mif_Boolean_t       *changed;        /* Flags used to prevent multiple entries */
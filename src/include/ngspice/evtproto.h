@@ -86,6 +86,12 @@ void EVTqueue_inst(
     double     posted_time,
     double     event_time);
 
+void EVTqueue_heap_insert(int *heap, int *pos, double *time, int *num, int index);
+
+void EVTqueue_heap_update(int *heap, int *pos, double *time, int num, int index);
+
+void EVTqueue_heap_remove(int *heap, int *pos, double *time, int *num, int index);
+
 void EVTdequeue(CKTcircuit *ckt, double time);
 
 int EVTload(CKTcircuit *ckt, int inst_index);
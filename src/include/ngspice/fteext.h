@@ -271,6 +271,9 @@ extern int raw_prec;
 extern void raw_write(char *name, struct plot *pl, bool app, bool binary);
 extern void spar_write(char *name, struct plot *pl, double val);
 extern struct plot *raw_read(char *name);
+extern void raw_vec_load(struct dvec *v);
+extern void raw_vec_load_file(char *name);
+extern void raw_vec_free(struct dvec *v);
 
 /* meas.c */
 extern bool do_measure(char *what, bool chk_only);
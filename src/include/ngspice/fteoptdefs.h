@@ -14,6 +14,7 @@ typedef struct sFTESTATistics {
     int FTESTATdeckNumLines;    /* number of lines in spice deck */
 
     double FTESTATnetLoadTime;  /* total time required to load the spice deck */
+    double FTESTATnetExpandTime; /* total time required to expand subcircuits */
     double FTESTATnetParseTime; /* total time required to parse the netlist */
 } FTESTATistics;
 
@@ -21,5 +22,6 @@ typedef struct sFTESTATistics {
 #define FTEOPT_NLDECK 1
 #define FTEOPT_NLT    2
 #define FTEOPT_NPT    3
+#define FTEOPT_NXT    4
 
 #endif
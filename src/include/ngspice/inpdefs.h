@@ -79,6 +79,16 @@ struct INPmodel{
     GENmodel *INPmodfast;   /* high speed pointer to model for access */
 };
 
+/* the binned models 'name.<digits>' sharing the base name 'name',
+   in model table order, see INPlookModBins() */
+typedef struct INPmodBins {
+    int INPnumMods;         /* number of models */
+    int INPmodsSize;        /* allocated size of INPmods */
+    INPmodel **INPmods;     /* the models */
+    int INPnumRanges;       /* L/W ranges set up by INPgetModBin(), -1 if not yet */
+    struct INPmodRange *INPranges;
+} INPmodBins;
+
 
 
 /* listing types - used for debug listings */
@@ -112,6 +122,9 @@ int INPinsert(char **, INPtables *);
 int INPretrieve(char **, INPtables *);
 int INPremove(char *, INPtables *);
 INPmodel *INPlookMod(const char *);
+INPmodBins *INPlookModBins(const char *);
+void INPappendMod(INPmodel *);
+void INPkillModIndex(void);
 int INPmakeMod(char *, int, card *);
 char *INPmkTemp(char *);
 void INPpas1(CKTcircuit *, card *, INPtables *);
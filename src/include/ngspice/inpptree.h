@@ -31,6 +31,7 @@ typedef struct INPparseTree {
     IFparseTree p;
     struct INPparseNode *tree;  /* The real stuff. */
     struct INPparseNode **derivs;   /* The derivative parse trees. */
+    struct PTcode *code;        /* All of them compiled, or NULL. */
 } INPparseTree;
 
 /* This is what is passed as the actual parameter value.  The fields will all
@@ -170,5 +171,13 @@ typedef struct PTelement {
 
 extern int IFeval(IFparseTree *tree, double gmin, double *result, double *vals, double *derivs);
 
+/* And in ptcompile.c */
+
+typedef struct PTcode PTcode;
+
+extern PTcode *PTcompile(INPparseTree *pt);
+extern void PTfreeCode(PTcode *code);
+extern int PTevalCode(PTcode *code, double gmin, double *result, double *vals, double *derivs);
+
 #endif
 
@@ -348,6 +348,30 @@ typedef struct Mif_Inst_Var_Data_s {
 
 
 
+/* ************************************************************************* */
+
+
+
+/*
+ * Reasons a code model callback is invoked for.
+ */
+
+typedef enum {
+    MIF_CB_DESTROY          /* The instance is about to be deleted           */
+} Mif_Callback_Reason_t;
+
+
+/*
+ * Callback registered by a code model through the CALLBACK macro,
+ * used to release resources its static variables refer to.
+ */
+
+struct Mif_Private_s;
+
+typedef void (*Mif_Callback_t)(struct Mif_Private_s *, Mif_Callback_Reason_t);
+
+
+
 /* ************************************************************************* */
 
 
@@ -366,6 +390,7 @@ typedef struct Mif_Private_s {
     Mif_Param_Data_t       **param;       /* Information about each parameter     */
     int                    num_inst_var;  /* Number of instance variables         */
     Mif_Inst_Var_Data_t    **inst_var;    /* Information about each inst variable */
+    Mif_Callback_t         *callback;     /* Callback of this instance            */
 
 } Mif_Private_t;
 
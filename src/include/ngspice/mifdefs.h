@@ -80,6 +80,8 @@ typedef struct sMIFinstance {
 
     int                 inst_index;       /* Index into inst_table in evt struct in ckt */
 
+    Mif_Callback_t      callback;         /* Callback registered by the code model */
+
 } MIFinstance ;
 
 
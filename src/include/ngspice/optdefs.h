@@ -45,6 +45,10 @@ typedef struct {
     double STATacSolveTime;     /* time spent in AC F-B subst. */
     double STATacLoadTime;      /* time spent in AC device loading */
     double STATacSyncTime;      /* time spent in transient sync'ing */
+    double STATbreakTime;       /* time spent maintaining the breakpoint table */
+    double STATpass1Time;       /* input pass 1 time (models, options) */
+    double STATpass2Time;       /* input pass 2 time (instances, analyses) */
+    double STATpass3Time;       /* input pass 3 time (nodesets, ics) */
     STATdevList *STATdevNum;    /* PN: Number of instances and models for each device */
 } STATistics;
 
@@ -119,6 +123,11 @@ typedef struct {
 #define OPT_RELDV        67  /* Original: 52 (Node_Damping) */
 
 #define OPT_NOOPAC       68
+#define OPT_BREAKTIME    69
+#define OPT_CSCSOLVER    70
+#define OPT_PASS1TIME    71
+#define OPT_PASS2TIME    72
+#define OPT_PASS3TIME    73
 
 #ifdef XSPICE
 /* gtri - begin - wbk - add new options */
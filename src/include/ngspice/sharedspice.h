@@ -65,6 +65,49 @@ char** ngSpice_AllVecs(char*);
 returns to the caller a pointer to an array of vector names in the plot
 named by the string in the argument.
 
+**
+ngSpice_Init_Stream(SendDataBlock*, char**, int, int)
+Opt-in streaming of simulation output in blocks of points, instead of
+(or in addition to) the SendData callback per accepted point. The caller
+selects the vectors by name (NULL for all vectors of each plot) and the
+number of points per block. SendDataBlock is called whenever a block is
+full, and with the remaining points and 'final' set at the end of each
+plot. The data of each vector are contiguous arrays of 'count' values.
+With nbufs == 0 they point straight into the vectors of the plot, no
+data are copied, but the pointers are valid only during the callback.
+With nbufs > 0 the data are copied to a ring of nbufs blocks, and each
+block remains valid until the caller has released it by calling
+ngSpice_Stream_Ack(), blocks being released in the order received. The
+simulation waits for a free block if all of them are held by the caller,
+so the caller may process the data in another thread. Call only while
+no simulation is running, sending NULL stops the streaming.
+
+**
+ngSpice_nInit(SendChar*, SendStat*, ControlledExit*,
+              SendData*, SendInitData*, BGThreadRunning*, void*)
+ngspice.dll keeps its circuits, plots and variables in static data, so a
+single loaded image may run only one simulation at a time. ngSpice_nInit()
+creates a new, independent ngspice instance and returns a handle to it.
+Each instance is backed by a private copy of ngspice.dll, loaded with
+local symbol scope, and thus has its own circuits, plots, variables,
+callbacks and background thread. Different instances may be driven
+concurrently from different threads of the caller. Each instance gets
+its own identification number (see ngSpice_nIdent()), which is handed to
+the callbacks in the same way as the number given to ngSpice_Init_Sync().
+The functions ngSpice_nCommand(), ngSpice_nCirc() etc. are the instance
+versions of the functions above. ngSpice_nDestroy() stops a running
+background thread of the instance, frees its circuits, plots and
+variables and unloads its copy of ngspice.dll. If the thread cannot be
+stopped, the copy is not unloaded and ngSpice_nDestroy() returns 1.
+The copy is created in the directory for temporary files. Signal handlers
+(Ctrl-C) are process wide, they are set by the primary image only and
+never by an instance. Code model libraries (*.cm) are bound to the image
+which loads them, so an instance loading a library already in use by
+another image gets a private copy of it in the directory for temporary
+files (on MS Windows loading such a library into a second image fails).
+Instances may be used together with the functions above, which act on the
+primary image of ngspice.dll and remain unaffected by all instances.
+
 **
 Additional basics:
 No memory mallocing and freeing across the interface:
@@ -164,6 +207,17 @@ typedef struct vecinfoall
 } vecinfoall, *pvecinfoall;
 
 
+/* block of points of the selected vectors, see ngSpice_Init_Stream() */
+typedef struct vecblock {
+    char *plot;         /* type name of the plot */
+    int veccount;       /* number of vectors in the block */
+    int first;          /* index of the first point of the block in the plot */
+    int count;          /* number of points in the block */
+    bool final;         /* TRUE for the last block of the plot */
+    pvector_info vecs;  /* array of veccount vectors, v_length is count */
+} vecblock, *pvecblock;
+
+
 /* callback functions
 addresses received from caller with ngSpice_Init() function
 */
@@ -251,6 +305,18 @@ typedef int (GetSyncData)(double, double*, double, int, int, int, void*);
    void*       return pointer received from caller
 */
 
+/* callback function
+   address received from caller with ngSpice_Init_Stream() function
+*/
+
+/* send back a block of vector data */
+typedef int (SendDataBlock)(pvecblock, int, void*);
+/*
+   vecblock*   pointer to the block of data points
+   int         identification number of calling ngspice shared lib
+   void*       return pointer received from caller
+*/
+
 /* ngspice initialization,
 printfcn: pointer to callback function for reading printf, fprintf
 statfcn: pointer to callback function for the status string and percent value
@@ -277,6 +343,20 @@ userData: pointer to user-defined data, will not be modified, but
 IMPEXP
 int  ngSpice_Init_Sync(GetVSRCData *vsrcdat, GetISRCData *isrcdat, GetSyncData *syncdat, int *ident, void *userData);
 
+/* initialization of block data streaming
+blockfcn: pointer to callback function receiving the blocks, NULL stops streaming
+vecnames: NULL terminated array of the names of the vectors to be sent,
+          NULL for all vectors of a plot
+blocksize: number of points per block
+nbufs: number of blocks in the ring, 0 for blocks pointing into the vectors
+*/
+IMPEXP
+int  ngSpice_Init_Stream(SendDataBlock* blockfcn, char** vecnames, int blocksize, int nbufs);
+
+/* release the oldest block held by the caller */
+IMPEXP
+int  ngSpice_Stream_Ack(void);
+
 /* Caller may send ngspice commands to ngspice.dll.
 Commands are executed immediately */
 IMPEXP
@@ -321,6 +401,65 @@ IMPEXP
 bool ngSpice_SetBkpt(double time);
 
 
+
+/* handle of an independent ngspice instance */
+typedef struct ngSpice_instance ngSpiceInst;
+
+/* create and initialize a new instance, callbacks as with ngSpice_Init(),
+   returns NULL upon error */
+IMPEXP
+ngSpiceInst* ngSpice_nInit(SendChar* printfcn, SendStat* statfcn, ControlledExit* ngexit,
+                           SendData* sdata, SendInitData* sinitdata, BGThreadRunning* bgtrun,
+                           void* userData);
+
+/* initialization of synchronizing functions of an instance,
+   as with ngSpice_Init_Sync(), the identification number is fixed */
+IMPEXP
+int ngSpice_nInit_Sync(ngSpiceInst* inst, GetVSRCData *vsrcdat, GetISRCData *isrcdat,
+                       GetSyncData *syncdat, void *userData);
+
+IMPEXP
+int ngSpice_nInit_Stream(ngSpiceInst* inst, SendDataBlock* blockfcn, char** vecnames,
+                         int blocksize, int nbufs);
+
+IMPEXP
+int ngSpice_nStream_Ack(ngSpiceInst* inst);
+
+/* identification number handed to the callbacks of an instance */
+IMPEXP
+int ngSpice_nIdent(ngSpiceInst* inst);
+
+/* instance versions of the functions above */
+IMPEXP
+int ngSpice_nCommand(ngSpiceInst* inst, char* command);
+
+IMPEXP
+pvector_info ngGet_nVec_Info(ngSpiceInst* inst, char* vecname);
+
+IMPEXP
+int ngSpice_nCirc(ngSpiceInst* inst, char** circarray);
+
+IMPEXP
+char* ngSpice_nCurPlot(ngSpiceInst* inst);
+
+IMPEXP
+char** ngSpice_nAllPlots(ngSpiceInst* inst);
+
+IMPEXP
+char** ngSpice_nAllVecs(ngSpiceInst* inst, char* plotname);
+
+IMPEXP
+bool ngSpice_nrunning(ngSpiceInst* inst);
+
+IMPEXP
+bool ngSpice_nSetBkpt(ngSpiceInst* inst, double time);
+
+/* stop the instance and release its copy of ngspice.dll,
+   the handle is invalid afterwards, unless 1 is returned */
+IMPEXP
+int ngSpice_nDestroy(ngSpiceInst* inst);
+
+
 #ifdef __cplusplus
 }
 #endif
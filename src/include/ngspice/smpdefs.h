@@ -26,9 +26,16 @@ void SMPcaSolve(SMPmatrix *Matrix, double RHS[], double iRHS[],
 		double Spare[], double iSpare[]);
 void SMPcSolve( SMPmatrix *, double [], double [], double [], double []);
 void SMPsolve( SMPmatrix *, double [], double []);
+void SMPsolveMany( SMPmatrix *, int, double *[] );
+void SMPsolveTransposed( SMPmatrix *, double [], double [] );
 int SMPmatSize( SMPmatrix *);
 int SMPnewMatrix( SMPmatrix ** );
 void SMPdestroy( SMPmatrix *);
+void SMPuseCSC( SMPmatrix *, int );
+int SMPcCopySize( SMPmatrix * );
+void SMPcCopyGather( SMPmatrix *, double * );
+int SMPcCopySolve( SMPmatrix *, double *, double *, double [], double [] );
+void SMPcCopySolveTransposed( SMPmatrix *, double *, double *, double [], double [] );
 int SMPpreOrder( SMPmatrix *);
 void SMPprint( SMPmatrix * , char *);
 void SMPprintRHS( SMPmatrix * , char *, double*, double*);
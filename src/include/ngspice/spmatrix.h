@@ -293,5 +293,7 @@ extern  void     spMultiply( MatrixPtr, spREAL*, spREAL*, spREAL*, spREAL* );
 extern  void     spMultTransposed(MatrixPtr,spREAL*,spREAL*,spREAL*,spREAL*);
 extern  void     spSolve( MatrixPtr, spREAL*, spREAL*, spREAL*, spREAL* );
 extern  void     spSolveTransposed(MatrixPtr,spREAL*,spREAL*,spREAL*,spREAL*);
+extern  void     spSolveMany( MatrixPtr, int, spREAL**, spREAL** );
+extern  void     spSolveManyTransposed( MatrixPtr, int, spREAL**, spREAL** );
 
 #endif  /* spOKAY */
@@ -0,0 +1,43 @@
+/*************
+ * Header file for stimfile.c
+ ************/
+
+#ifndef ngspice_STIMFILE_H
+#define ngspice_STIMFILE_H
+
+/*
+ * A binary stimulus file holds a table of doubles with one row per time
+ * point, the time followed by the values of the channels, after a
+ * header of 32 bytes:
+ *
+ *   char     magic[8]     "NGSTIMUL"
+ *   uint32   version      1
+ *   uint32   byte order   0x01020304
+ *   uint32   columns      the time and the channels, at least 2
+ *   uint32   reserved     0
+ *   uint64   rows         number of time points
+ *
+ * All numbers are in the byte order of the machine writing the file,
+ * files of the other byte order are refused.  The table is not
+ * compressed, so that it can be used right from a mapping of the file.
+ */
+
+#define STIM_MAGIC      "NGSTIMUL"
+#define STIM_VERSION    1
+#define STIM_HEADER     32
+
+struct mapfile;
+
+typedef struct stimfile {
+    int columns;            /* the time and the channels */
+    size_t rows;            /* the time points */
+    const double *data;     /* rows * columns values, row by row */
+    struct mapfile *map;    /* the mapping holding data, or NULL */
+    double *buf;            /* data read into memory if not mapped */
+} STIMfile;
+
+STIMfile *stim_open(FILE *fp, const char **errmsg);
+void stim_close(STIMfile *stim);
+int stim_write_header(FILE *fp, int columns, size_t rows);
+
+#endif
@@ -66,6 +66,7 @@ struct TSKtask {
     double TSKabsDv;                 /* abs limit for iter-iter voltage change */
     double TSKrelDv;                 /* rel limit for iter-iter voltage change */
     unsigned int TSKnoopac:1; /* flag for no OP calculation before AC */
+    unsigned int TSKcscSolver:1; /* flag for compressed column refactoring */
 };
 
 #endif
@@ -9,6 +9,8 @@
 
 typedef struct CKTcircuit CKTcircuit;
 typedef struct CKTnode CKTnode;
+typedef struct CKTlinear CKTlinear;
+typedef struct CKTstamp CKTstamp;
 
 
 typedef struct GENinstance GENinstance;
@@ -78,3 +78,64 @@ NIintegrate(CKTcircuit *ckt, double *geq, double *ceq, double cap, int qcap)
     *geq = ckt->CKTag[0] * cap;
     return(OK);
 }
+
+
+/* NIintegrateVec(ckt,n,geq,ceq,cap,qcap)
+ *  integrate n capacitors at once, the same as NIintegrate on each of
+ *  them, but with the method and order looked at only once.
+ */
+
+int
+NIintegrateVec(CKTcircuit *ckt, int n, double *geq, double *ceq,
+               double *cap, int *qcap)
+{
+    double *s0 = ckt->CKTstate0;
+    double *s1 = ckt->CKTstate1;
+    double ag0 = ckt->CKTag[0];
+    double ag1 = ckt->CKTag[1];
+    int k, j;
+
+    if (n <= 0)
+        return(OK);
+
+    switch(ckt->CKTintegrateMethod) {
+
+    case TRAPEZOIDAL:
+        switch(ckt->CKTorder) {
+        case 1:
+            for (k = 0; k < n; k++)
+                s0[qcap[k]+1] = ag0 * s0[qcap[k]] + ag1 * s1[qcap[k]];
+            break;
+        case 2:
+            for (k = 0; k < n; k++)
+                s0[qcap[k]+1] = - s1[qcap[k]+1] * ag1 +
+                        ag0 * ( s0[qcap[k]] - s1[qcap[k]] );
+            break;
+        default:
+            return(NIintegrate(ckt, geq, ceq, cap[0], qcap[0]));
+        }
+        break;
+    case GEAR:
+        if (ckt->CKTorder < 1 || ckt->CKTorder > 6)
+            return(NIintegrate(ckt, geq, ceq, cap[0], qcap[0]));
+        for (k = 0; k < n; k++)
+            s0[qcap[k]+1] = 0;
+        for (j = ckt->CKTorder; j >= 1; j--) {
+            double agj = ckt->CKTag[j];
+            double *sj = ckt->CKTstates[j];
+            for (k = 0; k < n; k++)
+                s0[qcap[k]+1] += agj * sj[qcap[k]];
+        }
+        for (k = 0; k < n; k++)
+            s0[qcap[k]+1] += ag0 * s0[qcap[k]];
+        break;
+
+    default:
+        return(NIintegrate(ckt, geq, ceq, cap[0], qcap[0]));
+    }
+    for (k = 0; k < n; k++) {
+        ceq[k] = s0[qcap[k]+1] - ag0 * s0[qcap[k]];
+        geq[k] = ag0 * cap[k];
+    }
+    return(OK);
+}
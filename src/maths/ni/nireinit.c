@@ -40,5 +40,6 @@ NIreinit( CKTcircuit *ckt)
     }
 #endif /* PREDICTOR */
     ckt->CKTniState = NISHOULDREORDER | NIACSHOULDREORDER | NIPZSHOULDREORDER;
+    SMPuseCSC(ckt->CKTmatrix, ckt->CKTcscSolver);
     return(0);
 }
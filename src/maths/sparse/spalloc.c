@@ -160,6 +160,8 @@ spCreate(int Size, int Complex, int *pError)
     /* Initialize matrix */
     Matrix->ID = SPARSE_ID;
     Matrix->Complex = Complex;
+    Matrix->CSC = NULL;
+    Matrix->CSCenabled = NO;
     Matrix->PreviousMatrixWasComplex = Complex;
     Matrix->Factored = NO;
     Matrix->Elements = 0;
@@ -662,6 +664,7 @@ spDestroy(MatrixPtr Matrix)
     assert( IS_SPARSE( Matrix ) );
 
     /* Deallocate the vectors that are located in the matrix frame. */
+    spcCSCdestroy( Matrix );
     SP_FREE( Matrix->IntToExtColMap );
     SP_FREE( Matrix->IntToExtRowMap );
     SP_FREE( Matrix->ExtToIntColMap );
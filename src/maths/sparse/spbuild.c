@@ -135,6 +135,7 @@ spClear(MatrixPtr Matrix)
 
     Matrix->Error = spOKAY;
     Matrix->Factored = NO;
+    spcCSCunfactor( Matrix );
     Matrix->SingularCol = 0;
     Matrix->SingularRow = 0;
     Matrix->PreviousMatrixWasComplex = Matrix->Complex;
@@ -1198,6 +1199,7 @@ spInitialize(MatrixPtr Matrix, int (*pInit)(RealNumber*, void *InitInfo, int , i
 
     Matrix->Error = spOKAY;
     Matrix->Factored = NO;
+    spcCSCunfactor( Matrix );
     Matrix->SingularCol = 0;
     Matrix->SingularRow = 0;
     Matrix->PreviousMatrixWasComplex = Matrix->Complex;
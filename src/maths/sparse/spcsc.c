@@ -0,0 +1,699 @@
+/*
+ *  COMPRESSED COLUMN REFACTORIZATION MODULE
+ *
+ *  Once spOrderAndFactor() has chosen the pivots and created the
+ *  fill-ins, the structure of L and U stays fixed until the matrix has
+ *  to be reordered.  The routines in this file take a snapshot of that
+ *  structure in compressed column form (U is additionally kept row by
+ *  row for the backward substitution), so that the following numerical
+ *  refactorizations and solves walk contiguous index and value arrays
+ *  instead of the NextInCol/NextInRow lists of the orthogonal linked
+ *  list.
+ *
+ *  The matrix elements themselves are not touched.  The loaders keep
+ *  adding into the very element addresses they got from spGetElement(),
+ *  and spcCSCfactor() gathers the values from there on every
+ *  refactorization.  The pivots are static: a zero pivot is reported as
+ *  spZERO_DIAG, just like spFactor() does, and the caller is expected to
+ *  call spOrderAndFactor() again, which invalidates the snapshot.
+ *
+ *  The arithmetic is done in the same order as in spFactor() and
+ *  spSolve(), so the results are identical to those of the linked list
+ *  code.
+ *
+ *  For complex matrices the values are not kept in the frame.  The
+ *  caller gathers them into a private array with spcCSCcomplexGather()
+ *  and factors and solves that array with spcCSCcomplexSolve(), which
+ *  only reads the frame.  Several copies, e.g. of the same matrix at
+ *  different frequencies, can so be worked on at the same time.  A
+ *  factored copy can be solved once more for the transposed matrix with
+ *  spcCSCcomplexSolveTransposed().
+ *
+ *  >>> Functions contained in this file:
+ *  spcCSCanalyze
+ *  spcCSCfactor
+ *  spcCSCsolve
+ *  spcCSCsolveTransposed
+ *  spcCSCsolveMany
+ *  spcCSCcomplexSize
+ *  spcCSCcomplexGather
+ *  spcCSCcomplexSolve
+ *  spcCSCcomplexSolveTransposed
+ *  spcCSCfactored
+ *  spcCSCunfactor
+ *  spcCSCdestroy
+ */
+
+#include <assert.h>
+
+#define spINSIDE_SPARSE
+#include "spconfig.h"
+#include "ngspice/spmatrix.h"
+#include "spdefs.h"
+
+
+/*
+ *  COMPRESSED COLUMN FRAME
+ *
+ *  All index arrays use the internal (ordered) row and column numbers.
+ *  For column J the strictly lower entries of L are found at
+ *  ColL[J] .. ColL[J+1]-1 of RowL/ValL, the strictly upper entries of U
+ *  at ColU[J] .. ColU[J+1]-1 of RowU.  The values of U are stored row by
+ *  row: row I owns RowStartU[I] .. RowStartU[I+1]-1 of ColOfU/ValU, and
+ *  PosU maps a column entry of U to its place in ValU, UofRow does the
+ *  reverse.  Pivot holds the
+ *  reciprocals of the pivots, as Diag[]->Real does after spFactor().
+ *  The Src arrays point to the Real fields of the matrix elements the
+ *  values are gathered from.
+ */
+
+struct CSCFrame
+{
+    int          Size;
+    int          Factored;
+    int          NumL;
+    int          NumU;
+    int         *ColL;
+    int         *RowL;
+    RealNumber  *ValL;
+    RealNumber **SrcL;
+    RealNumber  *Pivot;
+    RealNumber **SrcPivot;
+    int         *ColU;
+    int         *RowU;
+    int         *PosU;
+    RealNumber **SrcU;
+    int         *RowStartU;
+    int         *ColOfU;
+    int         *UofRow;
+    RealNumber  *ValU;
+    RealNumber  *Work;
+};
+
+
+/*
+ *  BUILD THE COMPRESSED COLUMN STRUCTURE
+ *
+ *  Must be called after a successful spOrderAndFactor() (or spFactor()),
+ *  when the pivots are on the diagonal and all fill-ins exist.
+ *
+ *  >>> Returned:
+ *  spOKAY or spNO_MEMORY.
+ */
+
+int
+spcCSCanalyze(MatrixPtr Matrix)
+{
+    struct CSCFrame *CSC;
+    ElementPtr  pElement;
+    int  I, J, K, Size, NumL, NumU, *Next;
+
+    /* Begin `spcCSCanalyze'. */
+    assert( IS_VALID(Matrix) && IS_FACTORED(Matrix) );
+
+    spcCSCdestroy( Matrix );
+    Size = Matrix->Size;
+
+    /* Count the entries of L and U. */
+    NumL = NumU = 0;
+    for (J = 1; J <= Size; J++) {
+        for (pElement = Matrix->FirstInCol[J]; pElement != NULL;
+             pElement = pElement->NextInCol) {
+            if (pElement->Row < J)
+                NumU++;
+            else if (pElement->Row > J)
+                NumL++;
+        }
+    }
+
+    CSC = SP_MALLOC(struct CSCFrame, 1);
+    if (CSC == NULL)
+        return (Matrix->Error = spNO_MEMORY);
+    CSC->Size = Size;
+    CSC->Factored = NO;
+    CSC->NumL = NumL;
+    CSC->NumU = NumU;
+    CSC->ColL = SP_MALLOC(int, Size + 2);
+    CSC->RowL = SP_MALLOC(int, NumL + 1);
+    CSC->ValL = SP_MALLOC(RealNumber, NumL + 1);
+    CSC->SrcL = SP_MALLOC(RealNumber *, NumL + 1);
+    CSC->Pivot = SP_MALLOC(RealNumber, Size + 1);
+    CSC->SrcPivot = SP_MALLOC(RealNumber *, Size + 1);
+    CSC->ColU = SP_MALLOC(int, Size + 2);
+    CSC->RowU = SP_MALLOC(int, NumU + 1);
+    CSC->PosU = SP_MALLOC(int, NumU + 1);
+    CSC->SrcU = SP_MALLOC(RealNumber *, NumU + 1);
+    CSC->RowStartU = SP_MALLOC(int, Size + 2);
+    CSC->ColOfU = SP_MALLOC(int, NumU + 1);
+    CSC->UofRow = SP_MALLOC(int, NumU + 1);
+    CSC->ValU = SP_MALLOC(RealNumber, NumU + 1);
+    CSC->Work = SP_MALLOC(RealNumber, Size + 1);
+    Matrix->CSC = CSC;
+    Next = SP_MALLOC(int, Size + 2);
+
+    if (!CSC->ColL || !CSC->RowL || !CSC->ValL || !CSC->SrcL ||
+        !CSC->Pivot || !CSC->SrcPivot || !CSC->ColU || !CSC->RowU ||
+        !CSC->PosU || !CSC->SrcU || !CSC->RowStartU || !CSC->ColOfU ||
+        !CSC->UofRow || !CSC->ValU || !CSC->Work || !Next) {
+        SP_FREE( Next );
+        spcCSCdestroy( Matrix );
+        return (Matrix->Error = spNO_MEMORY);
+    }
+
+    /* Split every column into its part of U, the pivot and its part of L.
+     * The columns are linked in increasing row order, so are the
+     * resulting index arrays. */
+    NumL = NumU = 0;
+    for (J = 1; J <= Size; J++) {
+        CSC->ColL[J] = NumL;
+        CSC->ColU[J] = NumU;
+        for (pElement = Matrix->FirstInCol[J]; pElement != NULL;
+             pElement = pElement->NextInCol) {
+            if (pElement->Row < J) {
+                CSC->RowU[NumU] = pElement->Row;
+                CSC->SrcU[NumU++] = &pElement->Real;
+            } else if (pElement->Row > J) {
+                CSC->RowL[NumL] = pElement->Row;
+                CSC->SrcL[NumL++] = &pElement->Real;
+            } else {
+                CSC->SrcPivot[J] = &pElement->Real;
+            }
+        }
+    }
+    CSC->ColL[Size + 1] = NumL;
+    CSC->ColU[Size + 1] = NumU;
+
+    /* Transpose the pattern of U.  Walking the columns in increasing
+     * order leaves every row sorted by column, as NextInRow is. */
+    for (I = 0; I <= Size + 1; I++)
+        Next[I] = 0;
+    for (K = 0; K < NumU; K++)
+        Next[CSC->RowU[K]]++;
+    CSC->RowStartU[1] = 0;
+    for (I = 1; I <= Size; I++) {
+        CSC->RowStartU[I + 1] = CSC->RowStartU[I] + Next[I];
+        Next[I] = CSC->RowStartU[I];
+    }
+    for (J = 1; J <= Size; J++) {
+        for (K = CSC->ColU[J]; K < CSC->ColU[J + 1]; K++) {
+            I = Next[CSC->RowU[K]]++;
+            CSC->PosU[K] = I;
+            CSC->ColOfU[I] = J;
+            CSC->UofRow[I] = K;
+        }
+    }
+
+    SP_FREE( Next );
+    return spOKAY;
+}
+
+
+/*
+ *  NUMERICAL REFACTORIZATION
+ *
+ *  Left looking column by column LU factorization on the structure
+ *  recorded by spcCSCanalyze().  Mirrors the direct addressing branch of
+ *  spFactor(): pivots belong to L, U has a unit diagonal.
+ *
+ *  >>> Returned:
+ *  spOKAY or spZERO_DIAG.
+ */
+
+int
+spcCSCfactor(MatrixPtr Matrix)
+{
+    struct CSCFrame *CSC = Matrix->CSC;
+    RealNumber  *Dest, Mult;
+    int  Step, Size, K, M, Row;
+
+    /* Begin `spcCSCfactor'. */
+    assert( IS_VALID(Matrix) && !Matrix->Factored && !Matrix->Complex );
+    assert( CSC != NULL && CSC->Size == Matrix->Size );
+
+    Size = CSC->Size;
+    Dest = CSC->Work;
+    CSC->Factored = NO;
+
+    for (Step = 1; Step <= Size; Step++) {
+        int *RowU = CSC->RowU, *RowL = CSC->RowL;
+        int EndU = CSC->ColU[Step + 1], EndL = CSC->ColL[Step + 1];
+
+        /* Scatter. */
+        for (K = CSC->ColU[Step]; K < EndU; K++)
+            Dest[RowU[K]] = *CSC->SrcU[K];
+        Dest[Step] = *CSC->SrcPivot[Step];
+        for (K = CSC->ColL[Step]; K < EndL; K++)
+            Dest[RowL[K]] = *CSC->SrcL[K];
+
+        /* Update column. */
+        for (K = CSC->ColU[Step]; K < EndU; K++) {
+            Row = RowU[K];
+            Mult = Dest[Row] * CSC->Pivot[Row];
+            CSC->ValU[CSC->PosU[K]] = Mult;
+            for (M = CSC->ColL[Row]; M < CSC->ColL[Row + 1]; M++)
+                Dest[RowL[M]] -= Mult * CSC->ValL[M];
+        }
+
+        /* Gather. */
+        for (K = CSC->ColL[Step]; K < EndL; K++)
+            CSC->ValL[K] = Dest[RowL[K]];
+
+        /* Check for singular matrix. */
+        if (Dest[Step] == 0.0) {
+            Matrix->SingularRow = Matrix->IntToExtRowMap[Step];
+            Matrix->SingularCol = Matrix->IntToExtColMap[Step];
+            return (Matrix->Error = spZERO_DIAG);
+        }
+        CSC->Pivot[Step] = 1.0 / Dest[Step];
+    }
+
+    CSC->Factored = YES;
+    Matrix->Factored = YES;
+    return (Matrix->Error = spOKAY);
+}
+
+
+/*
+ *  SOLVE
+ *
+ *  Forward and backward substitution with the factors computed by
+ *  spcCSCfactor().  Called by spSolve() for real matrices.
+ */
+
+void
+spcCSCsolve(MatrixPtr Matrix, RealVector RHS, RealVector Solution)
+{
+    struct CSCFrame *CSC = Matrix->CSC;
+    RealVector  Intermediate = Matrix->Intermediate;
+    RealNumber  Temp;
+    int  I, K, Size = CSC->Size;
+
+    /* Begin `spcCSCsolve'. */
+    for (I = Size; I > 0; I--)
+        Intermediate[I] = RHS[Matrix->IntToExtRowMap[I]];
+
+    /* Forward elimination. Solves Lc = b.*/
+    for (I = 1; I <= Size; I++) {
+        if ((Temp = Intermediate[I]) != 0.0) {
+            Intermediate[I] = (Temp *= CSC->Pivot[I]);
+            for (K = CSC->ColL[I]; K < CSC->ColL[I + 1]; K++)
+                Intermediate[CSC->RowL[K]] -= Temp * CSC->ValL[K];
+        }
+    }
+
+    /* Backward Substitution. Solves Ux = c.*/
+    for (I = Size; I > 0; I--) {
+        Temp = Intermediate[I];
+        for (K = CSC->RowStartU[I]; K < CSC->RowStartU[I + 1]; K++)
+            Temp -= CSC->ValU[K] * Intermediate[CSC->ColOfU[K]];
+        Intermediate[I] = Temp;
+    }
+
+    for (I = Size; I > 0; I--)
+        Solution[Matrix->IntToExtColMap[I]] = Intermediate[I];
+}
+
+
+/*
+ *  SOLVE TRANSPOSED
+ *
+ *  Same as spcCSCsolve(), but for the transposed matrix.  Called by
+ *  spSolveTransposed() for real matrices.
+ */
+
+void
+spcCSCsolveTransposed(MatrixPtr Matrix, RealVector RHS, RealVector Solution)
+{
+    struct CSCFrame *CSC = Matrix->CSC;
+    RealVector  Intermediate = Matrix->Intermediate;
+    RealNumber  Temp;
+    int  I, K, Size = CSC->Size;
+
+    /* Begin `spcCSCsolveTransposed'. */
+    for (I = Size; I > 0; I--)
+        Intermediate[I] = RHS[Matrix->IntToExtColMap[I]];
+
+    /* Forward elimination. */
+    for (I = 1; I <= Size; I++) {
+        if ((Temp = Intermediate[I]) != 0.0) {
+            for (K = CSC->RowStartU[I]; K < CSC->RowStartU[I + 1]; K++)
+                Intermediate[CSC->ColOfU[K]] -= Temp * CSC->ValU[K];
+        }
+    }
+
+    /* Backward Substitution. */
+    for (I = Size; I > 0; I--) {
+        Temp = Intermediate[I];
+        for (K = CSC->ColL[I]; K < CSC->ColL[I + 1]; K++)
+            Temp -= CSC->ValL[K] * Intermediate[CSC->RowL[K]];
+        Intermediate[I] = Temp * CSC->Pivot[I];
+    }
+
+    for (I = Size; I > 0; I--)
+        Solution[Matrix->IntToExtRowMap[I]] = Intermediate[I];
+}
+
+
+/*
+ *  SOLVE FOR SEVERAL RIGHT HAND SIDES
+ *
+ *  Solves the matrix, or with Transposed set the transposed matrix, for
+ *  NumRHS right hand sides at once.  The solutions overwrite
+ *  RHS[0] .. RHS[NumRHS-1].  The intermediate vectors are interleaved in
+ *  Work, which must have room for NumRHS*(Size+1) RealNumbers, so each
+ *  value of L and U is fetched once for all right hand sides.  Every
+ *  solution is computed in the same order as by spcCSCsolve() or
+ *  spcCSCsolveTransposed().
+ */
+
+void
+spcCSCsolveMany(MatrixPtr Matrix, int NumRHS, RealVector RHS[],
+                RealVector Work, int Transposed)
+{
+    struct CSCFrame *CSC = Matrix->CSC;
+    RealVector  W, V;
+    RealNumber  Val;
+    int  *InMap, *OutMap;
+    int  I, J, K, Size = CSC->Size;
+
+    /* Begin `spcCSCsolveMany'. */
+    InMap = Transposed ? Matrix->IntToExtColMap : Matrix->IntToExtRowMap;
+    OutMap = Transposed ? Matrix->IntToExtRowMap : Matrix->IntToExtColMap;
+
+    for (I = Size; I > 0; I--)
+        for (J = 0; J < NumRHS; J++)
+            Work[I * NumRHS + J] = RHS[J][InMap[I]];
+
+    if (!Transposed) {
+        /* Forward elimination. Solves Lc = b.*/
+        for (I = 1; I <= Size; I++) {
+            W = Work + I * NumRHS;
+            for (J = 0; J < NumRHS; J++)
+                if (W[J] != 0.0)
+                    W[J] *= CSC->Pivot[I];
+            for (K = CSC->ColL[I]; K < CSC->ColL[I + 1]; K++) {
+                Val = CSC->ValL[K];
+                V = Work + CSC->RowL[K] * NumRHS;
+                for (J = 0; J < NumRHS; J++)
+                    if (W[J] != 0.0)
+                        V[J] -= W[J] * Val;
+            }
+        }
+
+        /* Backward Substitution. Solves Ux = c.*/
+        for (I = Size; I > 0; I--) {
+            W = Work + I * NumRHS;
+            for (K = CSC->RowStartU[I]; K < CSC->RowStartU[I + 1]; K++) {
+                Val = CSC->ValU[K];
+                V = Work + CSC->ColOfU[K] * NumRHS;
+                for (J = 0; J < NumRHS; J++)
+                    W[J] -= Val * V[J];
+            }
+        }
+    } else {
+        /* Forward elimination. */
+        for (I = 1; I <= Size; I++) {
+            W = Work + I * NumRHS;
+            for (K = CSC->RowStartU[I]; K < CSC->RowStartU[I + 1]; K++) {
+                Val = CSC->ValU[K];
+                V = Work + CSC->ColOfU[K] * NumRHS;
+                for (J = 0; J < NumRHS; J++)
+                    if (W[J] != 0.0)
+                        V[J] -= W[J] * Val;
+            }
+        }
+
+        /* Backward Substitution. */
+        for (I = Size; I > 0; I--) {
+            W = Work + I * NumRHS;
+            for (K = CSC->ColL[I]; K < CSC->ColL[I + 1]; K++) {
+                Val = CSC->ValL[K];
+                V = Work + CSC->RowL[K] * NumRHS;
+                for (J = 0; J < NumRHS; J++)
+                    W[J] -= Val * V[J];
+            }
+            for (J = 0; J < NumRHS; J++)
+                W[J] *= CSC->Pivot[I];
+        }
+    }
+
+    for (I = Size; I > 0; I--)
+        for (J = 0; J < NumRHS; J++)
+            RHS[J][OutMap[I]] = Work[I * NumRHS + J];
+}
+
+
+/*
+ *  COMPLEX COPIES
+ *
+ *  A complex copy holds the values of U in column order, followed by the
+ *  Size diagonal values and the values of L, in the order of the Src
+ *  arrays.  spcCSCcomplexSize() returns its length in ComplexNumbers.
+ */
+
+int
+spcCSCcomplexSize(MatrixPtr Matrix)
+{
+    struct CSCFrame *CSC = Matrix->CSC;
+
+    return CSC->NumU + CSC->Size + CSC->NumL;
+}
+
+
+/*
+ *  Copy the current values of the matrix elements into Values.
+ */
+
+void
+spcCSCcomplexGather(MatrixPtr Matrix, ComplexVector Values)
+{
+    struct CSCFrame *CSC = Matrix->CSC;
+    int  K;
+
+    /* Begin `spcCSCcomplexGather'. */
+    for (K = 0; K < CSC->NumU; K++)
+        Values[K] = *(ComplexNumber *) CSC->SrcU[K];
+    Values += CSC->NumU - 1;
+    for (K = 1; K <= CSC->Size; K++)
+        Values[K] = *(ComplexNumber *) CSC->SrcPivot[K];
+    Values += CSC->Size + 1;
+    for (K = 0; K < CSC->NumL; K++)
+        Values[K] = *(ComplexNumber *) CSC->SrcL[K];
+}
+
+
+/*
+ *  Factor a complex copy in place and solve it for RHS + j iRHS.  The
+ *  solution overwrites RHS and iRHS.  Work must have room for Size+1
+ *  ComplexNumbers.  This mirrors FactorComplexMatrix() and
+ *  SolveComplexMatrix(), it does not modify the matrix or the frame and
+ *  may run concurrently on different copies.
+ *
+ *  >>> Returned:
+ *  spOKAY or spZERO_DIAG.
+ */
+
+int
+spcCSCcomplexSolve(MatrixPtr Matrix, ComplexVector Values, ComplexVector Work,
+                   RealVector RHS, RealVector iRHS)
+{
+    struct CSCFrame *CSC = Matrix->CSC;
+    ComplexVector  ValU, Pivot, ValL, Dest;
+    ComplexNumber  Mult, Temp;
+    int  I, K, M, Row, Step, Size = CSC->Size;
+
+    /* Begin `spcCSCcomplexSolve'. */
+    ValU = Values;
+    Pivot = Values + CSC->NumU - 1;
+    ValL = Values + CSC->NumU + Size;
+    Dest = Work;
+
+    for (Step = 1; Step <= Size; Step++) {
+        int EndU = CSC->ColU[Step + 1], EndL = CSC->ColL[Step + 1];
+
+        /* Scatter. */
+        for (K = CSC->ColU[Step]; K < EndU; K++)
+            Dest[CSC->RowU[K]] = ValU[K];
+        Dest[Step] = Pivot[Step];
+        for (K = CSC->ColL[Step]; K < EndL; K++)
+            Dest[CSC->RowL[K]] = ValL[K];
+
+        /* Update column. */
+        for (K = CSC->ColU[Step]; K < EndU; K++) {
+            Row = CSC->RowU[K];
+            /* Cmplx expr: Mult = Dest[Row] * (1.0 / Pivot[Row]). */
+            CMPLX_MULT(Mult, Dest[Row], Pivot[Row]);
+            CMPLX_ASSIGN(ValU[K], Mult);
+            for (M = CSC->ColL[Row]; M < CSC->ColL[Row + 1]; M++) {
+                /* Cmplx expr: Dest[RowL[M]] -= Mult * ValL[M] */
+                CMPLX_MULT_SUBT_ASSIGN(Dest[CSC->RowL[M]], Mult, ValL[M]);
+            }
+        }
+
+        /* Gather. */
+        for (K = CSC->ColL[Step]; K < EndL; K++)
+            ValL[K] = Dest[CSC->RowL[K]];
+
+        /* Check for singular matrix. */
+        Temp = Dest[Step];
+        if (CMPLX_1_NORM(Temp) == 0.0)
+            return spZERO_DIAG;
+        CMPLX_RECIPROCAL(Pivot[Step], Temp);
+    }
+
+    /* Initialize Intermediate vector. */
+    for (I = Size; I > 0; I--) {
+        Dest[I].Real = RHS[Matrix->IntToExtRowMap[I]];
+        Dest[I].Imag = iRHS[Matrix->IntToExtRowMap[I]];
+    }
+
+    /* Forward substitution. Solves Lc = b.*/
+    for (I = 1; I <= Size; I++) {
+        Temp = Dest[I];
+        if ((Temp.Real != 0.0) || (Temp.Imag != 0.0)) {
+            /* Cmplx expr: Temp *= (1.0 / Pivot). */
+            CMPLX_MULT_ASSIGN(Temp, Pivot[I]);
+            Dest[I] = Temp;
+            for (K = CSC->ColL[I]; K < CSC->ColL[I + 1]; K++) {
+                /* Cmplx expr: Dest[RowL[K]] -= Temp * ValL[K]. */
+                CMPLX_MULT_SUBT_ASSIGN(Dest[CSC->RowL[K]], Temp, ValL[K]);
+            }
+        }
+    }
+
+    /* Backward Substitution. Solves Ux = c.  The values of U are in
+     * column order here, UofRow leads from the row order to them. */
+    for (I = Size; I > 0; I--) {
+        Temp = Dest[I];
+        for (K = CSC->RowStartU[I]; K < CSC->RowStartU[I + 1]; K++) {
+            /* Cmplx expr: Temp -= ValU * Dest[ColOfU]. */
+            CMPLX_MULT_SUBT_ASSIGN(Temp, ValU[CSC->UofRow[K]],
+                                   Dest[CSC->ColOfU[K]]);
+        }
+        Dest[I] = Temp;
+    }
+
+    for (I = Size; I > 0; I--) {
+        RHS[Matrix->IntToExtColMap[I]] = Dest[I].Real;
+        iRHS[Matrix->IntToExtColMap[I]] = Dest[I].Imag;
+    }
+
+    return spOKAY;
+}
+
+
+/*
+ *  Solve the transposed system of a complex copy, which has been factored
+ *  by spcCSCcomplexSolve() before, for RHS + j iRHS.  The solution
+ *  overwrites RHS and iRHS.  Work must have room for Size+1
+ *  ComplexNumbers.  This mirrors SolveComplexTransposedMatrix() and, like
+ *  spcCSCcomplexSolve(), may run concurrently on different copies.
+ */
+
+void
+spcCSCcomplexSolveTransposed(MatrixPtr Matrix, ComplexVector Values,
+                             ComplexVector Work, RealVector RHS,
+                             RealVector iRHS)
+{
+    struct CSCFrame *CSC = Matrix->CSC;
+    ComplexVector  ValU, Pivot, ValL, Dest;
+    ComplexNumber  Temp;
+    int  I, K, Size = CSC->Size;
+
+    /* Begin `spcCSCcomplexSolveTransposed'. */
+    ValU = Values;
+    Pivot = Values + CSC->NumU - 1;
+    ValL = Values + CSC->NumU + Size;
+    Dest = Work;
+
+    /* Initialize Intermediate vector. */
+    for (I = Size; I > 0; I--) {
+        Dest[I].Real = RHS[Matrix->IntToExtColMap[I]];
+        Dest[I].Imag = iRHS[Matrix->IntToExtColMap[I]];
+    }
+
+    /* Forward elimination.  Solves U^T c = b, row by row of U. */
+    for (I = 1; I <= Size; I++) {
+        Temp = Dest[I];
+        if ((Temp.Real != 0.0) || (Temp.Imag != 0.0)) {
+            for (K = CSC->RowStartU[I]; K < CSC->RowStartU[I + 1]; K++) {
+                /* Cmplx expr: Dest[ColOfU] -= Temp * ValU. */
+                CMPLX_MULT_SUBT_ASSIGN(Dest[CSC->ColOfU[K]], Temp,
+                                       ValU[CSC->UofRow[K]]);
+            }
+        }
+    }
+
+    /* Backward Substitution.  Solves L^T x = c. */
+    for (I = Size; I > 0; I--) {
+        Temp = Dest[I];
+        for (K = CSC->ColL[I]; K < CSC->ColL[I + 1]; K++) {
+            /* Cmplx expr: Temp -= Dest[RowL] * ValL. */
+            CMPLX_MULT_SUBT_ASSIGN(Temp, Dest[CSC->RowL[K]], ValL[K]);
+        }
+        /* Cmplx expr: Dest = Temp * (1.0 / Pivot). */
+        CMPLX_MULT(Dest[I], Temp, Pivot[I]);
+    }
+
+    for (I = Size; I > 0; I--) {
+        RHS[Matrix->IntToExtRowMap[I]] = Dest[I].Real;
+        iRHS[Matrix->IntToExtRowMap[I]] = Dest[I].Imag;
+    }
+}
+
+
+/*
+ *  Tell whether the last real factorization was done by spcCSCfactor().
+ */
+
+int
+spcCSCfactored(MatrixPtr Matrix)
+{
+    return Matrix->CSC != NULL && Matrix->CSC->Factored;
+}
+
+
+/*
+ *  Forget the factors, e.g. because the linked list code is about to
+ *  factor the matrix.  The structure is kept.
+ */
+
+void
+spcCSCunfactor(MatrixPtr Matrix)
+{
+    if (Matrix->CSC != NULL)
+        Matrix->CSC->Factored = NO;
+}
+
+
+/*
+ *  Free the compressed column structure.
+ */
+
+void
+spcCSCdestroy(MatrixPtr Matrix)
+{
+    struct CSCFrame *CSC = Matrix->CSC;
+
+    /* Begin `spcCSCdestroy'. */
+    if (CSC == NULL)
+        return;
+
+    SP_FREE( CSC->ColL );
+    SP_FREE( CSC->RowL );
+    SP_FREE( CSC->ValL );
+    SP_FREE( CSC->SrcL );
+    SP_FREE( CSC->Pivot );
+    SP_FREE( CSC->SrcPivot );
+    SP_FREE( CSC->ColU );
+    SP_FREE( CSC->RowU );
+    SP_FREE( CSC->PosU );
+    SP_FREE( CSC->SrcU );
+    SP_FREE( CSC->RowStartU );
+    SP_FREE( CSC->ColOfU );
+    SP_FREE( CSC->UofRow );
+    SP_FREE( CSC->ValU );
+    SP_FREE( CSC->Work );
+    SP_FREE( CSC );
+    Matrix->CSC = NULL;
+}
@@ -566,6 +566,13 @@ struct ElementListNodeStruct
  *  Complex  (int)
  *      The flag which indicates whether the matrix is complex (true) or
  *      real.
+ *  CSC  (struct CSCFrame *)
+ *      Compressed column copy of the structure of the factored matrix,
+ *      used for refactorization when CSCenabled is set.  NULL if not
+ *      built.  See spcsc.c.
+ *  CSCenabled  (int)
+ *      Flag that selects the compressed column refactorization.  Set by
+ *      the SMP wrappers.
  *  CurrentSize  (int)
  *      This number is used during the building of the matrix when the
  *      TRANSLATE option is set true.  It indicates the number of internal
@@ -736,6 +743,8 @@ struct  MatrixFrame
     int                          AllocatedSize;
     int                          AllocatedExtSize;
     int                      Complex;
+    struct CSCFrame             *CSC;
+    int                      CSCenabled;
     int                          CurrentSize;
     ArrayOfElementPtrs           Diag;
     int                     *DoCmplxDirect;
@@ -801,6 +810,23 @@ extern void spcLinkRows( MatrixPtr );
 extern void spcColExchange( MatrixPtr, int, int );
 extern void spcRowExchange( MatrixPtr, int, int );
 
+extern int  spcCSCanalyze( MatrixPtr );
+extern int  spcCSCfactor( MatrixPtr );
+extern void spcCSCsolve( MatrixPtr, RealVector, RealVector );
+extern void spcCSCsolveTransposed( MatrixPtr, RealVector, RealVector );
+extern void spcCSCsolveMany( MatrixPtr, int, RealVector [], RealVector,
+                             int );
+extern int  spcCSCcomplexSize( MatrixPtr );
+extern void spcCSCcomplexGather( MatrixPtr, ComplexVector );
+extern int  spcCSCcomplexSolve( MatrixPtr, ComplexVector, ComplexVector,
+                                RealVector, RealVector );
+extern void spcCSCcomplexSolveTransposed( MatrixPtr, ComplexVector,
+                                          ComplexVector, RealVector,
+                                          RealVector );
+extern int  spcCSCfactored( MatrixPtr );
+extern void spcCSCunfactor( MatrixPtr );
+extern void spcCSCdestroy( MatrixPtr );
+
 void spErrorMessage(MatrixPtr, FILE *, char *);
 
 #endif
@@ -199,6 +199,9 @@ spOrderAndFactor(MatrixPtr Matrix, RealNumber RHS[], RealNumber RelThreshold,
     /* Begin `spOrderAndFactor'. */
     assert( IS_VALID(Matrix) && !Matrix->Factored);
 
+    /* The pivot order may change, drop the compressed column copy. */
+    spcCSCdestroy( Matrix );
+
     Matrix->Error = spOKAY;
     Size = Matrix->Size;
     if (RelThreshold <= 0.0)
@@ -329,6 +332,7 @@ spFactor(MatrixPtr Matrix)
 
     /* Begin `spFactor'. */
     assert( IS_VALID(Matrix) && !Matrix->Factored);
+    spcCSCunfactor( Matrix );
 
     if (Matrix->NeedsOrdering) {
         return spOrderAndFactor( Matrix, NULL,
@@ -22,9 +22,16 @@
  *  SMPcaSolve
  *  SMPcSolve
  *  SMPsolve
+ *  SMPsolveMany
+ *  SMPsolveTransposed
  *  SMPmatSize
  *  SMPnewMatrix
  *  SMPdestroy
+ *  SMPuseCSC
+ *  SMPcCopySize
+ *  SMPcCopyGather
+ *  SMPcCopySolve
+ *  SMPcCopySolveTransposed
  *  SMPpreOrder
  *  SMPprint
  *  SMPgetError
@@ -168,10 +175,21 @@ SMPcLUfac(SMPmatrix *Matrix, double PivTol)
 int
 SMPluFac(SMPmatrix *Matrix, double PivTol, double Gmin)
 {
+    int Error;
+
     NG_IGNORE(PivTol);
     spSetReal( Matrix );
     LoadGmin( Matrix, Gmin );
-    return spFactor( Matrix );
+    if (!Matrix->CSCenabled)
+        return spFactor( Matrix );
+
+    /* refactor on the compressed column copy of the last ordering */
+    if (Matrix->CSC && !Matrix->NeedsOrdering)
+        return spcCSCfactor( Matrix );
+    Error = spFactor( Matrix );
+    if (Error == spOKAY)
+        Error = spcCSCanalyze( Matrix );
+    return Error;
 }
 
 /*
@@ -193,10 +211,15 @@ SMPcReorder(SMPmatrix *Matrix, double PivTol, double PivRel,
 int
 SMPreorder(SMPmatrix *Matrix, double PivTol, double PivRel, double Gmin)
 {
+    int Error;
+
     spSetReal( Matrix );
     LoadGmin( Matrix, Gmin );
-    return spOrderAndFactor( Matrix, NULL,
-                             PivRel, PivTol, YES );
+    Error = spOrderAndFactor( Matrix, NULL,
+                              PivRel, PivTol, YES );
+    if (Error == spOKAY && Matrix->CSCenabled)
+        Error = spcCSCanalyze( Matrix );
+    return Error;
 }
 
 /*
@@ -236,6 +259,28 @@ SMPsolve(SMPmatrix *Matrix, double RHS[], double Spare[])
     spSolve( Matrix, RHS, RHS, NULL, NULL );
 }
 
+/*
+ * SMPsolveMany()
+ *    solve for the NumRHS right hand sides RHS[0..NumRHS-1] at once,
+ *    the solutions overwrite them
+ */
+void
+SMPsolveMany(SMPmatrix *Matrix, int NumRHS, double *RHS[])
+{
+    spSolveMany( Matrix, NumRHS, RHS, NULL );
+}
+
+/*
+ * SMPsolveTransposed()
+ */
+void
+SMPsolveTransposed(SMPmatrix *Matrix, double RHS[], double Spare[])
+{
+    NG_IGNORE(Spare);
+
+    spSolveTransposed( Matrix, RHS, RHS, NULL, NULL );
+}
+
 /*
  * SMPmatSize()
  */
@@ -265,6 +310,69 @@ SMPdestroy(SMPmatrix *Matrix)
     spDestroy( Matrix );
 }
 
+/*
+ * SMPuseCSC()
+ *    select the compressed column refactorization (see spcsc.c)
+ *    for the real factorizations following the next reordering
+ */
+void
+SMPuseCSC(SMPmatrix *Matrix, int Flag)
+{
+    Matrix->CSCenabled = Flag;
+    if (!Flag)
+        spcCSCdestroy( Matrix );
+}
+
+/*
+ * SMPcCopySize()
+ *    prepare for private copies of the complex matrix, which are
+ *    factored with the pivot order of the last factorization (see
+ *    spcsc.c), returns the number of doubles of one copy or -1
+ */
+int
+SMPcCopySize(SMPmatrix *Matrix)
+{
+    if (!Matrix->CSC && spcCSCanalyze( Matrix ) != spOKAY)
+        return -1;
+    return 2 * spcCSCcomplexSize( Matrix );
+}
+
+/*
+ * SMPcCopyGather()
+ *    copy the current values of the matrix
+ */
+void
+SMPcCopyGather(SMPmatrix *Matrix, double *Values)
+{
+    spcCSCcomplexGather( Matrix, (ComplexVector) Values );
+}
+
+/*
+ * SMPcCopySolve()
+ *    factor a copy and solve it, may run in parallel on different copies,
+ *    Work needs 2*(size+1) doubles, E_SINGULAR if a pivot became zero
+ */
+int
+SMPcCopySolve(SMPmatrix *Matrix, double *Values, double *Work,
+              double RHS[], double iRHS[])
+{
+    return spcCSCcomplexSolve( Matrix, (ComplexVector) Values,
+                               (ComplexVector) Work, RHS, iRHS );
+}
+
+/*
+ * SMPcCopySolveTransposed()
+ *    solve the transposed system of a copy already factored by
+ *    SMPcCopySolve(), Work needs 2*(size+1) doubles
+ */
+void
+SMPcCopySolveTransposed(SMPmatrix *Matrix, double *Values, double *Work,
+                        double RHS[], double iRHS[])
+{
+    spcCSCcomplexSolveTransposed( Matrix, (ComplexVector) Values,
+                                  (ComplexVector) Work, RHS, iRHS );
+}
+
 /*
  * SMPpreOrder()
  */
@@ -11,8 +11,13 @@
  *  >>> User accessible functions contained in this file:
  *  spSolve
  *  spSolveTransposed
+ *  spSolveMany
+ *  spSolveManyTransposed
  *
  *  >>> Other functions contained in this file:
+ *  SolveMany
+ *  SolveRealMany
+ *  SolveComplexMany
  *  SolveComplexMatrix
  *  SolveComplexTransposedMatrix
  */
@@ -59,6 +64,10 @@
  * Function declarations
  */
 
+static void SolveMany( MatrixPtr, int, RealVector [], RealVector [], int );
+static void SolveRealMany( MatrixPtr, int, RealVector [], RealVector, int );
+static void SolveComplexMany( MatrixPtr, int, RealVector [], RealVector [],
+                        ComplexVector, int );
 static void SolveComplexMatrix( MatrixPtr,
                         RealVector, RealVector, RealVector, RealVector );
 static void SolveComplexTransposedMatrix( MatrixPtr,
@@ -142,6 +151,12 @@ spSolve(MatrixPtr Matrix, RealVector RHS, RealVector Solution,
         return;
     }
 
+    if (spcCSCfactored( Matrix ))
+    {
+	spcCSCsolve( Matrix, RHS, Solution );
+        return;
+    }
+
     Intermediate = Matrix->Intermediate;
     Size = Matrix->Size;
 
@@ -417,6 +432,12 @@ spSolveTransposed(MatrixPtr Matrix, RealVector RHS, RealVector Solution,
         return;
     }
 
+    if (spcCSCfactored( Matrix ))
+    {
+	spcCSCsolveTransposed( Matrix, RHS, Solution );
+        return;
+    }
+
     Size = Matrix->Size;
     Intermediate = Matrix->Intermediate;
 
@@ -474,6 +495,348 @@ spSolveTransposed(MatrixPtr Matrix, RealVector RHS, RealVector Solution,
 
 
 
+
+/*
+ *  SOLVE FOR SEVERAL RIGHT HAND SIDES
+ *
+ *  Solves the factored matrix for NumRHS right hand sides.  The
+ *  solutions overwrite the right hand sides.  Each solution is the same
+ *  as the one spSolve() gives, but the right hand sides are eliminated
+ *  together, so that L and U are traversed only once.  This pays when
+ *  many excitations are applied to the same factorization, e.g. in the
+ *  transfer function analysis.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (char *)
+ *      Pointer to matrix.
+ *  NumRHS  <input>  (int)
+ *      Number of right hand sides.
+ *  RHS  <input/output>  (RealVector [])
+ *      The right hand sides, replaced by the solutions.
+ *  iRHS  <input/output>  (RealVector [])
+ *      The imaginary portions of the right hand sides, replaced by the
+ *      imaginary portions of the solutions.  If matrix is real, there is
+ *      no need to supply this array.
+ */
+
+void
+spSolveMany(MatrixPtr Matrix, int NumRHS, RealVector RHS[],
+            RealVector iRHS[])
+{
+    /* Begin `spSolveMany'. */
+    SolveMany( Matrix, NumRHS, RHS, iRHS, NO );
+}
+
+
+#if TRANSPOSE
+/*
+ *  SOLVE TRANSPOSED FOR SEVERAL RIGHT HAND SIDES
+ *
+ *  Same as spSolveMany(), but for the transposed matrix, as
+ *  spSolveTransposed() does.
+ */
+
+void
+spSolveManyTransposed(MatrixPtr Matrix, int NumRHS, RealVector RHS[],
+                      RealVector iRHS[])
+{
+    /* Begin `spSolveManyTransposed'. */
+    SolveMany( Matrix, NumRHS, RHS, iRHS, YES );
+}
+#endif /* TRANSPOSE */
+
+
+static void
+SolveMany(MatrixPtr Matrix, int NumRHS, RealVector RHS[], RealVector iRHS[],
+          int Transposed)
+{
+    RealVector  Work;
+    int  J;
+
+    /* Begin `SolveMany'. */
+    assert( IS_VALID(Matrix) && IS_FACTORED(Matrix) );
+
+    if (!Matrix->Complex && NumRHS > 1 && spcCSCfactored( Matrix ))
+    {
+        Work = SP_MALLOC(RealNumber, NumRHS * (Matrix->Size + 1));
+        if (Work != NULL)
+        {
+            spcCSCsolveMany( Matrix, NumRHS, RHS, Work, Transposed );
+            SP_FREE(Work);
+            return;
+        }
+    }
+
+    if (!Matrix->Complex && NumRHS > 1)
+    {
+        Work = SP_MALLOC(RealNumber, NumRHS * (Matrix->Size + 1));
+        if (Work != NULL)
+        {
+            SolveRealMany( Matrix, NumRHS, RHS, Work, Transposed );
+            SP_FREE(Work);
+            return;
+        }
+    }
+
+    if (Matrix->Complex && NumRHS > 1)
+    {
+        ComplexVector  cWork = SP_MALLOC(ComplexNumber, NumRHS * (Matrix->Size + 1));
+        if (cWork != NULL)
+        {
+            SolveComplexMany( Matrix, NumRHS, RHS, iRHS, cWork, Transposed );
+            SP_FREE(cWork);
+            return;
+        }
+    }
+
+    /* One by one. */
+    for (J = 0; J < NumRHS; J++)
+    {
+#if TRANSPOSE
+        if (Transposed)
+        {
+            if (Matrix->Complex)
+                spSolveTransposed( Matrix, RHS[J], RHS[J], iRHS[J], iRHS[J] );
+            else
+                spSolveTransposed( Matrix, RHS[J], RHS[J], NULL, NULL );
+            continue;
+        }
+#endif
+        if (Matrix->Complex)
+            spSolve( Matrix, RHS[J], RHS[J], iRHS[J], iRHS[J] );
+        else
+            spSolve( Matrix, RHS[J], RHS[J], NULL, NULL );
+    }
+}
+
+
+/*
+ *  SOLVE REAL MATRIX FOR SEVERAL RIGHT HAND SIDES
+ *
+ *  For a real matrix factored in the linked list structure.  The
+ *  intermediate vectors of all right hand sides are interleaved in Work,
+ *  which must have room for NumRHS*(Size+1) RealNumbers, and each
+ *  element of L and U is visited once for all of them.  Every solution
+ *  is computed in the same order as by spSolve() or spSolveTransposed().
+ */
+
+static void
+SolveRealMany(MatrixPtr Matrix, int NumRHS, RealVector RHS[],
+              RealVector Work, int Transposed)
+{
+    ElementPtr  pElement, pPivot;
+    RealVector  W, V;
+    RealNumber  Temp;
+    int  I, J, Size, *InMap, *OutMap;
+
+    /* Begin `SolveRealMany'. */
+    Size = Matrix->Size;
+    InMap = Transposed ? Matrix->IntToExtColMap : Matrix->IntToExtRowMap;
+    OutMap = Transposed ? Matrix->IntToExtRowMap : Matrix->IntToExtColMap;
+
+    for (I = Size; I > 0; I--)
+        for (J = 0; J < NumRHS; J++)
+            Work[I * NumRHS + J] = RHS[J][InMap[I]];
+
+    if (!Transposed)
+    {
+        /* Forward elimination. Solves Lc = b.*/
+        for (I = 1; I <= Size; I++)
+        {
+            W = Work + I * NumRHS;
+            pPivot = Matrix->Diag[I];
+            for (J = 0; J < NumRHS; J++)
+                if (W[J] != 0.0)
+                    W[J] *= pPivot->Real;
+            for (pElement = pPivot->NextInCol; pElement != NULL;
+                 pElement = pElement->NextInCol)
+            {
+                V = Work + pElement->Row * NumRHS;
+                for (J = 0; J < NumRHS; J++)
+                    if (W[J] != 0.0)
+                        V[J] -= W[J] * pElement->Real;
+            }
+        }
+
+        /* Backward Substitution. Solves Ux = c.*/
+        for (I = Size; I > 0; I--)
+        {
+            W = Work + I * NumRHS;
+            for (pElement = Matrix->Diag[I]->NextInRow; pElement != NULL;
+                 pElement = pElement->NextInRow)
+            {
+                V = Work + pElement->Col * NumRHS;
+                for (J = 0; J < NumRHS; J++)
+                    W[J] -= pElement->Real * V[J];
+            }
+        }
+    }
+#if TRANSPOSE
+    else
+    {
+        /* Forward elimination. */
+        for (I = 1; I <= Size; I++)
+        {
+            W = Work + I * NumRHS;
+            for (pElement = Matrix->Diag[I]->NextInRow; pElement != NULL;
+                 pElement = pElement->NextInRow)
+            {
+                V = Work + pElement->Col * NumRHS;
+                for (J = 0; J < NumRHS; J++)
+                    if ((Temp = W[J]) != 0.0)
+                        V[J] -= Temp * pElement->Real;
+            }
+        }
+
+        /* Backward Substitution. */
+        for (I = Size; I > 0; I--)
+        {
+            W = Work + I * NumRHS;
+            pPivot = Matrix->Diag[I];
+            for (pElement = pPivot->NextInCol; pElement != NULL;
+                 pElement = pElement->NextInCol)
+            {
+                V = Work + pElement->Row * NumRHS;
+                for (J = 0; J < NumRHS; J++)
+                    W[J] -= pElement->Real * V[J];
+            }
+            for (J = 0; J < NumRHS; J++)
+                W[J] *= pPivot->Real;
+        }
+    }
+#endif /* TRANSPOSE */
+
+    for (I = Size; I > 0; I--)
+        for (J = 0; J < NumRHS; J++)
+            RHS[J][OutMap[I]] = Work[I * NumRHS + J];
+}
+
+
+/*
+ *  SOLVE COMPLEX MATRIX FOR SEVERAL RIGHT HAND SIDES
+ *
+ *  The complex matrix is always factored in the linked list structure.
+ *  As SolveRealMany() does for the real one, the intermediate vectors
+ *  of all right hand sides are interleaved in Work, which must have room
+ *  for NumRHS*(Size+1) ComplexNumbers, and each element of L and U is
+ *  visited once for all of them.  Every solution is computed in the same
+ *  order as by SolveComplexMatrix() or SolveComplexTransposedMatrix().
+ */
+
+static void
+SolveComplexMany(MatrixPtr Matrix, int NumRHS, RealVector RHS[],
+                 RealVector iRHS[], ComplexVector Work, int Transposed)
+{
+    ElementPtr  pElement, pPivot;
+    ComplexVector  W, V;
+    ComplexNumber  Temp;
+    int  I, J, Size, *InMap, *OutMap;
+
+    /* Begin `SolveComplexMany'. */
+    Size = Matrix->Size;
+    InMap = Transposed ? Matrix->IntToExtColMap : Matrix->IntToExtRowMap;
+    OutMap = Transposed ? Matrix->IntToExtRowMap : Matrix->IntToExtColMap;
+
+    for (I = Size; I > 0; I--)
+        for (J = 0; J < NumRHS; J++)
+        {
+            Work[I * NumRHS + J].Real = RHS[J][InMap[I]];
+            Work[I * NumRHS + J].Imag = iRHS[J][InMap[I]];
+        }
+
+    if (!Transposed)
+    {
+        /* Forward substitution. Solves Lc = b.*/
+        for (I = 1; I <= Size; I++)
+        {
+            W = Work + I * NumRHS;
+            pPivot = Matrix->Diag[I];
+            for (J = 0; J < NumRHS; J++)
+                if ((W[J].Real != 0.0) || (W[J].Imag != 0.0))
+                {
+                    /* Cmplx expr: Temp *= (1.0 / Pivot). */
+                    Temp = W[J];
+                    CMPLX_MULT_ASSIGN(Temp, *pPivot);
+                    W[J] = Temp;
+                }
+            for (pElement = pPivot->NextInCol; pElement != NULL;
+                 pElement = pElement->NextInCol)
+            {
+                V = Work + pElement->Row * NumRHS;
+                for (J = 0; J < NumRHS; J++)
+                    if ((W[J].Real != 0.0) || (W[J].Imag != 0.0))
+                        CMPLX_MULT_SUBT_ASSIGN(V[J], W[J], *pElement);
+            }
+        }
+
+        /* Backward Substitution. Solves Ux = c.*/
+        for (I = Size; I > 0; I--)
+        {
+            W = Work + I * NumRHS;
+            for (pElement = Matrix->Diag[I]->NextInRow; pElement != NULL;
+                 pElement = pElement->NextInRow)
+            {
+                V = Work + pElement->Col * NumRHS;
+                for (J = 0; J < NumRHS; J++)
+                    CMPLX_MULT_SUBT_ASSIGN(W[J], *pElement, V[J]);
+            }
+        }
+    }
+#if TRANSPOSE
+    else
+    {
+        /* Forward elimination. */
+        for (I = 1; I <= Size; I++)
+        {
+            W = Work + I * NumRHS;
+            for (pElement = Matrix->Diag[I]->NextInRow; pElement != NULL;
+                 pElement = pElement->NextInRow)
+            {
+                V = Work + pElement->Col * NumRHS;
+                for (J = 0; J < NumRHS; J++)
+                    if ((W[J].Real != 0.0) || (W[J].Imag != 0.0))
+                        CMPLX_MULT_SUBT_ASSIGN(V[J], W[J], *pElement);
+            }
+        }
+
+        /* Backward Substitution. */
+        for (I = Size; I > 0; I--)
+        {
+            W = Work + I * NumRHS;
+            pPivot = Matrix->Diag[I];
+            for (pElement = pPivot->NextInCol; pElement != NULL;
+                 pElement = pElement->NextInCol)
+            {
+                V = Work + pElement->Row * NumRHS;
+                for (J = 0; J < NumRHS; J++)
+                    CMPLX_MULT_SUBT_ASSIGN(W[J], V[J], *pElement);
+            }
+            for (J = 0; J < NumRHS; J++)
+            {
+                /* Cmplx expr: Intermediate = Temp * (1.0 / *pPivot). */
+                Temp = W[J];
+                CMPLX_MULT(W[J], Temp, *pPivot);
+            }
+        }
+    }
+#endif /* TRANSPOSE */
+
+    for (I = Size; I > 0; I--)
+        for (J = 0; J < NumRHS; J++)
+        {
+            RHS[J][OutMap[I]] = Work[I * NumRHS + J].Real;
+            iRHS[J][OutMap[I]] = Work[I * NumRHS + J].Imag;
+        }
+}
+
+
+
+
+
+
+
+
+
 
 #if TRANSPOSE
 /*
@@ -0,0 +1,355 @@
+/*
+ * Fast conversion of doubles to text, used by the rawfile writer.
+ *
+ * dtoa_shortest() prints the shortest digit string that reads back
+ * into exactly the same double, in the exponential format "-d.ddde-XX".
+ * The digits are generated with the Grisu2 algorithm of F. Loitsch,
+ * "Printing Floating-Point Numbers Quickly and Accurately with Integers",
+ * PLDI 2010, which needs only 64 bit integer arithmetic.  Grisu2 always
+ * produces a string which round trips, in rare cases it is one digit
+ * longer than the shortest possible one.
+ */
+
+#include "ngspice/ngspice.h"
+#include <stdint.h>
+#include "dtoa.h"
+
+
+typedef struct {
+    uint64_t f;
+    int e;
+} diy_fp;
+
+
+#define DP_SIGNIFICAND_SIZE  52
+#define DP_EXPONENT_BIAS     (0x3FF + DP_SIGNIFICAND_SIZE)
+#define DP_HIDDEN_BIT        0x0010000000000000ULL
+#define DP_SIGNIFICAND_MASK  0x000FFFFFFFFFFFFFULL
+#define DP_EXPONENT_MASK     0x7FF0000000000000ULL
+
+
+/* Normalized 64 bit significands and binary exponents of 10^k,
+ * k = -348, -340, ..., 340 */
+
+static const uint64_t cached_f[] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+    0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+    0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+    0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+    0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+    0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+    0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+    0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+    0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+    0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+    0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+    0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+    0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+    0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+    0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+    0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+    0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+    0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+    0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+    0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+    0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+    0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+
+static const int cached_e[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066
+};
+
+static const uint32_t pow10_32[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+
+static diy_fp
+fp_multiply(diy_fp x, diy_fp y)
+{
+    const uint64_t M32 = 0xFFFFFFFFULL;
+    uint64_t a = x.f >> 32, b = x.f & M32;
+    uint64_t c = y.f >> 32, d = y.f & M32;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+    diy_fp r;
+
+    tmp += 1ULL << 31;          /* round */
+    r.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+    r.e = x.e + y.e + 64;
+    return r;
+}
+
+
+static diy_fp
+fp_normalize(diy_fp x)
+{
+    while (!(x.f & 0x8000000000000000ULL)) {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+
+/* boundaries m- and m+ of the rounding interval of v, both with the
+ * exponent of the normalized m+ */
+
+static void
+fp_boundaries(diy_fp v, diy_fp *mm, diy_fp *mp)
+{
+    diy_fp pl, mi;
+
+    pl.f = (v.f << 1) + 1;
+    pl.e = v.e - 1;
+    while (!(pl.f & (DP_HIDDEN_BIT << 1))) {
+        pl.f <<= 1;
+        pl.e--;
+    }
+    pl.f <<= 64 - DP_SIGNIFICAND_SIZE - 2;
+    pl.e -= 64 - DP_SIGNIFICAND_SIZE - 2;
+
+    if (v.f == DP_HIDDEN_BIT) {
+        mi.f = (v.f << 2) - 1;
+        mi.e = v.e - 2;
+    } else {
+        mi.f = (v.f << 1) - 1;
+        mi.e = v.e - 1;
+    }
+    mi.f <<= mi.e - pl.e;
+    mi.e = pl.e;
+
+    *mm = mi;
+    *mp = pl;
+}
+
+
+/* cached power 10^-K which brings a number with binary exponent e
+ * into the range needed by digit_gen */
+
+static diy_fp
+cached_power(int e, int *K)
+{
+    double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int k = (int) dk;
+    int index;
+    diy_fp r;
+
+    if (dk - k > 0.0)
+        k++;
+
+    index = (k >> 3) + 1;
+    *K = -(-348 + index * 8);
+
+    r.f = cached_f[index];
+    r.e = cached_e[index];
+    return r;
+}
+
+
+static int
+count_digits(uint32_t n)
+{
+    int i;
+    for (i = 1; i < 10; i++)
+        if (n < pow10_32[i])
+            return i;
+    return 10;
+}
+
+
+static void
+grisu_round(char *buf, int len, uint64_t delta, uint64_t rest,
+            uint64_t ten_kappa, uint64_t wp_w)
+{
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w ||
+            wp_w - rest > rest + ten_kappa - wp_w)) {
+        buf[len - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+
+static int
+digit_gen(diy_fp W, diy_fp Mp, uint64_t delta, char *buf, int *K)
+{
+    diy_fp one;
+    uint64_t wp_w = Mp.f - W.f;
+    uint32_t p1;
+    uint64_t p2;
+    int kappa, len = 0;
+
+    one.f = 1ULL << -Mp.e;
+    one.e = Mp.e;
+
+    p1 = (uint32_t) (Mp.f >> -one.e);
+    p2 = Mp.f & (one.f - 1);
+    kappa = count_digits(p1);
+
+    while (kappa > 0) {
+        uint32_t d = p1 / pow10_32[kappa - 1];
+        uint64_t tmp;
+
+        p1 %= pow10_32[kappa - 1];
+        if (d || len)
+            buf[len++] = (char) ('0' + d);
+        kappa--;
+        tmp = ((uint64_t) p1 << -one.e) + p2;
+        if (tmp <= delta) {
+            *K += kappa;
+            grisu_round(buf, len, delta, tmp,
+                        (uint64_t) pow10_32[kappa] << -one.e, wp_w);
+            return len;
+        }
+    }
+
+    for (;;) {
+        char d;
+
+        p2 *= 10;
+        delta *= 10;
+        d = (char) (p2 >> -one.e);
+        if (d || len)
+            buf[len++] = (char) ('0' + d);
+        p2 &= one.f - 1;
+        kappa--;
+        if (p2 < delta) {
+            *K += kappa;
+            grisu_round(buf, len, delta, p2, one.f,
+                        -kappa < 10 ? wp_w * pow10_32[-kappa] : 0);
+            return len;
+        }
+    }
+}
+
+
+/* Digits of a positive, finite v into buf, returns their number,
+ * v = digits * 10^K */
+
+static int
+grisu2(double v, char *buf, int *K)
+{
+    union {
+        double d;
+        uint64_t u;
+    } bits;
+    diy_fp w, w_m, w_p, c_mk, W, Wp, Wm;
+    int biased_e;
+
+    bits.d = v;
+    biased_e = (int) ((bits.u & DP_EXPONENT_MASK) >> DP_SIGNIFICAND_SIZE);
+    w.f = bits.u & DP_SIGNIFICAND_MASK;
+    if (biased_e != 0) {
+        w.f += DP_HIDDEN_BIT;
+        w.e = biased_e - DP_EXPONENT_BIAS;
+    } else {
+        w.e = 1 - DP_EXPONENT_BIAS;
+    }
+
+    fp_boundaries(w, &w_m, &w_p);
+    c_mk = cached_power(w_p.e, K);
+    W = fp_multiply(fp_normalize(w), c_mk);
+    Wp = fp_multiply(w_p, c_mk);
+    Wm = fp_multiply(w_m, c_mk);
+    Wm.f++;
+    Wp.f--;
+
+    return digit_gen(W, Wp, Wp.f - Wm.f, buf, K);
+}
+
+
+/* Print num into buf, returns the length of the string. */
+
+int
+dtoa_shortest(char *buf, double num)
+{
+    char digits[20];
+    char *p = buf;
+    int len, K, exp, i;
+
+    if (num != num || num - num != 0.0)   /* NaN or Inf */
+        return sprintf(buf, "%e", num);
+
+    if (signbit(num)) {
+        *p++ = '-';
+        num = -num;
+    }
+
+    if (num == 0.0) {
+        strcpy(p, "0e+00");
+        return (int) (p - buf) + 5;
+    }
+
+    len = grisu2(num, digits, &K);
+    exp = K + len - 1;
+
+    *p++ = digits[0];
+    if (len > 1) {
+        *p++ = '.';
+        for (i = 1; i < len; i++)
+            *p++ = digits[i];
+    }
+
+    *p++ = 'e';
+    if (exp < 0) {
+        *p++ = '-';
+        exp = -exp;
+    } else {
+        *p++ = '+';
+    }
+    if (exp >= 100) {
+        *p++ = (char) ('0' + exp / 100);
+        exp %= 100;
+    }
+    *p++ = (char) ('0' + exp / 10);
+    *p++ = (char) ('0' + exp % 10);
+    *p = '\0';
+
+    return (int) (p - buf);
+}
+
+
+/* Print a decimal integer into buf, returns the length of the string. */
+
+int
+itoa_decimal(char *buf, long num)
+{
+    char tmp[24];
+    unsigned long u;
+    int n = 0, len = 0;
+
+    if (num < 0) {
+        buf[len++] = '-';
+        u = 0UL - (unsigned long) num;
+    } else {
+        u = (unsigned long) num;
+    }
+
+    do {
+        tmp[n++] = (char) ('0' + u % 10);
+        u /= 10;
+    } while (u);
+
+    while (n)
+        buf[len++] = tmp[--n];
+    buf[len] = '\0';
+
+    return len;
+}
@@ -0,0 +1,14 @@
+/*************
+ * Header file for dtoa.c
+ ************/
+
+#ifndef ngspice_DTOA_H
+#define ngspice_DTOA_H
+
+/* Large enough for any number written by dtoa_shortest and the '\0' */
+#define DTOA_BUFSIZE 32
+
+int dtoa_shortest(char *buf, double num);
+int itoa_decimal(char *buf, long num);
+
+#endif
@@ -0,0 +1,254 @@
+/*
+ * Read only memory mapping of whole files
+ *
+ * mapfile_open() returns NULL if the file can't be mapped (no mmap on
+ * this system, empty file, file larger than the address space, ...),
+ * the caller is expected to fall back to plain stdio then.
+ * The returned mapping carries one reference, mapfile_close() drops a
+ * reference and unmaps the file when the last one is gone.
+ * mapfile_fmap() maps the file behind an open stream instead.
+ * A mapped file which is truncated makes an access to the lost pages
+ * raise SIGBUS.  Users keeping a mapping for long ask mapfile_changed()
+ * before they read from it.
+ */
+
+#if defined(__MINGW32__) || defined(_MSC_VER)
+#include <windows.h>
+#include <io.h>
+#endif
+
+#include "ngspice/ngspice.h"
+#include "mapfile.h"
+
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_MMAP)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define MAPFILE_MMAP
+#elif defined(__MINGW32__) || defined(_MSC_VER)
+#define MAPFILE_WIN
+#endif
+
+
+#if defined(MAPFILE_MMAP)
+
+/* the mapping takes over fd */
+static struct mapfile *
+map_fd(int fd)
+{
+    struct mapfile *m;
+    struct stat st;
+    void *p;
+
+    if (fstat(fd, &st) < 0 || st.st_size <= 0 ||
+        (unsigned long long) st.st_size > (size_t) -1) {
+        close(fd);
+        return NULL;
+    }
+
+    p = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+
+    m = TMALLOC(struct mapfile, 1);
+    m->data = (char *) p;
+    m->size = (size_t) st.st_size;
+    m->refs = 1;
+    m->fd = fd;
+    m->mtime = st.st_mtime;
+    return m;
+}
+
+#elif defined(MAPFILE_WIN)
+
+/* the mapping closes file if own is set */
+static struct mapfile *
+map_handle(HANDLE file, int own)
+{
+    struct mapfile *m;
+    HANDLE map;
+    LARGE_INTEGER size;
+    void *p;
+
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0 ||
+        (unsigned long long) size.QuadPart > (size_t) -1)
+        return NULL;
+
+    map = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!map)
+        return NULL;
+
+    p = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+    if (!p) {
+        CloseHandle(map);
+        return NULL;
+    }
+
+    m = TMALLOC(struct mapfile, 1);
+    m->data = (char *) p;
+    m->size = (size_t) size.QuadPart;
+    m->refs = 1;
+    m->file = own ? file : NULL;
+    m->map = map;
+    return m;
+}
+
+#endif
+
+
+struct mapfile *
+mapfile_open(const char *name)
+{
+#if defined(MAPFILE_MMAP)
+
+    int fd;
+
+    if ((fd = open(name, O_RDONLY)) < 0)
+        return NULL;
+
+    return map_fd(fd);
+
+#elif defined(MAPFILE_WIN)
+
+    struct mapfile *m;
+    HANDLE file;
+
+    file = CreateFileA(name, GENERIC_READ, FILE_SHARE_READ, NULL,
+                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    m = map_handle(file, 1);
+    if (!m)
+        CloseHandle(file);
+    return m;
+
+#else
+
+    NG_IGNORE(name);
+    return NULL;
+
+#endif
+}
+
+
+/* map the whole file opened as fp, which stays open */
+struct mapfile *
+mapfile_fmap(FILE *fp)
+{
+#if defined(MAPFILE_MMAP)
+
+    int fd = dup(fileno(fp));
+
+    if (fd < 0)
+        return NULL;
+
+    return map_fd(fd);
+
+#elif defined(MAPFILE_WIN)
+
+    HANDLE file = (HANDLE) _get_osfhandle(_fileno(fp));
+
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    return map_handle(file, 0);
+
+#else
+
+    NG_IGNORE(fp);
+    return NULL;
+
+#endif
+}
+
+
+/* TRUE if the file has been written or truncated since it was mapped.
+   Under Windows it can't be, the mapping keeps it from being changed. */
+bool
+mapfile_changed(struct mapfile *m)
+{
+#if defined(MAPFILE_MMAP)
+
+    struct stat st;
+
+    if (fstat(m->fd, &st) < 0)
+        return TRUE;
+
+    return (unsigned long long) st.st_size != m->size || st.st_mtime != m->mtime;
+
+#else
+
+    NG_IGNORE(m);
+    return FALSE;
+
+#endif
+}
+
+
+/* TRUE if name is the file mapped by m */
+bool
+mapfile_is(struct mapfile *m, const char *name)
+{
+#if defined(MAPFILE_MMAP)
+
+    struct stat st, mst;
+
+    return stat(name, &st) == 0 && fstat(m->fd, &mst) == 0 &&
+        st.st_dev == mst.st_dev && st.st_ino == mst.st_ino;
+
+#elif defined(MAPFILE_WIN)
+
+    BY_HANDLE_FILE_INFORMATION fi, mfi;
+    HANDLE file;
+    bool same;
+
+    if (!m->file)
+        return FALSE;
+
+    file = CreateFileA(name, 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                       NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return FALSE;
+
+    same = GetFileInformationByHandle(file, &fi) &&
+        GetFileInformationByHandle((HANDLE) m->file, &mfi) &&
+        fi.dwVolumeSerialNumber == mfi.dwVolumeSerialNumber &&
+        fi.nFileIndexHigh == mfi.nFileIndexHigh &&
+        fi.nFileIndexLow == mfi.nFileIndexLow;
+
+    CloseHandle(file);
+    return same;
+
+#else
+
+    NG_IGNORE(m);
+    NG_IGNORE(name);
+    return FALSE;
+
+#endif
+}
+
+
+void
+mapfile_close(struct mapfile *m)
+{
+    if (!m || --m->refs > 0)
+        return;
+
+#if defined(MAPFILE_MMAP)
+    munmap(m->data, m->size);
+    close(m->fd);
+#elif defined(MAPFILE_WIN)
+    UnmapViewOfFile(m->data);
+    CloseHandle((HANDLE) m->map);
+    if (m->file)
+        CloseHandle((HANDLE) m->file);
+#endif
+
+    tfree(m);
+}
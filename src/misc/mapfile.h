@@ -0,0 +1,26 @@
+/*************
+ * Header file for mapfile.c
+ ************/
+
+#ifndef ngspice_MAPFILE_H
+#define ngspice_MAPFILE_H
+
+struct mapfile {
+    char *data;         /* start of the mapped file */
+    size_t size;        /* its length in bytes */
+    int refs;           /* users of the mapping */
+#if defined(__MINGW32__) || defined(_MSC_VER)
+    void *file, *map;   /* HANDLEs */
+#else
+    int fd;             /* kept open, for mapfile_changed() */
+    time_t mtime;       /* modification time when mapped */
+#endif
+};
+
+struct mapfile *mapfile_open(const char *name);
+struct mapfile *mapfile_fmap(FILE *fp);
+bool mapfile_changed(struct mapfile *m);
+bool mapfile_is(struct mapfile *m, const char *name);
+void mapfile_close(struct mapfile *m);
+
+#endif
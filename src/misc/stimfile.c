@@ -0,0 +1,127 @@
+/*
+ * Binary stimulus files, see ngspice/stimfile.h for the format
+ *
+ * stim_open() reads the header from the start of an open stream and
+ * maps the table, or reads it into memory where mapping is not
+ * possible.  It returns NULL without an error message if the stream is
+ * not a stimulus file at all, the caller may then rewind the stream
+ * and read it as text.
+ * This file is linked into the code models as well, so it must not use
+ * anything beyond the memory allocation of the simulator.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/stimfile.h"
+#include "mapfile.h"
+
+
+#define STIM_ORDER  0x01020304UL
+
+
+static unsigned long
+get_u32(const unsigned char *p)
+{
+    unsigned int v;
+
+    memcpy(&v, p, 4);
+    return v;
+}
+
+
+STIMfile *
+stim_open(FILE *fp, const char **errmsg)
+{
+    unsigned char head[STIM_HEADER];
+    unsigned long long rows;
+    size_t n, need;
+    int columns;
+    STIMfile *stim;
+
+    *errmsg = NULL;
+
+    if (fread(head, 1, STIM_HEADER, fp) != STIM_HEADER ||
+        memcmp(head, STIM_MAGIC, 8) != 0)
+        return NULL;
+
+    if (get_u32(head + 12) != STIM_ORDER) {
+        *errmsg = "stimulus file written with another byte order";
+        return NULL;
+    }
+    if (get_u32(head + 8) != STIM_VERSION) {
+        *errmsg = "unknown stimulus file version";
+        return NULL;
+    }
+
+    columns = (int) get_u32(head + 16);
+    memcpy(&rows, head + 24, 8);
+    if (columns < 2 || columns > 65536 || rows == 0 ||
+        rows > ((size_t) -1 - STIM_HEADER) / sizeof(double) / (size_t) columns) {
+        *errmsg = "bad stimulus file header";
+        return NULL;
+    }
+
+    n = (size_t) rows * (size_t) columns;
+    need = STIM_HEADER + n * sizeof(double);
+
+    stim = TMALLOC(STIMfile, 1);
+    stim->columns = columns;
+    stim->rows = (size_t) rows;
+
+    stim->map = mapfile_fmap(fp);
+    if (stim->map) {
+        if (stim->map->size < need) {
+            mapfile_close(stim->map);
+            tfree(stim);
+            *errmsg = "stimulus file is truncated";
+            return NULL;
+        }
+        stim->data = (const double *) (stim->map->data + STIM_HEADER);
+        return stim;
+    }
+
+    /* no mapping, read the table */
+    stim->buf = TMALLOC(double, n);
+    if (!stim->buf || fread(stim->buf, sizeof(double), n, fp) != n) {
+        tfree(stim->buf);
+        tfree(stim);
+        *errmsg = "stimulus file is truncated";
+        return NULL;
+    }
+    stim->data = stim->buf;
+    return stim;
+}
+
+
+void
+stim_close(STIMfile *stim)
+{
+    if (!stim)
+        return;
+
+    if (stim->map)
+        mapfile_close(stim->map);
+    tfree(stim->buf);
+    tfree(stim);
+}
+
+
+/* write the header of a table of rows * columns doubles, which follow */
+int
+stim_write_header(FILE *fp, int columns, size_t rows)
+{
+    unsigned char head[STIM_HEADER];
+    unsigned int v;
+    unsigned long long r = rows;
+
+    memset(head, 0, sizeof(head));
+    memcpy(head, STIM_MAGIC, 8);
+    v = STIM_VERSION;
+    memcpy(head + 8, &v, 4);
+    v = (unsigned int) STIM_ORDER;
+    memcpy(head + 12, &v, 4);
+    v = (unsigned int) columns;
+    memcpy(head + 16, &v, 4);
+    memcpy(head + 24, &r, 8);
+
+    return fwrite(head, 1, STIM_HEADER, fp) == STIM_HEADER ? 0 : -1;
+}
@@ -72,3 +72,13 @@ NDEVacct(CKTcircuit *ckt, FILE *file)
 }
 
 #endif
+
+
+/* nutmeg does not simulate, there is no rawfile output to finish */
+
+void OUTrawClose(void);
+
+void
+OUTrawClose(void)
+{
+}
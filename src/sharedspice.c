@@ -26,6 +26,11 @@
 /*              Header files for C functions                          */
 /**********************************************************************/
 
+/* dladdr() for ngSpice_nInit() */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <stdio.h>
 #include <setjmp.h>
 
@@ -116,6 +121,9 @@ typedef pthread_t threadId_t;
 #define close _close
 #else
 #include <unistd.h> /* usleep */
+#ifdef HAVE_DLFCN_H
+#include <dlfcn.h> /* dlopen, dladdr */
+#endif
 #endif /* __MINGW32__ */
 
 #include "ngspice/iferrmsg.h"
@@ -184,6 +192,7 @@ int sh_fputsll(const char *input, FILE* outf);
 int sh_ExecutePerLoop(void);
 double getvsrcval(double, char*);
 int sh_vecinit(runDesc *run);
+void sh_stream_end(void);
 
 void shared_exit(int status);
 
@@ -194,6 +203,8 @@ void wl_delete_first(wordlist **wlstart, wordlist **wlend);
 int add_bkpt(void);
 int sharedsync(double*, double*, double, double, double, int, int*, int);
 
+static void stream_free(void);
+
 #if !defined(low_latency)
 static char* outstorage(char*, bool);
 static void printsend(void);
@@ -201,6 +212,10 @@ static void printsend(void);
 
 #include "ngspice/sharedspice.h"
 
+/* used by the primary image on the private copy of an instance only */
+IMPEXP int ngSpice_Inst_Init(void);
+IMPEXP int ngSpice_Inst_Release(void);
+
 static SendChar* pfcn;
 static void* userptr;
 static SendStat* statfcn;
@@ -224,9 +239,25 @@ static bool wantidat = FALSE;
 static bool wantsync = FALSE;
 static bool immediate = FALSE;
 static bool coquit = FALSE;
+static bool instimage = FALSE;   /* private copy of an instance */
+static bool instrelease = FALSE; /* instance is being released */
 static jmp_buf errbufm, errbufc;
 static int intermj = 1;
 
+/* block data streaming, see ngSpice_Init_Stream() */
+static SendDataBlock* blockfcn = NULL;
+static char **streamnames = NULL;       /* selected vectors, NULL for all */
+static int streamsize = 0;              /* points per block */
+static int streambufs = 0;              /* blocks in the ring, 0 for none */
+static struct dvec **streamvecs = NULL; /* selected vectors of current plot */
+static int streamcount = 0;             /* number of selected vectors */
+static vecblock *streamblocks = NULL;   /* ring slots, or the single block */
+static double *streamring = NULL;       /* data storage of the ring */
+static int streamfirst = 0;             /* plot index of first point in block */
+static int streamfill = 0;              /* points in the current block */
+static int streamsent = 0;              /* blocks sent for the current plot */
+static int streamacked = 0;             /* blocks released by the caller */
+
 
 // thread IDs
 unsigned int main_id, ng_id, command_id;
@@ -235,6 +266,7 @@ unsigned int main_id, ng_id, command_id;
 mutexType triggerMutex;
 mutexType allocMutex;
 mutexType fputsMutex;
+static mutexType streamMutex;
 #endif
 
 /* initialization status */
@@ -360,6 +392,15 @@ sighandler_sharedspice(int num)
 #endif /*THREADS*/
 
 
+/* Set the Ctrl-C handler of the process. Instances, which may run
+   concurrently, leave it to the primary image. */
+static sighandler
+sigint_set(sighandler handler)
+{
+    return instimage ? SIG_DFL : signal(SIGINT, handler);
+}
+
+
 /* run a ngspice command */
 static int
 runc(char* command)
@@ -410,10 +451,10 @@ runc(char* command)
 
     /* Catch Ctrl-C to break simulations */
 #if 1 //!defined(_MSC_VER) /*&& !defined(__MINGW32__) */
-    oldHandler = signal(SIGINT, (SIGNAL_FUNCTION) ft_sigintr);
+    oldHandler = sigint_set((SIGNAL_FUNCTION) ft_sigintr);
     if (SETJMP(jbuf, 1) != 0) {
         ft_sigintr_cleanup();
-        signal(SIGINT, oldHandler);
+        sigint_set(oldHandler);
         return 0;
     }
 #else
@@ -441,7 +482,7 @@ runc(char* command)
     } else
         /* bg_halt (pause) a bg run */
         if (!strcmp(buf, "bg_halt")) {
-            signal(SIGINT, oldHandler);
+            sigint_set(oldHandler);
             return _thread_stop();
         } else
             /* cannot do anything if ngspice is running in the bg*/
@@ -459,7 +500,7 @@ runc(char* command)
 #else
     cp_evloop(buf);
 #endif /*THREADS*/
-    signal(SIGINT, oldHandler);
+    sigint_set(oldHandler);
     return 0;
 }
 
@@ -511,6 +552,59 @@ ngSpice_Init_Sync(GetVSRCData *vsrcdat, GetISRCData *isrcdat, GetSyncData *syncd
 }
 
 
+/* Initialise block data streaming */
+IMPEXP
+int
+ngSpice_Init_Stream(SendDataBlock* blockfcnin, char** vecnames, int blocksize, int nbufs)
+{
+    int i, n = 0;
+
+    if (blockfcnin && (blocksize < 1 || nbufs < 0)) {
+        fprintf(stderr, "Error: ngSpice_Init_Stream: invalid block size or number of blocks\n");
+        return 1;
+    }
+
+    if (streamnames) {
+        for (i = 0; streamnames[i]; i++)
+            tfree(streamnames[i]);
+        tfree(streamnames);
+    }
+    if (vecnames) {
+        while (vecnames[n])
+            n++;
+        streamnames = TMALLOC(char*, n + 1);
+        for (i = 0; i < n; i++)
+            streamnames[i] = copy(vecnames[i]);
+        streamnames[n] = NULL;
+    }
+
+    blockfcn = blockfcnin;
+    streamsize = blocksize;
+    streambufs = nbufs;
+    return 0;
+}
+
+
+/* Release the oldest block of the ring held by the caller */
+IMPEXP
+int
+ngSpice_Stream_Ack(void)
+{
+    int err = 0;
+#ifdef THREADS
+    mutex_lock(&streamMutex);
+#endif
+    if (streamacked < streamsent)
+        streamacked++;
+    else
+        err = 1;
+#ifdef THREADS
+    mutex_unlock(&streamMutex);
+#endif
+    return err;
+}
+
+
 /* Initialise ngspice and setup native methods */
 IMPEXP
 int
@@ -548,20 +642,23 @@ ngSpice_Init(SendChar* printfcn, SendStat* statusfcn, ControlledExit* ngspiceexi
     pthread_mutex_init(&triggerMutex, NULL);
     pthread_mutex_init(&allocMutex, NULL);
     pthread_mutex_init(&fputsMutex, NULL);
+    pthread_mutex_init(&streamMutex, NULL);
 #else
 #ifdef SRW
     InitializeSRWLock(&triggerMutex);
     InitializeSRWLock(&allocMutex);
     InitializeSRWLock(&fputsMutex);
+    InitializeSRWLock(&streamMutex);
 #else
     InitializeCriticalSection(&triggerMutex);
     InitializeCriticalSection(&allocMutex);
     InitializeCriticalSection(&fputsMutex);
+    InitializeCriticalSection(&streamMutex);
 #endif
 #endif
     // Id of primary thread
     main_id =  threadid_self();
-    signal(SIGINT, sighandler_sharedspice);
+    sigint_set(sighandler_sharedspice);
 #endif
 
     ft_rawfile = NULL;
@@ -594,7 +691,7 @@ ngSpice_Init(SendChar* printfcn, SendStat* statusfcn, ControlledExit* ngspiceexi
 
     /* Read the user config files */
     /* To catch interrupts during .spiceinit... */
-    old_sigint = signal(SIGINT, (SIGNAL_FUNCTION) ft_sigintr);
+    old_sigint = sigint_set((SIGNAL_FUNCTION) ft_sigintr);
     if (SETJMP(jbuf, 1) == 1) {
         ft_sigintr_cleanup();
         fprintf(cp_err, "Warning: error executing .spiceinit.\n");
@@ -626,7 +723,7 @@ ngSpice_Init(SendChar* printfcn, SendStat* statusfcn, ControlledExit* ngspiceexi
     }
 #endif /* ~ HAVE_PWD_H */
 bot:
-    signal(SIGINT, old_sigint);
+    sigint_set(old_sigint);
 
     /* initilise display to 'no display at all'*/
     DevInit();
@@ -711,6 +808,52 @@ int  ngSpice_Command(char* comexec)
     return 1;
 };
 
+
+/* Called by ngSpice_nInit() before ngSpice_Init() of the private copy:
+   instances share the signal handlers of the process and do not set
+   them. */
+IMPEXP
+int ngSpice_Inst_Init(void)
+{
+    instimage = TRUE;
+    return 0;
+}
+
+
+/* Called by ngSpice_nDestroy() before the private copy is unloaded:
+   stop and join the background thread, then free circuits, plots,
+   variables and devices as command 'quit' does, they are allocated
+   from the heap of the process. Returns 1 if the thread does not stop. */
+IMPEXP
+int ngSpice_Inst_Release(void)
+{
+#ifdef THREADS
+    if (fl_running && _thread_stop() != EXIT_NORMAL)
+        return 1;
+#endif
+    if (!is_initialized)
+        return 0;
+    /* not via ngSpice_Command(), calls to exported functions would end
+       up in the primary image */
+    instrelease = TRUE;
+    if (!setjmp(errbufc)) {
+        intermj = 1;
+        runc("quit noask");
+    }
+    is_initialized = FALSE;
+    stream_free();
+    if (streamnames) {
+        int i;
+        for (i = 0; streamnames[i]; i++)
+            tfree(streamnames[i]);
+        tfree(streamnames);
+    }
+    tfree(myvec);
+    tfree(allvecs);
+    tfree(allplots);
+    return 0;
+}
+
 /* Return information about a vector to the caller */
 IMPEXP
 pvector_info  ngGet_Vec_Info(char* vecname)
@@ -898,6 +1041,395 @@ add_bkpt(void)
 }
 
 
+/*------------------------------------------------------*/
+/* Independent instances, each one running in a private */
+/* copy of the shared library                           */
+/*------------------------------------------------------*/
+
+#if defined(__MINGW32__) || defined(_MSC_VER)
+#define NGINST_WIN
+typedef HMODULE libHandle_t;
+#elif defined(HAVE_DLFCN_H)
+#define NGINST_DL
+typedef void *libHandle_t;
+#endif
+
+struct ngSpice_instance {
+    int ident;                  /* handed to the callbacks */
+    libHandle_t handle;         /* the private copy of ngspice.dll */
+#ifdef NGINST_WIN
+    char libpath[MAX_PATH];     /* removed when the copy is released */
+#endif
+#ifdef NGINST_DL
+    struct sigaction old_sigint; /* restored before the copy is released */
+#endif
+    int (*inst_init)(void);
+    int (*release)(void);
+    int (*init)(SendChar*, SendStat*, ControlledExit*, SendData*,
+                SendInitData*, BGThreadRunning*, void*);
+    int (*init_sync)(GetVSRCData*, GetISRCData*, GetSyncData*, int*, void*);
+    int (*init_stream)(SendDataBlock*, char**, int, int);
+    int (*stream_ack)(void);
+    int (*command)(char*);
+    pvector_info (*vec_info)(char*);
+    int (*circ)(char**);
+    char* (*curplot)(void);
+    char** (*allplots)(void);
+    char** (*allvecs)(char*);
+    bool (*running)(void);
+    bool (*setbkpt)(double);
+};
+
+#if defined(NGINST_WIN) || defined(NGINST_DL)
+
+/* identification numbers of the instances, 0 is the primary image */
+static int
+inst_next_ident(void)
+{
+#ifdef NGINST_WIN
+    static volatile LONG count = 0;
+    return (int) InterlockedIncrement(&count);
+#elif defined(HAVE_LIBPTHREAD)
+    static pthread_mutex_t countMutex = PTHREAD_MUTEX_INITIALIZER;
+    static int count = 0;
+    int ident;
+    pthread_mutex_lock(&countMutex);
+    ident = ++count;
+    pthread_mutex_unlock(&countMutex);
+    return ident;
+#else
+    static int count = 0;
+    return ++count;
+#endif
+}
+
+
+static void *
+inst_sym(ngSpiceInst *inst, const char *name)
+{
+#ifdef NGINST_WIN
+    return (void *) GetProcAddress(inst->handle, name);
+#else
+    return dlsym(inst->handle, name);
+#endif
+}
+
+
+static void
+inst_unload(ngSpiceInst *inst)
+{
+#ifdef NGINST_WIN
+    FreeLibrary(inst->handle);
+    DeleteFile(inst->libpath);
+#else
+    dlclose(inst->handle);
+#endif
+}
+
+
+#ifdef NGINST_DL
+/* copy file 'from' to the open file descriptor 'fd' */
+static int
+inst_copy_file(const char *from, int fd)
+{
+    char buf[65536];
+    ssize_t n;
+    int in = open(from, O_RDONLY);
+
+    if (in < 0)
+        return 1;
+    while ((n = read(in, buf, sizeof(buf))) > 0)
+        if (write(fd, buf, (size_t) n) != n) {
+            n = -1;
+            break;
+        }
+    close(in);
+    return n < 0;
+}
+#endif
+
+
+/* Load a private copy of this very library. Loading the library file
+   itself again would only return the image already loaded, so the file
+   is copied to a new name in the directory for temporary files. */
+static int
+inst_load(ngSpiceInst *inst)
+{
+#ifdef NGINST_WIN
+    HMODULE self;
+    char from[MAX_PATH], dir[MAX_PATH];
+    char *to = inst->libpath;
+
+    if (!GetModuleHandleEx(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                           GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                           (LPCSTR) &inst_load, &self) ||
+        !GetModuleFileName(self, from, MAX_PATH) ||
+        !GetTempPath(MAX_PATH, dir) ||
+        !GetTempFileName(dir, "ngs", 0, to))
+        return 1;
+    if (!CopyFile(from, to, FALSE)) {
+        DeleteFile(to);
+        return 1;
+    }
+    inst->handle = LoadLibrary(to);
+    if (!inst->handle) {
+        DeleteFile(to);
+        return 1;
+    }
+#else
+    Dl_info info;
+    const char *tmpdir = getenv("TMPDIR");
+    char *to;
+    size_t len;
+    int fd, err;
+
+    if (!dladdr((void *) &inst_load, &info) || !info.dli_fname)
+        return 1;
+    if (!tmpdir || !*tmpdir)
+        tmpdir = "/tmp";
+    len = strlen(tmpdir) + sizeof("/ngspiceXXXXXX");
+    to = malloc(len);
+    if (!to)
+        return 1;
+    snprintf(to, len, "%s/ngspiceXXXXXX", tmpdir);
+    fd = mkstemp(to);
+    if (fd < 0) {
+        free(to);
+        return 1;
+    }
+    err = inst_copy_file(info.dli_fname, fd);
+    close(fd);
+    /* local scope: the copy does not resolve its symbols to this image */
+    if (!err)
+        inst->handle = dlopen(to, RTLD_NOW | RTLD_LOCAL);
+    /* the mapping stays valid, so nothing is left behind */
+    unlink(to);
+    free(to);
+    if (!inst->handle)
+        return 1;
+#endif
+    return 0;
+}
+
+#endif /* NGINST_WIN || NGINST_DL */
+
+
+/* Create a new instance of ngspice in a private copy of the library.
+   The primary image need not be initialized, so its memory allocation
+   and printing functions are not used here. */
+IMPEXP
+ngSpiceInst*
+ngSpice_nInit(SendChar* printfcn, SendStat* statusfcn, ControlledExit* ngspiceexit,
+              SendData* sdata, SendInitData* sinitdata, BGThreadRunning* bgtrun, void* userData)
+{
+#if defined(NGINST_WIN) || defined(NGINST_DL)
+    ngSpiceInst *inst = calloc(1, sizeof(ngSpiceInst));
+
+    if (!inst)
+        return NULL;
+    if (inst_load(inst)) {
+        myputs("Error: cannot load a new copy of the ngspice shared library\n", stderr);
+        free(inst);
+        return NULL;
+    }
+
+    inst->init = (int (*)(SendChar*, SendStat*, ControlledExit*, SendData*,
+                          SendInitData*, BGThreadRunning*, void*))
+        inst_sym(inst, "ngSpice_Init");
+    inst->init_sync = (int (*)(GetVSRCData*, GetISRCData*, GetSyncData*, int*, void*))
+        inst_sym(inst, "ngSpice_Init_Sync");
+    inst->init_stream = (int (*)(SendDataBlock*, char**, int, int))
+        inst_sym(inst, "ngSpice_Init_Stream");
+    inst->stream_ack = (int (*)(void)) inst_sym(inst, "ngSpice_Stream_Ack");
+    inst->command = (int (*)(char*)) inst_sym(inst, "ngSpice_Command");
+    inst->vec_info = (pvector_info (*)(char*)) inst_sym(inst, "ngGet_Vec_Info");
+    inst->circ = (int (*)(char**)) inst_sym(inst, "ngSpice_Circ");
+    inst->curplot = (char* (*)(void)) inst_sym(inst, "ngSpice_CurPlot");
+    inst->allplots = (char** (*)(void)) inst_sym(inst, "ngSpice_AllPlots");
+    inst->allvecs = (char** (*)(char*)) inst_sym(inst, "ngSpice_AllVecs");
+    inst->running = (bool (*)(void)) inst_sym(inst, "ngSpice_running");
+    inst->setbkpt = (bool (*)(double)) inst_sym(inst, "ngSpice_SetBkpt");
+    inst->inst_init = (int (*)(void)) inst_sym(inst, "ngSpice_Inst_Init");
+    inst->release = (int (*)(void)) inst_sym(inst, "ngSpice_Inst_Release");
+
+    if (!inst->init || !inst->init_sync || !inst->init_stream || !inst->stream_ack ||
+        !inst->command || !inst->vec_info ||
+        !inst->circ || !inst->curplot || !inst->allplots || !inst->allvecs ||
+        !inst->setbkpt || !inst->inst_init || !inst->release) {
+        myputs("Error: incomplete copy of the ngspice shared library\n", stderr);
+        inst_unload(inst);
+        free(inst);
+        return NULL;
+    }
+
+    /* the identification number has to be known before the first callback */
+    inst->ident = inst_next_ident();
+    inst->init_sync(NULL, NULL, NULL, &inst->ident, NULL);
+#ifdef NGINST_DL
+    sigaction(SIGINT, NULL, &inst->old_sigint);
+#endif
+    inst->inst_init();
+    inst->init(printfcn, statusfcn, ngspiceexit, sdata, sinitdata, bgtrun, userData);
+
+    return inst;
+#else
+    NG_IGNORE(printfcn);
+    NG_IGNORE(statusfcn);
+    NG_IGNORE(ngspiceexit);
+    NG_IGNORE(sdata);
+    NG_IGNORE(sinitdata);
+    NG_IGNORE(bgtrun);
+    NG_IGNORE(userData);
+    myputs("Error: ngspice instances are not available on this system\n", stderr);
+    return NULL;
+#endif
+}
+
+
+IMPEXP
+int
+ngSpice_nInit_Sync(ngSpiceInst* inst, GetVSRCData *vsrcdat, GetISRCData *isrcdat,
+                   GetSyncData *syncdat, void *userData)
+{
+    return inst->init_sync(vsrcdat, isrcdat, syncdat, &inst->ident, userData);
+}
+
+
+IMPEXP
+int
+ngSpice_nInit_Stream(ngSpiceInst* inst, SendDataBlock* blockfcnin, char** vecnames,
+                     int blocksize, int nbufs)
+{
+    return inst->init_stream(blockfcnin, vecnames, blocksize, nbufs);
+}
+
+
+IMPEXP
+int
+ngSpice_nStream_Ack(ngSpiceInst* inst)
+{
+    return inst->stream_ack();
+}
+
+
+IMPEXP
+int
+ngSpice_nIdent(ngSpiceInst* inst)
+{
+    return inst->ident;
+}
+
+
+IMPEXP
+int
+ngSpice_nCommand(ngSpiceInst* inst, char* command)
+{
+    return inst->command(command);
+}
+
+
+IMPEXP
+pvector_info
+ngGet_nVec_Info(ngSpiceInst* inst, char* vecname)
+{
+    return inst->vec_info(vecname);
+}
+
+
+IMPEXP
+int
+ngSpice_nCirc(ngSpiceInst* inst, char** circarray)
+{
+    return inst->circ(circarray);
+}
+
+
+IMPEXP
+char*
+ngSpice_nCurPlot(ngSpiceInst* inst)
+{
+    return inst->curplot();
+}
+
+
+IMPEXP
+char**
+ngSpice_nAllPlots(ngSpiceInst* inst)
+{
+    return inst->allplots();
+}
+
+
+IMPEXP
+char**
+ngSpice_nAllVecs(ngSpiceInst* inst, char* plotname)
+{
+    return inst->allvecs(plotname);
+}
+
+
+IMPEXP
+bool
+ngSpice_nrunning(ngSpiceInst* inst)
+{
+    /* the copy has no background thread without THREADS */
+    return inst->running ? inst->running() : FALSE;
+}
+
+
+IMPEXP
+bool
+ngSpice_nSetBkpt(ngSpiceInst* inst, double time)
+{
+    return inst->setbkpt(time);
+}
+
+
+#ifdef NGINST_DL
+/* The instance does not set a Ctrl-C handler, but commands like 'shell'
+   may leave one behind. A handler pointing into the copy is replaced
+   by the one active when the instance was created. */
+static void
+inst_restore_sigint(ngSpiceInst *inst)
+{
+    struct sigaction cur;
+    Dl_info hinfo, iinfo;
+
+    if (sigaction(SIGINT, NULL, &cur) || (cur.sa_flags & SA_SIGINFO) ||
+        cur.sa_handler == SIG_DFL || cur.sa_handler == SIG_IGN)
+        return;
+    if (dladdr((void *) cur.sa_handler, &hinfo) &&
+        dladdr((void *) inst->command, &iinfo) &&
+        hinfo.dli_fbase == iinfo.dli_fbase)
+        sigaction(SIGINT, &inst->old_sigint, NULL);
+}
+#endif
+
+
+/* Stop a background thread of the instance and release the copy.
+   If the thread does not stop, the copy stays loaded and 1 is
+   returned, the handle is still valid then. */
+IMPEXP
+int
+ngSpice_nDestroy(ngSpiceInst* inst)
+{
+    if (!inst)
+        return 1;
+#if defined(NGINST_WIN) || defined(NGINST_DL)
+    if (inst->release()) {
+        myputs("Error: cannot stop the ngspice instance, it is not released\n", stderr);
+        return 1;
+    }
+#ifdef NGINST_DL
+    inst_restore_sigint(inst);
+#endif
+    inst_unload(inst);
+#endif
+    free(inst);
+    return 0;
+}
+
+
 /*------------------------------------------------------*/
 /* Redefine the vfprintf() functions for callback       */
 /*------------------------------------------------------*/
@@ -1461,6 +1993,10 @@ void shared_exit(int status)
 #else
         usleep(10000);
 #endif
+    /* 'quit' sent by ngSpice_Inst_Release(), the caller is not asked
+       to detach, as the primary image unloads the instance anyway */
+    if (instrelease)
+        longjmp(errbufc, 1);
     /* status >= 1000 tells us that we react on command 'quit'
       hand this information over to caller */
     if (status >= 1000) {
@@ -1516,6 +2052,220 @@ void shared_exit(int status)
 static int len = 0;
 static pvecvaluesall curvecvalsall;
 
+
+/*------------------------------------------------------*/
+/* Block data streaming                                 */
+/*------------------------------------------------------*/
+
+static int
+stream_acked(void)
+{
+    int acked;
+#ifdef THREADS
+    mutex_lock(&streamMutex);
+#endif
+    acked = streamacked;
+#ifdef THREADS
+    mutex_unlock(&streamMutex);
+#endif
+    return acked;
+}
+
+
+/* wait until the caller holds no more than 'held' blocks of the ring,
+   returns FALSE if the simulation has been interrupted meanwhile */
+static bool
+stream_wait(int held)
+{
+    while (streamsent - stream_acked() > held) {
+        if (ft_intrpt)
+            return FALSE;
+#if defined(__MINGW32__) || defined(_MSC_VER)
+        Sleep(1);
+#else
+        usleep(1000);
+#endif
+    }
+    return TRUE;
+}
+
+
+/* send the current block to the caller */
+static void
+stream_send(bool final)
+{
+    vecblock *blk;
+    int i;
+
+    if (streambufs) {
+        blk = streamblocks + streamsent % streambufs;
+    } else {
+        /* point straight into the vectors of the plot */
+        blk = streamblocks;
+        for (i = 0; i < streamcount; i++) {
+            struct dvec *d = streamvecs[i];
+            if (streamfill == 0) {
+                blk->vecs[i].v_realdata = NULL;
+                blk->vecs[i].v_compdata = NULL;
+            } else if (isreal(d)) {
+                blk->vecs[i].v_realdata = d->v_realdata + streamfirst;
+            } else {
+                blk->vecs[i].v_compdata = d->v_compdata + streamfirst;
+            }
+        }
+    }
+
+    blk->first = streamfirst;
+    blk->count = streamfill;
+    blk->final = final;
+    for (i = 0; i < streamcount; i++)
+        blk->vecs[i].v_length = streamfill;
+
+#ifdef THREADS
+    mutex_lock(&streamMutex);
+#endif
+    streamsent++;
+#ifdef THREADS
+    mutex_unlock(&streamMutex);
+#endif
+    streamfill = 0;
+
+    blockfcn(blk, ng_ident, userptr);
+}
+
+
+/* release the blocks of the previous plot */
+static void
+stream_free(void)
+{
+    int i, nblocks;
+
+    if (streamblocks) {
+        nblocks = streambufs ? streambufs : 1;
+        for (i = 0; i < nblocks; i++)
+            tfree(streamblocks[i].vecs);
+        tfree(streamblocks);
+    }
+    tfree(streamring);
+    tfree(streamvecs);
+    streamcount = 0;
+    streamsent = streamacked = streamfill = 0;
+}
+
+
+/* select the vectors of a new plot and set up the blocks */
+static void
+stream_init(runDesc *run)
+{
+    struct dvec *d;
+    int i, j, width, nblocks;
+
+    /* blocks of the previous plot still held by the caller */
+    if (streambufs)
+        stream_wait(0);
+
+    stream_free();
+
+    /* data written to a rawfile are not kept in the vectors */
+    if (run->writeOut || !run->runPlot)
+        return;
+
+    streamvecs = TMALLOC(struct dvec *, run->numData);
+    for (d = run->runPlot->pl_dvecs; d; d = d->v_next) {
+        if (streamnames) {
+            for (i = 0; streamnames[i]; i++)
+                if (cieq(streamnames[i], d->v_name))
+                    break;
+            if (!streamnames[i])
+                continue;
+        }
+        if (streamcount < run->numData)
+            streamvecs[streamcount++] = d;
+    }
+    if (streamcount == 0) {
+        tfree(streamvecs);
+        return;
+    }
+
+    nblocks = streambufs ? streambufs : 1;
+    streamblocks = TMALLOC(vecblock, nblocks);
+
+    /* real vectors take one, complex vectors two doubles per point */
+    width = 0;
+    for (j = 0; j < streamcount; j++)
+        width += isreal(streamvecs[j]) ? 1 : 2;
+    if (streambufs)
+        streamring = TMALLOC(double, (size_t) nblocks * (size_t) streamsize * (size_t) width);
+
+    for (i = 0; i < nblocks; i++) {
+        vecblock *blk = streamblocks + i;
+        double *data = streamring ? streamring + (size_t) i * (size_t) streamsize * (size_t) width : NULL;
+        blk->plot = run->runPlot->pl_typename;
+        blk->veccount = streamcount;
+        blk->vecs = TMALLOC(vector_info, streamcount);
+        for (j = 0; j < streamcount; j++) {
+            d = streamvecs[j];
+            blk->vecs[j].v_name = d->v_name;
+            blk->vecs[j].v_type = d->v_type;
+            blk->vecs[j].v_flags = d->v_flags;
+            if (!data)
+                continue;
+            if (isreal(d)) {
+                blk->vecs[j].v_realdata = data;
+                data += streamsize;
+            } else {
+                blk->vecs[j].v_compdata = (ngcomplex_t *) data;
+                data += 2 * streamsize;
+            }
+        }
+    }
+}
+
+
+/* add the point just stored in the vectors to the current block */
+static void
+stream_point(void)
+{
+    vecblock *blk;
+    int i, idx = streamvecs[0]->v_length - 1;
+
+    if (streamfill == 0) {
+        /* get hold of a free block of the ring */
+        if (streambufs && !stream_wait(streambufs - 1))
+            return;
+        streamfirst = idx;
+    }
+
+    if (streambufs) {
+        blk = streamblocks + streamsent % streambufs;
+        for (i = 0; i < streamcount; i++) {
+            struct dvec *d = streamvecs[i];
+            if (isreal(d))
+                blk->vecs[i].v_realdata[streamfill] = d->v_realdata[idx];
+            else
+                blk->vecs[i].v_compdata[streamfill] = d->v_compdata[idx];
+        }
+    }
+
+    if (++streamfill == streamsize)
+        stream_send(FALSE);
+}
+
+
+/* called from OUTendPlot() in outitf.c,
+   sends the remaining points of the plot as the final block */
+void
+sh_stream_end(void)
+{
+    if (!blockfcn || !streamvecs)
+        return;
+    if (streambufs && streamfill == 0 && !stream_wait(streambufs - 1))
+        return;
+    stream_send(TRUE);
+    /* the vectors may be destroyed from now on */
+    tfree(streamvecs);
+}
+
 #ifdef olld
 static pvecvalues* curvecvals;
 static char type_name[128];
@@ -1590,6 +2340,10 @@ int sh_ExecutePerLoop(void)
     int i, veclen;
 //  double testval;
     struct plot *pl = plot_cur;
+
+    if (blockfcn && streamvecs)
+        stream_point();
+
     /* return immediately if callback not wanted */
     if (nodatawanted)
         return 2;
@@ -1629,6 +2383,9 @@ int sh_vecinit(runDesc *run)
     static pvecinfoall pvca = NULL;
     pvecinfo *pvc;
 
+    if (blockfcn)
+        stream_init(run);
+
     /* return immediately if callback not wanted */
     if (nodatainitwanted)
         return 2;
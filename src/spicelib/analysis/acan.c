@@ -10,6 +10,10 @@ Modified 2001: AlansFixes
 #include "ngspice/devdefs.h"
 #include "ngspice/sperror.h"
 
+#ifdef USE_OMP
+#include <omp.h>
+#endif
+
 #ifdef XSPICE
 /* gtri - add - wbk - 12/19/90 - Add headers */ 
 #include "ngspice/mif.h"
@@ -39,6 +43,179 @@ do { \
 } while(0)
 
 
+/* advance freq to the next point of the sweep, *more is 0 if there is none */
+static int
+ACnextFreq(ACAN *job, double *freq, int *more)
+{
+    switch (job->ACstepType) {
+    case DECADE:
+    case OCTAVE:
+
+/* inserted again 14.12.2001  */
+#ifdef HAS_PROGREP
+        {
+            double endfreq   = job->ACstopFreq;
+            double startfreq = job->ACstartFreq;
+            endfreq   = log(endfreq);
+            if (startfreq == 0.0)
+                startfreq = 1e-12;
+            startfreq = log(startfreq);
+
+            if (*freq > 0.0)
+                SetAnalyse( "ac", (int)((log(*freq)-startfreq) * 1000.0 / (endfreq-startfreq)));
+        }
+#endif
+
+        *freq *= job->ACfreqDelta;
+        *more = (job->ACfreqDelta != 1);
+        return(OK);
+
+    case LINEAR:
+
+#ifdef HAS_PROGREP
+        {
+            double endfreq   = job->ACstopFreq;
+            double startfreq = job->ACstartFreq;
+            SetAnalyse( "ac", (int)((*freq - startfreq)* 1000.0 / (endfreq-startfreq)));
+        }
+#endif
+
+        *freq += job->ACfreqDelta;
+        *more = (job->ACfreqDelta != 0);
+        return(OK);
+
+    default:
+        return(E_INTERN);
+    }
+}
+
+
+#ifdef USE_OMP
+/* Sweep the remaining frequency points, solving several of them at once.
+ *
+ * The devices add into the one circuit matrix, so the loads stay serial.
+ * After each load the matrix values and the rhs are copied away, and a
+ * batch of these copies is factored and solved in parallel with the pivot
+ * order of the last factorization (SMPcCopySolve()), the same static
+ * pivoting NIacIter() does.  The results are dumped in frequency order.
+ * A point which runs into a zero pivot is done again by NIacIter(), which
+ * reorders, and the points after it are loaded again.
+ */
+static int
+ACbatchSweep(CKTcircuit *ckt, ACAN *job, double freq, double freqTol,
+             runDesc *acPlot)
+{
+    int size = SMPmatSize(ckt->CKTmatrix);
+    int nbatch = omp_get_max_threads();
+    int nval = -1;
+    int more = 1;
+    int error = OK;
+    int i, n;
+    double *freqs = TMALLOC(double, nbatch);
+    int *status = TMALLOC(int, nbatch);
+    double *rhs = TMALLOC(double, 2 * (size + 1) * nbatch);
+    double *work = TMALLOC(double, 2 * (size + 1) * nbatch);
+    double *values = NULL;
+    double startTime;
+
+    while (more) {
+        if (SPfrontEnd->IFpauseTest()) {
+            /* user asked us to pause via an interrupt */
+            job->ACsaveFreq = freq;
+            error = E_PAUSE;
+            break;
+        }
+
+        /* the pivot order has changed, or this is the first batch */
+        if (nval < 0) {
+            nval = SMPcCopySize(ckt->CKTmatrix);
+            if (nval < 0) {
+                error = E_NOMEM;
+                break;
+            }
+            tfree(values);
+            values = TMALLOC(double, (size_t) nval * (size_t) nbatch);
+        }
+
+        for (n = 0; n < nbatch && more; n++) {
+            double *r = rhs + 2 * (size + 1) * n;
+            ckt->CKTomega = 2.0 * M_PI * freq;
+            ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODEAC;
+            error = CKTacLoad(ckt);
+            if (error)
+                break;
+            SMPcCopyGather(ckt->CKTmatrix, values + (size_t) nval * (size_t) n);
+            memcpy(r, ckt->CKTrhs, (size_t) (size + 1) * sizeof(double));
+            memcpy(r + size + 1, ckt->CKTirhs, (size_t) (size + 1) * sizeof(double));
+            freqs[n] = freq;
+            error = ACnextFreq(job, &freq, &more);
+            if (error)
+                break;
+            more = more && freq <= job->ACstopFreq + freqTol;
+        }
+        if (error)
+            break;
+
+        startTime = SPfrontEnd->IFseconds();
+#pragma omp parallel for schedule(dynamic)
+        for (i = 0; i < n; i++) {
+            double *r = rhs + 2 * (size + 1) * i;
+            status[i] = SMPcCopySolve(ckt->CKTmatrix,
+                                      values + (size_t) nval * (size_t) i,
+                                      work + 2 * (size + 1) * omp_get_thread_num(),
+                                      r, r + size + 1);
+        }
+        ckt->CKTstat->STATdecompTime += SPfrontEnd->IFseconds() - startTime;
+
+        for (i = 0; i < n; i++) {
+            if (status[i]) {
+                ckt->CKTomega = 2.0 * M_PI * freqs[i];
+                ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODEAC;
+                error = NIacIter(ckt);
+                if (error)
+                    break;
+                nval = -1;
+                if (i + 1 < n) {
+                    freq = freqs[i + 1];
+                    more = 1;
+                    n = i + 1;
+                }
+            } else {
+                double *r = rhs + 2 * (size + 1) * i;
+                memcpy(ckt->CKTrhsOld, r, (size_t) (size + 1) * sizeof(double));
+                memcpy(ckt->CKTirhsOld, r + size + 1, (size_t) (size + 1) * sizeof(double));
+                ckt->CKTrhsOld[0] = 0;
+                ckt->CKTirhsOld[0] = 0;
+            }
+
+#ifdef XSPICE
+            if(g_ipc.enabled)
+                ipc_send_data_prefix(freqs[i]);
+
+            error = CKTacDump(ckt,freqs[i],acPlot);
+
+            if(g_ipc.enabled)
+                ipc_send_data_suffix();
+#else
+            error = CKTacDump(ckt,freqs[i],acPlot);
+#endif
+            if (error)
+                break;
+        }
+        if (error)
+            break;
+    }
+
+    tfree(values);
+    tfree(work);
+    tfree(rhs);
+    tfree(status);
+    tfree(freqs);
+    return(error);
+}
+#endif
+
+
 int
 ACan(CKTcircuit *ckt, int restart)
 {
@@ -52,6 +229,7 @@ ACan(CKTcircuit *ckt, int restart)
     double startkTime;
     double startTime;
     int error;
+    int more;
     int numNames;
     IFuid *nameList;  /* va: tmalloc'ed list of names */
     IFuid freqUid;
@@ -333,47 +511,31 @@ ACan(CKTcircuit *ckt, int restart)
  	}
 
         /*  increment frequency */
+        error = ACnextFreq(job, &freq, &more);
+        if (error)
+            return(error);
+        if (!more)
+            goto endsweep;
 
-        switch (job->ACstepType) {
-        case DECADE:
-        case OCTAVE:
-
-/* inserted again 14.12.2001  */
-#ifdef HAS_PROGREP
-            {
-                double endfreq   = job->ACstopFreq;
-                double startfreq = job->ACstartFreq;
-                endfreq   = log(endfreq);
-                if (startfreq == 0.0)
-                    startfreq = 1e-12;
-                startfreq = log(startfreq);
-
-                if (freq > 0.0)
-                    SetAnalyse( "ac", (int)((log(freq)-startfreq) * 1000.0 / (endfreq-startfreq)));
-            }
-#endif
-
-            freq *= job->ACfreqDelta;
-            if (job->ACfreqDelta == 1) goto endsweep;
-        break;
-        case LINEAR:
-
-#ifdef HAS_PROGREP
-			 {
-				 double endfreq   = job->ACstopFreq;
-				 double startfreq = job->ACstartFreq;
-				 SetAnalyse( "ac", (int)((freq - startfreq)* 1000.0 / (endfreq-startfreq)));
-			 }
+#ifdef USE_OMP
+        /* the rest of the sweep can be solved in parallel */
+        if (omp_get_max_threads() > 1 && !ckt->CKTvarHertz
+#ifdef WANT_SENSE2
+            && !(ckt->CKTsenInfo && (ckt->CKTsenInfo->SENmode & ACSEN))
 #endif
-
-            freq += job->ACfreqDelta;
-            if (job->ACfreqDelta == 0) goto endsweep;
-            break;
-        default:
-            return(E_INTERN);
-    
+            ) {
+            if (freq <= job->ACstopFreq + freqTol) {
+                error = ACbatchSweep(ckt, job, freq, freqTol, acPlot);
+                if (error == E_PAUSE)
+                    return(error);
+                if (error) {
+                    UPDATE_STATS(DOING_AC);
+                    return(error);
+                }
+            }
+            goto endsweep;
         }
-
+#endif
     }
 endsweep:
     SPfrontEnd->OUTendPlot (acPlot);
@@ -109,6 +109,18 @@ CKTacct(CKTcircuit *ckt, JOB *anal, int which, IFvalue *val)
     case OPT_TRANTRUNC:
         val->rValue = ckt->CKTstat->STATtranTruncTime;
         break;
+    case OPT_BREAKTIME:
+        val->rValue = ckt->CKTstat->STATbreakTime;
+        break;
+    case OPT_PASS1TIME:
+        val->rValue = ckt->CKTstat->STATpass1Time;
+        break;
+    case OPT_PASS2TIME:
+        val->rValue = ckt->CKTstat->STATpass2Time;
+        break;
+    case OPT_PASS3TIME:
+        val->rValue = ckt->CKTstat->STATpass3Time;
+        break;
     case OPT_ACLOAD:
         val->rValue = ckt->CKTstat->STATacLoadTime;
         break;
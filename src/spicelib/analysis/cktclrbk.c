@@ -11,6 +11,7 @@ Author: 1985 Thomas L. Quarles
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/ifsim.h"
 #include "ngspice/sperror.h"
 
 
@@ -18,21 +19,17 @@ Author: 1985 Thomas L. Quarles
 int
 CKTclrBreak(CKTcircuit *ckt)
 {
-    double *tmp;
-    int j;
+    double startTime = SPfrontEnd->IFseconds();
 
     if(ckt->CKTbreakSize >2) {
-        tmp = TMALLOC(double, ckt->CKTbreakSize - 1);
-        if(tmp == NULL) return(E_NOMEM);
-        for(j=1;j<ckt->CKTbreakSize;j++) {
-            tmp[j-1] = ckt->CKTbreaks[j];
-        }
-        FREE(ckt->CKTbreaks);
+        /* the table stays in place, see CKTsetBreak() */
+        ckt->CKTbreaks++;
         ckt->CKTbreakSize--;
-        ckt->CKTbreaks=tmp;
     } else {
         ckt->CKTbreaks[0] = ckt->CKTbreaks[1];
         ckt->CKTbreaks[1] = ckt->CKTfinalTime;
     }
+
+    ckt->CKTstat->STATbreakTime += SPfrontEnd->IFseconds() - startTime;
     return(OK);
 }
@@ -44,11 +44,13 @@ CKTdestroy(CKTcircuit *ckt)
     for(i=0;i<=ckt->CKTmaxOrder+1;i++){
         FREE(ckt->CKTstates[i]);
     }
+    CKTstampDestroy(ckt);
     if(ckt->CKTmatrix) {
         SMPdestroy(ckt->CKTmatrix);
         ckt->CKTmatrix = NULL;
     }
-    FREE(ckt->CKTbreaks);
+    FREE(ckt->CKTbreakBuf);
+    ckt->CKTbreaks = NULL;
     for(node = ckt->CKTnodes; node; ) {
         nnode = node->next;
         FREE(node);
@@ -147,6 +149,8 @@ evt_dest(Evt_Ckt_Data_t *evt)
     tfree(inst_queue->modified);
     tfree(inst_queue->pending_index);
     tfree(inst_queue->pending);
+    tfree(inst_queue->pending_pos);
+    tfree(inst_queue->pending_time);
     tfree(inst_queue->to_call_index);
     tfree(inst_queue->to_call);
 
@@ -175,6 +179,8 @@ evt_dest(Evt_Ckt_Data_t *evt)
     tfree(output_queue->modified);
     tfree(output_queue->pending_index);
     tfree(output_queue->pending);
+    tfree(output_queue->pending_pos);
+    tfree(output_queue->pending_time);
     tfree(output_queue->changed_index);
     tfree(output_queue->changed);
 
@@ -9,6 +9,7 @@ Author: 1985 Thomas L. Quarles
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "ngspice/ifsim.h"
 #include "ngspice/sperror.h"
 
@@ -20,7 +21,7 @@ CKTdltMod(CKTcircuit *ckt, GENmodel *m)
 {
     GENmodel *mod, **prevp;
     GENinstance *h, *next_i;
-    int	error;
+    int	error, type;
 
     prevp = &ckt->CKThead[m->GENmodType];
     for (mod = *prevp; m && mod != m; mod = mod->GENnextModel)
@@ -30,6 +31,7 @@ CKTdltMod(CKTcircuit *ckt, GENmodel *m)
 	return OK;
 
     *prevp = m->GENnextModel;
+    type = m->GENmodType;
 
     for (h = m->GENinstances; h; h = next_i) {
 	    next_i = h->GENnextInstance;
@@ -43,5 +45,10 @@ CKTdltMod(CKTcircuit *ckt, GENmodel *m)
         fprintf(stderr, "ERROR, ouch nasal daemons ...\n");
     error = SPfrontEnd->IFdelUid (ckt, m->GENmodName, UID_MODEL);
     tfree(m);
+
+    /* the stamp buffers of the two-phase load point to the instances */
+    if (ckt->CKTstampScratch && DEVices[type]->DEVloadInst)
+        return CKTstampSetup(ckt);
+
     return(OK);
 }
@@ -58,8 +58,20 @@ CKTload(CKTcircuit *ckt)
     noncon = ckt->CKTnoncon;
 #endif /* STEPDEBUG */
 
+#ifdef USE_OMP
+    /* two-phase load: evaluate all instances of the devices providing
+     * DEVloadInst in parallel, their stamps are scattered below */
+    if (ckt->CKTstampCount)
+        CKTstampEval(ckt);
+#endif
+
     for (i = 0; i < DEVmaxnum; i++) {
         if (DEVices[i] && DEVices[i]->DEVload && ckt->CKThead[i]) {
+#ifdef USE_OMP
+            if (ckt->CKTstampCount && DEVices[i]->DEVloadInst)
+                error = CKTstampLoadDev(ckt, i);
+            else
+#endif
             error = DEVices[i]->DEVload (ckt->CKThead[i], ckt);
             if (ckt->CKTnoncon)
                 ckt->CKTtroubleNode = 0;
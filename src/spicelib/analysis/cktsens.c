@@ -52,10 +52,13 @@ static double inc_freq(double freq, int type, double step_size);
  *
  *		For each frequency point:
  *			(for AC) call NIacIter to get base node voltages
+ *			Solve the adjoint system Y^T A = C once, C selects
+ *			the output
  *			For each element/parameter in the test list:
  *				construct the perturbation matrix
- *				Solve for the sensitivities:
- *					delta_E = Y^-1 (delta_Y E - delta_I)
+ *				Find the sensitivity of the output:
+ *					C delta_E = C Y^-1 (delta_Y E - delta_I)
+ *						  = A (delta_Y E - delta_I)
  *				save results
  */
 
@@ -66,7 +69,8 @@ int sens_sens(CKTcircuit *ckt, int restart)
 
 	static int	size;
 	static double	*delta_I, *delta_iI,
-			*delta_I_delta_Y, *delta_iI_delta_Y;
+			*delta_I_delta_Y, *delta_iI_delta_Y,
+			*adj_I, *adj_iI;
 	sgen		*sg;
 	static double	freq;
 	static int	nfreqs;
@@ -155,6 +159,9 @@ int sens_sens(CKTcircuit *ckt, int restart)
 		delta_I_delta_Y = TMALLOC(double, size);
 		delta_iI_delta_Y = TMALLOC(double, size);
 
+		adj_I = TMALLOC(double, size);
+		adj_iI = TMALLOC(double, size);
+
 
 		num_vars = 0;
 		for (sg = sgen_init(ckt, is_dc); sg; sgen_next(&sg)) {
@@ -314,6 +321,22 @@ int sens_sens(CKTcircuit *ckt, int restart)
 			Y = ckt->CKTmatrix;
 		}
 
+		/* The adjoint solution A, Y already factored */
+
+		for (j = 0; j < size; j++) {
+			adj_I[j] = 0.0;
+			adj_iI[j] = 0.0;
+		}
+		if (job->output_volt) {
+			adj_I[job->output_pos->number] += 1.0;
+			adj_I[job->output_neg->number] -= 1.0;
+		} else {
+			adj_I[branch_eq] = 1.0;
+		}
+		spSolveTransposed(Y, adj_I, adj_I, adj_iI, adj_iI);
+		adj_I[0] = 0.0;
+		adj_iI[0] = 0.0;
+
 		/* Use a different vector & matrix */
 
 		save_context(ckt->CKTrhs, saved_rhs);
@@ -502,65 +525,27 @@ int sens_sens(CKTcircuit *ckt, int restart)
 						delta_I[j], delta_iI[j]);
 			}
 #endif
-			/* Solve; Y already factored */
-			spSolve(Y, delta_I, delta_I, delta_iI, delta_iI);
-
-                        /* the special `0' node
-                        *    the matrix indizes are [1..n]
-                        *    yet the vector indizes are [0..n]
-                        *    with [0] being implicit === 0
-                        */
-                        delta_I[0]  = 0.0;
-                        delta_iI[0] = 0.0;
-
-#ifdef ASDEBUG
-			DEBUG(2) {
-				for (j = 1; j < size; j++) {
-
-					if (sg->is_instparam)
-						printf("%d/%s.%s = %g, %g\n",
-							j,
-							sg->instance->GENname,
-						sg->ptable[sg->param].keyword,
-						delta_I[j], delta_iI[j]);
-					else
-						printf("%d/%s:%s = %g, %g\n",
-							j,
-							sg->instance->GENname,
-						sg->ptable[sg->param].keyword,
-						delta_I[j], delta_iI[j]);
-
-				}
-			}
-#endif
-
-			/* delta_I is now equal to delta_E */
+			/* A (delta_I - delta_Y E), the change of the output.
+			 * The special `0' node is skipped, the matrix
+			 * indizes are [1..n], yet the vector indizes are
+			 * [0..n] with [0] being implicit === 0
+			 */
 
 			if (is_dc) {
-				if (job->output_volt)
-					output_values[n] =
-					    delta_I [job->output_pos->number]
-					    - delta_I [job->output_neg->number];
-				else {
-					output_values[n] = delta_I[branch_eq];
-				}
-				output_values[n] /= delta_var;
+				double sum = 0.0;
+				for (j = 1; j < size; j++)
+					sum += adj_I[j] * delta_I[j];
+				output_values[n] = sum / delta_var;
 			} else {
-				if (job->output_volt) {
-					output_cvalues[n].real =
-					    delta_I [job->output_pos->number]
-					    - delta_I [job->output_neg->number];
-					output_cvalues[n].imag =
-					    delta_iI [job->output_pos->number]
-					    - delta_iI [job->output_neg->number];
-				} else {
-					output_cvalues[n].real =
-						delta_I[branch_eq];
-					output_cvalues[n].imag =
-						delta_iI[branch_eq];
+				double sum = 0.0, isum = 0.0;
+				for (j = 1; j < size; j++) {
+					sum += adj_I[j] * delta_I[j]
+						- adj_iI[j] * delta_iI[j];
+					isum += adj_I[j] * delta_iI[j]
+						+ adj_iI[j] * delta_I[j];
 				}
-				output_cvalues[n].real /= delta_var;
-				output_cvalues[n].imag /= delta_var;
+				output_cvalues[n].real = sum / delta_var;
+				output_cvalues[n].imag = isum / delta_var;
 			}
 
 			n += 1;
@@ -603,6 +588,9 @@ int sens_sens(CKTcircuit *ckt, int restart)
 	FREE(delta_I_delta_Y);
 	FREE(delta_iI_delta_Y);
 
+	FREE(adj_I);
+	FREE(adj_iI);
+
 	ckt->CKTbypass = bypass;
 
 #ifdef notdef
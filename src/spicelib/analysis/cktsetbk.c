@@ -17,77 +17,161 @@ Author: 1985 Thomas L. Quarles
 /* define to enable breakpoint trace code */
 /* #define TRACE_BREAKPOINT */
 
-int
-CKTsetBreak(CKTcircuit *ckt, double time)
+/*
+ * The breakpoint table CKTbreaks[0..CKTbreakSize-1] is kept sorted inside
+ * the larger block CKTbreakBuf[0..CKTbreakBufSize-1].  CKTclrBreak() pops
+ * the first entry by moving CKTbreaks up, and CKTsetBreak() inserts by
+ * shifting whichever side of the insertion point is shorter into the free
+ * room before or after the table, so that neither reallocates and copies
+ * the whole table on every call.
+ */
+
+static int
+insertBreak(CKTcircuit *ckt, int i, double time)
 {
-    double *tmp;
-    int i,j;
+    double *breaks = ckt->CKTbreaks;
+    int size = ckt->CKTbreakSize;
+    int before = (int) (breaks - ckt->CKTbreakBuf);
+    int after = ckt->CKTbreakBufSize - before - size;
 
-#ifdef TRACE_BREAKPOINT
-    printf("[t:%e] \t want breakpoint for t = %e\n", ckt->CKTtime, time);
-#endif
+    if (before > 0 && (i < size - i || after == 0)) {
+        /* move the entries in front of i down */
+        memmove(breaks - 1, breaks, (size_t) i * sizeof(double));
+        breaks--;
+    } else if (after > 0) {
+        /* move the entries from i on up */
+        memmove(breaks + i + 1, breaks + i, (size_t) (size - i) * sizeof(double));
+    } else {
+        /* no room left, grow */
+        int bufsize = 2 * size + 2;
+        double *buf = TMALLOC(double, bufsize);
+        if (buf == NULL)
+            return(E_NOMEM);
+        memcpy(buf, breaks, (size_t) i * sizeof(double));
+        memcpy(buf + i + 1, breaks + i, (size_t) (size - i) * sizeof(double));
+        FREE(ckt->CKTbreakBuf);
+        ckt->CKTbreakBuf = breaks = buf;
+        ckt->CKTbreakBufSize = bufsize;
+    }
 
-    if(ckt->CKTtime > time) {
-        SPfrontEnd->IFerrorf (ERR_PANIC, "breakpoint in the past - HELP!");
-        return(E_INTERN);
+    breaks[i] = time;
+    ckt->CKTbreaks = breaks;
+    ckt->CKTbreakSize++;
+    return(OK);
+}
+
+
+static int
+setBreak(CKTcircuit *ckt, double time)
+{
+    double *breaks = ckt->CKTbreaks;
+    int size = ckt->CKTbreakSize;
+    int i, lo, hi;
+
+    /* find the first entry later than time */
+    if (breaks[0] > time) {
+        i = 0;
+    } else {
+        lo = 1;
+        hi = size;
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (breaks[mid] > time)
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        i = lo;
     }
-    for(i=0;i<ckt->CKTbreakSize;i++) {
-        if(ckt->CKTbreaks[i]>time) { /* passed */
-            if((ckt->CKTbreaks[i]-time) <= ckt->CKTminBreak) {
-                /* very close together - take earlier point */
-#ifdef TRACE_BREAKPOINT
-                printf("[t:%e] \t %e replaces %e\n", ckt->CKTtime, time,
-		ckt->CKTbreaks[i]);
-		CKTbreakDump(ckt);
-#endif		
-                ckt->CKTbreaks[i] = time;
-                return(OK);
-            }
-            if(i>0 && time-ckt->CKTbreaks[i-1] <= ckt->CKTminBreak) {
-                /* very close together, but after, so skip */
+
+    if (i < size) { /* passed */
+        if ((breaks[i] - time) <= ckt->CKTminBreak) {
+            /* very close together - take earlier point */
 #ifdef TRACE_BREAKPOINT
-                printf("[t:%e] \t %e skipped\n", ckt->CKTtime, time);
-		CKTbreakDump(ckt);
-#endif			
-                return(OK);
-            }
-            /* fits in middle - new array & insert */
-            tmp = TMALLOC(double, ckt->CKTbreakSize + 1);
-            if(tmp == NULL) return(E_NOMEM);
-            for(j=0;j<i;j++) {
-                tmp[j] = ckt->CKTbreaks[j];
-            }
-            tmp[i]=time;
+            printf("[t:%e] \t %e replaces %e\n", ckt->CKTtime, time,
+                   breaks[i]);
+            CKTbreakDump(ckt);
+#endif
+            breaks[i] = time;
+            return(OK);
+        }
+        if (i > 0 && time - breaks[i-1] <= ckt->CKTminBreak) {
+            /* very close together, but after, so skip */
 #ifdef TRACE_BREAKPOINT
-                printf("[t:%e] \t %e added\n", ckt->CKTtime, time);
-		CKTbreakDump(ckt);
-#endif	    
-            for(j=i;j<ckt->CKTbreakSize;j++) {
-                tmp[j+1] = ckt->CKTbreaks[j];
-            }
-            FREE(ckt->CKTbreaks);
-            ckt->CKTbreakSize++;
-            ckt->CKTbreaks=tmp;
-
+            printf("[t:%e] \t %e skipped\n", ckt->CKTtime, time);
+            CKTbreakDump(ckt);
+#endif
             return(OK);
         }
+        /* fits in middle - insert */
+#ifdef TRACE_BREAKPOINT
+        printf("[t:%e] \t %e added\n", ckt->CKTtime, time);
+        CKTbreakDump(ckt);
+#endif
+        return insertBreak(ckt, i, time);
     }
+
     /* never found it - beyond end of time - extend out idea of time */
-    if(time-ckt->CKTbreaks[ckt->CKTbreakSize-1]<=ckt->CKTminBreak) {
+    if (time - breaks[size-1] <= ckt->CKTminBreak) {
         /* very close tegether - keep earlier, throw out new point */
 #ifdef TRACE_BREAKPOINT
-                printf("[t:%e] \t %e skipped (at the end)\n", ckt->CKTtime, time);
-                CKTbreakDump(ckt);
-#endif	
+        printf("[t:%e] \t %e skipped (at the end)\n", ckt->CKTtime, time);
+        CKTbreakDump(ckt);
+#endif
         return(OK);
     }
-    /* fits at end - grow array & add on */
-    ckt->CKTbreaks = TREALLOC(double, ckt->CKTbreaks, ckt->CKTbreakSize + 1);
-    ckt->CKTbreakSize++;
-    ckt->CKTbreaks[ckt->CKTbreakSize-1]=time;
+
+    /* fits at end - add on */
 #ifdef TRACE_BREAKPOINT
-                printf("[t:%e] \t %e added at end\n", ckt->CKTtime, time);
-		CKTbreakDump(ckt);
-#endif    
+    printf("[t:%e] \t %e added at end\n", ckt->CKTtime, time);
+    CKTbreakDump(ckt);
+#endif
+    return insertBreak(ckt, size, time);
+}
+
+
+int
+CKTsetBreak(CKTcircuit *ckt, double time)
+{
+    double startTime;
+    int error;
+
+#ifdef TRACE_BREAKPOINT
+    printf("[t:%e] \t want breakpoint for t = %e\n", ckt->CKTtime, time);
+#endif
+
+    if(ckt->CKTtime > time) {
+        SPfrontEnd->IFerrorf (ERR_PANIC, "breakpoint in the past - HELP!");
+        return(E_INTERN);
+    }
+
+    startTime = SPfrontEnd->IFseconds();
+    error = setBreak(ckt, time);
+    ckt->CKTstat->STATbreakTime += SPfrontEnd->IFseconds() - startTime;
+
+    return(error);
+}
+
+
+    /* CKTinitBreak(ckt)
+     *   reset the breakpoint table to the start and the end of time
+     */
+
+int
+CKTinitBreak(CKTcircuit *ckt)
+{
+    FREE(ckt->CKTbreakBuf);
+    ckt->CKTbreakBufSize = 16;
+    ckt->CKTbreakBuf = TMALLOC(double, ckt->CKTbreakBufSize);
+    if(ckt->CKTbreakBuf == NULL) {
+        ckt->CKTbreakBufSize = 0;
+        ckt->CKTbreaks = NULL;
+        ckt->CKTbreakSize = 0;
+        return(E_NOMEM);
+    }
+    ckt->CKTbreaks = ckt->CKTbreakBuf;
+    ckt->CKTbreaks[0] = 0;
+    ckt->CKTbreaks[1] = ckt->CKTfinalTime;
+    ckt->CKTbreakSize = 2;
     return(OK);
 }
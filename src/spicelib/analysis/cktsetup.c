@@ -79,6 +79,8 @@ CKTsetup(CKTcircuit *ckt)
             if(error) return(error);
         }
     }
+    error = CKTstampSetup(ckt);
+    if(error) return(error);
     for(i=0;i<=MAX(2,ckt->CKTmaxOrder)+1;i++) { /* dctran needs 3 states as minimum */
         CKALLOC(ckt->CKTstates[i],ckt->CKTnumStates,double);
     }
@@ -158,6 +160,7 @@ CKTunsetup(CKTcircuit *ckt)
                 error = e2;
         }
     }
+    CKTstampDestroy(ckt);
     ckt->CKTisSetup = 0;
     if(error) return(error);
 
@@ -161,6 +161,9 @@ CKTsetOpt(CKTcircuit *ckt, JOB *anal, int opt, IFvalue *val)
     case OPT_NOOPAC:
         task->TSKnoopac = (val->iValue != 0);
         break;
+    case OPT_CSCSOLVER:
+        task->TSKcscSolver = (val->iValue != 0);
+        break;
 /* gtri - begin - wbk - add new options */
 #ifdef XSPICE
     case OPT_EVT_MAX_OP_ALTER:
@@ -291,6 +294,10 @@ static IFparm OPTtbl[] = {
  { "tranfactortime", OPT_TRANDECOMP,IF_ASK|IF_REAL,"Transient factor time" },
  { "transolvetime", OPT_TRANSOLVE, IF_ASK|IF_REAL,"Transient solve time" },
  { "trantrunctime", OPT_TRANTRUNC, IF_ASK|IF_REAL,"Transient trunc time" },
+ { "breaktime", OPT_BREAKTIME, IF_ASK|IF_REAL,"Breakpoint table time" },
+ { "pass1time", OPT_PASS1TIME, IF_ASK|IF_REAL,"Input pass 1 (models) time" },
+ { "pass2time", OPT_PASS2TIME, IF_ASK|IF_REAL,"Input pass 2 (instances) time" },
+ { "pass3time", OPT_PASS3TIME, IF_ASK|IF_REAL,"Input pass 3 (nodesets, ics) time" },
  { "trancuriters", OPT_TRANCURITER, IF_ASK|IF_INTEGER,
         "Transient iters per point" },
  { "actime", OPT_ACTIME, IF_ASK|IF_REAL,"AC analysis time" },
@@ -313,7 +320,9 @@ static IFparm OPTtbl[] = {
  { "reldv", OPT_RELDV, IF_SET|IF_REAL,
         "Maximum relative iter-iter node voltage change" },
  { "noopac", OPT_NOOPAC, IF_SET|IF_FLAG,
-        "No op calculation in ac if circuit is linear" }
+        "No op calculation in ac if circuit is linear" },
+ { "csc", OPT_CSCSOLVER, IF_SET|IF_FLAG,
+        "Refactor the matrix in compressed column form" }
 };
 
 int OPTcount = NUMELEMS(OPTtbl);
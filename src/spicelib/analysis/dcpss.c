@@ -202,12 +202,8 @@ DCpss(CKTcircuit *ckt,
         /* end LTRA code addition */
 
         /* Breakpoints initialization */
-        if(ckt->CKTbreaks) FREE(ckt->CKTbreaks);
-        ckt->CKTbreaks = TMALLOC(double, 2);
-        if(ckt->CKTbreaks == NULL) return(E_NOMEM);
-        ckt->CKTbreaks[0] = 0;
-        ckt->CKTbreaks[1] = ckt->CKTfinalTime;
-        ckt->CKTbreakSize = 2;
+        error = CKTinitBreak(ckt);
+        if(error) return(error);
 
 #ifdef XSPICE
 /* gtri - begin - wbk - 12/19/90 - Modify setting of CKTminBreak */
@@ -131,12 +131,8 @@ DCtran(CKTcircuit *ckt,
             ckt->CKTtimePoints = TMALLOC(double, ckt->CKTtimeListSize);
         /* end LTRA code addition */
 
-        if(ckt->CKTbreaks) FREE(ckt->CKTbreaks);
-        ckt->CKTbreaks = TMALLOC(double, 2);
-        if(ckt->CKTbreaks == NULL) return(E_NOMEM);
-        ckt->CKTbreaks[0] = 0;
-        ckt->CKTbreaks[1] = ckt->CKTfinalTime;
-        ckt->CKTbreakSize = 2;
+        error = CKTinitBreak(ckt);
+        if(error) return(error);
 
 #ifdef SHARED_MODULE
         add_bkpt();
@@ -11,6 +11,7 @@ Modified: 1999 Paolo Nenzi
 #include "res/resdefs.h"
 
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktlinear.h"
 #include "ngspice/const.h"
 #include "ngspice/sperror.h"
 
@@ -24,12 +25,39 @@ Modified: 1999 Paolo Nenzi
 
 #include "ngspice/devdefs.h"
 
+#if defined(HAVE_FORK) && defined(HAVE_MMAP) && defined(HAVE_SYS_WAIT_H) && \
+    !defined(SHARED_MODULE) && !defined(TCL_MODULE)
+#define DC_FORK_SWEEP
+#include "ngspice/cpextern.h"
+#include <errno.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef USE_OMP
+#include <omp.h>
+#endif
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
 #ifdef HAS_PROGREP
 static double actval, actdiff; 
 #endif
 
 extern void inp_evaluate_temper(void);
 
+static int DCsweep(CKTcircuit *ckt, TRCV *job, runDesc *plot, int i,
+                   int outerLeft, double *outBuf, int *numPoints);
+static void DCstep(CKTcircuit *ckt, TRCV *job, int i);
+
+#ifdef DC_FORK_SWEEP
+extern bool OUTpHasSpecial(runDesc *plotPtr);
+extern void OUTrawClose(void);
+static int DCforkSweep(CKTcircuit *ckt, TRCV *job, runDesc *plot, int *error);
+#endif
+
 int
 DCtrCurv(CKTcircuit *ckt, int restart) 
                 
@@ -38,21 +66,16 @@ DCtrCurv(CKTcircuit *ckt, int restart)
     TRCV *job = (TRCV *) ckt->CKTcurJob;
 
     int i;
-    double *temp;
-    int converged;
     int rcode;     
     int vcode;
     int icode;
-    int j;
     int error;
     IFuid varUid;
     IFuid *nameList;
     int numNames;
-    int firstTime=1;
     static runDesc *plot = NULL;
 
 #ifdef WANT_SENSE2
-    long save;
 #ifdef SENSDEBUG
     if(ckt->CKTsenInfo && (ckt->CKTsenInfo->SENmode&DCSEN) ){
         printf("\nDC Sensitivity Results\n\n");
@@ -234,8 +257,86 @@ found:;
     
     i = 0;
 
+#ifdef DC_FORK_SWEEP
+    /* the sweep may be split up among several processes */
+    if (DCforkSweep(ckt, job, plot, &error)) {
+        if (error)
+            return(error);
+        goto finished;
+    }
+#endif
+
 resume:
-    
+
+    error = DCsweep(ckt, job, plot, i, -1, NULL, NULL);
+    if (error)
+        return(error);
+
+#ifdef DC_FORK_SWEEP
+finished:
+#endif
+    /* all done, lets put everything back */
+
+    for (i = 0; i <= job->TRCVnestLevel; i++) {
+        if (job->TRCVvType[i] == vcode) {   /* voltage source */
+            ((VSRCinstance*)(job->TRCVvElt[i]))->VSRCdcValue =
+                    job->TRCVvSave[i];
+            ((VSRCinstance*)(job->TRCVvElt[i]))->VSRCdcGiven = (job->TRCVgSave[i] != 0);
+        } else  if (job->TRCVvType[i] == icode) /*current source */ {
+            ((ISRCinstance*)(job->TRCVvElt[i]))->ISRCdcValue =
+                    job->TRCVvSave[i];
+            ((ISRCinstance*)(job->TRCVvElt[i]))->ISRCdcGiven = (job->TRCVgSave[i] != 0);
+        } else  if (job->TRCVvType[i] == rcode) /* Resistance */ {
+            ((RESinstance*)(job->TRCVvElt[i]))->RESresist =
+                    job->TRCVvSave[i];
+            /* We restore both resistance and conductance */
+            ((RESinstance*)(job->TRCVvElt[i]))->RESconduct =
+                1/(((RESinstance*)(job->TRCVvElt[i]))->RESresist);
+       
+            ((RESinstance*)(job->TRCVvElt[i]))->RESresGiven = (job->TRCVgSave[i] != 0);
+            CKTlinearFree(&((RESinstance*)(job->TRCVvElt[i]))->RESmodPtr->RESlinear);
+            DEVices[rcode]->DEVload(job->TRCVvElt[i]->GENmodPtr, ckt);
+       
+       /*
+        * RESload(job->TRCVvElt[i]->GENmodPtr, ckt);
+        */ 
+        }
+        else if (job->TRCVvType[i] == TEMP_CODE) {
+            ckt->CKTtemp = job->TRCVvSave[i];
+            CKTtemp(ckt);
+            if (expr_w_temper)
+                inp_evaluate_temper();
+        } /* else not possible */
+    }
+    SPfrontEnd->OUTendPlot (plot);
+
+    return(OK);
+}
+
+
+/* Walk the sweep from level i on, as far as the sources have not
+ * reached their stop values, or for outerLeft steps of the outermost
+ * source if that is positive.  The points are written to plot, or, if
+ * outBuf is given, stored there as the reference value followed by the
+ * solution vector, and counted in numPoints.
+ */
+static int
+DCsweep(CKTcircuit *ckt, TRCV *job, runDesc *plot, int i,
+        int outerLeft, double *outBuf, int *numPoints)
+{
+    double *temp;
+    int converged;
+    int rcode = CKTtypelook("Resistor");
+    int vcode = CKTtypelook("Vsource");
+    int icode = CKTtypelook("Isource");
+    int j;
+    int firstTime=1;
+
+#ifdef WANT_SENSE2
+    int error;
+    long save;
+#endif
+
     for(;;) {
 
         if (job->TRCVvType[i] == vcode) { /* voltage source */
@@ -317,6 +418,7 @@ resume:
                          1/(((RESinstance *)(job->TRCVvElt[i]))->RESresist);
                          /* Note: changing the resistance does nothing */
                          /* changing the conductance 1/r instead */
+                CKTlinearFree(&((RESinstance*)(job->TRCVvElt[i]))->RESmodPtr->RESlinear);
                 DEVices[rcode]->DEVload(job->TRCVvElt[i]->GENmodPtr, ckt);
       
       /*
@@ -480,10 +582,19 @@ resume:
             ipc_send_data_prefix(ckt->CKTtime);
 #endif
 
-        CKTdump(ckt,ckt->CKTtime,plot);
+        if (outBuf) {
+            /* keep the point for the parent process */
+            *outBuf++ = ckt->CKTtime;
+            memcpy(outBuf, ckt->CKTrhsOld + 1,
+                   (size_t) (ckt->CKTmaxEqNum - 1) * sizeof(double));
+            outBuf += ckt->CKTmaxEqNum - 1;
+            (*numPoints)++;
+        } else {
+            CKTdump(ckt,ckt->CKTtime,plot);
+        }
 
         if (ckt->CKTsoaCheck)
-            error = CKTsoaCheck(ckt);
+            (void) CKTsoaCheck(ckt);
 
 #ifdef XSPICE
         if(g_ipc.enabled)
@@ -500,32 +611,12 @@ resume:
 
 nextstep:;
 
-        if (job->TRCVvType[i] == vcode) { /* voltage source */
-            ((VSRCinstance*)(job->TRCVvElt[i]))->VSRCdcValue +=
-                    job->TRCVvStep[i];
-        } else if (job->TRCVvType[i] == icode) { /* current source */
-            ((ISRCinstance*)(job->TRCVvElt[i]))->ISRCdcValue +=
-                    job->TRCVvStep[i];
-        } else if (job->TRCVvType[i] == rcode) { /* resistance */
-            ((RESinstance*)(job->TRCVvElt[i]))->RESresist +=
-                    job->TRCVvStep[i];
-            /* This code should update resistance and conductance */    
-            ((RESinstance*)(job->TRCVvElt[i]))->RESconduct =
-                1/(((RESinstance*)(job->TRCVvElt[i]))->RESresist);
-            DEVices[rcode]->DEVload(job->TRCVvElt[i]->GENmodPtr, ckt);
-            /*
-        * RESload(job->TRCVvElt[i]->GENmodPtr, ckt);
-        */ 
-        }
-        /* PN Temp Sweep - serban */
-        else if (job->TRCVvType[i] == TEMP_CODE)
-        {
-            ckt->CKTtemp += job->TRCVvStep[i];
-            CKTtemp(ckt);	    
-            if (expr_w_temper)
-                inp_evaluate_temper();
-        } /* else not possible */
-        
+        DCstep(ckt, job, i);
+
+        /* the chunk of a split sweep ends with its last outer point */
+        if (outerLeft > 0 && i == job->TRCVnestLevel && --outerLeft == 0)
+            return(OK);
+
         if(SPfrontEnd->IFpauseTest()) {
             /* user asked us to pause, so save state */
             job->TRCVnestState = i;
@@ -539,39 +630,227 @@ nextstep:;
 #endif
     }
 
-    /* all done, lets put everything back */
+    return(OK);
+}
 
-    for (i = 0; i <= job->TRCVnestLevel; i++) {
-        if (job->TRCVvType[i] == vcode) {   /* voltage source */
-            ((VSRCinstance*)(job->TRCVvElt[i]))->VSRCdcValue =
-                    job->TRCVvSave[i];
-            ((VSRCinstance*)(job->TRCVvElt[i]))->VSRCdcGiven = (job->TRCVgSave[i] != 0);
-        } else  if (job->TRCVvType[i] == icode) /*current source */ {
-            ((ISRCinstance*)(job->TRCVvElt[i]))->ISRCdcValue =
-                    job->TRCVvSave[i];
-            ((ISRCinstance*)(job->TRCVvElt[i]))->ISRCdcGiven = (job->TRCVgSave[i] != 0);
-        } else  if (job->TRCVvType[i] == rcode) /* Resistance */ {
-            ((RESinstance*)(job->TRCVvElt[i]))->RESresist =
-                    job->TRCVvSave[i];
-            /* We restore both resistance and conductance */
-            ((RESinstance*)(job->TRCVvElt[i]))->RESconduct =
-                1/(((RESinstance*)(job->TRCVvElt[i]))->RESresist);
-       
-            ((RESinstance*)(job->TRCVvElt[i]))->RESresGiven = (job->TRCVgSave[i] != 0);
-            DEVices[rcode]->DEVload(job->TRCVvElt[i]->GENmodPtr, ckt);
-       
-       /*
-        * RESload(job->TRCVvElt[i]->GENmodPtr, ckt);
-        */ 
+
+/* Advance the source or temperature of sweep level i by one step. */
+static void
+DCstep(CKTcircuit *ckt, TRCV *job, int i)
+{
+    int rcode = CKTtypelook("Resistor");
+    int vcode = CKTtypelook("Vsource");
+    int icode = CKTtypelook("Isource");
+
+
+    if (job->TRCVvType[i] == vcode) { /* voltage source */
+        ((VSRCinstance*)(job->TRCVvElt[i]))->VSRCdcValue +=
+                job->TRCVvStep[i];
+    } else if (job->TRCVvType[i] == icode) { /* current source */
+        ((ISRCinstance*)(job->TRCVvElt[i]))->ISRCdcValue +=
+                job->TRCVvStep[i];
+    } else if (job->TRCVvType[i] == rcode) { /* resistance */
+        ((RESinstance*)(job->TRCVvElt[i]))->RESresist +=
+                job->TRCVvStep[i];
+        /* This code should update resistance and conductance */    
+        ((RESinstance*)(job->TRCVvElt[i]))->RESconduct =
+            1/(((RESinstance*)(job->TRCVvElt[i]))->RESresist);
+        CKTlinearFree(&((RESinstance*)(job->TRCVvElt[i]))->RESmodPtr->RESlinear);
+        DEVices[rcode]->DEVload(job->TRCVvElt[i]->GENmodPtr, ckt);
+        /*
+    * RESload(job->TRCVvElt[i]->GENmodPtr, ckt);
+    */ 
+    }
+    /* PN Temp Sweep - serban */
+    else if (job->TRCVvType[i] == TEMP_CODE)
+    {
+        ckt->CKTtemp += job->TRCVvStep[i];
+        CKTtemp(ckt);	    
+        if (expr_w_temper)
+            inp_evaluate_temper();
+    } /* else not possible */
+}
+
+
+#ifdef DC_FORK_SWEEP
+/* Number of points of sweep level i, counted the way DCsweep() steps,
+ * -1 if the sweep does not end.
+ */
+static int
+DCcountPoints(TRCV *job, int i)
+{
+    /* the temperature is stepped in Kelvin */
+    double offset = (job->TRCVvType[i] == TEMP_CODE) ? CONSTCtoK : 0.0;
+    double step = job->TRCVvStep[i];
+    double val = job->TRCVvStart[i] + offset;
+    int n = 0;
+
+    if (step == 0.0)
+        return -1;
+
+    while ((val - offset) * SIGN(1.0, step) - SIGN(1.0, step) *
+           job->TRCVvStop[i] <= DBL_EPSILON*1e+03) {
+        if (++n > 100000000)
+            return -1;
+        val += step;
+    }
+
+    return n;
+}
+
+
+/* Split the sweep among dc_processes processes.
+ *
+ * The points of the outermost source are divided into contiguous
+ * chunks.  The first chunk is run here, every other one by a forked copy
+ * of this process, which has its own copy of the circuit.  It starts
+ * its chunk from the initial junction voltages, as the sweep does at
+ * its first point, and leaves its points in shared memory, from where
+ * they are written to the plot in sweep order.  A chunk which did not
+ * finish, e.g. because of a convergence problem, is done again here,
+ * and the rest of the sweep with it.
+ *
+ * Returns 0 if the sweep is not split, otherwise 1 with the result of
+ * the sweep in *error.
+ */
+static int
+DCforkSweep(CKTcircuit *ckt, TRCV *job, runDesc *plot, int *error)
+{
+    int outer = job->TRCVnestLevel;
+    int nworkers, nforked, nouter, ninner, nval, npoints;
+    int c, k, n, wstatus;
+    int *first;
+    pid_t *pid;
+    int *shared;        /* points done and result of each chunk */
+    double *data, *buf;
+    size_t headSize, mapSize;
+    void *map;
+
+    if (!cp_getvar("dc_processes", CP_NUM, &nworkers) || nworkers < 2)
+        return 0;
+
+    /* the points must not need anything but the solution vector */
+    if (ckt->CKTsoaCheck || OUTpHasSpecial(plot))
+        return 0;
+#ifdef XSPICE
+    if (ckt->evt->counts.num_insts != 0 || g_ipc.enabled)
+        return 0;
+#endif
+#ifdef WANT_SENSE2
+    if (ckt->CKTsenInfo && (ckt->CKTsenInfo->SENmode & DCSEN))
+        return 0;
+#endif
+#ifdef CIDER
+    for (k = 0; k < DEVmaxnum; k++)
+        if (DEVices[k] && DEVices[k]->DEVdump && ckt->CKThead[k])
+            return 0;
+#endif
+
+    nouter = DCcountPoints(job, outer);
+    ninner = (outer > 0) ? DCcountPoints(job, 0) : 1;
+    if (nouter < 2 || ninner < 1)
+        return 0;
+    if (nworkers > nouter)
+        nworkers = nouter;
+
+    first = TMALLOC(int, nworkers + 1);
+    for (c = 0; c <= nworkers; c++)
+        first[c] = (int) ((long) c * nouter / nworkers);
+
+    /* reference value and solution of each point */
+    nval = ckt->CKTmaxEqNum;
+    headSize = (2 * (size_t) nworkers * sizeof(int) + sizeof(double) - 1)
+        / sizeof(double) * sizeof(double);
+    mapSize = headSize + (size_t) (nouter - first[1]) * (size_t) ninner
+        * (size_t) nval * sizeof(double);
+    map = mmap(NULL, mapSize, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) {
+        tfree(first);
+        return 0;
+    }
+    shared = (int *) map;
+    data = (double *) ((char *) map + headSize);
+
+    pid = TMALLOC(pid_t, nworkers);
+    /* the rawfile writer thread is not copied into the children */
+    OUTrawClose();
+    fflush(NULL);
+    for (nforked = 1; nforked < nworkers; nforked++) {
+        c = nforked;
+        pid[c] = fork();
+        if (pid[c] < 0)
+            break;
+        if (pid[c] == 0) {
+            /* the child, interrupts are left to the parent */
+            signal(SIGINT, SIG_IGN);
+#ifdef USE_OMP
+            omp_set_num_threads(1);
+#endif
+            for (k = 0; k < first[c]; k++)
+                DCstep(ckt, job, outer);
+            ckt->CKTmode = (ckt->CKTmode & MODEUIC) |
+                MODEDCTRANCURVE | MODEINITJCT;
+            buf = data + (size_t) (first[c] - first[1]) * (size_t) ninner
+                * (size_t) nval;
+            n = 0;
+            shared[2 * c + 1] = DCsweep(ckt, job, plot, outer,
+                                        first[c + 1] - first[c], buf, &n);
+            shared[2 * c] = n;
+            /* the other streams belong to the parent */
+            fflush(stdout);
+            fflush(stderr);
+            _exit(0);
         }
-        else if (job->TRCVvType[i] == TEMP_CODE) {
-            ckt->CKTtemp = job->TRCVvSave[i];
-            CKTtemp(ckt);
-            if (expr_w_temper)
-                inp_evaluate_temper();
-        } /* else not possible */
     }
-    SPfrontEnd->OUTendPlot (plot);
 
-    return(OK);
+    /* the first chunk */
+    *error = DCsweep(ckt, job, plot, 0, first[1], NULL, NULL);
+
+    for (c = 1; c < nworkers && !*error; c++) {
+        npoints = (first[c + 1] - first[c]) * ninner;
+        if (c >= nforked)
+            break;
+        while ((n = waitpid(pid[c], &wstatus, 0)) < 0 && errno == EINTR)
+            ;
+        if (n != pid[c])
+            break;
+        /* reaped */
+        pid[c] = 0;
+        if (!WIFEXITED(wstatus) || shared[2 * c + 1] != OK ||
+            shared[2 * c] != npoints)
+            break;
+
+        buf = data + (size_t) (first[c] - first[1]) * (size_t) ninner
+            * (size_t) nval;
+        for (k = 0; k < npoints; k++, buf += nval) {
+            memcpy(ckt->CKTrhsOld + 1, buf + 1,
+                   (size_t) (nval - 1) * sizeof(double));
+            CKTdump(ckt, buf[0], plot);
+        }
+
+        for (k = first[c]; k < first[c + 1]; k++)
+            DCstep(ckt, job, outer);
+    }
+
+    /* stop and reap the processes not waited for */
+    for (k = c; k < nforked; k++)
+        if (pid[k] > 0) {
+            kill(pid[k], SIGKILL);
+            while (waitpid(pid[k], &wstatus, 0) < 0 && errno == EINTR)
+                ;
+        }
+
+    if (c < nworkers && !*error) {
+        /* go on from chunk c */
+        ckt->CKTmode = (ckt->CKTmode & MODEUIC) |
+            MODEDCTRANCURVE | MODEINITJCT;
+        *error = DCsweep(ckt, job, plot, outer, -1, NULL, NULL);
+    }
+
+    munmap(map, mapSize);
+    tfree(pid);
+    tfree(first);
+    return 1;
 }
+#endif
@@ -21,12 +21,233 @@ Modified: 2001 AlansFixes
 #include "vsrc/vsrcdefs.h"
 #include "isrc/isrcdefs.h"
 
+#ifdef USE_OMP
+#include <omp.h>
+#endif
+
 // fixme
 //   ugly hack to work around missing api to specify the "type" of signals
 extern int fixme_onoise_type;
 extern int fixme_inoise_type;
 
 
+/* advance freq to the next point of the sweep */
+static int
+NOISEnextFreq(NOISEAN *job, double *freq)
+{
+    switch (job->NstpType) {
+
+    case DECADE:
+    case OCTAVE:
+	*freq *= job->NfreqDelta;
+	return 1;
+
+    case LINEAR:
+	*freq += job->NfreqDelta;
+	return 1;
+
+    default:
+	return 0;
+    }
+}
+
+
+/*
+ * Evaluate the noise densities of the frequency point data->freq.  The
+ * transfer function between input and output is realVal + j imagVal,
+ * the solution of the adjoint system is in CKTrhs and CKTirhs.
+ */
+static int
+NOISEdensity(CKTcircuit *ckt, NOISEAN *job, Ndata *data, int step,
+	     double realVal, double imagVal)
+{
+    int error;
+
+    data->GainSqInv = 1.0 / MAX(((realVal*realVal)
+	    + (imagVal*imagVal)),N_MINGAIN);
+    data->lnGainInv = log(data->GainSqInv);
+
+    /* set up a block of "common" data so we don't have to
+     * recalculate it for every device
+     */
+
+    data->delFreq = data->freq - data->lstFreq;
+    data->lnFreq = log(MAX(data->freq,N_MINLOG));
+    data->lnLastFreq = log(MAX(data->lstFreq,N_MINLOG));
+    data->delLnFreq = data->lnFreq - data->lnLastFreq;
+
+    if ((job->NStpsSm != 0) && ((step % (job->NStpsSm)) == 0)) {
+	data->prtSummary = TRUE;
+    } else {
+	data->prtSummary = FALSE;
+    }
+
+    /*
+    data->outNumber = 1;
+    */
+
+    data->outNumber = 0;
+    /* the frequency will NOT be stored in array[0]  as before; instead,
+     * it will be given in refVal.rValue (see later)
+     */
+
+    /* now we use the adjoint system to calculate the noise
+     * contributions of each generator in the circuit
+     */
+
+    error = CKTnoise(ckt,N_DENS,N_CALC,data);
+    if (error) return(error);
+    data->lstFreq = data->freq;
+
+    return(OK);
+}
+
+
+#ifdef USE_OMP
+/* Sweep the remaining frequency points, solving several of them at once.
+ *
+ * As in ACbatchSweep(), the matrix is loaded serially for each point,
+ * and copies of it are factored in parallel with the pivot order of the
+ * last factorization.  Each factored copy is solved for the input
+ * excitation and, transposed, for the unit excitation at the output,
+ * which gives the transfer function and the adjoint solution of that
+ * point.  The noise generators are then evaluated in frequency order,
+ * since the integrated noise of the devices depends on the point before.
+ * A point which runs into a zero pivot is done again by NIacIter() and
+ * NInzIter(), and the points after it are loaded again.
+ */
+static int
+NOISEbatchSweep(CKTcircuit *ckt, NOISEAN *job, Ndata *data, int *step,
+		double freqTol)
+{
+    int posOutNode = (job->output) -> number;
+    int negOutNode = (job->outputRef) -> number;
+    GENinstance *inst = ckt->noise_input;
+    int size = SMPmatSize(ckt->CKTmatrix);
+    int nbatch = omp_get_max_threads();
+    int nval = -1;
+    int more = 1;
+    int error = OK;
+    int i, n;
+    double freq = data->freq;
+    double realVal, imagVal;
+    double *freqs = TMALLOC(double, nbatch);
+    int *status = TMALLOC(int, nbatch);
+    double *rhs = TMALLOC(double, 4 * (size + 1) * nbatch);
+    double *work = TMALLOC(double, 2 * (size + 1) * nbatch);
+    double *values = NULL;
+    double startTime;
+
+    while (more) {
+        if (SPfrontEnd->IFpauseTest()) {
+	    job->NsavFstp = *step;   /* save our results */
+	    job->NsavOnoise = data->outNoiz; /* up until now     */
+	    job->NsavInoise = data->inNoise;
+            error = E_PAUSE;
+            break;
+        }
+
+        /* the pivot order has changed, or this is the first batch */
+        if (nval < 0) {
+            nval = SMPcCopySize(ckt->CKTmatrix);
+            if (nval < 0) {
+                error = E_NOMEM;
+                break;
+            }
+            tfree(values);
+            values = TMALLOC(double, (size_t) nval * (size_t) nbatch);
+        }
+
+        for (n = 0; n < nbatch && more; n++) {
+            double *r = rhs + 4 * (size + 1) * n;
+            ckt->CKTomega = 2.0 * M_PI * freq;
+            ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODEAC | MODEACNOISE;
+            ckt->noise_input = inst;
+            error = CKTacLoad(ckt);
+            if (error)
+                break;
+            SMPcCopyGather(ckt->CKTmatrix, values + (size_t) nval * (size_t) n);
+            memcpy(r, ckt->CKTrhs, (size_t) (size + 1) * sizeof(double));
+            memcpy(r + size + 1, ckt->CKTirhs, (size_t) (size + 1) * sizeof(double));
+            freqs[n] = freq;
+            NOISEnextFreq(job, &freq);
+            more = freq <= job->NstopFreq + freqTol;
+        }
+        if (error)
+            break;
+
+        startTime = SPfrontEnd->IFseconds();
+#pragma omp parallel for schedule(dynamic)
+        for (i = 0; i < n; i++) {
+            double *r = rhs + 4 * (size + 1) * i;
+            double *a = r + 2 * (size + 1);
+            double *v = values + (size_t) nval * (size_t) i;
+            double *w = work + 2 * (size + 1) * omp_get_thread_num();
+            status[i] = SMPcCopySolve(ckt->CKTmatrix, v, w, r, r + size + 1);
+            if (!status[i]) {
+                /* apply unit current excitation */
+                memset(a, 0, 2 * (size_t) (size + 1) * sizeof(double));
+                a[posOutNode] = 1.0;
+                a[negOutNode] = -1.0;
+                SMPcCopySolveTransposed(ckt->CKTmatrix, v, w, a, a + size + 1);
+            }
+        }
+        ckt->CKTstat->STATdecompTime += SPfrontEnd->IFseconds() - startTime;
+
+        for (i = 0; i < n; i++) {
+            data->freq = freqs[i];
+            /* read by the noise generators of some devices (HiSIM2) */
+            ckt->CKTomega = 2.0 * M_PI * freqs[i];
+            if (status[i]) {
+                ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODEAC | MODEACNOISE;
+                ckt->noise_input = inst;
+                error = NIacIter(ckt);
+                if (error)
+                    break;
+                realVal = ckt->CKTrhsOld [posOutNode]
+                    - ckt->CKTrhsOld [negOutNode];
+                imagVal = ckt->CKTirhsOld [posOutNode]
+                    - ckt->CKTirhsOld [negOutNode];
+                NInzIter(ckt, posOutNode, negOutNode);
+                nval = -1;
+                if (i + 1 < n) {
+                    freq = freqs[i + 1];
+                    more = 1;
+                    n = i + 1;
+                }
+            } else {
+                double *r = rhs + 4 * (size + 1) * i;
+                double *a = r + 2 * (size + 1);
+                r[0] = r[size + 1] = 0.0;
+                realVal = r[posOutNode] - r[negOutNode];
+                imagVal = r[size + 1 + posOutNode] - r[size + 1 + negOutNode];
+                memcpy(ckt->CKTrhs, a, (size_t) (size + 1) * sizeof(double));
+                memcpy(ckt->CKTirhs, a + size + 1, (size_t) (size + 1) * sizeof(double));
+                ckt->CKTrhs[0] = 0.0;
+                ckt->CKTirhs[0] = 0.0;
+            }
+
+            error = NOISEdensity(ckt, job, data, *step, realVal, imagVal);
+            if (error)
+                break;
+            (*step)++;
+        }
+        if (error)
+            break;
+    }
+
+    data->freq = freq;
+
+    tfree(values);
+    tfree(work);
+    tfree(rhs);
+    tfree(status);
+    tfree(freqs);
+    return(error);
+}
+#endif
+
+
 int
 NOISEan (CKTcircuit *ckt, int restart)
 {
@@ -237,61 +458,28 @@ NOISEan (CKTcircuit *ckt, int restart)
 		- ckt->CKTrhsOld [negOutNode];
 	imagVal = ckt->CKTirhsOld [posOutNode]
 		- ckt->CKTirhsOld [negOutNode];
-	data->GainSqInv = 1.0 / MAX(((realVal*realVal)
-		+ (imagVal*imagVal)),N_MINGAIN);
-	data->lnGainInv = log(data->GainSqInv);
-
-	/* set up a block of "common" data so we don't have to
-	 * recalculate it for every device
-	 */
-
-	data->delFreq = data->freq - data->lstFreq;
-	data->lnFreq = log(MAX(data->freq,N_MINLOG));
-	data->lnLastFreq = log(MAX(data->lstFreq,N_MINLOG));
-        data->delLnFreq = data->lnFreq - data->lnLastFreq;
-
-	if ((job->NStpsSm != 0) && ((step % (job->NStpsSm)) == 0)) {
-	    data->prtSummary = TRUE;
-        } else {
-	    data->prtSummary = FALSE;
-        }
-
-	/*
-	data->outNumber = 1;       
-	*/
-
-	data->outNumber = 0;
-	/* the frequency will NOT be stored in array[0]  as before; instead,
-	 * it will be given in refVal.rValue (see later)
-	 */
 
 	NInzIter(ckt,posOutNode,negOutNode);   /* solve the adjoint system */
 
-	/* now we use the adjoint system to calculate the noise
-	 * contributions of each generator in the circuit
-	 */
-
-	error = CKTnoise(ckt,N_DENS,N_CALC,data);
+	error = NOISEdensity(ckt, job, data, step, realVal, imagVal);
 	if (error) return(error);
-	data->lstFreq = data->freq;
 
 	/* update the frequency */
 
-	switch (job->NstpType) {
-
-	case DECADE:
-	case OCTAVE:
-	    data->freq *= job->NfreqDelta;
-	    break;
-
-        case LINEAR:
-	    data->freq += job->NfreqDelta;
-	    break;
-        
-	default:
+	if (!NOISEnextFreq(job, &data->freq))
 	    return(E_INTERN);
-        }
 	step++;
+
+#ifdef USE_OMP
+	/* the rest of the sweep can be solved in parallel */
+	if (omp_get_max_threads() > 1) {
+	    if (data->freq <= job->NstopFreq + freqTol) {
+		error = NOISEbatchSweep(ckt, job, data, &step, freqTol);
+		if (error) return(error);
+	    }
+	    break;
+	}
+#endif
     }
 
     error = CKTnoise(ckt,N_DENS,N_CLOSE,data);
@@ -30,6 +30,8 @@ TFanal(CKTcircuit *ckt, int restart)
     int error;
     int converged;
     int i;
+    int sameres;
+    double *rhs[2];
     runDesc *plotptr = NULL;   /* pointer to out plot */
     GENinstance *ptr = NULL;
     IFuid uids[3];
@@ -70,22 +72,41 @@ TFanal(CKTcircuit *ckt, int restart)
         return E_NOTFOUND;
     }
 
+    /* The excitation at the input gives the transfer function and the
+     * input resistance, the one at the output the output resistance.
+     * Both are solved with the operating point factorization at once.
+     */
     size = SMPmatSize(ckt->CKTmatrix);
+    rhs[0] = ckt->CKTrhs;
+    rhs[1] = ckt->CKTrhsSpare;
     for(i=0;i<=size;i++) {
-        ckt->CKTrhs[i] = 0;
+        rhs[0][i] = 0;
+        rhs[1][i] = 0;
     }
 
     if (job->TFinIsI) {
-        ckt->CKTrhs[ptr->GENnode1] -= 1;
-        ckt->CKTrhs[ptr->GENnode2] += 1;
+        rhs[0][ptr->GENnode1] -= 1;
+        rhs[0][ptr->GENnode2] += 1;
     } else {
         insrc = CKTfndBranch(ckt, job->TFinSrc);
-        ckt->CKTrhs[insrc] += 1;
+        rhs[0][insrc] += 1;
     }
 
+    if (job->TFoutIsV) {
+        rhs[1][job->TFoutPos->number] -= 1;
+        rhs[1][job->TFoutNeg->number] += 1;
+    } else {
+        outsrc = CKTfndBranch(ckt, job->TFoutSrc);
+        rhs[1][outsrc] += 1;
+    }
 
-    SMPsolve(ckt->CKTmatrix,ckt->CKTrhs,ckt->CKTrhsSpare);
-    ckt->CKTrhs[0]=0;
+    /* no need to compute output resistance when it is the same as
+       the input  */
+    sameres = job->TFoutIsI && job->TFoutSrc == job->TFinSrc;
+
+    SMPsolveMany(ckt->CKTmatrix, sameres ? 1 : 2, rhs);
+    rhs[0][0] = 0;
+    rhs[1][0] = 0;
 
     /* make a UID for the transfer function output */
     SPfrontEnd->IFnewUid (ckt, &tfuid, NULL, "Transfer_function", UID_OTHER, NULL);
@@ -110,52 +131,33 @@ TFanal(CKTcircuit *ckt, int restart)
 
     /*find transfer function */
     if (job->TFoutIsV) {
-        outputs[0] = ckt->CKTrhs[job->TFoutPos->number] -
-            ckt->CKTrhs[job->TFoutNeg->number];
+        outputs[0] = rhs[0][job->TFoutPos->number] -
+            rhs[0][job->TFoutNeg->number];
     } else {
-        outsrc = CKTfndBranch(ckt, job->TFoutSrc);
-        outputs[0] = ckt->CKTrhs[outsrc];
+        outputs[0] = rhs[0][outsrc];
     }
 
     /* now for input resistance */
     if (job->TFinIsI) {
-        outputs[1] = ckt->CKTrhs[ptr->GENnode2] -
-                ckt->CKTrhs[ptr->GENnode1];
+        outputs[1] = rhs[0][ptr->GENnode2] -
+                rhs[0][ptr->GENnode1];
     } else {
-        if(fabs(ckt->CKTrhs[insrc])<1e-20) {
+        if(fabs(rhs[0][insrc])<1e-20) {
             outputs[1]=1e20;
         } else {
-            outputs[1] = -1/ckt->CKTrhs[insrc];
+            outputs[1] = -1/rhs[0][insrc];
         }
     }
 
-    if (job->TFoutIsI &&
-            (job->TFoutSrc ==
-            job->TFinSrc)) {
-        outputs[2]=outputs[1];
-        goto done;
-        /* no need to compute output resistance when it is the same as 
-           the input  */
-    }
     /* now for output resistance */
-    for(i=0;i<=size;i++) {
-        ckt->CKTrhs[i] = 0;
-    }
-    if (job->TFoutIsV) {
-        ckt->CKTrhs[job->TFoutPos->number] -= 1;
-        ckt->CKTrhs[job->TFoutNeg->number] += 1;
-    } else {
-        ckt->CKTrhs[outsrc] += 1;
-    }
-    SMPsolve(ckt->CKTmatrix,ckt->CKTrhs,ckt->CKTrhsSpare);
-    ckt->CKTrhs[0]=0;
-    if (job->TFoutIsV) {
-        outputs[2] = ckt->CKTrhs[job->TFoutNeg->number] -
-            ckt->CKTrhs[job->TFoutPos->number];
+    if (sameres) {
+        outputs[2]=outputs[1];
+    } else if (job->TFoutIsV) {
+        outputs[2] = rhs[1][job->TFoutNeg->number] -
+            rhs[1][job->TFoutPos->number];
     } else {
-        outputs[2] = 1/MAX(1e-20,ckt->CKTrhs[outsrc]);
+        outputs[2] = 1/MAX(1e-20,rhs[1][outsrc]);
     }
-done:
     outdata.v.numValue=3;
     outdata.v.vec.rVec=outputs;
     refval.rValue = 0;
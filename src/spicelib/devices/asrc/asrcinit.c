@@ -74,7 +74,10 @@ SPICEdev ASRCinfo = {
     /* DEVacct       */ NULL,
 #endif
     /* DEVinstSize   */ &ASRCiSize,
-    /* DEVmodSize    */ &ASRCmSize
+    /* DEVmodSize    */ &ASRCmSize,
+    /* DEVloadInst   */ NULL,
+    /* DEVstampMat   */ 0,
+    /* DEVstampRhs   */ 0
 };
 
 
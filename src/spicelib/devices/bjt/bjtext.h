@@ -14,6 +14,7 @@ extern int BJTdelete(GENmodel*,IFuid,GENinstance**);
 extern void BJTdestroy(GENmodel**);
 extern int BJTgetic(GENmodel*,CKTcircuit*);
 extern int BJTload(GENmodel*,CKTcircuit*);
+extern int BJTloadInst(GENinstance*,CKTcircuit*,CKTstamp*);
 extern int BJTmAsk(CKTcircuit*,GENmodel*,int,IFvalue*);
 extern int BJTmDelete(GENmodel**,IFuid,GENmodel*);
 extern int BJTmParam(int,IFvalue*,GENmodel*);
@@ -73,8 +73,10 @@ SPICEdev BJTinfo = {                  /* description from struct IFdevice  */
  /* DEVacct       */ NULL,
 #endif                     
  /* DEVinstSize   */ &BJTiSize,
- /* DEVmodSize    */ &BJTmSize
-
+ /* DEVmodSize    */ &BJTmSize,
+ /* DEVloadInst   */ BJTloadInst,
+ /* DEVstampMat   */ 24,
+ /* DEVstampRhs   */ 6
 };
 
 
@@ -73,7 +73,10 @@ SPICEdev B1info = {
  /* DEVacct       */ NULL,
 #endif    
  /* DEVinstSize   */ &B1iSize,
- /* DEVmodSize    */ &B1mSize
+ /* DEVmodSize    */ &B1mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -73,7 +73,10 @@ SPICEdev B2info = {
  /* DEVacct       */ NULL,
 #endif    
  /* DEVinstSize   */ &B2iSize,
- /* DEVmodSize    */ &B2mSize
+ /* DEVmodSize    */ &B2mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -72,7 +72,10 @@ SPICEdev BSIM3info = {
  /* DEVacct       */ NULL,
 #endif                       
  /* DEVinstSize   */ &BSIM3iSize,
- /* DEVmodSize    */ &BSIM3mSize
+ /* DEVmodSize    */ &BSIM3mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -70,7 +70,10 @@ SPICEdev B3SOIDDinfo = {
  /* DEVacct       */ NULL,
 #endif
  /* DEVinstSize   */ &B3SOIDDiSize,
- /* DEVmodSize    */ &B3SOIDDmSize
+ /* DEVmodSize    */ &B3SOIDDmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 };
 
 SPICEdev *
@@ -71,7 +71,10 @@ SPICEdev B3SOIFDinfo = {
  /* DEVacct       */ NULL,
 #endif    
  /* DEVinstSize*/	&B3SOIFDiSize,
- /* DEVmodSize*/	&B3SOIFDmSize
+ /* DEVmodSize*/	&B3SOIFDmSize,
+ /* DEVloadInst*/	NULL,
+ /* DEVstampMat*/	0,
+ /* DEVstampRhs*/	0
 };
 
 
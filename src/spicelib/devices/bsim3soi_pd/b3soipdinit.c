@@ -72,7 +72,10 @@ SPICEdev B3SOIPDinfo = {
  /* DEVacct*/        NULL,
 #endif
  /* DEVinstSize*/   &B3SOIPDiSize,
- /* DEVmodSize*/    &B3SOIPDmSize
+ /* DEVmodSize*/    &B3SOIPDmSize,
+ /* DEVloadInst*/    NULL,
+ /* DEVstampMat*/    0,
+ /* DEVstampRhs*/    0
 };
 
 SPICEdev *
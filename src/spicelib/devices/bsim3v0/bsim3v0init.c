@@ -71,7 +71,10 @@ SPICEdev B3v0info = {
  /* DEVacct       */ NULL,
 #endif                    
  /* DEVinstSize   */ &BSIM3v0iSize,
- /* DEVmodSize    */ &BSIM3v0mSize
+ /* DEVmodSize    */ &BSIM3v0mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -71,7 +71,10 @@ SPICEdev BSIM3v1info = {
  /* DEVacct       */ NULL,
 #endif                    
  /* DEVinstSize   */ &BSIM3v1iSize,
- /* DEVmodSize    */ &BSIM3v1mSize
+ /* DEVmodSize    */ &BSIM3v1mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
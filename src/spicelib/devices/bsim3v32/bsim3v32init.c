@@ -72,7 +72,10 @@ SPICEdev BSIM3v32info = {
  /* DEVacct       */ NULL,
 #endif
  /* DEVinstSize   */ &BSIM3v32iSize,
- /* DEVmodSize    */ &BSIM3v32mSize
+ /* DEVmodSize    */ &BSIM3v32mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
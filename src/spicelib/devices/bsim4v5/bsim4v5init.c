@@ -73,7 +73,10 @@ SPICEdev BSIM4v5info = {
     NULL,          /* DEVacct        */
 #endif
     &BSIM4v5iSize,   /* DEVinstSize    */
-    &BSIM4v5mSize    /* DEVmodSize     */
+    &BSIM4v5mSize,   /* DEVmodSize     */
+    NULL,            /* DEVloadInst    */
+    0,               /* DEVstampMat    */
+    0                /* DEVstampRhs    */
 };
 
 
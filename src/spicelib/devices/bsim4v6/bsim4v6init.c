@@ -73,7 +73,10 @@ SPICEdev BSIM4v6info = {
     NULL,          /* DEVacct        */
 #endif
     &BSIM4v6iSize,   /* DEVinstSize    */
-    &BSIM4v6mSize    /* DEVmodSize     */
+    &BSIM4v6mSize,   /* DEVmodSize     */
+    NULL,            /* DEVloadInst    */
+    0,               /* DEVstampMat    */
+    0                /* DEVstampRhs    */
 };
 
 
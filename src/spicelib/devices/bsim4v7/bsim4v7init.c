@@ -73,7 +73,10 @@ SPICEdev BSIM4v7info = {
     NULL,          /* DEVacct        */
 #endif
     &BSIM4v7iSize,   /* DEVinstSize    */
-    &BSIM4v7mSize    /* DEVmodSize     */
+    &BSIM4v7mSize,   /* DEVmodSize     */
+    NULL,            /* DEVloadInst    */
+    0,               /* DEVstampMat    */
+    0                /* DEVstampRhs    */
 };
 
 
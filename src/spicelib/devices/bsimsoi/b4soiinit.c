@@ -71,7 +71,10 @@ SPICEdev B4SOIinfo = {
  /* DEVacct       */ NULL,
 #endif
  /* DEVinstSize   */ &B4SOIiSize,
- /* DEVmodSize    */ &B4SOImSize
+ /* DEVmodSize    */ &B4SOImSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 };
 
 SPICEdev *
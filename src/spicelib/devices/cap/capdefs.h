@@ -111,6 +111,8 @@ typedef struct sCAPmodel {      /* model structure for a capacitor */
     unsigned CAPthickGiven     : 1;    /* flags indicates insulator thickness given */
     unsigned CAPbv_maxGiven    : 1;    /* flags indicates maximum voltage is given */
 
+
+    CKTlinear *CAPlinear;   /* the instances in arrays, for the load */
 } CAPmodel;
 
 /* device parameters */
@@ -7,6 +7,7 @@ Modified: September 2003 Paolo Nenzi
  */
 
 #include "ngspice/ngspice.h"
+#include "ngspice/cktlinear.h"
 #include "capdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -26,6 +27,7 @@ CAPdelete(GENmodel *inModel, IFuid name, GENinstance **inst)
         for(here = *prev; here ; here = *prev) {
             if(here->CAPname == name || (fast && here==*fast) ) {
                 *prev= here->CAPnextInstance;
+                CKTlinearFree(&model->CAPlinear);
                 FREE(here);
                 return(OK);
             }
@@ -7,6 +7,7 @@ Modified: September 2003 Paolo Nenzi
  */
 
 #include "ngspice/ngspice.h"
+#include "ngspice/cktlinear.h"
 #include "capdefs.h"
 #include "ngspice/suffix.h"
 
@@ -25,6 +26,7 @@ CAPdestroy(GENmodel **inModel)
     for( ; mod ; mod = mod->CAPnextModel) {
         if(oldmod) FREE(oldmod);
         oldmod = mod;
+        CKTlinearFree(&mod->CAPlinear);
         prev = NULL;
         for(here = mod->CAPinstances ; here ; here = here->CAPnextInstance) {
             if(prev) FREE(prev);
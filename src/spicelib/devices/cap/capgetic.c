@@ -6,6 +6,7 @@ Modified: September 2003 Paolo Nenzi
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktlinear.h"
 #include "capdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -23,6 +24,7 @@ CAPgetic(GENmodel *inModel, CKTcircuit *ckt)
      */
 
     for( ; model ; model = model->CAPnextModel) {
+        CKTlinearFree(&model->CAPlinear);
         for(here = model->CAPinstances; here ; here = here->CAPnextInstance) {
                 
             if(!here->CAPicGiven) {
@@ -6,11 +6,72 @@ Modified: September 2003 Paolo Nenzi
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktlinear.h"
 #include "capdefs.h"
 #include "ngspice/trandefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
 
+
+/* copy what the load needs of the instances of a model into arrays:
+ * capacitance, multiplier and initial condition, the nodes, the state
+ * vector entries and the matrix pointers
+ */
+static CKTlinear *
+CAPlinearMake(CAPmodel *model)
+{
+    CAPinstance *here;
+    CKTlinear *lin;
+    double **elt;
+    int k;
+
+    k = 0;
+    for (here = model->CAPinstances; here != NULL ;
+            here=here->CAPnextInstance)
+        k++;
+
+    lin = CKTlinearNew(k, 4);
+    elt = lin->elt;
+
+    k = 0;
+    for (here = model->CAPinstances; here != NULL ;
+            here=here->CAPnextInstance) {
+        lin->val[k] = here->CAPcapac;
+        lin->par[k] = here->CAPm;
+        lin->init[k] = here->CAPinitCond;
+        lin->posNode[k] = here->CAPposNode;
+        lin->negNode[k] = here->CAPnegNode;
+        lin->state[k] = here->CAPqcap;
+        k++;
+        *elt++ = here->CAPposPosptr;
+        *elt++ = here->CAPnegNegptr;
+        *elt++ = here->CAPposNegptr;
+        *elt++ = here->CAPnegPosptr;
+    }
+
+    return lin;
+}
+
+
+/* the charges from the capacitor voltages */
+static void
+CAPcharges(CKTlinear *lin, CKTcircuit *ckt, int cond1)
+{
+    double *rhsOld = ckt->CKTrhsOld;
+    double *state0 = ckt->CKTstate0;
+    int k;
+
+    if(cond1) {
+        for (k = 0; k < lin->count; k++)
+            state0[lin->state[k]] = lin->val[k] * lin->init[k];
+    } else {
+        for (k = 0; k < lin->count; k++)
+            state0[lin->state[k]] = lin->val[k] *
+                (rhsOld[lin->posNode[k]] - rhsOld[lin->negNode[k]]);
+    }
+}
+
+
 int
 CAPload(GENmodel *inModel, CKTcircuit *ckt)
 /* actually load the current capacitance value into the
@@ -18,70 +79,73 @@ CAPload(GENmodel *inModel, CKTcircuit *ckt)
  */
 {
     CAPmodel *model = (CAPmodel*)inModel;
-    CAPinstance *here;
+    CKTlinear *lin;
+    double **elt;
+    double *state0 = ckt->CKTstate0;
+    double *state1 = ckt->CKTstate1;
     int cond1;
-    double vcap;
-    double geq;
-    double ceq;
     int error;
+    int k;
     double m;
 
     /* check if capacitors are in the circuit or are open circuited */
-    if(ckt->CKTmode & (MODETRAN|MODEAC|MODETRANOP) ) {
-        /* evaluate device independent analysis conditions */
-        cond1=
-            ( ( (ckt->CKTmode & MODEDC) &&
-                (ckt->CKTmode & MODEINITJCT) )
-              || ( ( ckt->CKTmode & MODEUIC) &&
-                   ( ckt->CKTmode & MODEINITTRAN) ) ) ;
-        /*  loop through all the capacitor models */
-        for( ; model != NULL; model = model->CAPnextModel ) {
-
-            /* loop through all the instances of the model */
-            for (here = model->CAPinstances; here != NULL ;
-                    here=here->CAPnextInstance) {
-
-                m = here->CAPm;
-
-                if(cond1) {
-                    vcap = here->CAPinitCond;
-                } else {
-                    vcap = *(ckt->CKTrhsOld+here->CAPposNode) -
-                           *(ckt->CKTrhsOld+here->CAPnegNode) ;
-                }
-                if(ckt->CKTmode & (MODETRAN | MODEAC)) {
+    if(!(ckt->CKTmode & (MODETRAN|MODEAC|MODETRANOP)))
+        return(OK);
+
+    /* evaluate device independent analysis conditions */
+    cond1=
+        ( ( (ckt->CKTmode & MODEDC) &&
+            (ckt->CKTmode & MODEINITJCT) )
+          || ( ( ckt->CKTmode & MODEUIC) &&
+               ( ckt->CKTmode & MODEINITTRAN) ) ) ;
+
+    /*  loop through all the capacitor models */
+    for( ; model != NULL; model = model->CAPnextModel ) {
+
+        if (!model->CAPlinear)
+            model->CAPlinear = CAPlinearMake(model);
+        lin = model->CAPlinear;
+
+        if(!(ckt->CKTmode & (MODETRAN | MODEAC))) {
+            CAPcharges(lin, ckt, cond1);
+            continue;
+        }
+
+        /* first the charges and their integration for all instances,
+         * over the arrays ... */
 #ifndef PREDICTOR
-                    if(ckt->CKTmode & MODEINITPRED) {
-                        *(ckt->CKTstate0+here->CAPqcap) =
-                            *(ckt->CKTstate1+here->CAPqcap);
-                    } else { /* only const caps - no poly's */
+        if(ckt->CKTmode & MODEINITPRED) {
+            for (k = 0; k < lin->count; k++)
+                state0[lin->state[k]] = state1[lin->state[k]];
+        } else { /* only const caps - no poly's */
 #endif /* PREDICTOR */
-                        *(ckt->CKTstate0+here->CAPqcap) = here->CAPcapac * vcap;
-                        if((ckt->CKTmode & MODEINITTRAN)) {
-                            *(ckt->CKTstate1+here->CAPqcap) =
-                                *(ckt->CKTstate0+here->CAPqcap);
-                        }
+            CAPcharges(lin, ckt, cond1);
+            if((ckt->CKTmode & MODEINITTRAN)) {
+                for (k = 0; k < lin->count; k++)
+                    state1[lin->state[k]] = state0[lin->state[k]];
+            }
 #ifndef PREDICTOR
-                    }
+        }
 #endif /* PREDICTOR */
-                    error = NIintegrate(ckt,&geq,&ceq,here->CAPcapac,
-                                        here->CAPqcap);
-                    if(error) return(error);
-                    if(ckt->CKTmode & MODEINITTRAN) {
-                        *(ckt->CKTstate1+here->CAPccap) =
-                            *(ckt->CKTstate0+here->CAPccap);
-                    }
-                    *(here->CAPposPosptr) += m * geq;
-                    *(here->CAPnegNegptr) += m * geq;
-                    *(here->CAPposNegptr) -= m * geq;
-                    *(here->CAPnegPosptr) -= m * geq;
-                    *(ckt->CKTrhs+here->CAPposNode) -= m * ceq;
-                    *(ckt->CKTrhs+here->CAPnegNode) += m * ceq;
-                } else
-                    *(ckt->CKTstate0+here->CAPqcap) = here->CAPcapac * vcap;
-            }
+        error = NIintegrateVec(ckt, lin->count, lin->geq, lin->ceq,
+                               lin->val, lin->state);
+        if(error) return(error);
+        if(ckt->CKTmode & MODEINITTRAN) {
+            for (k = 0; k < lin->count; k++)
+                state1[lin->state[k]+1] = state0[lin->state[k]+1];
+        }
+
+        /* ... then the matrix and the rhs, instance by instance */
+        elt = lin->elt;
+        for (k = 0; k < lin->count; k++, elt += 4) {
+            m = lin->par[k];
+            *(elt[0]) += m * lin->geq[k];
+            *(elt[1]) += m * lin->geq[k];
+            *(elt[2]) -= m * lin->geq[k];
+            *(elt[3]) -= m * lin->geq[k];
+            ckt->CKTrhs[lin->posNode[k]] -= m * lin->ceq[k];
+            ckt->CKTrhs[lin->negNode[k]] += m * lin->ceq[k];
         }
     }
     return(OK);
 }
-
@@ -7,6 +7,7 @@ Modified: Spetember 2003 Paolo Nenzi
  */
 
 #include "ngspice/ngspice.h"
+#include "ngspice/cktlinear.h"
 #include "capdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -36,6 +37,7 @@ delgot:
         prev = here;
     }
     if(prev) FREE(prev);
+    CKTlinearFree(&(*model)->CAPlinear);
     FREE(*model);
     return(OK);
 
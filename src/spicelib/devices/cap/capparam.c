@@ -8,6 +8,7 @@ Modified: September 2003 Paolo Nenzi
 
 #include "ngspice/ngspice.h"
 #include "ngspice/ifsim.h"
+#include "ngspice/cktlinear.h"
 #include "capdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -24,6 +25,9 @@ CAPparam(int param, IFvalue *value, GENinstance *inst, IFvalue *select)
 
     NG_IGNORE(select);
 
+    /* the load has its own copy of the parameters */
+    CKTlinearFree(&here->CAPmodPtr->CAPlinear);
+
     if (!cp_getvar("scale", CP_REAL, &scale))
         scale = 1;
 
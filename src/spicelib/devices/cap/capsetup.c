@@ -8,6 +8,7 @@ Modified: September 2003 Paolo Nenzi
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktlinear.h"
 #include "capdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -27,6 +28,8 @@ CAPsetup(SMPmatrix *matrix, GENmodel *inModel, CKTcircuit *ckt, int *states)
     /*  loop through all the capacitor models */
     for( ; model != NULL; model = model->CAPnextModel ) {
 
+        CKTlinearFree(&model->CAPlinear);
+
         /*Default Value Processing for Model Parameters */
         if (!model->CAPmCapGiven) {
             model->CAPmCap = 0.0;
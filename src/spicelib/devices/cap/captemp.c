@@ -12,6 +12,7 @@ Modified: September 2003 Paolo Nenzi
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktlinear.h"
 #include "capdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -31,6 +32,8 @@ CAPtemp(GENmodel *inModel, CKTcircuit *ckt)
     /*  loop through all the capacitor models */
     for( ; model != NULL; model = model->CAPnextModel ) {
 
+        CKTlinearFree(&model->CAPlinear);
+
         /* loop through all the instances of the model */
         for (here = model->CAPinstances; here != NULL ;
                 here=here->CAPnextInstance) {
@@ -72,7 +72,10 @@ SPICEdev CCCSinfo = {
  /* DEVacct       */ NULL,
 #endif    
  /* DEVinstSize   */ &CCCSiSize,
- /* DEVmodSize    */ &CCCSmSize
+ /* DEVmodSize    */ &CCCSmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -73,7 +73,10 @@ SPICEdev CCVSinfo = {
  /* DEVacct       */ NULL,
 #endif
  /* DEVinstSize   */ &CCVSiSize,
- /* DEVmodSize    */ &CCVSmSize
+ /* DEVmodSize    */ &CCVSmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -0,0 +1,73 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+**********/
+
+/*
+ * Instances of a linear device model in plain arrays, see cktlinear.h.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktlinear.h"
+
+
+CKTlinear *
+CKTlinearNew(int count, int nelt)
+{
+    CKTlinear *lin = TMALLOC(CKTlinear, 1);
+
+    lin->count = count;
+    lin->nelt = nelt;
+    lin->elt = TMALLOC(double *, count * nelt);
+    lin->val = TMALLOC(double, count);
+    lin->par = TMALLOC(double, count);
+    lin->init = TMALLOC(double, count);
+    lin->posNode = TMALLOC(int, count);
+    lin->negNode = TMALLOC(int, count);
+    lin->state = TMALLOC(int, count);
+    lin->geq = TMALLOC(double, count);
+    lin->ceq = TMALLOC(double, count);
+
+    return lin;
+}
+
+
+void
+CKTlinearFree(CKTlinear **linp)
+{
+    CKTlinear *lin = *linp;
+
+    if (!lin)
+        return;
+
+    tfree(lin->elt);
+    tfree(lin->val);
+    tfree(lin->par);
+    tfree(lin->init);
+    tfree(lin->posNode);
+    tfree(lin->negNode);
+    tfree(lin->state);
+    tfree(lin->geq);
+    tfree(lin->ceq);
+    tfree(*linp);
+}
+
+
+/* Add val to the first two and subtract it from the next two matrix
+ * elements of each instance, the stamp of a conductance.  Instances may
+ * share elements, so this goes instance by instance in list order.
+ */
+void
+CKTlinearStamp(CKTlinear *lin)
+{
+    double **elt = lin->elt;
+    double *val = lin->val;
+    int nelt = lin->nelt;
+    int k;
+
+    for (k = 0; k < lin->count; k++, elt += nelt) {
+        *(elt[0]) += val[k];
+        *(elt[1]) += val[k];
+        *(elt[2]) -= val[k];
+        *(elt[3]) -= val[k];
+    }
+}
@@ -0,0 +1,250 @@
+/**********
+Copyright 2026 The ngspice team.  All rights reserved.
+**********/
+
+/*
+ * Two-phase device load.
+ *
+ * Devices which provide DEVloadInst do not add into the sparse matrix
+ * and the rhs themselves.  Each instance is evaluated into a stamp
+ * buffer first, which is then scattered into the matrix and the rhs.
+ *
+ * Without OpenMP (or with num_threads = 1, or for small circuits) a
+ * single scratch buffer is used, and evaluation and scatter alternate
+ * instance by instance.
+ *
+ * With OpenMP, CKTload evaluates all instances of all such devices in
+ * one parallel loop into per instance buffers (CKTstampEval), and
+ * afterwards scatters them serially, device type by device type and in
+ * model/instance order (CKTstampLoadDev).  The scatter is therefore
+ * race free, and the matrix and rhs are bit-identical to a serial load.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
+#include "ngspice/sperror.h"
+
+#ifdef USE_OMP
+extern int nthreads;
+
+/* below this many instances a parallel region costs more than it saves */
+#define STAMP_MIN_PARALLEL 256
+#endif
+
+
+static void
+stamp_alloc(CKTstamp *st, int nmat, int nrhs)
+{
+    st->matPtr = TMALLOC(double *, nmat);
+    st->matVal = TMALLOC(double, nmat);
+    st->rhsNode = TMALLOC(int, nrhs);
+    st->rhsVal = TMALLOC(double, nrhs);
+}
+
+
+/* the scratch buffer is sized for the largest device of all */
+static void
+scratch_alloc(CKTcircuit *ckt)
+{
+    int i, nmat = 0, nrhs = 0;
+
+    for (i = 0; i < DEVmaxnum; i++)
+        if (DEVices[i] && DEVices[i]->DEVloadInst) {
+            nmat = MAX(nmat, DEVices[i]->DEVstampMat);
+            nrhs = MAX(nrhs, DEVices[i]->DEVstampRhs);
+        }
+
+    ckt->CKTstampScratch = TMALLOC(CKTstamp, 1);
+    stamp_alloc(ckt->CKTstampScratch, nmat, nrhs);
+}
+
+
+static void
+stamp_free(CKTstamp *st)
+{
+    tfree(st->matPtr);
+    tfree(st->matVal);
+    tfree(st->rhsNode);
+    tfree(st->rhsVal);
+}
+
+
+/* allocate the stamp buffers, called by CKTsetup after all device setups */
+int
+CKTstampSetup(CKTcircuit *ckt)
+{
+#ifdef USE_OMP
+    int i, count, k, nmat, nrhs;
+    GENmodel *model;
+    GENinstance *inst;
+    double **matPtr, *matVal, *rhsVal;
+    int *rhsNode;
+#endif
+
+    CKTstampDestroy(ckt);
+    scratch_alloc(ckt);
+
+#ifdef USE_OMP
+    if (nthreads <= 1)
+        return OK;
+
+    /* count the instances and their stamps */
+    count = nmat = nrhs = 0;
+    for (i = 0; i < DEVmaxnum; i++)
+        if (DEVices[i] && DEVices[i]->DEVloadInst)
+            for (model = ckt->CKThead[i]; model; model = model->GENnextModel)
+                for (inst = model->GENinstances; inst; inst = inst->GENnextInstance) {
+                    count++;
+                    nmat += DEVices[i]->DEVstampMat;
+                    nrhs += DEVices[i]->DEVstampRhs;
+                }
+
+    if (count < STAMP_MIN_PARALLEL)
+        return OK;
+
+    ckt->CKTstampCount = count;
+    ckt->CKTstampInst = TMALLOC(GENinstance *, count);
+    ckt->CKTstamps = TMALLOC(CKTstamp, count);
+    ckt->CKTstampFirst = TMALLOC(int, DEVmaxnum + 1);
+
+    /* one contiguous pool, carved into per instance buffers */
+    matPtr = TMALLOC(double *, nmat);
+    matVal = TMALLOC(double, nmat);
+    rhsNode = TMALLOC(int, nrhs);
+    rhsVal = TMALLOC(double, nrhs);
+
+    k = 0;
+    for (i = 0; i < DEVmaxnum; i++) {
+        ckt->CKTstampFirst[i] = k;
+        if (DEVices[i] && DEVices[i]->DEVloadInst)
+            for (model = ckt->CKThead[i]; model; model = model->GENnextModel)
+                for (inst = model->GENinstances; inst; inst = inst->GENnextInstance) {
+                    CKTstamp *st = &ckt->CKTstamps[k];
+                    ckt->CKTstampInst[k++] = inst;
+                    st->matPtr = matPtr;
+                    st->matVal = matVal;
+                    st->rhsNode = rhsNode;
+                    st->rhsVal = rhsVal;
+                    matPtr += DEVices[i]->DEVstampMat;
+                    matVal += DEVices[i]->DEVstampMat;
+                    rhsNode += DEVices[i]->DEVstampRhs;
+                    rhsVal += DEVices[i]->DEVstampRhs;
+                }
+    }
+    ckt->CKTstampFirst[DEVmaxnum] = k;
+#endif
+
+    return OK;
+}
+
+
+void
+CKTstampDestroy(CKTcircuit *ckt)
+{
+    if (ckt->CKTstampScratch) {
+        stamp_free(ckt->CKTstampScratch);
+        tfree(ckt->CKTstampScratch);
+    }
+
+#ifdef USE_OMP
+    if (ckt->CKTstamps) {
+        /* the first buffer owns the whole pool */
+        stamp_free(&ckt->CKTstamps[0]);
+        tfree(ckt->CKTstamps);
+    }
+    tfree(ckt->CKTstampInst);
+    tfree(ckt->CKTstampFirst);
+    ckt->CKTstampCount = 0;
+#endif
+}
+
+
+/* add the recorded contributions of one instance */
+void
+CKTstampScatter(CKTcircuit *ckt, GENinstance *inst, CKTstamp *st)
+{
+    int k;
+
+    for (k = 0; k < st->nmat; k++)
+        *(st->matPtr[k]) += st->matVal[k];
+    for (k = 0; k < st->nrhs; k++)
+        ckt->CKTrhs[st->rhsNode[k]] += st->rhsVal[k];
+
+    if (st->noncon) {
+        ckt->CKTnoncon += st->noncon;
+        ckt->CKTtroubleElt = inst;
+    }
+}
+
+
+/* DEVload of a device providing DEVloadInst: evaluate and scatter
+ * instance by instance through the scratch buffer
+ */
+int
+CKTstampLoad(GENmodel *inModel, CKTcircuit *ckt)
+{
+    SPICEdev *dev;
+    CKTstamp *st;
+    GENinstance *inst;
+    int error;
+
+    if (!inModel)
+        return OK;
+
+    dev = DEVices[inModel->GENmodType];
+
+    if (!ckt->CKTstampScratch)
+        scratch_alloc(ckt);
+    st = ckt->CKTstampScratch;
+
+    for (; inModel; inModel = inModel->GENnextModel)
+        for (inst = inModel->GENinstances; inst; inst = inst->GENnextInstance) {
+            st->nmat = st->nrhs = st->noncon = 0;
+            error = dev->DEVloadInst(inst, ckt, st);
+            if (error)
+                return error;
+            CKTstampScatter(ckt, inst, st);
+        }
+
+    return OK;
+}
+
+
+#ifdef USE_OMP
+
+/* evaluation phase: all instances of all two-phase devices in parallel */
+void
+CKTstampEval(CKTcircuit *ckt)
+{
+    int k;
+
+#pragma omp parallel for schedule(dynamic, 64)
+    for (k = 0; k < ckt->CKTstampCount; k++) {
+        GENinstance *inst = ckt->CKTstampInst[k];
+        CKTstamp *st = &ckt->CKTstamps[k];
+        st->nmat = st->nrhs = st->noncon = 0;
+        st->error = DEVices[inst->GENmodPtr->GENmodType]->DEVloadInst(inst, ckt, st);
+    }
+}
+
+
+/* scatter phase for the instances of one device type, in the order of
+ * a serial load, stopping at the first instance which failed
+ */
+int
+CKTstampLoadDev(CKTcircuit *ckt, int type)
+{
+    int k;
+
+    for (k = ckt->CKTstampFirst[type]; k < ckt->CKTstampFirst[type + 1]; k++) {
+        CKTstamp *st = &ckt->CKTstamps[k];
+        if (st->error)
+            return st->error;
+        CKTstampScatter(ckt, ckt->CKTstampInst[k], st);
+    }
+
+    return OK;
+}
+
+#endif
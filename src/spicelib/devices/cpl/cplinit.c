@@ -73,7 +73,10 @@ SPICEdev CPLinfo = {
 /* DEVacct        */ NULL,
 #endif   
 /* DEVinstSize    */ &CPLiSize,
-/* DEVmodSize     */ &CPLmSize
+/* DEVmodSize     */ &CPLmSize,
+/* DEVloadInst    */ NULL,
+/* DEVstampMat    */ 0,
+/* DEVstampRhs    */ 0
 
 };
 
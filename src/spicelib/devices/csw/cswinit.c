@@ -75,7 +75,10 @@ SPICEdev CSWinfo = {
  /* DEVacct       */ NULL,
 #endif
  /* DEVinstSize   */ &CSWiSize,
- /* DEVmodSize    */ &CSWmSize
+ /* DEVmodSize    */ &CSWmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -397,6 +397,59 @@ int add_udn(int n,Evt_Udn_Info_t **udns){
 
 extern struct coreInfo_t  coreInfo;
 
+#ifdef SHARED_MODULE
+/* Each image of the shared ngspice (see ngSpice_nInit()) needs its own
+   copy of a code model library, because the core interface of the
+   library points into the image which has loaded it. Loading the same
+   file again would only return the library already bound to another
+   image, so a private copy is made in the directory for temporary files. */
+static void *load_opus_copy(void *lib, char *name){
+#if defined(__MINGW32__) || defined(HAS_WINGUI) || defined(_MSC_VER)
+  NG_IGNORE(lib);
+  printf("Error: code model library %s is in use by another ngspice instance\n", name);
+  return NULL;
+#else
+  const char *tmpdir = getenv("TMPDIR");
+  char *to;
+  char buf[65536];
+  size_t n;
+  FILE *in, *out;
+  int fd, err = 0;
+
+  dlclose(lib);
+  if (!tmpdir || !*tmpdir)
+    tmpdir = "/tmp";
+  to = tprintf("%s/ngspicecmXXXXXX", tmpdir);
+  fd = mkstemp(to);
+  if (fd < 0) {
+    printf("Error: cannot copy code model library %s\n", name);
+    tfree(to);
+    return NULL;
+  }
+  out = fdopen(fd, "wb");
+  in = fopen(name, "rb");
+  if (!in || !out)
+    err = 1;
+  while (!err && (n = fread(buf, 1, sizeof(buf), in)) > 0)
+    if (fwrite(buf, 1, n, out) != n)
+      err = 1;
+  if (in)
+    fclose(in);
+  if (out ? fclose(out) : close(fd))
+    err = 1;
+  lib = NULL;
+  if (!err)
+    lib = dlopen(to, RTLD_NOW | RTLD_LOCAL);
+  /* the mapping stays valid, so nothing is left behind */
+  unlink(to);
+  tfree(to);
+  if (!lib)
+    printf("Error: cannot load a copy of code model library %s\n", name);
+  return lib;
+#endif
+}
+#endif
+
 int load_opus(char *name){
   void *lib;
   const char *msg;
@@ -412,7 +465,19 @@ int load_opus(char *name){
     printf("%s\n", msg);
     return 1;
   }
-  
+
+#ifdef SHARED_MODULE
+  fetch = dlsym(lib,"CMgetCoreItfPtr");
+  if(fetch){
+    core = ((struct coreInfo_t ** (*)(void)) fetch) ();
+    if(*core && *core != &coreInfo){
+      lib = load_opus_copy(lib, name);
+      if(!lib)
+        return 1;
+    }
+  }
+#endif
+
   fetch = dlsym(lib,"CMdevNum");
   if(fetch){
     num = ((int * (*)(void)) fetch) ();
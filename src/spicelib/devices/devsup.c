@@ -9,9 +9,12 @@ Modified: 2000 AlansFixes
 #include "ngspice/ngspice.h"
 #include "ngspice/devdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/sperror.h"
+#include "ngspice/stimfile.h"
 #include "ngspice/suffix.h"
 
 #include <stdarg.h>
+#include <errno.h>
 
 
 /* 
@@ -775,6 +778,156 @@ DEVpred(CKTcircuit *ckt, int loct)
 }
 
 
+/* Find the segment of a piecewise linear table coeffs[] (npts pairs of
+ * time and value) holding time, with offset added to the table times.
+ * Returns the first i in [first, npts-2] where time equals the table
+ * time (within ulps units, exactly if ulps is 0, *exact set), or lies
+ * strictly between table times i and i+1, -1 if there is none.  This is
+ * what a scan from first finds.  If the table times do not decrease
+ * (sorted), the search starts from *cursor, the segment found last, and
+ * bisects if time has moved further than a few segments from there.
+ */
+#define PWL_TIME(k) (coeffs[2*(k)] + offset)
+#define PWL_EQUAL(k) \
+    (ulps ? AlmostEqualUlps(PWL_TIME(k), time, ulps) : PWL_TIME(k) == time)
+
+int
+DEVpwlFind(double *coeffs, int npts, int first, double offset, double time,
+           int ulps, int sorted, int *cursor, int *exact)
+{
+    int i, lo, hi, mid, k;
+
+    *exact = 0;
+
+    if (!sorted) {
+        for (i = first; i < npts - 1; i++) {
+            if (PWL_EQUAL(i)) {
+                *exact = 1;
+                return i;
+            }
+            if (PWL_TIME(i) < time && PWL_TIME(i+1) > time)
+                return i;
+        }
+        return -1;
+    }
+
+    /* the last table point not later than time, first if there is none */
+    lo = first;
+    hi = npts - 1;
+    if (PWL_TIME(hi) <= time) {
+        lo = hi;
+    } else {
+        k = *cursor;
+        if (k > first && k < hi) {
+            if (PWL_TIME(k) <= time) {
+                lo = k;
+                for (i = 0; i < 4 && PWL_TIME(lo+1) <= time; i++)
+                    lo++;
+                if (PWL_TIME(lo+1) > time)
+                    hi = lo;
+            } else {
+                hi = k - 1;
+            }
+        }
+        while (lo < hi) {
+            mid = lo + (hi - lo + 1) / 2;
+            if (PWL_TIME(mid) <= time)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        if (PWL_TIME(lo) <= time)
+            *cursor = lo;
+    }
+
+    /* points equal to time are next to each other, take the first */
+    k = lo;
+    while (k > first && PWL_EQUAL(k-1))
+        k--;
+
+    for (i = k; i < npts - 1; i++) {
+        if (PWL_EQUAL(i)) {
+            *exact = 1;
+            return i;
+        }
+        if (PWL_TIME(i) < time && PWL_TIME(i+1) > time)
+            return i;
+        if (PWL_TIME(i) > time)
+            break;
+    }
+    return -1;
+}
+
+#undef PWL_TIME
+#undef PWL_EQUAL
+
+
+/* Read a pwl table of time and value pairs from channel column (1 is
+ * the first) of the binary stimulus file name, see ngspice/stimfile.h.
+ * A relative name is looked for next to the input file first.
+ */
+int
+DEVpwlFile(char *name, int column, double **coeffs, int *order)
+{
+    FILE *fp = NULL;
+    STIMfile *stim;
+    const char *msg;
+    const double *row;
+    double *c;
+    size_t i;
+
+    if (!name || !*name) {
+        fprintf(stderr, "ERROR: empty pwl file name\n");
+        return(E_PARMVAL);
+    }
+
+    if (Infile_Path && *name != '/' && name[1] != ':') {
+        char *path = tprintf("%s/%s", Infile_Path, name);
+        fp = fopen(path, "rb");
+        tfree(path);
+    }
+    if (!fp)
+        fp = fopen(name, "rb");
+    if (!fp) {
+        fprintf(stderr, "ERROR: can't open pwl file %s: %s\n",
+                name, strerror(errno));
+        return(E_PARMVAL);
+    }
+
+    stim = stim_open(fp, &msg);
+    fclose(fp);
+    if (!stim) {
+        fprintf(stderr, "ERROR: pwl file %s: %s\n",
+                name, msg ? msg : "not a binary stimulus file");
+        return(E_PARMVAL);
+    }
+    if (column < 1 || column >= stim->columns) {
+        fprintf(stderr, "ERROR: pwl file %s has no channel %d\n",
+                name, column);
+        stim_close(stim);
+        return(E_PARMVAL);
+    }
+    if (stim->rows > INT_MAX / 2) {
+        fprintf(stderr, "ERROR: pwl file %s has too many time points\n",
+                name);
+        stim_close(stim);
+        return(E_PARMVAL);
+    }
+
+    tfree(*coeffs);
+    *coeffs = c = TMALLOC(double, 2 * stim->rows);
+    *order = 2 * (int) stim->rows;
+    row = stim->data;
+    for (i = 0; i < stim->rows; i++, row += stim->columns) {
+        *c++ = row[0];
+        *c++ = row[column];
+    }
+
+    stim_close(stim);
+    return(OK);
+}
+
+
 /* SOA check printout used in DEVsoaCheck functions */
 extern FILE *slogp;  /* soa log file ('--soa-log file' command line option) */
 
@@ -11,6 +11,7 @@ extern int DIOdelete(GENmodel*,IFuid,GENinstance**);
 extern void DIOdestroy(GENmodel**);
 extern int DIOgetic(GENmodel*,CKTcircuit*);
 extern int DIOload(GENmodel*,CKTcircuit*);
+extern int DIOloadInst(GENinstance*,CKTcircuit*,CKTstamp*);
 extern int DIOmAsk(CKTcircuit*,GENmodel*,int,IFvalue*);
 extern int DIOmDelete(GENmodel**,IFuid,GENmodel*);
 extern int DIOmParam(int,IFvalue*,GENmodel*);
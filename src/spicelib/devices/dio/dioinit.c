@@ -74,7 +74,10 @@ SPICEdev DIOinfo = {
  /* DEVacct       */ NULL,
 #endif                     
  /* DEVinstSize   */ &DIOiSize,
- /* DEVmodSize    */ &DIOmSize
+ /* DEVmodSize    */ &DIOmSize,
+ /* DEVloadInst   */ DIOloadInst,
+ /* DEVstampMat   */ 7,
+ /* DEVstampRhs   */ 2
 };
 
 
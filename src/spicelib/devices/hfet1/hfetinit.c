@@ -73,7 +73,10 @@ SPICEdev HFETAinfo = {
  /* DEVacct       */ NULL,
 #endif    
  /* DEVinstSize   */ &HFETAiSize,
- /* DEVmodSize    */ &HFETAmSize
+ /* DEVmodSize    */ &HFETAmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -73,7 +73,10 @@ SPICEdev HFET2info = {
  /* DEVacct       */ NULL,
 #endif    
  /* DEVinstSize   */ &HFET2iSize,
- /* DEVmodSize    */ &HFET2mSize
+ /* DEVmodSize    */ &HFET2mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
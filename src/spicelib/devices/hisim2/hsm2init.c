@@ -71,7 +71,10 @@ SPICEdev HSM2info = {
  /* DEVacct       */ NULL,
 #endif
  /* DEVinstSize   */ &HSM2iSize,
- /* DEVmodSize    */ &HSM2mSize
+ /* DEVmodSize    */ &HSM2mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -71,7 +71,10 @@ SPICEdev HSMHVinfo = {
  /* DEVacct       */ NULL,
 #endif
  /* DEVinstSize   */ &HSMHViSize,
- /* DEVmodSize    */ &HSMHVmSize
+ /* DEVmodSize    */ &HSMHVmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -71,7 +71,10 @@ SPICEdev HSMHV2info = {
  /* DEVacct       */ NULL,
 #endif
  /* DEVinstSize   */ &HSMHV2iSize,
- /* DEVmodSize    */ &HSMHV2mSize
+ /* DEVmodSize    */ &HSMHV2mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -103,6 +103,8 @@ typedef struct sINDmodel {       /* model structure for an inductor */
     unsigned INDmIndGiven  : 1; /* flag to indicate model inductance given */
 
     double INDspecInd;     /* Specific (one turn) inductance */
+
+    CKTlinear *INDlinear;   /* the instances in arrays, for the load */
 } INDmodel;
 
 
@@ -6,6 +6,7 @@ Author: 1985 Thomas L. Quarles
  */
 
 #include "ngspice/ngspice.h"
+#include "ngspice/cktlinear.h"
 #include "inddefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -24,6 +25,7 @@ INDdelete(GENmodel *inModel, IFuid name, GENinstance **kill)
         for(here = *prev; here ; here = *prev) {
             if(here->INDname == name || (fast && here==*fast) ) {
                 *prev= here->INDnextInstance;
+                CKTlinearFree(&model->INDlinear);
                 FREE(here);
                 return(OK);
             }
@@ -6,6 +6,7 @@ Author: 1985 Thomas L. Quarles
  */
 
 #include "ngspice/ngspice.h"
+#include "ngspice/cktlinear.h"
 #include "inddefs.h"
 #include "ngspice/suffix.h"
 
@@ -22,6 +23,7 @@ INDdestroy(GENmodel **inModel)
     for( ; mod ; mod = mod->INDnextModel) {
         if(oldmod) FREE(oldmod);
         oldmod = mod;
+        CKTlinearFree(&mod->INDlinear);
         prev = NULL;
         for(here = mod->INDinstances ; here ; here = here->INDnextInstance) {
             if(prev) FREE(prev);
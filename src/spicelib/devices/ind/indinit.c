@@ -72,7 +72,10 @@ SPICEdev INDinfo = {
  /* DEVacct       */ NULL,
 #endif                       
  /* DEVinstSize   */ &INDiSize,
- /* DEVmodSize    */ &INDmSize
+ /* DEVmodSize    */ &INDmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -143,7 +146,10 @@ SPICEdev MUTinfo = {
  /* DEVacct       */ NULL,
 #endif  
     &MUTiSize,
-    &MUTmSize
+    &MUTmSize,
+    NULL,
+    0,
+    0
 
 };
 
@@ -9,20 +9,61 @@ Author: 1985 Thomas L. Quarles
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktlinear.h"
 #include "inddefs.h"
 #include "ngspice/trandefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
 
+/* copy what the load needs of the instances of a model into arrays:
+ * inductance over multiplier, initial condition, branch equation,
+ * state vector entries and matrix pointers
+ */
+static CKTlinear *
+INDlinearMake(INDmodel *model)
+{
+    INDinstance *here;
+    CKTlinear *lin;
+    double **elt;
+    int k;
+
+    k = 0;
+    for (here = model->INDinstances; here != NULL ;
+            here=here->INDnextInstance)
+        k++;
+
+    lin = CKTlinearNew(k, 5);
+    elt = lin->elt;
+
+    k = 0;
+    for (here = model->INDinstances; here != NULL ;
+            here=here->INDnextInstance) {
+        lin->val[k] = here->INDinduct / here->INDm;
+        lin->init[k] = here->INDinitCond;
+        lin->posNode[k] = here->INDbrEq;
+        lin->state[k] = here->INDflux;
+        k++;
+        *elt++ = here->INDposIbrptr;
+        *elt++ = here->INDnegIbrptr;
+        *elt++ = here->INDibrPosptr;
+        *elt++ = here->INDibrNegptr;
+        *elt++ = here->INDibrIbrptr;
+    }
+
+    return lin;
+}
+
+
 int
 INDload(GENmodel *inModel, CKTcircuit *ckt)
 {
     INDmodel *model = (INDmodel*)inModel;
-    INDinstance *here;
-    double veq;
-    double req;
-    double m;
+    CKTlinear *lin;
+    double **elt;
+    double *state0 = ckt->CKTstate0;
+    double *state1 = ckt->CKTstate1;
     int error;
+    int k;
 
 #ifdef MUTUAL
     MUTinstance *muthere;
@@ -34,23 +75,21 @@ INDload(GENmodel *inModel, CKTcircuit *ckt)
     /*  loop through all the inductor models */
     for( ; model != NULL; model = model->INDnextModel ) {
 
-        /* loop through all the instances of the model */
-        for (here = model->INDinstances; here != NULL ;
-                here=here->INDnextInstance) {
-
-            m = (here->INDm);
-
-            if(!(ckt->CKTmode & (MODEDC|MODEINITPRED))) {
-                if(ckt->CKTmode & MODEUIC && ckt->CKTmode & MODEINITTRAN) {
-                    *(ckt->CKTstate0 + here->INDflux) = here->INDinduct / m *
-                                                        here->INDinitCond;
-                } else {
-                    *(ckt->CKTstate0 + here->INDflux) = here->INDinduct / m *
-                                                        *(ckt->CKTrhsOld + here->INDbrEq);
-                }
+        if (!model->INDlinear)
+            model->INDlinear = INDlinearMake(model);
+        lin = model->INDlinear;
+
+        if(!(ckt->CKTmode & (MODEDC|MODEINITPRED))) {
+            if(ckt->CKTmode & MODEUIC && ckt->CKTmode & MODEINITTRAN) {
+                for (k = 0; k < lin->count; k++)
+                    state0[lin->state[k]] = lin->val[k] * lin->init[k];
+            } else {
+                for (k = 0; k < lin->count; k++)
+                    state0[lin->state[k]] = lin->val[k] *
+                        ckt->CKTrhsOld[lin->posNode[k]];
             }
-#ifdef MUTUAL
         }
+#ifdef MUTUAL
     }
     ktype = CKTtypelook("mutual");
     mutmodel = (MUTmodel *)(ckt->CKThead[ktype]);
@@ -80,47 +119,49 @@ INDload(GENmodel *inModel, CKTcircuit *ckt)
     /*  loop through all the inductor models */
     for( ; model != NULL; model = model->INDnextModel ) {
 
-        /* loop through all the instances of the model */
-        for (here = model->INDinstances; here != NULL ;
-                here=here->INDnextInstance) {
+        if (!model->INDlinear)
+            model->INDlinear = INDlinearMake(model);
+        lin = model->INDlinear;
 
 #endif /*MUTUAL*/
-            if(ckt->CKTmode & MODEDC) {
-                req = 0.0;
-                veq = 0.0;
-            } else {
-                double newmind;
+        if(ckt->CKTmode & MODEDC) {
+            for (k = 0; k < lin->count; k++) {
+                lin->geq[k] = 0.0;
+                lin->ceq[k] = 0.0;
+            }
+        } else {
 #ifndef PREDICTOR
-                if(ckt->CKTmode & MODEINITPRED) {
-                    *(ckt->CKTstate0 + here->INDflux) =
-                        *(ckt->CKTstate1 + here->INDflux);
-                } else {
+            if(ckt->CKTmode & MODEINITPRED) {
+                for (k = 0; k < lin->count; k++)
+                    state0[lin->state[k]] = state1[lin->state[k]];
+            } else {
 #endif /*PREDICTOR*/
-                    if (ckt->CKTmode & MODEINITTRAN) {
-                        *(ckt->CKTstate1 + here->INDflux) =
-                            *(ckt->CKTstate0 + here->INDflux);
-                    }
-#ifndef PREDICTOR
+                if (ckt->CKTmode & MODEINITTRAN) {
+                    for (k = 0; k < lin->count; k++)
+                        state1[lin->state[k]] = state0[lin->state[k]];
                 }
-#endif /*PREDICTOR*/
-                m = (here->INDm);
-                newmind = here->INDinduct/m;
-                error=NIintegrate(ckt,&req,&veq,newmind,here->INDflux);
-                if(error) return(error);
+#ifndef PREDICTOR
             }
+#endif /*PREDICTOR*/
+            error = NIintegrateVec(ckt, lin->count, lin->geq, lin->ceq,
+                                   lin->val, lin->state);
+            if(error) return(error);
+        }
 
-            *(ckt->CKTrhs+here->INDbrEq) += veq;
-
-            if(ckt->CKTmode & MODEINITTRAN) {
-                *(ckt->CKTstate1+here->INDvolt) =
-                    *(ckt->CKTstate0+here->INDvolt);
-            }
+        if(ckt->CKTmode & MODEINITTRAN) {
+            for (k = 0; k < lin->count; k++)
+                state1[lin->state[k]+1] = state0[lin->state[k]+1];
+        }
 
-            *(here->INDposIbrptr) +=  1;
-            *(here->INDnegIbrptr) -=  1;
-            *(here->INDibrPosptr) +=  1;
-            *(here->INDibrNegptr) -=  1;
-            *(here->INDibrIbrptr) -=  req;
+        /* req and veq are in geq and ceq */
+        elt = lin->elt;
+        for (k = 0; k < lin->count; k++, elt += 5) {
+            ckt->CKTrhs[lin->posNode[k]] += lin->ceq[k];
+            *(elt[0]) +=  1;
+            *(elt[1]) -=  1;
+            *(elt[2]) +=  1;
+            *(elt[3]) -=  1;
+            *(elt[4]) -=  lin->geq[k];
         }
     }
     return(OK);
@@ -6,6 +6,7 @@ Author: 1985 Thomas L. Quarles
 #include "ngspice/ngspice.h"
 #include "ngspice/smpdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktlinear.h"
 #include "inddefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -23,6 +24,8 @@ INDsetup(SMPmatrix *matrix, GENmodel *inModel, CKTcircuit *ckt, int *states)
 
     /*  loop through all the inductor models */
     for( ; model != NULL; model = model->INDnextModel ) {
+
+        CKTlinearFree(&model->INDlinear);
  
    /* Default Value Processing for Model Parameters */
         if (!model->INDmIndGiven) {
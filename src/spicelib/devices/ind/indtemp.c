@@ -8,6 +8,7 @@ Author: 2003 Paolo Nenzi
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktlinear.h"
 #include "inddefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -26,6 +27,8 @@ INDtemp(GENmodel *inModel, CKTcircuit *ckt)
     /*  loop through all the inductor models */
     for( ; model != NULL; model = model->INDnextModel ) {
 
+        CKTlinearFree(&model->INDlinear);
+
         /* loop through all the instances of the model */
         for (here = model->INDinstances; here != NULL ;
                 here=here->INDnextInstance) {
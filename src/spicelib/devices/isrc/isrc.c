@@ -44,7 +44,9 @@ IFparm ISRCpTable[] = { /* parameters */
 #endif
 /* gtri - end - add parameter for current source value */
  IP  ("distof1", ISRC_D_F1,      IF_REALVEC,"f1 input for distortion"),
- IP  ("distof2", ISRC_D_F2,      IF_REALVEC,"f2 input for distortion")
+ IP  ("distof2", ISRC_D_F2,      IF_REALVEC,"f2 input for distortion"),
+ IP  ("file",    ISRC_PWL_FILE,   IF_STRING, "pwl stimulus file"),
+ IP  ("column",  ISRC_PWL_COLUMN, IF_INTEGER,"pwl stimulus file channel")
 };
 
 char *ISRCnames[] = {
@@ -5,6 +5,7 @@ Author: 1985 Thomas L. Quarles
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "isrcdefs.h"
 #include "ngspice/trandefs.h"
 #include "ngspice/sperror.h"
@@ -165,19 +166,27 @@ ISRCaccept(CKTcircuit *ckt, GENmodel *inModel)
                     break;
 
                     case PWL: {
-                        int i;
+                        int i, exact;
+                        int npts = here->ISRCfunctionOrder/2;
                         if(ckt->CKTtime < *(here->ISRCcoeffs)) {
                             if(ckt->CKTbreak) {
                                 error = CKTsetBreak(ckt,*(here->ISRCcoeffs));
                                 break;
                             }
                         }
-                        for(i=0;i<(here->ISRCfunctionOrder/2)-1;i++) {
-                            if ( ckt->CKTbreak && AlmostEqualUlps(*(here->ISRCcoeffs+2*i), ckt->CKTtime, 3 ) ) {
-                                error = CKTsetBreak(ckt, *(here->ISRCcoeffs+2*i+2));
-                                if(error) return(error);
-                                goto bkptset;
-                            }
+                        if(!ckt->CKTbreak)
+                            break;
+                        /* a table time at CKTtime, not just a segment */
+                        i = -1;
+                        do
+                            i = DEVpwlFind(here->ISRCcoeffs, npts, i+1, 0.0,
+                                           ckt->CKTtime, 3, here->ISRCpwlSorted,
+                                           &here->ISRCpwlIndex, &exact);
+                        while(i >= 0 && !exact);
+                        if(i >= 0) {
+                            error = CKTsetBreak(ckt, *(here->ISRCcoeffs+2*i+2));
+                            if(error) return(error);
+                            goto bkptset;
                         }
                         break;
                     }
@@ -31,6 +31,9 @@ typedef struct sISRCinstance {
     int ISRCfunctionType;   /* code number of function type for source */
     int ISRCfunctionOrder;  /* order of the function for the source */
     double *ISRCcoeffs; /* pointer to array of coefficients */
+    int ISRCpwlIndex;      /* pwl segment found last */
+    char *ISRCpwlFile;     /* pwl stimulus file */
+    int ISRCpwlColumn;     /* channel of the stimulus file */
 
     double ISRCdcValue; /* DC and TRANSIENT value of source */
     double ISRCmValue;  /* Parallel multiplier */
@@ -66,6 +69,7 @@ typedef struct sISRCinstance {
     unsigned ISRCdGiven      :1 ;  /* flag to indicate source is a distortion input */
     unsigned ISRCdF1given    :1 ;  /* flag to indicate source is an f1 distortion input */
     unsigned ISRCdF2given    :1 ;  /* flag to indicate source is an f2 distortion input */
+    unsigned ISRCpwlSorted   :1 ;  /* flag to indicate pwl times do not decrease */
 } ISRCinstance ;
 
 
@@ -131,6 +135,8 @@ typedef struct sISRCmodel {
 #define ISRC_TRNOISE 25
 #define ISRC_TRRANDOM 26
 #define ISRC_EXTERNAL 27
+#define ISRC_PWL_FILE 28
+#define ISRC_PWL_COLUMN 29
 
 /* model parameters */
 
@@ -26,6 +26,7 @@ ISRCdestroy(GENmodel **inModel)
         for(here = mod->ISRCinstances ; here ; here = here->ISRCnextInstance) {
             if(prev) {
                 tfree(prev->ISRCcoeffs);
+                tfree(prev->ISRCpwlFile);
                 FREE(prev);
             }
             prev = here;
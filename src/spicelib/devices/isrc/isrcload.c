@@ -6,6 +6,7 @@ Modified: 2000 Alansfixes
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "isrcdefs.h"
 #include "ngspice/trandefs.h"
 #include "ngspice/sperror.h"
@@ -296,29 +297,29 @@ ISRCload(GENmodel *inModel, CKTcircuit *ckt)
                     break;
 
                     case PWL: {
-                        int i;
+                        int i, exact;
                         if(time < *(here->ISRCcoeffs)) {
                             value = *(here->ISRCcoeffs + 1) ;
                             break;
                         }
-                        for(i=0; i < (here->ISRCfunctionOrder / 2) - 1; i++) {
-                            if((*(here->ISRCcoeffs+2*i)==time)) {
-                                value = *(here->ISRCcoeffs+2*i+1);
-                                goto loadDone;
-                            }
-                            if((*(here->ISRCcoeffs+2*i)<time) &&
-                               (*(here->ISRCcoeffs+2*(i+1)) >time)) {
-                                value = *(here->ISRCcoeffs+2*i+1) +
-                                   (((time-*(here->ISRCcoeffs+2*i))/
-                                   (*(here->ISRCcoeffs+2*(i+1)) -
-                                    *(here->ISRCcoeffs+2*i))) *
-                                   (*(here->ISRCcoeffs+2*i+3) -
-                                    *(here->ISRCcoeffs+2*i+1)));
-                                goto loadDone;
-                            }
+                        i = DEVpwlFind(here->ISRCcoeffs, here->ISRCfunctionOrder / 2,
+                                       0, 0.0, time, 0, here->ISRCpwlSorted,
+                                       &here->ISRCpwlIndex, &exact);
+                        if(i < 0) {
+                            value = *(here->ISRCcoeffs+ here->ISRCfunctionOrder-1) ;
+                            break;
                         }
-                        value = *(here->ISRCcoeffs+ here->ISRCfunctionOrder-1) ;
-                        break;
+                        if(exact) {
+                            value = *(here->ISRCcoeffs+2*i+1);
+                            goto loadDone;
+                        }
+                        value = *(here->ISRCcoeffs+2*i+1) +
+                           (((time-*(here->ISRCcoeffs+2*i))/
+                           (*(here->ISRCcoeffs+2*(i+1)) -
+                            *(here->ISRCcoeffs+2*i))) *
+                           (*(here->ISRCcoeffs+2*i+3) -
+                            *(here->ISRCcoeffs+2*i+1)));
+                        goto loadDone;
                     }
 
 /**** tansient noise routines:
@@ -8,6 +8,7 @@ Modified: 2000 AlansFixes
 
 #include "ngspice/ngspice.h"
 #include "ngspice/ifsim.h"
+#include "ngspice/devdefs.h"
 #include "isrcdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -29,11 +30,48 @@ static void copy_coeffs(ISRCinstance *here, IFvalue *value)
 }
 
 
+/* note if the pwl time points do not decrease, for DEVpwlFind() */
+static void pwl_check(ISRCinstance *here)
+{
+    int i;
+
+    here->ISRCpwlIndex = 0;
+    here->ISRCpwlSorted = TRUE;
+    for (i=0; i<(here->ISRCfunctionOrder/2)-1; i++) {
+          if (*(here->ISRCcoeffs+2*(i+1))<*(here->ISRCcoeffs+2*i))
+             here->ISRCpwlSorted = FALSE;
+          if (*(here->ISRCcoeffs+2*(i+1))<=*(here->ISRCcoeffs+2*i)) {
+             fprintf(stderr, "Warning : current source %s",
+                                                       here->ISRCname);
+             fprintf(stderr, " has non-increasing PWL time points.\n");
+          }
+    }
+}
+
+
+/* the pwl table from a channel of a binary stimulus file */
+static int pwl_file(ISRCinstance *here)
+{
+    int error;
+
+    error = DEVpwlFile(here->ISRCpwlFile,
+                       here->ISRCpwlColumn ? here->ISRCpwlColumn : 1,
+                       &here->ISRCcoeffs, &here->ISRCfunctionOrder);
+    if(error)
+        return(error);
+
+    here->ISRCfunctionType = PWL;
+    here->ISRCfuncTGiven = TRUE;
+    here->ISRCcoeffsGiven = TRUE;
+    pwl_check(here);
+    return(OK);
+}
+
+
 /* ARGSUSED */
 int
 ISRCparam(int param, IFvalue *value, GENinstance *inst, IFvalue *select)
 {
-    int i;
     ISRCinstance *here = (ISRCinstance *) inst;
 
     NG_IGNORE(select);
@@ -103,20 +141,29 @@ ISRCparam(int param, IFvalue *value, GENinstance *inst, IFvalue *select)
             break;
 
         case ISRC_PWL:
+            /* 'pwl file=...', the table is checked in ISRCtemp() */
+            if(value->v.numValue == 0) {
+                here->ISRCfunctionType = PWL;
+                here->ISRCfuncTGiven = TRUE;
+                break;
+            }
             if(value->v.numValue < 2)
                 return(E_BADPARM);
             here->ISRCfunctionType = PWL;
             here->ISRCfuncTGiven = TRUE;
             copy_coeffs(here, value);
+            pwl_check(here);
+            break;
 
-            for (i=0; i<(here->ISRCfunctionOrder/2)-1; i++) {
-                  if (*(here->ISRCcoeffs+2*(i+1))<=*(here->ISRCcoeffs+2*i)) {
-                     fprintf(stderr, "Warning : current source %s",
-                                                               here->ISRCname);
-                     fprintf(stderr, " has non-increasing PWL time points.\n");
-                  }
-            }
+        case ISRC_PWL_FILE:
+            tfree(here->ISRCpwlFile);
+            here->ISRCpwlFile = value->sValue;
+            return pwl_file(here);
 
+        case ISRC_PWL_COLUMN:
+            here->ISRCpwlColumn = value->iValue;
+            if(here->ISRCpwlFile)
+                return pwl_file(here);
             break;
 
         case ISRC_SFFM:
@@ -29,6 +29,13 @@ ISRCtemp(GENmodel *inModel, CKTcircuit *ckt)
         for (here = model->ISRCinstances; here != NULL ;
                 here=here->ISRCnextInstance) {
 
+            /* 'pwl' without time points and without 'file=' */
+            if(here->ISRCfunctionType == PWL && !here->ISRCcoeffsGiven) {
+                SPfrontEnd->IFerrorf (ERR_FATAL,
+                        "%s: pwl has no time points", here->ISRCname);
+                return(E_BADPARM);
+            }
+
             if(here->ISRCacGiven && !here->ISRCacMGiven) {
                 here->ISRCacMag = 1;
             }
@@ -73,7 +73,10 @@ SPICEdev JFETinfo = {
  /* DEVacct       */ NULL,
 #endif                        
  /* DEVinstSize   */ &JFETiSize,
- /* DEVmodSize    */ &JFETmSize
+ /* DEVmodSize    */ &JFETmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -73,7 +73,10 @@ SPICEdev JFET2info = {
  /* DEVacct       */ NULL,
 #endif                        
  /* DEVinstSize   */ &JFET2iSize,
- /* DEVmodSize    */ &JFET2mSize
+ /* DEVmodSize    */ &JFET2mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
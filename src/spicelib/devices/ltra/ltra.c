@@ -50,6 +50,8 @@ IFparm LTRAmPTable[] = {	/* model parameters */
       "use N-R iterations for step calculation in LTRAtrunc"),
   IOPU("truncdontcut", LTRA_MOD_TRUNCDONTCUT, IF_FLAG,
       "don't limit timestep to keep impulse response calculation errors low"),
+  IOPU("recconv", LTRA_MOD_RECCONV, IF_FLAG,
+      "use recursive convolution with fitted impulse responses"),
   IOPAU("compactrel", LTRA_MOD_STLINEREL, IF_REAL,
       "special reltol for straight line checking"),
   IOPAU("compactabs", LTRA_MOD_STLINEABS, IF_REAL,
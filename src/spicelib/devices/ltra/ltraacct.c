@@ -36,8 +36,36 @@ LTRAaccept(CKTcircuit *ckt, GENmodel *inModel)
       LTRAmemMANAGE(model->LTRAh1dashCoeffs, model->LTRAmodelListSize)
 	  LTRAmemMANAGE(model->LTRAh2Coeffs, model->LTRAmodelListSize)
 	  LTRAmemMANAGE(model->LTRAh3dashCoeffs, model->LTRAmodelListSize)
+
+      /*
+       * fit the impulse responses for recursive convolution; the fit
+       * depends on the final time, so it is redone for every run
+       */
+      model->LTRArecConv = 0;
+      model->LTRArecAuxIndex = 0;
+      if (model->LTRArecConvGiven) {
+	if (model->LTRAspecialCase != LTRA_MOD_RLC) {
+	  SPfrontEnd->IFerrorf (ERR_WARNING,
+	      "%s: recconv applies to RLC lines only, ignored",
+	      model->LTRAmodName);
+	} else if (!LTRArlcFitSetup((GENmodel *) model, ckt->CKTfinalTime,
+		0.1 * ckt->CKTreltol)) {
+	  SPfrontEnd->IFerrorf (ERR_WARNING,
+	      "%s: impulse responses could not be fitted accurately, recconv ignored",
+	      model->LTRAmodName);
+	} else {
+	  model->LTRArecConv = 1;
+	}
+      }
     }
-    if (ckt->CKTtimeIndex >= model->LTRAmodelListSize) {	/* need more space */
+    if (model->LTRArecConv) {
+      /* no coefficient lists; set up the step just accepted */
+      if (ckt->CKTtimeIndex > 0)
+	LTRArecFactors(model->LTRApoles, model->LTRAnumPoles,
+	    *(ckt->CKTtimePoints + ckt->CKTtimeIndex) -
+	    *(ckt->CKTtimePoints + ckt->CKTtimeIndex - 1),
+	    model->LTRArecFactors);
+    } else if (ckt->CKTtimeIndex >= model->LTRAmodelListSize) {	/* need more space */
       model->LTRAmodelListSize += ckt->CKTsizeIncr;
 
 
@@ -56,6 +84,11 @@ LTRAaccept(CKTcircuit *ckt, GENmodel *inModel)
 	    LTRAmemMANAGE(here->LTRAi1, here->LTRAinstListSize)
 	    LTRAmemMANAGE(here->LTRAv2, here->LTRAinstListSize)
 	    LTRAmemMANAGE(here->LTRAi2, here->LTRAinstListSize)
+
+	if (model->LTRArecConv) {
+	  LTRAmemMANAGE(here->LTRArecState,
+	      LTRA_REC_BLOCKS * model->LTRAnumPoles)
+	}
       }
       /*
        * why is this here? ask TQ
@@ -83,6 +116,24 @@ LTRAaccept(CKTcircuit *ckt, GENmodel *inModel)
       *(here->LTRAi2 + ckt->CKTtimeIndex) = *(ckt->CKTrhsOld +
 	  here->LTRAbrEq2);
 
+      if (model->LTRArecConv && (ckt->CKTtimeIndex > 0)) {
+	/*
+	 * the h1dash states follow the last timepoint; the previous one is
+	 * taken at the initial value for timepoint 0, as in LTRAload
+	 */
+	int n = model->LTRAnumPoles;
+	int prev = ckt->CKTtimeIndex - 1;
+
+	LTRArecUpdate(here->LTRArecState + LTRA_REC_H1V1 * n,
+	    model->LTRAh1dashRes, model->LTRArecFactors, n,
+	    (prev == 0) ? 0.0 : *(here->LTRAv1 + prev) - here->LTRAinitVolt1,
+	    *(here->LTRAv1 + prev + 1) - here->LTRAinitVolt1);
+	LTRArecUpdate(here->LTRArecState + LTRA_REC_H1V2 * n,
+	    model->LTRAh1dashRes, model->LTRArecFactors, n,
+	    (prev == 0) ? 0.0 : *(here->LTRAv2 + prev) - here->LTRAinitVolt2,
+	    *(here->LTRAv2 + prev + 1) - here->LTRAinitVolt2);
+      }
+
       if (ckt->CKTtryToCompact && (ckt->CKTtimeIndex >= 2)) {
 
 	/*
@@ -258,6 +309,31 @@ LTRAaccept(CKTcircuit *ckt, GENmodel *inModel)
       /* ask TQ } */
 
     }				/* instance */
+
+    if (model->LTRArecConv) {
+      /*
+       * move the delayed states up to the last timepoint before
+       * time - T, but not past timepoint CKTtimeIndex - 2: compaction
+       * may still replace the ones after it
+       */
+      int n = model->LTRAnumPoles;
+      double *factors = model->LTRArecFactors + 3 * n;
+      double tdelayed = ckt->CKTtime - model->LTRAtd;
+      int aux = model->LTRArecAuxIndex;
+
+      while ((aux < ckt->CKTtimeIndex - 2) &&
+	  (*(ckt->CKTtimePoints + aux + 1) < tdelayed)) {
+	LTRArecFactors(model->LTRApoles, n,
+	    *(ckt->CKTtimePoints + aux + 1) - *(ckt->CKTtimePoints + aux),
+	    factors);
+	for (here = model->LTRAinstances; here != NULL;
+	    here = here->LTRAnextInstance)
+	  LTRArecDelayedStep((GENmodel *) model, (GENinstance *) here,
+	      here->LTRArecState + LTRA_REC_DELAYED * n, factors, aux);
+	aux++;
+      }
+      model->LTRArecAuxIndex = aux;
+    }
   }				/* model */
 
 
@@ -41,6 +41,7 @@ typedef struct sLTRAinstance {
     double *LTRAv2;     /* past values of v2 */
     double *LTRAi2;     /* past values of i2 */
     int LTRAinstListSize; /* size of above lists */
+    double *LTRArecState; /* recursive convolution states */
 
     double *LTRAibr1Ibr1Ptr;     /* pointer to sparse matrix */
     double *LTRAibr1Ibr2Ptr;     /* pointer to sparse matrix */
@@ -120,6 +121,15 @@ typedef struct sLTRAmodel {       /* model structure for a transmission lines */
     double *LTRAh3dashCoeffs; /* list of other coefficients for h3dash */
     int LTRAmodelListSize; /* size of above lists */
 
+    int LTRArecConv;       /* fitted impulse responses are in use */
+    int LTRAnumPoles;      /* number of poles of the fits */
+    double *LTRApoles;     /* poles shared by all three fits */
+    double *LTRAh1dashRes; /* residues of the fit to h1dash(t) */
+    double *LTRAh2Res;     /* residues of the fit to h2(t+T) */
+    double *LTRAh3dashRes; /* residues of the fit to h3dash(t+T) */
+    double *LTRArecFactors; /* per step exponentials and weights */
+    int LTRArecAuxIndex;   /* timepoint the delayed states belong to */
+
     double LTRAconduct;  /* conductance G  - input */
     double LTRAresist;   /* resistance R  - input */
     double LTRAinduct;   /* inductance L - input */
@@ -157,6 +167,7 @@ typedef struct sLTRAmodel {       /* model structure for a transmission lines */
     unsigned LTRAabstolGiven:1;  /* flag to ind. absolute deriv. tol. given */
 	unsigned LTRAtruncNR:1; /* flag to ind. use N-R iterations for calculating step in LTRAtrunc */
 	unsigned LTRAtruncDontCut:1; /* flag to ind. don't bother about errors in impulse response calculations due to large steps*/
+	unsigned LTRArecConvGiven:1; /* flag to ind. use recursive convolution with fitted impulse responses */
 	double LTRAmaxSafeStep; /* maximum safe step for impulse response calculations */
     unsigned LTRAresistGiven : 1; /* flag to indicate R was specified */
     unsigned LTRAconductGiven : 1; /* flag to indicate G was specified */
@@ -230,6 +241,19 @@ typedef struct sLTRAmodel {       /* model structure for a transmission lines */
 #define LTRA_MOD_CHOPABS 45
 #define LTRA_MOD_TRUNCNR 46
 #define LTRA_MOD_TRUNCDONTCUT	47
+#define LTRA_MOD_RECCONV 48
+
+/*
+ * blocks of LTRArecState, LTRAnumPoles long each: the convolutions of
+ * h1dash with v1 and v2 at the last timepoint, those of h2 with i1 and i2
+ * and of h3dash with v1 and v2 at timepoint LTRArecAuxIndex, and a copy of
+ * the latter four for LTRAload to carry forward
+ */
+#define LTRA_REC_H1V1 0
+#define LTRA_REC_H1V2 1
+#define LTRA_REC_DELAYED 2
+#define LTRA_REC_SCRATCH 6
+#define LTRA_REC_BLOCKS 10
 
 
 
@@ -20,10 +20,16 @@ LTRAdestroy(GENmodel **inModel)
     if (oldmod)
       FREE(oldmod);
     oldmod = mod;
+    FREE(mod->LTRApoles);
+    FREE(mod->LTRAh1dashRes);
+    FREE(mod->LTRAh2Res);
+    FREE(mod->LTRAh3dashRes);
+    FREE(mod->LTRArecFactors);
     prev = NULL;
     for (here = mod->LTRAinstances; here; here = here->LTRAnextInstance) {
       if (prev)
 	FREE(prev);
+      FREE(here->LTRArecState);
       prev = here;
     }
     if (prev)
@@ -44,3 +44,8 @@ extern double LTRAh3dashCoeffSetup(double*,int,double,double,double,double*,int,
 extern void LTRArcCoeffsSetup(double*,double*,double*,double*,double*,double*,int,double,double,double,double*,int,double);
 extern void LTRArlcCoeffsSetup(double*,double*,double*,double*,double*,double*,int,double,double,double,double,double*,int,double,int*);
 extern int LTRAstraightLineCheck(double,double,double,double,double,double,double,double);
+extern int LTRArlcFitSetup(GENmodel*,double,double);
+extern void LTRArecFactors(double*,int,double,double*);
+extern void LTRArecUpdate(double*,double*,double*,int,double,double);
+extern double LTRArecConvolve(double*,double*,double*,int,double,double);
+extern void LTRArecDelayedStep(GENmodel*,GENinstance*,double*,double*,int);
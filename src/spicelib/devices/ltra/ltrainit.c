@@ -73,7 +73,10 @@ SPICEdev LTRAinfo = {
  /* DEVacct       */ NULL,
 #endif                        
  /* DEVinstSize   */ &LTRAiSize,
- /* DEVmodSize    */ &LTRAmSize
+ /* DEVmodSize    */ &LTRAmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
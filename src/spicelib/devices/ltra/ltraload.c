@@ -10,6 +10,57 @@ Author: 1990 Jaijeet S. Roychowdhury
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
 
+/*
+ * LTRArecSetup - the recursive convolution counterpart of
+ * LTRArlcCoeffsSetup: sets up the factors for the step from the last
+ * timepoint and the h1dash coefficient that goes into the matrix, and, once
+ * the delay is over, carries copies of the delayed states forward to the
+ * last timepoint before time - T and sets up the factors for the rest of the
+ * way there.
+ */
+
+static void
+LTRArecSetup(LTRAmodel *model, CKTcircuit *ckt, unsigned tdover)
+{
+  LTRAinstance *here;
+  int n = model->LTRAnumPoles;
+  double *factors = model->LTRArecFactors;
+  double *timepoints = ckt->CKTtimePoints;
+  double tdelayed = ckt->CKTtime - model->LTRAtd;
+  int aux, k;
+
+  LTRArecFactors(model->LTRApoles, n,
+      ckt->CKTtime - *(timepoints + ckt->CKTtimeIndex), factors);
+  model->LTRAh1dashFirstCoeff = 0.0;
+  for (k = 0; k < n; k++)
+    model->LTRAh1dashFirstCoeff += model->LTRAh1dashRes[k] *
+	factors[2 * n + k];
+
+  if (!tdover)
+    return;
+
+  factors += 3 * n;
+  for (here = model->LTRAinstances; here != NULL;
+      here = here->LTRAnextInstance)
+    memcpy(here->LTRArecState + LTRA_REC_SCRATCH * n,
+	here->LTRArecState + LTRA_REC_DELAYED * n,
+	(size_t) (4 * n) * sizeof(double));
+
+  for (aux = model->LTRArecAuxIndex; (aux < ckt->CKTtimeIndex) &&
+      (*(timepoints + aux + 1) < tdelayed); aux++) {
+    LTRArecFactors(model->LTRApoles, n,
+	*(timepoints + aux + 1) - *(timepoints + aux), factors);
+    for (here = model->LTRAinstances; here != NULL;
+	here = here->LTRAnextInstance)
+      LTRArecDelayedStep((GENmodel *) model, (GENinstance *) here,
+	  here->LTRArecState + LTRA_REC_SCRATCH * n, factors, aux);
+  }
+
+  LTRArecFactors(model->LTRApoles, n, tdelayed - *(timepoints + aux),
+      factors);
+  model->LTRAauxIndex = aux;
+}
+
 int
 LTRAload(GENmodel *inModel, CKTcircuit *ckt)
 /*
@@ -113,15 +164,19 @@ LTRAload(GENmodel *inModel, CKTcircuit *ckt)
 	   * all together in one procedure
 	   */
 
-	  (void)
-	      LTRArlcCoeffsSetup(&(model->LTRAh1dashFirstCoeff),
-	      &(model->LTRAh2FirstCoeff),
-	      &(model->LTRAh3dashFirstCoeff),
-	      model->LTRAh1dashCoeffs, model->LTRAh2Coeffs,
-	      model->LTRAh3dashCoeffs, model->LTRAmodelListSize,
-	      model->LTRAtd, model->LTRAalpha, model->LTRAbeta,
-	      ckt->CKTtime, ckt->CKTtimePoints, ckt->CKTtimeIndex,
-	      model->LTRAchopReltol, &(model->LTRAauxIndex));
+	  if (model->LTRArecConv) {
+	    LTRArecSetup(model, ckt, tdover);
+	  } else {
+	    (void)
+		LTRArlcCoeffsSetup(&(model->LTRAh1dashFirstCoeff),
+		&(model->LTRAh2FirstCoeff),
+		&(model->LTRAh3dashFirstCoeff),
+		model->LTRAh1dashCoeffs, model->LTRAh2Coeffs,
+		model->LTRAh3dashCoeffs, model->LTRAmodelListSize,
+		model->LTRAtd, model->LTRAalpha, model->LTRAbeta,
+		ckt->CKTtime, ckt->CKTtimePoints, ckt->CKTtimeIndex,
+		model->LTRAchopReltol, &(model->LTRAauxIndex));
+	  }
 
 
 	case LTRA_MOD_LC:
@@ -601,14 +656,31 @@ LTRAload(GENmodel *inModel, CKTcircuit *ckt)
 	    /* the matrix has already been loaded above */
 
 	    dummy1 = dummy2 = 0.0;
-	    for (i = /* model->LTRAh1dashIndex */ ckt->CKTtimeIndex; i > 0; i--) {
-	      if (*(model->LTRAh1dashCoeffs + i) != 0.0) {
-		dummy1 += *(model->LTRAh1dashCoeffs
-		    + i) * (*(here->LTRAv1 + i) -
-		    here->LTRAinitVolt1);
-		dummy2 += *(model->LTRAh1dashCoeffs
-		    + i) * (*(here->LTRAv2 + i) -
-		    here->LTRAinitVolt2);
+	    if (model->LTRArecConv) {
+	      int n = model->LTRAnumPoles;
+
+	      if (ckt->CKTtimeIndex > 0) {
+		dummy1 = *(here->LTRAv1 + ckt->CKTtimeIndex) -
+		    here->LTRAinitVolt1;
+		dummy2 = *(here->LTRAv2 + ckt->CKTtimeIndex) -
+		    here->LTRAinitVolt2;
+	      }
+	      dummy1 = LTRArecConvolve(here->LTRArecState +
+		  LTRA_REC_H1V1 * n, model->LTRAh1dashRes,
+		  model->LTRArecFactors, n, dummy1, 0.0);
+	      dummy2 = LTRArecConvolve(here->LTRArecState +
+		  LTRA_REC_H1V2 * n, model->LTRAh1dashRes,
+		  model->LTRArecFactors, n, dummy2, 0.0);
+	    } else {
+	      for (i = /* model->LTRAh1dashIndex */ ckt->CKTtimeIndex; i > 0; i--) {
+		if (*(model->LTRAh1dashCoeffs + i) != 0.0) {
+		  dummy1 += *(model->LTRAh1dashCoeffs
+		      + i) * (*(here->LTRAv1 + i) -
+		      here->LTRAinitVolt1);
+		  dummy2 += *(model->LTRAh1dashCoeffs
+		      + i) * (*(here->LTRAv2 + i) -
+		      here->LTRAinitVolt2);
+		}
 	      }
 	    }
 
@@ -630,7 +702,24 @@ LTRAload(GENmodel *inModel, CKTcircuit *ckt)
 	    /* convolution of h2 with i2 and i1 */
 
 	    dummy1 = dummy2 = 0.0;
-	    if (tdover) {
+	    if (tdover && model->LTRArecConv) {
+
+	      /* the delayed states were carried up to LTRAauxIndex */
+
+	      int n = model->LTRAnumPoles;
+	      double *state = here->LTRArecState + LTRA_REC_SCRATCH * n;
+	      int aux = model->LTRAauxIndex;
+
+	      dummy1 = LTRArecConvolve(state + n, model->LTRAh2Res,
+		  model->LTRArecFactors + 3 * n, n, (aux == 0) ? 0.0 :
+		  *(here->LTRAi2 + aux) - here->LTRAinitCur2,
+		  i2d - here->LTRAinitCur2);
+	      dummy2 = LTRArecConvolve(state, model->LTRAh2Res,
+		  model->LTRArecFactors + 3 * n, n, (aux == 0) ? 0.0 :
+		  *(here->LTRAi1 + aux) - here->LTRAinitCur1,
+		  i1d - here->LTRAinitCur1);
+
+	    } else if (tdover) {
 
 	      /* the term for ckt->CKTtime - model->LTRAtd */
 
@@ -670,7 +759,22 @@ LTRAload(GENmodel *inModel, CKTcircuit *ckt)
 	    /* the term for ckt->CKTtime - model->LTRAtd */
 
 	    dummy1 = dummy2 = 0.0;
-	    if (tdover) {
+	    if (tdover && model->LTRArecConv) {
+
+	      int n = model->LTRAnumPoles;
+	      double *state = here->LTRArecState + LTRA_REC_SCRATCH * n;
+	      int aux = model->LTRAauxIndex;
+
+	      dummy1 = LTRArecConvolve(state + 3 * n, model->LTRAh3dashRes,
+		  model->LTRArecFactors + 3 * n, n, (aux == 0) ? 0.0 :
+		  *(here->LTRAv2 + aux) - here->LTRAinitVolt2,
+		  v2d - here->LTRAinitVolt2);
+	      dummy2 = LTRArecConvolve(state + 2 * n, model->LTRAh3dashRes,
+		  model->LTRArecFactors + 3 * n, n, (aux == 0) ? 0.0 :
+		  *(here->LTRAv1 + aux) - here->LTRAinitVolt1,
+		  v1d - here->LTRAinitVolt1);
+
+	    } else if (tdover) {
 
 	      dummy1 = (v2d - here->LTRAinitVolt2) *
 		  model->LTRAh3dashFirstCoeff;
@@ -49,6 +49,9 @@ LTRAmAsk(CKTcircuit *ckt, GENmodel *inModel, int param, IFvalue *value)
   case LTRA_MOD_TRUNCDONTCUT:
     value->iValue = mods->LTRAtruncDontCut;
     break;
+  case LTRA_MOD_RECCONV:
+    value->iValue = mods->LTRArecConvGiven;
+    break;
   case LTRA_MOD_R:
     value->rValue = mods->LTRAresist;
     break;
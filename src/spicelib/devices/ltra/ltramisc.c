@@ -767,6 +767,382 @@ LTRArlcCoeffsSetup(double *h1dashfirstcoeff, double *h2firstcoeff, double *h3das
   *auxindexptr = auxindex;
 }
 
+/*
+ * Recursive convolution for the RLC line
+ *
+ * h1dash(t), h2(t+T) and h3dash(t+T) are fitted once per transient run by
+ * sums of exponentials a_k*exp(-p_k*t) sharing the poles p_k, which are
+ * spread logarithmically from the final time of the analysis up to the
+ * fastest time constant of the line.  Convolving one such term with a
+ * piecewise linear waveform can be carried from one timepoint to the next
+ * in a fixed number of operations, so the cost per timestep no longer
+ * grows with the length of the history.
+ */
+
+/*
+ * exp(-|x|) times I_0(x), I_1(x) and I_1(x)/x; these stay finite for the
+ * large arguments the impulse responses reach at late times
+ */
+
+static double
+bessI0e(double x)
+{
+  double ax, ans;
+  double y;
+
+  if ((ax = fabs(x)) < 3.75) {
+    y = x / 3.75;
+    y *= y;
+    ans = exp(-ax) * (1.0 + y * (3.5156229 + y * (3.0899424 + y * (1.2067492
+		+ y * (0.2659732 + y * (0.360768e-1 + y * 0.45813e-2))))));
+  } else {
+    y = 3.75 / ax;
+    ans = (1.0 / sqrt(ax)) * (0.39894228 + y * (0.1328592e-1
+	    + y * (0.225319e-2 + y * (-0.157565e-2 + y * (0.916281e-2
+			+ y * (-0.2057706e-1 + y * (0.2635537e-1 + y * (-0.1647633e-1
+				    + y * 0.392377e-2))))))));
+  }
+  return (ans);
+}
+
+static double
+bessI1e(double x)
+{
+  double ax, ans;
+  double y;
+
+  if ((ax = fabs(x)) < 3.75) {
+    return (exp(-ax) * bessI1(x));
+  } else {
+    y = 3.75 / ax;
+    ans = 0.2282967e-1 + y * (-0.2895312e-1 + y * (0.1787654e-1
+	    - y * 0.420059e-2));
+    ans = 0.39894228 + y * (-0.3988024e-1 + y * (-0.362018e-2
+	    + y * (0.163801e-2 + y * (-0.1031555e-1 + y * ans))));
+    ans /= sqrt(ax);
+  }
+  return (x < 0.0 ? -ans : ans);
+}
+
+static double
+bessI1xOverXe(double x)
+{
+  double ax;
+
+  if ((ax = fabs(x)) < 3.75)
+    return (exp(-ax) * bessI1xOverX(x));
+  return (bessI1e(ax) / ax);
+}
+
+/*
+ * LTRArlcFitFunc - the function to be fitted: h1dash(time) for which == 0,
+ * h2(time+T) for which == 1 and h3dash(time+T) for which == 2
+ */
+
+static double
+LTRArlcFitFunc(int which, double time, double T, double alpha, double beta)
+{
+  double besselarg;
+
+  if (which == 0) {
+    besselarg = alpha * time;
+    return (alpha * exp((alpha - beta) * time) *
+	(bessI1e(besselarg) - bessI0e(besselarg)));
+  }
+
+  besselarg = alpha * sqrt(time * (time + 2.0 * T));
+
+  if (which == 1)
+    return (alpha * alpha * T * exp(besselarg - beta * (time + T)) *
+	bessI1xOverXe(besselarg));
+
+  return (alpha * exp(besselarg - beta * (time + T)) *
+      (alpha * (time + T) * bessI1xOverXe(besselarg) - bessI0e(besselarg)));
+}
+
+/*
+ * LTRAleastSquares - solves the m x n (m >= n) least squares problem
+ * a x = b by Householder reflections; a is stored by columns, a and b are
+ * overwritten.  Returns 0 if a is rank deficient.
+ */
+
+static int
+LTRAleastSquares(int m, int n, double *a, double *b, double *x)
+{
+  double *col, *other, *diag;
+  double norm, scale, dot;
+  int i, j, k;
+
+  diag = TMALLOC(double, n);
+
+  for (k = 0; k < n; k++) {
+    col = a + k * m;
+    norm = 0.0;
+    for (i = k; i < m; i++)
+      norm += col[i] * col[i];
+    norm = sqrt(norm);
+    if (norm == 0.0) {
+      tfree(diag);
+      return (0);
+    }
+    diag[k] = (col[k] > 0.0) ? -norm : norm;
+    col[k] -= diag[k];
+    scale = -diag[k] * col[k];
+
+    for (j = k + 1; j < n; j++) {
+      other = a + j * m;
+      dot = 0.0;
+      for (i = k; i < m; i++)
+	dot += col[i] * other[i];
+      dot /= scale;
+      for (i = k; i < m; i++)
+	other[i] -= dot * col[i];
+    }
+    dot = 0.0;
+    for (i = k; i < m; i++)
+      dot += col[i] * b[i];
+    dot /= scale;
+    for (i = k; i < m; i++)
+      b[i] -= dot * col[i];
+  }
+
+  for (k = n - 1; k >= 0; k--) {
+    dot = b[k];
+    for (j = k + 1; j < n; j++)
+      dot -= a[j * m + k] * x[j];
+    x[k] = dot / diag[k];
+  }
+
+  tfree(diag);
+  return (1);
+}
+
+#define LTRAmaxPoles 64
+
+/*
+ * LTRArlcFitSetup - fits the three impulse responses of an RLC line over
+ * [0, tmax], using more poles per decade until the integral of the absolute
+ * error of every fit is below tol times the integral of the absolute value
+ * of its function.  On success the poles and residues are stored in the
+ * model and 1 is returned, otherwise 0.
+ */
+
+int
+LTRArlcFitSetup(GENmodel *genmodel, double tmax, double tol)
+{
+  LTRAmodel *model = (LTRAmodel *) genmodel;
+  double T = model->LTRAtd;
+  double alpha = model->LTRAalpha;
+  double beta = model->LTRAbeta;
+  double pmin, pmax, tlo, lo, hi, h, fval, gval;
+  double err[3], norm[3], preverr[3], prevnorm[3];
+  double *poles, *res, *a, *b, *samples, *weight, *expval;
+  int perdecade, npoles, nsamples, ncheck, which, j, k;
+  int fitted = 0;
+
+  if (tmax <= 0.0 || alpha <= 0.0)
+    return (0);
+
+  /* the fastest time constants are those of h1dash and of h2 near T */
+  pmax = 20.0 * (alpha + alpha * alpha * T);
+  pmin = 0.2 / tmax;
+  if (pmax < 10.0 * pmin)
+    pmax = 10.0 * pmin;
+  tlo = 0.05 / pmax;
+
+  for (perdecade = 3; perdecade <= 6 && !fitted; perdecade++) {
+
+    npoles = (int) ceil(perdecade * log10(pmax / pmin)) + 1;
+    if (npoles > LTRAmaxPoles)
+      npoles = LTRAmaxPoles;
+    nsamples = 8 * npoles;
+    ncheck = 4 * nsamples;
+
+    poles = TMALLOC(double, npoles);
+    res = TMALLOC(double, 3 * npoles);
+    a = TMALLOC(double, nsamples * npoles);
+    b = TMALLOC(double, nsamples);
+    samples = TMALLOC(double, nsamples);
+    weight = TMALLOC(double, nsamples);
+    expval = TMALLOC(double, npoles);
+
+    for (k = 0; k < npoles; k++)
+      poles[k] = pmin * pow(pmax / pmin, (double) k / (npoles - 1));
+
+    /*
+     * sample at zero and logarithmically from tlo to tmax, weighting each
+     * sample by the square root of the interval it stands for
+     */
+    samples[0] = 0.0;
+    for (j = 1; j < nsamples; j++)
+      samples[j] = tlo * pow(tmax / tlo, (double) (j - 1) / (nsamples - 2));
+    for (j = 0; j < nsamples; j++) {
+      lo = (j == 0) ? 0.0 : 0.5 * (samples[j - 1] + samples[j]);
+      hi = (j == nsamples - 1) ? samples[j] :
+	  0.5 * (samples[j] + samples[j + 1]);
+      weight[j] = sqrt(hi - lo);
+    }
+
+    fitted = 1;
+    for (which = 0; which < 3 && fitted; which++) {
+      for (j = 0; j < nsamples; j++) {
+	b[j] = weight[j] * LTRArlcFitFunc(which, samples[j], T, alpha, beta);
+	for (k = 0; k < npoles; k++)
+	  a[k * nsamples + j] = weight[j] * exp(-poles[k] * samples[j]);
+      }
+      fitted = LTRAleastSquares(nsamples, npoles, a, b, res + which * npoles);
+    }
+
+    /* check the fits on a finer grid */
+    for (which = 0; which < 3; which++)
+      err[which] = norm[which] = preverr[which] = prevnorm[which] = 0.0;
+    lo = 0.0;
+    for (j = 0; j <= ncheck && fitted; j++) {
+      hi = (j == 0) ? 0.0 :
+	  0.1 * tlo * pow(10.0 * tmax / tlo, (double) (j - 1) / (ncheck - 1));
+      h = hi - lo;
+      for (k = 0; k < npoles; k++)
+	expval[k] = exp(-poles[k] * hi);
+      for (which = 0; which < 3; which++) {
+	gval = LTRArlcFitFunc(which, hi, T, alpha, beta);
+	fval = 0.0;
+	for (k = 0; k < npoles; k++)
+	  fval += res[which * npoles + k] * expval[k];
+	err[which] += 0.5 * h * (fabs(gval - fval) + preverr[which]);
+	norm[which] += 0.5 * h * (fabs(gval) + prevnorm[which]);
+	preverr[which] = fabs(gval - fval);
+	prevnorm[which] = fabs(gval);
+      }
+      lo = hi;
+    }
+    for (which = 0; which < 3 && fitted; which++)
+      if (!(err[which] <= tol * norm[which]))
+	fitted = 0;
+
+    if (fitted) {
+      FREE(model->LTRApoles);
+      FREE(model->LTRAh1dashRes);
+      FREE(model->LTRAh2Res);
+      FREE(model->LTRAh3dashRes);
+      FREE(model->LTRArecFactors);
+      model->LTRAnumPoles = npoles;
+      model->LTRApoles = poles;
+      model->LTRAh1dashRes = TMALLOC(double, npoles);
+      model->LTRAh2Res = TMALLOC(double, npoles);
+      model->LTRAh3dashRes = TMALLOC(double, npoles);
+      model->LTRArecFactors = TMALLOC(double, 6 * npoles);
+      for (k = 0; k < npoles; k++) {
+	model->LTRAh1dashRes[k] = res[k];
+	model->LTRAh2Res[k] = res[npoles + k];
+	model->LTRAh3dashRes[k] = res[2 * npoles + k];
+      }
+    } else {
+      tfree(poles);
+    }
+    tfree(res);
+    tfree(a);
+    tfree(b);
+    tfree(samples);
+    tfree(weight);
+    tfree(expval);
+  }
+
+  return (fitted);
+}
+
+/*
+ * LTRArecFactors - sets up factors[0..3n-1] for a step of length h: the
+ * decays exp(-p_k h), followed by the weights w0_k and w1_k for which
+ * \int_0^h exp(-p_k \tau) x(t-\tau) d\tau = w0_k x(t-h) + w1_k x(t)
+ * when x is linear over the step
+ */
+
+void
+LTRArecFactors(double *poles, int n, double h, double *factors)
+{
+  double *decay = factors, *w0 = factors + n, *w1 = factors + 2 * n;
+  double z, e0, e1;
+  int k;
+
+  for (k = 0; k < n; k++) {
+    z = poles[k] * h;
+    decay[k] = exp(-z);
+    e0 = -expm1(-z) / poles[k];
+    if (z < 0.05) {
+      /* series for (1 - exp(-z)*(1+z))/z^2, which cancels badly here */
+      e1 = h * (1.0 / 2 - z * (1.0 / 3 - z * (1.0 / 8 - z * (1.0 / 30
+			  - z * (1.0 / 144 - z * (1.0 / 840 - z / 5760))))));
+    } else {
+      e1 = (1.0 - decay[k] * (1.0 + z)) / (poles[k] * z);
+    }
+    w0[k] = e1;
+    w1[k] = e0 - e1;
+  }
+}
+
+/*
+ * LTRArecUpdate - carries the states of the convolution of a fit with
+ * residues res over a step set up by LTRArecFactors, the waveform going
+ * linearly from x0 to x1; LTRArecConvolve returns the value of the
+ * convolution at the end of the step, leaving the states alone
+ */
+
+void
+LTRArecUpdate(double *state, double *res, double *factors, int n, double x0, double x1)
+{
+  double *decay = factors, *w0 = factors + n, *w1 = factors + 2 * n;
+  int k;
+
+  for (k = 0; k < n; k++)
+    state[k] = decay[k] * state[k] + res[k] * (w0[k] * x0 + w1[k] * x1);
+}
+
+double
+LTRArecConvolve(double *state, double *res, double *factors, int n, double x0, double x1)
+{
+  double *decay = factors, *w0 = factors + n, *w1 = factors + 2 * n;
+  double sum = 0.0;
+  int k;
+
+  for (k = 0; k < n; k++)
+    sum += decay[k] * state[k] + res[k] * (w0[k] * x0 + w1[k] * x1);
+  return (sum);
+}
+
+/*
+ * LTRArecDelayedStep - carries the four delayed states of an instance
+ * (h2 with i1 and i2, h3dash with v1 and v2) over the step from timepoint
+ * i to i+1; as in the direct convolution, the waveforms start at their
+ * initial values at timepoint 0
+ */
+
+void
+LTRArecDelayedStep(GENmodel *genmodel, GENinstance *geninstance, double *state, double *factors, int i)
+{
+  LTRAmodel *model = (LTRAmodel *) genmodel;
+  LTRAinstance *here = (LTRAinstance *) geninstance;
+  int n = model->LTRAnumPoles;
+  double i1, i2, v1, v2;
+
+  if (i == 0) {
+    i1 = i2 = v1 = v2 = 0.0;
+  } else {
+    i1 = *(here->LTRAi1 + i) - here->LTRAinitCur1;
+    i2 = *(here->LTRAi2 + i) - here->LTRAinitCur2;
+    v1 = *(here->LTRAv1 + i) - here->LTRAinitVolt1;
+    v2 = *(here->LTRAv2 + i) - here->LTRAinitVolt2;
+  }
+
+  LTRArecUpdate(state, model->LTRAh2Res, factors, n, i1,
+      *(here->LTRAi1 + i + 1) - here->LTRAinitCur1);
+  LTRArecUpdate(state + n, model->LTRAh2Res, factors, n, i2,
+      *(here->LTRAi2 + i + 1) - here->LTRAinitCur2);
+  LTRArecUpdate(state + 2 * n, model->LTRAh3dashRes, factors, n, v1,
+      *(here->LTRAv1 + i + 1) - here->LTRAinitVolt1);
+  LTRArecUpdate(state + 3 * n, model->LTRAh3dashRes, factors, n, v2,
+      *(here->LTRAv2 + i + 1) - here->LTRAinitVolt2);
+}
+
 /*
  * LTRAstraightLineCheck - takes the co-ordinates of three points, finds the
  * area of the triangle enclosed by these points and compares this area with
@@ -48,6 +48,9 @@ LTRAmParam(int param, IFvalue *value, GENmodel *inModel)
   case LTRA_MOD_TRUNCDONTCUT:
     mods->LTRAtruncDontCut = TRUE;
     break;
+  case LTRA_MOD_RECCONV:
+    mods->LTRArecConvGiven = TRUE;
+    break;
   case LTRA_MOD_R:
     mods->LTRAresist = value->rValue;
     mods->LTRAresistGiven = TRUE;
@@ -73,7 +73,10 @@ SPICEdev MESinfo = {
  /* DEVacct       */ NULL,
 #endif                        
  /* DEVinstSize   */ &MESiSize,
- /* DEVmodSize    */ &MESmSize
+ /* DEVmodSize    */ &MESmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
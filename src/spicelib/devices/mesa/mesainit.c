@@ -73,7 +73,10 @@ SPICEdev MESAinfo = {
  /* DEVacct       */ NULL,
 #endif                        
  /* DEVinstSize   */ &MESAiSize,
- /* DEVmodSize    */ &MESAmSize
+ /* DEVmodSize    */ &MESAmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -73,7 +73,10 @@ SPICEdev MOS2info = {
  /* DEVacct       */ NULL,
 #endif    
  /* DEVinstSize   */ &MOS2iSize,
- /* DEVmodSize    */ &MOS2mSize
+ /* DEVmodSize    */ &MOS2mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 };
 
 
@@ -73,7 +73,10 @@ SPICEdev MOS3info = {
  /* DEVacct       */ NULL,
 #endif                         
  /* DEVinstSize   */ &MOS3iSize,
- /* DEVmodSize    */ &MOS3mSize
+ /* DEVmodSize    */ &MOS3mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -73,7 +73,10 @@ SPICEdev MOS6info = {
  /* DEVacct       */ NULL,
 #endif                        
  /* DEVinstSize   */ &MOS6iSize,
- /* DEVmodSize    */ &MOS6mSize
+ /* DEVmodSize    */ &MOS6mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 };
 
 
@@ -73,7 +73,10 @@ SPICEdev MOS9info = {
  /* DEVacct       */ NULL,
 #endif                        
  /* DEVinstSize   */ &MOS9iSize,
- /* DEVmodSize    */ &MOS9mSize
+ /* DEVmodSize    */ &MOS9mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -74,7 +74,10 @@ SPICEdev NBJTinfo = {
 #endif
 
  /* DEVinstSize   */ &NBJTiSize,
- /* DEVmodSize    */ &NBJTmSize
+ /* DEVmodSize    */ &NBJTmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -74,7 +74,10 @@ SPICEdev NBJT2info = {
 #endif  
                     
  /* DEVinstSize   */ &NBJT2iSize,
- /* DEVmodSize    */ &NBJT2mSize
+ /* DEVmodSize    */ &NBJT2mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -74,7 +74,10 @@ SPICEdev NDEVinfo = {
 #endif               
                     
  /* DEVinstSize   */ &NDEViSize,
- /* DEVmodSize    */ &NDEVmSize
+ /* DEVmodSize    */ &NDEVmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
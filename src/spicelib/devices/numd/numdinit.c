@@ -74,7 +74,10 @@ SPICEdev NUMDinfo = {
 #endif
                     
  /* DEVinstSize   */ &NUMDiSize,
- /* DEVmodSize    */ &NUMDmSize
+ /* DEVmodSize    */ &NUMDmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -74,7 +74,10 @@ SPICEdev NUMD2info = {
 #endif
                     
  /* DEVinstSize   */ &NUMD2iSize,
- /* DEVmodSize    */ &NUMD2mSize
+ /* DEVmodSize    */ &NUMD2mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -74,7 +74,10 @@ SPICEdev NUMOSinfo = {
 #endif
                     
  /* DEVinstSize   */ &NUMOSiSize,
- /* DEVmodSize    */ &NUMOSmSize
+ /* DEVmodSize    */ &NUMOSmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -129,6 +129,8 @@ typedef struct sRESmodel {       /* model structure for a resistor */
     unsigned RESlfGiven         :1; /* flags indicates lf is given */
     unsigned RESwfGiven         :1; /* flags indicates wf is given */
     unsigned RESefGiven         :1; /* flags indicates ef is given */
+
+    CKTlinear *RESlinear;   /* the instances in arrays, for the load */
 } RESmodel;
 
 /* device parameters */
@@ -7,6 +7,7 @@ Modified: Apr 2000 - Paolo Nenzi
  */
 
 #include "ngspice/ngspice.h"
+#include "ngspice/cktlinear.h"
 #include "resdefs.h"
 #include "ngspice/sperror.h"
 
@@ -24,6 +25,7 @@ RESdelete(GENmodel *inModel, IFuid name, GENinstance **inst)
         for(here = *prev; here ; here = *prev) {
             if(here->RESname == name || (fast && here==*fast) ) {
                 *prev= here->RESnextInstance;
+                CKTlinearFree(&model->RESlinear);
                 FREE(here);
                 return(OK);
             }
@@ -7,6 +7,7 @@ Modified: Apr 2000 - Paolo Nenzi
  */
 
 #include "ngspice/ngspice.h"
+#include "ngspice/cktlinear.h"
 #include "resdefs.h"
 
 
@@ -22,6 +23,7 @@ RESdestroy(GENmodel **inModel)
     for( ; mod ; mod = mod->RESnextModel) {
         if(oldmod) FREE(oldmod);
         oldmod = mod;
+        CKTlinearFree(&mod->RESlinear);
         prev = NULL;
         for(here = mod->RESinstances ; here ; here = here->RESnextInstance) {
             if(prev) FREE(prev);
@@ -6,36 +6,57 @@ Modified: Apr 2000 - Paolo Nenzi
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktlinear.h"
 #include "resdefs.h"
 #include "ngspice/sperror.h"
 
 
+/* copy the conductances and matrix pointers of the instances of a
+ * model into arrays */
+static CKTlinear *
+RESlinearMake(RESmodel *model)
+{
+    RESinstance *here;
+    CKTlinear *lin;
+    double **elt;
+    int k;
+
+    k = 0;
+    for (here = model->RESinstances; here != NULL ;
+         here = here->RESnextInstance)
+        k++;
+
+    lin = CKTlinearNew(k, 4);
+    elt = lin->elt;
+
+    k = 0;
+    for (here = model->RESinstances; here != NULL ;
+         here = here->RESnextInstance) {
+        lin->val[k++] = here->RESm * here->RESconduct;
+        *elt++ = here->RESposPosptr;
+        *elt++ = here->RESnegNegptr;
+        *elt++ = here->RESposNegptr;
+        *elt++ = here->RESnegPosptr;
+    }
+
+    return lin;
+}
+
+
 /* actually load the current resistance value into the sparse matrix
  * previously provided */
 int
 RESload(GENmodel *inModel, CKTcircuit *ckt)
 {
     RESmodel *model = (RESmodel *)inModel;
-    double m;
+
+    NG_IGNORE(ckt);
 
     /*  loop through all the resistor models */
     for( ; model != NULL; model = model->RESnextModel ) {
-        RESinstance *here;
-
-        /* loop through all the instances of the model */
-        for (here = model->RESinstances; here != NULL ;
-                here = here->RESnextInstance) {
-
-            here->REScurrent = (*(ckt->CKTrhsOld+here->RESposNode) -
-                                *(ckt->CKTrhsOld+here->RESnegNode)) * here->RESconduct;
-
-            m = (here->RESm);
-
-            *(here->RESposPosptr) += m * here->RESconduct;
-            *(here->RESnegNegptr) += m * here->RESconduct;
-            *(here->RESposNegptr) -= m * here->RESconduct;
-            *(here->RESnegPosptr) -= m * here->RESconduct;
-        }
+        if (!model->RESlinear)
+            model->RESlinear = RESlinearMake(model);
+        CKTlinearStamp(model->RESlinear);
     }
     return(OK);
 }
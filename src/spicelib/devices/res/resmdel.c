@@ -5,6 +5,7 @@ Modified: Apr 2000 - Paolo Nenzi
 **********/
 
 #include "ngspice/ngspice.h"
+#include "ngspice/cktlinear.h"
 #include "resdefs.h"
 #include "ngspice/sperror.h"
 
@@ -32,6 +33,7 @@ delgot:
         prev = here;
     }
     if(prev) FREE(prev);
+    CKTlinearFree(&(*model)->RESlinear);
     FREE(*model);
     return(OK);
 
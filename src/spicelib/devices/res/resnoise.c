@@ -63,6 +63,13 @@ RESnoise (int mode, int operation, GENmodel *genmodel, CKTcircuit *ckt,
 
             case N_OPEN:
 
+                /* the dc current for the flicker noise, CKTrhsOld still
+                 * holds the operating point */
+                if (mode == N_DENS)
+                    inst->REScurrent = (*(ckt->CKTrhsOld+inst->RESposNode) -
+                                        *(ckt->CKTrhsOld+inst->RESnegNode)) *
+                                       inst->RESconduct;
+
                 /* 
                  * See if we have to to produce a summary report
                  * if so, name the noise generator 
@@ -7,6 +7,7 @@ Modified: Apr 2000 - Paolo Nenzi
 #include "ngspice/ngspice.h"
 #include "ngspice/const.h"
 #include "ngspice/ifsim.h"
+#include "ngspice/cktlinear.h"
 #include "resdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/missing_math.h"
@@ -21,6 +22,9 @@ RESparam(int param, IFvalue *value, GENinstance *inst, IFvalue *select)
 
     NG_IGNORE(select);
 
+    /* the load has its own copy of the parameters */
+    CKTlinearFree(&here->RESmodPtr->RESlinear);
+
     if (!cp_getvar("scale", CP_REAL, &scale))
         scale = 1;
 
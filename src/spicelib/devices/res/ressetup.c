@@ -6,6 +6,7 @@ Modified: Apr 2000 Paolo Nenzi
 
 #include "ngspice/ngspice.h"
 #include "ngspice/smpdefs.h"
+#include "ngspice/cktlinear.h"
 #include "resdefs.h"
 #include "ngspice/sperror.h"
 
@@ -25,6 +26,8 @@ RESsetup(SMPmatrix *matrix, GENmodel *inModel, CKTcircuit*ckt, int *state)
     /*  loop through all the resistor models */
     for( ; model != NULL; model = model->RESnextModel ) {
 
+        CKTlinearFree(&model->RESlinear);
+
         /* Default Value Processing for Resistor Models */
         if(!model->REStnomGiven) model->REStnom         = ckt->CKTnomTemp;
         if(!model->RESsheetResGiven) model->RESsheetRes = 0.0;
@@ -7,6 +7,7 @@ Modified: 2000 AlanSfixes
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktlinear.h"
 #include "resdefs.h"
 #include "ngspice/sperror.h"
 
@@ -29,6 +30,8 @@ REStemp(GENmodel *inModel, CKTcircuit *ckt)
     /*  loop through all the resistor models */
     for( ; model != NULL; model = model->RESnextModel ) {
 
+        CKTlinearFree(&model->RESlinear);
+
         /* loop through all the instances of the model */
         for (here = model->RESinstances; here != NULL ;
                 here=here->RESnextInstance) {
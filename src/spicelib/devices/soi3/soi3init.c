@@ -73,7 +73,10 @@ SPICEdev SOI3info = {
  /* DEVacct       */ NULL,
 #endif                        
  /* DEVinstSize   */ &SOI3iSize,
- /* DEVmodSize    */ &SOI3mSize
+ /* DEVmodSize    */ &SOI3mSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
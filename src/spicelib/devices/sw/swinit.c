@@ -74,7 +74,10 @@ SPICEdev SWinfo = {
  /* DEVacct       */ NULL,
 #endif /* CIDER */                        
  /* DEVinstSize   */ &SWiSize,
- /* DEVmodSize    */ &SWmSize
+ /* DEVmodSize    */ &SWmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -73,7 +73,10 @@ SPICEdev TRAinfo = {
  /* DEVacct       */ NULL,
 #endif                        
  /* DEVinstSize   */ &TRAiSize,
- /* DEVmodSize    */ &TRAmSize
+ /* DEVmodSize    */ &TRAmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
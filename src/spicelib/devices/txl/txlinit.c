@@ -78,7 +78,10 @@ SPICEdev TXLinfo = {
  /* DEVacct       */ NULL,  
 #endif
     &TXLiSize,
-    &TXLmSize
+    &TXLmSize,
+    NULL,
+    0,
+    0
 
 };
 
@@ -73,7 +73,10 @@ SPICEdev URCinfo = {
  /* DEVacct       */ NULL,
 #endif                        
  /* DEVinstSize   */ &URCiSize,
- /* DEVmodSize    */ &URCmSize
+ /* DEVmodSize    */ &URCmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -15,6 +15,7 @@ extern int VBICdelete(GENmodel*,IFuid,GENinstance**);
 extern void VBICdestroy(GENmodel**);
 extern int VBICgetic(GENmodel*,CKTcircuit*);
 extern int VBICload(GENmodel*,CKTcircuit*);
+extern int VBICloadInst(GENinstance*,CKTcircuit*,CKTstamp*);
 extern int VBICmAsk(CKTcircuit*,GENmodel*,int,IFvalue*);
 extern int VBICmDelete(GENmodel**,IFuid,GENmodel*);
 extern int VBICmParam(int,IFvalue*,GENmodel*);
@@ -78,8 +78,10 @@ SPICEdev VBICinfo = {
     NULL,         /* DEVacct       */
 #endif                                                         
     &VBICiSize,   /* DEVinstSize    */
-    &VBICmSize    /* DEVmodSize     */
-
+    &VBICmSize,   /* DEVmodSize     */
+    VBICloadInst, /* DEVloadInst    */
+    116,          /* DEVstampMat    */
+    28            /* DEVstampRhs    */
 };
 
 
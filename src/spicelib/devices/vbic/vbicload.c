@@ -12,6 +12,7 @@ Spice3 Implementation: 2003 Dietmar Warning DAnalyse GmbH
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktstamp.h"
 #include "vbicdefs.h"
 #include "ngspice/const.h"
 #include "ngspice/trandefs.h"
@@ -37,8 +38,16 @@ VBICload(GENmodel *inModel, CKTcircuit *ckt)
          * sparse matrix previously provided 
          */
 {
-    VBICmodel *model = (VBICmodel*)inModel;
-    VBICinstance *here;
+    return CKTstampLoad(inModel, ckt);
+}
+
+
+/* evaluate a single VBIC transistor into its stamp buffer */
+int
+VBICloadInst(GENinstance *inInst, CKTcircuit *ckt, CKTstamp *st)
+{
+    VBICinstance *here = (VBICinstance *)inInst;
+    VBICmodel *model = here->VBICmodPtr;
     double p[108]
     ,Vbei,Vbex,Vbci,Vbep,Vbcp,Vrcx
     ,Vbcx,Vrci,Vrbx,Vrbi,Vre,Vrbp,Vrs
@@ -84,253 +93,191 @@ VBICload(GENmodel *inModel, CKTcircuit *ckt)
     int SenCond=0;
     double gqbeo, cqbeo, gqbco, cqbco, gbcx, cbcx;
 
-    /*  loop through all the models */
-    for( ; model != NULL; model = model->VBICnextModel ) {
-
-        /* loop through all the instances of the model */
-        for (here = model->VBICinstances; here != NULL ;
-                here=here->VBICnextInstance) {
 
-            vt = here->VBICtemp * CONSTKoverQ;
+    vt = here->VBICtemp * CONSTKoverQ;
 
-            if(ckt->CKTsenInfo){
+    if(ckt->CKTsenInfo){
 #ifdef SENSDEBUG
-                printf("VBICload\n");
+        printf("VBICload\n");
 #endif /* SENSDEBUG */
-                if((ckt->CKTsenInfo->SENstatus == PERTURBATION)&&
-                    (here->VBICsenPertFlag == OFF)) continue;
-                SenCond = here->VBICsenPertFlag;
-            }
+        if((ckt->CKTsenInfo->SENstatus == PERTURBATION)&&
+            (here->VBICsenPertFlag == OFF)) return(OK);
+        SenCond = here->VBICsenPertFlag;
+    }
 
-            gbcx = 0.0;
-            cbcx = 0.0;
-            gqbeo = 0.0;
-            cqbeo = 0.0;
-            gqbco = 0.0;
-            cqbco = 0.0;
-            /*
-             *   dc model paramters
-             */
-            p[0] = here->VBICttnom;
-            p[1] = here->VBICtextCollResist;
-            p[2] = here->VBICtintCollResist;
-            p[3] = here->VBICtepiSatVoltage;
-            p[4] = here->VBICtepiDoping;
-            p[5] = model->VBIChighCurFac;
-            p[6] = here->VBICtextBaseResist;
-            p[7] = here->VBICtintBaseResist;
-            p[8] = here->VBICtemitterResist;
-            p[9] = here->VBICtsubstrateResist;
-            p[10] = here->VBICtparBaseResist;
-            p[11] = here->VBICtsatCur;
-            p[12] = here->VBICtemissionCoeffF;
-            p[13] = here->VBICtemissionCoeffR;
-            p[14] = model->VBICdeplCapLimitF;
-            p[15] = model->VBICextOverlapCapBE;
-            p[16] = here->VBICtdepletionCapBE;
-            p[17] = here->VBICtpotentialBE;
-            p[18] = model->VBICjunctionExpBE;
-            p[19] = model->VBICsmoothCapBE;
-            p[20] = model->VBICextOverlapCapBC;
-            p[21] = here->VBICtdepletionCapBC;
-            p[22] = model->VBICepiCharge;
-            p[23] = here->VBICtextCapBC;
-            p[24] = here->VBICtpotentialBC;
-            p[25] = model->VBICjunctionExpBC;
-            p[26] = model->VBICsmoothCapBC;
-            p[27] = here->VBICtextCapSC;
-            p[28] = here->VBICtpotentialSC;
-            p[29] = model->VBICjunctionExpSC;
-            p[30] = model->VBICsmoothCapSC;
-            p[31] = here->VBICtidealSatCurBE;
-            p[32] = model->VBICportionIBEI;
-            p[33] = model->VBICidealEmissCoeffBE;
-            p[34] = here->VBICtnidealSatCurBE;
-            p[35] = model->VBICnidealEmissCoeffBE;
-            p[36] = here->VBICtidealSatCurBC;
-            p[37] = model->VBICidealEmissCoeffBC;
-            p[38] = here->VBICtnidealSatCurBC;
-            p[39] = model->VBICnidealEmissCoeffBC;
-            p[40] = model->VBICavalanchePar1BC;
-            p[41] = here->VBICtavalanchePar2BC;
-            p[42] = here->VBICtparasitSatCur;
-            p[43] = model->VBICportionICCP;
-            p[44] = model->VBICparasitFwdEmissCoeff;
-            p[45] = here->VBICtidealParasitSatCurBE;
-            p[46] = here->VBICtnidealParasitSatCurBE;
-            p[47] = here->VBICtidealParasitSatCurBC;
-            p[48] = model->VBICidealParasitEmissCoeffBC;
-            p[49] = here->VBICtnidealParasitSatCurBC;
-            p[50] = model->VBICnidealParasitEmissCoeffBC;
-            p[51] = model->VBICearlyVoltF;
-            p[52] = model->VBICearlyVoltR;
-            p[53] = here->VBICtrollOffF;
-            p[54] = model->VBICrollOffR;
-            p[55] = model->VBICparRollOff;
-            p[56] = model->VBICtransitTimeF;
-            p[57] = model->VBICvarTransitTimeF;
-            p[58] = model->VBICtransitTimeBiasCoeffF;
-            p[59] = model->VBICtransitTimeFVBC;
-            p[60] = model->VBICtransitTimeHighCurrentF;
-            p[61] = model->VBICtransitTimeR;
-            p[62] = model->VBICdelayTimeF;
-            p[63] = model->VBICfNcoef;
-            p[64] = model->VBICfNexpA;
-            p[65] = model->VBICfNexpB;
-            p[66] = model->VBICtempExpRE;
-            p[67] = model->VBICtempExpRBI;
-            p[68] = model->VBICtempExpRCI;
-            p[69] = model->VBICtempExpRS;
-            p[70] = model->VBICtempExpVO;
-            p[71] = model->VBICactivEnergyEA;
-            p[72] = model->VBICactivEnergyEAIE;
-            p[73] = model->VBICactivEnergyEAIC;
-            p[74] = model->VBICactivEnergyEAIS;
-            p[75] = model->VBICactivEnergyEANE;
-            p[76] = model->VBICactivEnergyEANC;
-            p[77] = model->VBICactivEnergyEANS;
-            p[78] = model->VBICtempExpIS;
-            p[79] = model->VBICtempExpII;
-            p[80] = model->VBICtempExpIN;
-            p[81] = model->VBICtempExpNF;
-            p[82] = model->VBICtempExpAVC;
-            p[83] = model->VBICthermalResist;
-            p[84] = model->VBICthermalCapacitance;
-            p[85] = model->VBICpunchThroughVoltageBC;
-            p[86] = model->VBICdeplCapCoeff1;
-            p[87] = model->VBICfixedCapacitanceCS;
-            p[88] = model->VBICsgpQBselector;
-            p[89] = model->VBIChighCurrentBetaRolloff;
-            p[90] = model->VBICtempExpIKF;
-            p[91] = model->VBICtempExpRCX;
-            p[92] = model->VBICtempExpRBX;
-            p[93] = model->VBICtempExpRBP;
-            p[94] = here->VBICtsepISRR;
-            p[95] = model->VBICtempExpXISR;
-            p[96] = model->VBICdear;
-            p[97] = model->VBICeap;
-            p[98] = here->VBICtvbbe;
-            p[99] = here->VBICtnbbe;
-            p[100] = model->VBICibbe;
-            p[101] = model->VBICtvbbe1;
-            p[102] = model->VBICtvbbe2;
-            p[103] = model->VBICtnbbe;
-            p[104] = model->VBICebbe;
-            p[105] = model->VBIClocTempDiff;
-            p[106] = model->VBICrevVersion;
-            p[107] = model->VBICrefVersion;
+    gbcx = 0.0;
+    cbcx = 0.0;
+    gqbeo = 0.0;
+    cqbeo = 0.0;
+    gqbco = 0.0;
+    cqbco = 0.0;
+    /*
+     *   dc model paramters
+     */
+    p[0] = here->VBICttnom;
+    p[1] = here->VBICtextCollResist;
+    p[2] = here->VBICtintCollResist;
+    p[3] = here->VBICtepiSatVoltage;
+    p[4] = here->VBICtepiDoping;
+    p[5] = model->VBIChighCurFac;
+    p[6] = here->VBICtextBaseResist;
+    p[7] = here->VBICtintBaseResist;
+    p[8] = here->VBICtemitterResist;
+    p[9] = here->VBICtsubstrateResist;
+    p[10] = here->VBICtparBaseResist;
+    p[11] = here->VBICtsatCur;
+    p[12] = here->VBICtemissionCoeffF;
+    p[13] = here->VBICtemissionCoeffR;
+    p[14] = model->VBICdeplCapLimitF;
+    p[15] = model->VBICextOverlapCapBE;
+    p[16] = here->VBICtdepletionCapBE;
+    p[17] = here->VBICtpotentialBE;
+    p[18] = model->VBICjunctionExpBE;
+    p[19] = model->VBICsmoothCapBE;
+    p[20] = model->VBICextOverlapCapBC;
+    p[21] = here->VBICtdepletionCapBC;
+    p[22] = model->VBICepiCharge;
+    p[23] = here->VBICtextCapBC;
+    p[24] = here->VBICtpotentialBC;
+    p[25] = model->VBICjunctionExpBC;
+    p[26] = model->VBICsmoothCapBC;
+    p[27] = here->VBICtextCapSC;
+    p[28] = here->VBICtpotentialSC;
+    p[29] = model->VBICjunctionExpSC;
+    p[30] = model->VBICsmoothCapSC;
+    p[31] = here->VBICtidealSatCurBE;
+    p[32] = model->VBICportionIBEI;
+    p[33] = model->VBICidealEmissCoeffBE;
+    p[34] = here->VBICtnidealSatCurBE;
+    p[35] = model->VBICnidealEmissCoeffBE;
+    p[36] = here->VBICtidealSatCurBC;
+    p[37] = model->VBICidealEmissCoeffBC;
+    p[38] = here->VBICtnidealSatCurBC;
+    p[39] = model->VBICnidealEmissCoeffBC;
+    p[40] = model->VBICavalanchePar1BC;
+    p[41] = here->VBICtavalanchePar2BC;
+    p[42] = here->VBICtparasitSatCur;
+    p[43] = model->VBICportionICCP;
+    p[44] = model->VBICparasitFwdEmissCoeff;
+    p[45] = here->VBICtidealParasitSatCurBE;
+    p[46] = here->VBICtnidealParasitSatCurBE;
+    p[47] = here->VBICtidealParasitSatCurBC;
+    p[48] = model->VBICidealParasitEmissCoeffBC;
+    p[49] = here->VBICtnidealParasitSatCurBC;
+    p[50] = model->VBICnidealParasitEmissCoeffBC;
+    p[51] = model->VBICearlyVoltF;
+    p[52] = model->VBICearlyVoltR;
+    p[53] = here->VBICtrollOffF;
+    p[54] = model->VBICrollOffR;
+    p[55] = model->VBICparRollOff;
+    p[56] = model->VBICtransitTimeF;
+    p[57] = model->VBICvarTransitTimeF;
+    p[58] = model->VBICtransitTimeBiasCoeffF;
+    p[59] = model->VBICtransitTimeFVBC;
+    p[60] = model->VBICtransitTimeHighCurrentF;
+    p[61] = model->VBICtransitTimeR;
+    p[62] = model->VBICdelayTimeF;
+    p[63] = model->VBICfNcoef;
+    p[64] = model->VBICfNexpA;
+    p[65] = model->VBICfNexpB;
+    p[66] = model->VBICtempExpRE;
+    p[67] = model->VBICtempExpRBI;
+    p[68] = model->VBICtempExpRCI;
+    p[69] = model->VBICtempExpRS;
+    p[70] = model->VBICtempExpVO;
+    p[71] = model->VBICactivEnergyEA;
+    p[72] = model->VBICactivEnergyEAIE;
+    p[73] = model->VBICactivEnergyEAIC;
+    p[74] = model->VBICactivEnergyEAIS;
+    p[75] = model->VBICactivEnergyEANE;
+    p[76] = model->VBICactivEnergyEANC;
+    p[77] = model->VBICactivEnergyEANS;
+    p[78] = model->VBICtempExpIS;
+    p[79] = model->VBICtempExpII;
+    p[80] = model->VBICtempExpIN;
+    p[81] = model->VBICtempExpNF;
+    p[82] = model->VBICtempExpAVC;
+    p[83] = model->VBICthermalResist;
+    p[84] = model->VBICthermalCapacitance;
+    p[85] = model->VBICpunchThroughVoltageBC;
+    p[86] = model->VBICdeplCapCoeff1;
+    p[87] = model->VBICfixedCapacitanceCS;
+    p[88] = model->VBICsgpQBselector;
+    p[89] = model->VBIChighCurrentBetaRolloff;
+    p[90] = model->VBICtempExpIKF;
+    p[91] = model->VBICtempExpRCX;
+    p[92] = model->VBICtempExpRBX;
+    p[93] = model->VBICtempExpRBP;
+    p[94] = here->VBICtsepISRR;
+    p[95] = model->VBICtempExpXISR;
+    p[96] = model->VBICdear;
+    p[97] = model->VBICeap;
+    p[98] = here->VBICtvbbe;
+    p[99] = here->VBICtnbbe;
+    p[100] = model->VBICibbe;
+    p[101] = model->VBICtvbbe1;
+    p[102] = model->VBICtvbbe2;
+    p[103] = model->VBICtnbbe;
+    p[104] = model->VBICebbe;
+    p[105] = model->VBIClocTempDiff;
+    p[106] = model->VBICrevVersion;
+    p[107] = model->VBICrefVersion;
 
-            SCALE = here->VBICarea * here->VBICm;
+    SCALE = here->VBICarea * here->VBICm;
 
-            if(SenCond){
+    if(SenCond){
 #ifdef SENSDEBUG
-                printf("VBICsenPertFlag = ON \n");
+        printf("VBICsenPertFlag = ON \n");
 #endif /* SENSDEBUG */
 
-                if((ckt->CKTsenInfo->SENmode == TRANSEN)&&
-                    (ckt->CKTmode & MODEINITTRAN)) {
-                    Vbe = model->VBICtype*(
-                        *(ckt->CKTrhsOp+here->VBICbaseNode)-
-                        *(ckt->CKTrhsOp+here->VBICemitNode));
-                    Vbc = model->VBICtype*(
-                        *(ckt->CKTrhsOp+here->VBICbaseNode)-
-                        *(ckt->CKTrhsOp+here->VBICcollNode));
-                    Vbei = *(ckt->CKTstate1 + here->VBICvbei);
-                    Vbex = *(ckt->CKTstate1 + here->VBICvbex);
-                    Vbci = *(ckt->CKTstate1 + here->VBICvbci);
-                    Vbcx = *(ckt->CKTstate1 + here->VBICvbcx);
-                    Vbep = *(ckt->CKTstate1 + here->VBICvbep);
-                    Vrci = *(ckt->CKTstate1 + here->VBICvrci);
-                    Vrbi = *(ckt->CKTstate1 + here->VBICvrbi);
-                    Vrbp = *(ckt->CKTstate1 + here->VBICvrbp);
-                    Vrcx = model->VBICtype*(
-                        *(ckt->CKTrhsOp+here->VBICcollNode)-
-                        *(ckt->CKTrhsOp+here->VBICcollCXNode));
-                    Vrbx = model->VBICtype*(
-                        *(ckt->CKTrhsOp+here->VBICbaseNode)-
-                        *(ckt->CKTrhsOp+here->VBICbaseBXNode));
-                    Vre = model->VBICtype*(
-                        *(ckt->CKTrhsOp+here->VBICemitNode)-
-                        *(ckt->CKTrhsOp+here->VBICemitEINode));
-                    Vbcp = *(ckt->CKTstate1 + here->VBICvbcp);
-                    Vrs = model->VBICtype*(
-                        *(ckt->CKTrhsOp+here->VBICsubsNode)-
-                        *(ckt->CKTrhsOp+here->VBICsubsSINode));
-                }
-                else{
-                    Vbei = *(ckt->CKTstate0 + here->VBICvbei);
-                    Vbex = *(ckt->CKTstate0 + here->VBICvbex);
-                    Vbci = *(ckt->CKTstate0 + here->VBICvbci);
-                    Vbcx = *(ckt->CKTstate0 + here->VBICvbcx);
-                    Vbep = *(ckt->CKTstate0 + here->VBICvbep);
-                    Vrci = *(ckt->CKTstate0 + here->VBICvrci);
-                    Vrbi = *(ckt->CKTstate0 + here->VBICvrbi);
-                    Vrbp = *(ckt->CKTstate0 + here->VBICvrbp);
-                    Vbcp = *(ckt->CKTstate0 + here->VBICvbcp);
-                    if((ckt->CKTsenInfo->SENmode == DCSEN)||
-                        (ckt->CKTsenInfo->SENmode == TRANSEN)){
-                        Vbe = model->VBICtype*(
-                            *(ckt->CKTrhsOld+here->VBICbaseNode)-
-                            *(ckt->CKTrhsOld+here->VBICemitNode));
-                        Vbc = model->VBICtype*(
-                            *(ckt->CKTrhsOld+here->VBICbaseNode)-
-                            *(ckt->CKTrhsOld+here->VBICcollNode));
-                        Vrcx = model->VBICtype*(
-                            *(ckt->CKTrhsOld+here->VBICcollNode)-
-                            *(ckt->CKTrhsOld+here->VBICcollCXNode));
-                        Vrbx = model->VBICtype*(
-                            *(ckt->CKTrhsOld+here->VBICbaseNode)-
-                            *(ckt->CKTrhsOld+here->VBICbaseBXNode));
-                        Vre = model->VBICtype*(
-                            *(ckt->CKTrhsOld+here->VBICemitNode)-
-                            *(ckt->CKTrhsOld+here->VBICemitEINode));
-                        Vrs = model->VBICtype*(
-                            *(ckt->CKTrhsOld+here->VBICsubsNode)-
-                            *(ckt->CKTrhsOld+here->VBICsubsSINode));
-                    }
-                    if(ckt->CKTsenInfo->SENmode == ACSEN){
-                        Vbe = model->VBICtype*(
-                            *(ckt->CKTrhsOp+here->VBICbaseNode)-
-                            *(ckt->CKTrhsOp+here->VBICemitNode));
-                        Vbc = model->VBICtype*(
-                            *(ckt->CKTrhsOp+here->VBICbaseNode)-
-                            *(ckt->CKTrhsOp+here->VBICcollNode));
-                        Vrcx = model->VBICtype*(
-                            *(ckt->CKTrhsOp+here->VBICcollNode)-
-                            *(ckt->CKTrhsOp+here->VBICcollCXNode));
-                        Vrbx = model->VBICtype*(
-                            *(ckt->CKTrhsOp+here->VBICbaseNode)-
-                            *(ckt->CKTrhsOp+here->VBICbaseBXNode));
-                        Vre = model->VBICtype*(
-                            *(ckt->CKTrhsOp+here->VBICemitNode)-
-                            *(ckt->CKTrhsOp+here->VBICemitEINode));
-                        Vrs = model->VBICtype*(
-                            *(ckt->CKTrhsOp+here->VBICsubsNode)-
-                            *(ckt->CKTrhsOp+here->VBICsubsSINode));
-                    }
-                }
-                goto next1;
-            }
-
-            /*
-             *   initialization
-             */
-            icheck=1;
-            if(ckt->CKTmode & MODEINITSMSIG) {
+        if((ckt->CKTsenInfo->SENmode == TRANSEN)&&
+            (ckt->CKTmode & MODEINITTRAN)) {
+            Vbe = model->VBICtype*(
+                *(ckt->CKTrhsOp+here->VBICbaseNode)-
+                *(ckt->CKTrhsOp+here->VBICemitNode));
+            Vbc = model->VBICtype*(
+                *(ckt->CKTrhsOp+here->VBICbaseNode)-
+                *(ckt->CKTrhsOp+here->VBICcollNode));
+            Vbei = *(ckt->CKTstate1 + here->VBICvbei);
+            Vbex = *(ckt->CKTstate1 + here->VBICvbex);
+            Vbci = *(ckt->CKTstate1 + here->VBICvbci);
+            Vbcx = *(ckt->CKTstate1 + here->VBICvbcx);
+            Vbep = *(ckt->CKTstate1 + here->VBICvbep);
+            Vrci = *(ckt->CKTstate1 + here->VBICvrci);
+            Vrbi = *(ckt->CKTstate1 + here->VBICvrbi);
+            Vrbp = *(ckt->CKTstate1 + here->VBICvrbp);
+            Vrcx = model->VBICtype*(
+                *(ckt->CKTrhsOp+here->VBICcollNode)-
+                *(ckt->CKTrhsOp+here->VBICcollCXNode));
+            Vrbx = model->VBICtype*(
+                *(ckt->CKTrhsOp+here->VBICbaseNode)-
+                *(ckt->CKTrhsOp+here->VBICbaseBXNode));
+            Vre = model->VBICtype*(
+                *(ckt->CKTrhsOp+here->VBICemitNode)-
+                *(ckt->CKTrhsOp+here->VBICemitEINode));
+            Vbcp = *(ckt->CKTstate1 + here->VBICvbcp);
+            Vrs = model->VBICtype*(
+                *(ckt->CKTrhsOp+here->VBICsubsNode)-
+                *(ckt->CKTrhsOp+here->VBICsubsSINode));
+        }
+        else{
+            Vbei = *(ckt->CKTstate0 + here->VBICvbei);
+            Vbex = *(ckt->CKTstate0 + here->VBICvbex);
+            Vbci = *(ckt->CKTstate0 + here->VBICvbci);
+            Vbcx = *(ckt->CKTstate0 + here->VBICvbcx);
+            Vbep = *(ckt->CKTstate0 + here->VBICvbep);
+            Vrci = *(ckt->CKTstate0 + here->VBICvrci);
+            Vrbi = *(ckt->CKTstate0 + here->VBICvrbi);
+            Vrbp = *(ckt->CKTstate0 + here->VBICvrbp);
+            Vbcp = *(ckt->CKTstate0 + here->VBICvbcp);
+            if((ckt->CKTsenInfo->SENmode == DCSEN)||
+                (ckt->CKTsenInfo->SENmode == TRANSEN)){
                 Vbe = model->VBICtype*(
                     *(ckt->CKTrhsOld+here->VBICbaseNode)-
                     *(ckt->CKTrhsOld+here->VBICemitNode));
                 Vbc = model->VBICtype*(
                     *(ckt->CKTrhsOld+here->VBICbaseNode)-
                     *(ckt->CKTrhsOld+here->VBICcollNode));
-                Vbei = *(ckt->CKTstate0 + here->VBICvbei);
-                Vbex = *(ckt->CKTstate0 + here->VBICvbex);
-                Vbci = *(ckt->CKTstate0 + here->VBICvbci);
-                Vbcx = *(ckt->CKTstate0 + here->VBICvbcx);
-                Vbep = *(ckt->CKTstate0 + here->VBICvbep);
-                Vrci = *(ckt->CKTstate0 + here->VBICvrci);
-                Vrbi = *(ckt->CKTstate0 + here->VBICvrbi);
-                Vrbp = *(ckt->CKTstate0 + here->VBICvrbp);
                 Vrcx = model->VBICtype*(
                     *(ckt->CKTrhsOld+here->VBICcollNode)-
                     *(ckt->CKTrhsOld+here->VBICcollCXNode));
@@ -340,923 +287,975 @@ VBICload(GENmodel *inModel, CKTcircuit *ckt)
                 Vre = model->VBICtype*(
                     *(ckt->CKTrhsOld+here->VBICemitNode)-
                     *(ckt->CKTrhsOld+here->VBICemitEINode));
-                Vbcp = *(ckt->CKTstate0 + here->VBICvbcp);
                 Vrs = model->VBICtype*(
                     *(ckt->CKTrhsOld+here->VBICsubsNode)-
                     *(ckt->CKTrhsOld+here->VBICsubsSINode));
-            } else if(ckt->CKTmode & MODEINITTRAN) {
+            }
+            if(ckt->CKTsenInfo->SENmode == ACSEN){
                 Vbe = model->VBICtype*(
-                    *(ckt->CKTrhsOld+here->VBICbaseNode)-
-                    *(ckt->CKTrhsOld+here->VBICemitNode));
+                    *(ckt->CKTrhsOp+here->VBICbaseNode)-
+                    *(ckt->CKTrhsOp+here->VBICemitNode));
                 Vbc = model->VBICtype*(
-                    *(ckt->CKTrhsOld+here->VBICbaseNode)-
-                    *(ckt->CKTrhsOld+here->VBICcollNode));
-                Vbei = *(ckt->CKTstate1 + here->VBICvbei);
-                Vbex = *(ckt->CKTstate1 + here->VBICvbex);
-                Vbci = *(ckt->CKTstate1 + here->VBICvbci);
-                Vbcx = *(ckt->CKTstate1 + here->VBICvbcx);
-                Vbep = *(ckt->CKTstate1 + here->VBICvbep);
-                Vrci = *(ckt->CKTstate1 + here->VBICvrci);
-                Vrbi = *(ckt->CKTstate1 + here->VBICvrbi);
-                Vrbp = *(ckt->CKTstate1 + here->VBICvrbp);
+                    *(ckt->CKTrhsOp+here->VBICbaseNode)-
+                    *(ckt->CKTrhsOp+here->VBICcollNode));
                 Vrcx = model->VBICtype*(
-                    *(ckt->CKTrhsOld+here->VBICcollNode)-
-                    *(ckt->CKTrhsOld+here->VBICcollCXNode));
+                    *(ckt->CKTrhsOp+here->VBICcollNode)-
+                    *(ckt->CKTrhsOp+here->VBICcollCXNode));
                 Vrbx = model->VBICtype*(
-                    *(ckt->CKTrhsOld+here->VBICbaseNode)-
-                    *(ckt->CKTrhsOld+here->VBICbaseBXNode));
+                    *(ckt->CKTrhsOp+here->VBICbaseNode)-
+                    *(ckt->CKTrhsOp+here->VBICbaseBXNode));
                 Vre = model->VBICtype*(
-                    *(ckt->CKTrhsOld+here->VBICemitNode)-
-                    *(ckt->CKTrhsOld+here->VBICemitEINode));
-                Vbcp = *(ckt->CKTstate1 + here->VBICvbcp);
+                    *(ckt->CKTrhsOp+here->VBICemitNode)-
+                    *(ckt->CKTrhsOp+here->VBICemitEINode));
                 Vrs = model->VBICtype*(
-                    *(ckt->CKTrhsOld+here->VBICsubsNode)-
-                    *(ckt->CKTrhsOld+here->VBICsubsSINode));
-                if( (ckt->CKTmode & MODETRAN) && (ckt->CKTmode & MODEUIC) ) {
-                    Vbc = model->VBICtype * (here->VBICicVBE-here->VBICicVCE);
-                }
-            } else if((ckt->CKTmode & MODEINITJCT) && 
-                    (ckt->CKTmode & MODETRANOP) && (ckt->CKTmode & MODEUIC)){
-                Vbe=model->VBICtype*here->VBICicVBE;
-                Vbei=Vbex=Vbe;
-                vce=model->VBICtype*here->VBICicVCE;
-                Vbc=Vbe-vce;
-                Vbci=Vbcx=Vbc;
-                Vbep=Vbcp=0.0;
-                Vrci=Vrbi=Vrbp=0.0;
-                Vrcx=Vrbx=Vre=Vrs=0.0;
-            } else if((ckt->CKTmode & MODEINITJCT) && (here->VBICoff==0)) {
-                Vbe=Vbei=Vbex=model->VBICtype*here->VBICtVcrit;
-                Vbc=Vbci=Vbcx=Vbep=0.0;
-                Vbcp=Vbc-Vbe;
-                Vrci=Vrbi=Vrbp=0.0;
-                Vrcx=Vrbx=Vre=Vrs=0.0;
-            } else if((ckt->CKTmode & MODEINITJCT) ||
-                    ( (ckt->CKTmode & MODEINITFIX) && (here->VBICoff!=0))) {
-                Vbe=0.0;
-                Vbei=Vbex=Vbe;
-                Vbc=0.0;
-                Vbci=Vbcx=Vbc;
-                Vbep=Vbcp=0.0;
-                Vrci=Vrbi=Vrbp=0.0;
-                Vrcx=Vrbx=Vre=Vrs=0.0;
-            } else {
+                    *(ckt->CKTrhsOp+here->VBICsubsNode)-
+                    *(ckt->CKTrhsOp+here->VBICsubsSINode));
+            }
+        }
+        goto next1;
+    }
+
+    /*
+     *   initialization
+     */
+    icheck=1;
+    if(ckt->CKTmode & MODEINITSMSIG) {
+        Vbe = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICbaseNode)-
+            *(ckt->CKTrhsOld+here->VBICemitNode));
+        Vbc = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICbaseNode)-
+            *(ckt->CKTrhsOld+here->VBICcollNode));
+        Vbei = *(ckt->CKTstate0 + here->VBICvbei);
+        Vbex = *(ckt->CKTstate0 + here->VBICvbex);
+        Vbci = *(ckt->CKTstate0 + here->VBICvbci);
+        Vbcx = *(ckt->CKTstate0 + here->VBICvbcx);
+        Vbep = *(ckt->CKTstate0 + here->VBICvbep);
+        Vrci = *(ckt->CKTstate0 + here->VBICvrci);
+        Vrbi = *(ckt->CKTstate0 + here->VBICvrbi);
+        Vrbp = *(ckt->CKTstate0 + here->VBICvrbp);
+        Vrcx = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICcollNode)-
+            *(ckt->CKTrhsOld+here->VBICcollCXNode));
+        Vrbx = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICbaseNode)-
+            *(ckt->CKTrhsOld+here->VBICbaseBXNode));
+        Vre = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICemitNode)-
+            *(ckt->CKTrhsOld+here->VBICemitEINode));
+        Vbcp = *(ckt->CKTstate0 + here->VBICvbcp);
+        Vrs = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICsubsNode)-
+            *(ckt->CKTrhsOld+here->VBICsubsSINode));
+    } else if(ckt->CKTmode & MODEINITTRAN) {
+        Vbe = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICbaseNode)-
+            *(ckt->CKTrhsOld+here->VBICemitNode));
+        Vbc = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICbaseNode)-
+            *(ckt->CKTrhsOld+here->VBICcollNode));
+        Vbei = *(ckt->CKTstate1 + here->VBICvbei);
+        Vbex = *(ckt->CKTstate1 + here->VBICvbex);
+        Vbci = *(ckt->CKTstate1 + here->VBICvbci);
+        Vbcx = *(ckt->CKTstate1 + here->VBICvbcx);
+        Vbep = *(ckt->CKTstate1 + here->VBICvbep);
+        Vrci = *(ckt->CKTstate1 + here->VBICvrci);
+        Vrbi = *(ckt->CKTstate1 + here->VBICvrbi);
+        Vrbp = *(ckt->CKTstate1 + here->VBICvrbp);
+        Vrcx = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICcollNode)-
+            *(ckt->CKTrhsOld+here->VBICcollCXNode));
+        Vrbx = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICbaseNode)-
+            *(ckt->CKTrhsOld+here->VBICbaseBXNode));
+        Vre = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICemitNode)-
+            *(ckt->CKTrhsOld+here->VBICemitEINode));
+        Vbcp = *(ckt->CKTstate1 + here->VBICvbcp);
+        Vrs = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICsubsNode)-
+            *(ckt->CKTrhsOld+here->VBICsubsSINode));
+        if( (ckt->CKTmode & MODETRAN) && (ckt->CKTmode & MODEUIC) ) {
+            Vbc = model->VBICtype * (here->VBICicVBE-here->VBICicVCE);
+        }
+    } else if((ckt->CKTmode & MODEINITJCT) && 
+            (ckt->CKTmode & MODETRANOP) && (ckt->CKTmode & MODEUIC)){
+        Vbe=model->VBICtype*here->VBICicVBE;
+        Vbei=Vbex=Vbe;
+        vce=model->VBICtype*here->VBICicVCE;
+        Vbc=Vbe-vce;
+        Vbci=Vbcx=Vbc;
+        Vbep=Vbcp=0.0;
+        Vrci=Vrbi=Vrbp=0.0;
+        Vrcx=Vrbx=Vre=Vrs=0.0;
+    } else if((ckt->CKTmode & MODEINITJCT) && (here->VBICoff==0)) {
+        Vbe=Vbei=Vbex=model->VBICtype*here->VBICtVcrit;
+        Vbc=Vbci=Vbcx=Vbep=0.0;
+        Vbcp=Vbc-Vbe;
+        Vrci=Vrbi=Vrbp=0.0;
+        Vrcx=Vrbx=Vre=Vrs=0.0;
+    } else if((ckt->CKTmode & MODEINITJCT) ||
+            ( (ckt->CKTmode & MODEINITFIX) && (here->VBICoff!=0))) {
+        Vbe=0.0;
+        Vbei=Vbex=Vbe;
+        Vbc=0.0;
+        Vbci=Vbcx=Vbc;
+        Vbep=Vbcp=0.0;
+        Vrci=Vrbi=Vrbp=0.0;
+        Vrcx=Vrbx=Vre=Vrs=0.0;
+    } else {
 #ifndef PREDICTOR
-                if(ckt->CKTmode & MODEINITPRED) {
-                    xfact = ckt->CKTdelta/ckt->CKTdeltaOld[1];
-                    Vbei = (1+xfact) * *(ckt->CKTstate1 + here->VBICvbei)-
-                            xfact * *(ckt->CKTstate2 + here->VBICvbei);
-                    Vbex = (1+xfact) * *(ckt->CKTstate1 + here->VBICvbex)-
-                            xfact * *(ckt->CKTstate2 + here->VBICvbex);
-                    Vbci = (1+xfact) * *(ckt->CKTstate1 + here->VBICvbci)-
-                            xfact * *(ckt->CKTstate2 + here->VBICvbci);
-                    Vbcx = (1+xfact) * *(ckt->CKTstate1 + here->VBICvbcx)-
-                            xfact * *(ckt->CKTstate2 + here->VBICvbcx);
-                    Vbep = (1+xfact) * *(ckt->CKTstate1 + here->VBICvbep)-
-                            xfact * *(ckt->CKTstate2 + here->VBICvbep);
-                    Vrci = (1+xfact) * *(ckt->CKTstate1 + here->VBICvrci)-
-                            xfact * *(ckt->CKTstate2 + here->VBICvrci);
-                    Vrbi = (1+xfact) * *(ckt->CKTstate1 + here->VBICvrbi)-
-                            xfact * *(ckt->CKTstate2 + here->VBICvrbi);
-                    Vrbp = (1+xfact) * *(ckt->CKTstate1 + here->VBICvrbp)-
-                            xfact * *(ckt->CKTstate2 + here->VBICvrbp);
-                    Vbcp = (1+xfact) * *(ckt->CKTstate1 + here->VBICvbcp)-
-                            xfact * *(ckt->CKTstate2 + here->VBICvbcp);
-                    *(ckt->CKTstate0 + here->VBICvbei) = 
-                            *(ckt->CKTstate1 + here->VBICvbei);
-                    *(ckt->CKTstate0 + here->VBICvbex) = 
-                            *(ckt->CKTstate1 + here->VBICvbex);
-                    *(ckt->CKTstate0 + here->VBICvbci) = 
-                            *(ckt->CKTstate1 + here->VBICvbci);
-                    *(ckt->CKTstate0 + here->VBICvbcx) = 
-                            *(ckt->CKTstate1 + here->VBICvbcx);
-                    *(ckt->CKTstate0 + here->VBICvbep) = 
-                            *(ckt->CKTstate1 + here->VBICvbep);
-                    *(ckt->CKTstate0 + here->VBICvrci) = 
-                            *(ckt->CKTstate1 + here->VBICvrci);
-                    *(ckt->CKTstate0 + here->VBICvrbi) = 
-                            *(ckt->CKTstate1 + here->VBICvrbi);
-                    *(ckt->CKTstate0 + here->VBICvrbp) = 
-                            *(ckt->CKTstate1 + here->VBICvrbp);
-                    *(ckt->CKTstate0 + here->VBICvbcp) = 
-                            *(ckt->CKTstate1 + here->VBICvbcp);
-                    *(ckt->CKTstate0 + here->VBICibe) = 
-                            *(ckt->CKTstate1 + here->VBICibe);
-                    *(ckt->CKTstate0 + here->VBICibe_Vbei) = 
-                            *(ckt->CKTstate1 + here->VBICibe_Vbei);
-                    *(ckt->CKTstate0 + here->VBICibex) = 
-                            *(ckt->CKTstate1 + here->VBICibex);
-                    *(ckt->CKTstate0 + here->VBICibex_Vbex) = 
-                            *(ckt->CKTstate1 + here->VBICibex_Vbex);
-                    *(ckt->CKTstate0 + here->VBICitzf) = 
-                            *(ckt->CKTstate1 + here->VBICitzf);
-                    *(ckt->CKTstate0 + here->VBICitzf_Vbei) = 
-                            *(ckt->CKTstate1 + here->VBICitzf_Vbei);
-                    *(ckt->CKTstate0 + here->VBICitzf_Vbci) = 
-                            *(ckt->CKTstate1 + here->VBICitzf_Vbci);
-                    *(ckt->CKTstate0 + here->VBICitzr) = 
-                            *(ckt->CKTstate1 + here->VBICitzr);
-                    *(ckt->CKTstate0 + here->VBICitzr_Vbei) = 
-                            *(ckt->CKTstate1 + here->VBICitzf_Vbei);
-                    *(ckt->CKTstate0 + here->VBICitzr_Vbci) = 
-                            *(ckt->CKTstate1 + here->VBICitzr_Vbci);
-                    *(ckt->CKTstate0 + here->VBICibc) = 
-                            *(ckt->CKTstate1 + here->VBICibc);
-                    *(ckt->CKTstate0 + here->VBICibc_Vbci) = 
-                            *(ckt->CKTstate1 + here->VBICibc_Vbci);
-                    *(ckt->CKTstate0 + here->VBICibc_Vbei) = 
-                            *(ckt->CKTstate1 + here->VBICibc_Vbei);
-                    *(ckt->CKTstate0 + here->VBICibep) = 
-                            *(ckt->CKTstate1 + here->VBICibep);
-                    *(ckt->CKTstate0 + here->VBICibep_Vbep) = 
-                            *(ckt->CKTstate1 + here->VBICibep_Vbep);
-                    *(ckt->CKTstate0 + here->VBICirci) = 
-                            *(ckt->CKTstate1 + here->VBICirci);
-                    *(ckt->CKTstate0 + here->VBICirci_Vrci) = 
-                            *(ckt->CKTstate1 + here->VBICirci_Vrci);
-                    *(ckt->CKTstate0 + here->VBICirci_Vbci) = 
-                            *(ckt->CKTstate1 + here->VBICirci_Vbci);
-                    *(ckt->CKTstate0 + here->VBICirci_Vbcx) = 
-                            *(ckt->CKTstate1 + here->VBICirci_Vbcx);
-                    *(ckt->CKTstate0 + here->VBICirbi) = 
-                            *(ckt->CKTstate1 + here->VBICirbi);
-                    *(ckt->CKTstate0 + here->VBICirbi_Vrbi) = 
-                            *(ckt->CKTstate1 + here->VBICirbi_Vrbi);
-                    *(ckt->CKTstate0 + here->VBICirbi_Vbei) = 
-                            *(ckt->CKTstate1 + here->VBICirbi_Vbei);
-                    *(ckt->CKTstate0 + here->VBICirbi_Vbci) = 
-                            *(ckt->CKTstate1 + here->VBICirbi_Vbci);
-                    *(ckt->CKTstate0 + here->VBICirbp) = 
-                            *(ckt->CKTstate1 + here->VBICirbp);
-                    *(ckt->CKTstate0 + here->VBICirbp_Vrbp) = 
-                            *(ckt->CKTstate1 + here->VBICirbp_Vrbp);
-                    *(ckt->CKTstate0 + here->VBICirbp_Vbep) = 
-                            *(ckt->CKTstate1 + here->VBICirbp_Vbep);
-                    *(ckt->CKTstate0 + here->VBICirbp_Vbci) = 
-                            *(ckt->CKTstate1 + here->VBICirbp_Vbci);
-                    *(ckt->CKTstate0 + here->VBICibcp) = 
-                            *(ckt->CKTstate1 + here->VBICibcp);
-                    *(ckt->CKTstate0 + here->VBICibcp_Vbcp) = 
-                            *(ckt->CKTstate1 + here->VBICibcp_Vbcp);
-                    *(ckt->CKTstate0 + here->VBICiccp) = 
-                            *(ckt->CKTstate1 + here->VBICiccp);
-                    *(ckt->CKTstate0 + here->VBICiccp_Vbep) = 
-                            *(ckt->CKTstate1 + here->VBICiccp_Vbep);
-                    *(ckt->CKTstate0 + here->VBICiccp_Vbci) = 
-                            *(ckt->CKTstate1 + here->VBICiccp_Vbci);
-                    *(ckt->CKTstate0 + here->VBICiccp_Vbcp) = 
-                            *(ckt->CKTstate1 + here->VBICiccp_Vbcp);
-                    *(ckt->CKTstate0 + here->VBICgqbeo) = 
-                            *(ckt->CKTstate1 + here->VBICgqbeo);
-                    *(ckt->CKTstate0 + here->VBICgqbco) = 
-                            *(ckt->CKTstate1 + here->VBICgqbco);
-                    *(ckt->CKTstate0 + here->VBICircx_Vrcx) = 
-                            *(ckt->CKTstate1 + here->VBICircx_Vrcx);
-                    *(ckt->CKTstate0 + here->VBICirbx_Vrbx) = 
-                            *(ckt->CKTstate1 + here->VBICirbx_Vrbx);
-                    *(ckt->CKTstate0 + here->VBICirs_Vrs) = 
-                            *(ckt->CKTstate1 + here->VBICirs_Vrs);
-                    *(ckt->CKTstate0 + here->VBICire_Vre) = 
-                            *(ckt->CKTstate1 + here->VBICire_Vre);
-                } else {
+        if(ckt->CKTmode & MODEINITPRED) {
+            xfact = ckt->CKTdelta/ckt->CKTdeltaOld[1];
+            Vbei = (1+xfact) * *(ckt->CKTstate1 + here->VBICvbei)-
+                    xfact * *(ckt->CKTstate2 + here->VBICvbei);
+            Vbex = (1+xfact) * *(ckt->CKTstate1 + here->VBICvbex)-
+                    xfact * *(ckt->CKTstate2 + here->VBICvbex);
+            Vbci = (1+xfact) * *(ckt->CKTstate1 + here->VBICvbci)-
+                    xfact * *(ckt->CKTstate2 + here->VBICvbci);
+            Vbcx = (1+xfact) * *(ckt->CKTstate1 + here->VBICvbcx)-
+                    xfact * *(ckt->CKTstate2 + here->VBICvbcx);
+            Vbep = (1+xfact) * *(ckt->CKTstate1 + here->VBICvbep)-
+                    xfact * *(ckt->CKTstate2 + here->VBICvbep);
+            Vrci = (1+xfact) * *(ckt->CKTstate1 + here->VBICvrci)-
+                    xfact * *(ckt->CKTstate2 + here->VBICvrci);
+            Vrbi = (1+xfact) * *(ckt->CKTstate1 + here->VBICvrbi)-
+                    xfact * *(ckt->CKTstate2 + here->VBICvrbi);
+            Vrbp = (1+xfact) * *(ckt->CKTstate1 + here->VBICvrbp)-
+                    xfact * *(ckt->CKTstate2 + here->VBICvrbp);
+            Vbcp = (1+xfact) * *(ckt->CKTstate1 + here->VBICvbcp)-
+                    xfact * *(ckt->CKTstate2 + here->VBICvbcp);
+            *(ckt->CKTstate0 + here->VBICvbei) = 
+                    *(ckt->CKTstate1 + here->VBICvbei);
+            *(ckt->CKTstate0 + here->VBICvbex) = 
+                    *(ckt->CKTstate1 + here->VBICvbex);
+            *(ckt->CKTstate0 + here->VBICvbci) = 
+                    *(ckt->CKTstate1 + here->VBICvbci);
+            *(ckt->CKTstate0 + here->VBICvbcx) = 
+                    *(ckt->CKTstate1 + here->VBICvbcx);
+            *(ckt->CKTstate0 + here->VBICvbep) = 
+                    *(ckt->CKTstate1 + here->VBICvbep);
+            *(ckt->CKTstate0 + here->VBICvrci) = 
+                    *(ckt->CKTstate1 + here->VBICvrci);
+            *(ckt->CKTstate0 + here->VBICvrbi) = 
+                    *(ckt->CKTstate1 + here->VBICvrbi);
+            *(ckt->CKTstate0 + here->VBICvrbp) = 
+                    *(ckt->CKTstate1 + here->VBICvrbp);
+            *(ckt->CKTstate0 + here->VBICvbcp) = 
+                    *(ckt->CKTstate1 + here->VBICvbcp);
+            *(ckt->CKTstate0 + here->VBICibe) = 
+                    *(ckt->CKTstate1 + here->VBICibe);
+            *(ckt->CKTstate0 + here->VBICibe_Vbei) = 
+                    *(ckt->CKTstate1 + here->VBICibe_Vbei);
+            *(ckt->CKTstate0 + here->VBICibex) = 
+                    *(ckt->CKTstate1 + here->VBICibex);
+            *(ckt->CKTstate0 + here->VBICibex_Vbex) = 
+                    *(ckt->CKTstate1 + here->VBICibex_Vbex);
+            *(ckt->CKTstate0 + here->VBICitzf) = 
+                    *(ckt->CKTstate1 + here->VBICitzf);
+            *(ckt->CKTstate0 + here->VBICitzf_Vbei) = 
+                    *(ckt->CKTstate1 + here->VBICitzf_Vbei);
+            *(ckt->CKTstate0 + here->VBICitzf_Vbci) = 
+                    *(ckt->CKTstate1 + here->VBICitzf_Vbci);
+            *(ckt->CKTstate0 + here->VBICitzr) = 
+                    *(ckt->CKTstate1 + here->VBICitzr);
+            *(ckt->CKTstate0 + here->VBICitzr_Vbei) = 
+                    *(ckt->CKTstate1 + here->VBICitzf_Vbei);
+            *(ckt->CKTstate0 + here->VBICitzr_Vbci) = 
+                    *(ckt->CKTstate1 + here->VBICitzr_Vbci);
+            *(ckt->CKTstate0 + here->VBICibc) = 
+                    *(ckt->CKTstate1 + here->VBICibc);
+            *(ckt->CKTstate0 + here->VBICibc_Vbci) = 
+                    *(ckt->CKTstate1 + here->VBICibc_Vbci);
+            *(ckt->CKTstate0 + here->VBICibc_Vbei) = 
+                    *(ckt->CKTstate1 + here->VBICibc_Vbei);
+            *(ckt->CKTstate0 + here->VBICibep) = 
+                    *(ckt->CKTstate1 + here->VBICibep);
+            *(ckt->CKTstate0 + here->VBICibep_Vbep) = 
+                    *(ckt->CKTstate1 + here->VBICibep_Vbep);
+            *(ckt->CKTstate0 + here->VBICirci) = 
+                    *(ckt->CKTstate1 + here->VBICirci);
+            *(ckt->CKTstate0 + here->VBICirci_Vrci) = 
+                    *(ckt->CKTstate1 + here->VBICirci_Vrci);
+            *(ckt->CKTstate0 + here->VBICirci_Vbci) = 
+                    *(ckt->CKTstate1 + here->VBICirci_Vbci);
+            *(ckt->CKTstate0 + here->VBICirci_Vbcx) = 
+                    *(ckt->CKTstate1 + here->VBICirci_Vbcx);
+            *(ckt->CKTstate0 + here->VBICirbi) = 
+                    *(ckt->CKTstate1 + here->VBICirbi);
+            *(ckt->CKTstate0 + here->VBICirbi_Vrbi) = 
+                    *(ckt->CKTstate1 + here->VBICirbi_Vrbi);
+            *(ckt->CKTstate0 + here->VBICirbi_Vbei) = 
+                    *(ckt->CKTstate1 + here->VBICirbi_Vbei);
+            *(ckt->CKTstate0 + here->VBICirbi_Vbci) = 
+                    *(ckt->CKTstate1 + here->VBICirbi_Vbci);
+            *(ckt->CKTstate0 + here->VBICirbp) = 
+                    *(ckt->CKTstate1 + here->VBICirbp);
+            *(ckt->CKTstate0 + here->VBICirbp_Vrbp) = 
+                    *(ckt->CKTstate1 + here->VBICirbp_Vrbp);
+            *(ckt->CKTstate0 + here->VBICirbp_Vbep) = 
+                    *(ckt->CKTstate1 + here->VBICirbp_Vbep);
+            *(ckt->CKTstate0 + here->VBICirbp_Vbci) = 
+                    *(ckt->CKTstate1 + here->VBICirbp_Vbci);
+            *(ckt->CKTstate0 + here->VBICibcp) = 
+                    *(ckt->CKTstate1 + here->VBICibcp);
+            *(ckt->CKTstate0 + here->VBICibcp_Vbcp) = 
+                    *(ckt->CKTstate1 + here->VBICibcp_Vbcp);
+            *(ckt->CKTstate0 + here->VBICiccp) = 
+                    *(ckt->CKTstate1 + here->VBICiccp);
+            *(ckt->CKTstate0 + here->VBICiccp_Vbep) = 
+                    *(ckt->CKTstate1 + here->VBICiccp_Vbep);
+            *(ckt->CKTstate0 + here->VBICiccp_Vbci) = 
+                    *(ckt->CKTstate1 + here->VBICiccp_Vbci);
+            *(ckt->CKTstate0 + here->VBICiccp_Vbcp) = 
+                    *(ckt->CKTstate1 + here->VBICiccp_Vbcp);
+            *(ckt->CKTstate0 + here->VBICgqbeo) = 
+                    *(ckt->CKTstate1 + here->VBICgqbeo);
+            *(ckt->CKTstate0 + here->VBICgqbco) = 
+                    *(ckt->CKTstate1 + here->VBICgqbco);
+            *(ckt->CKTstate0 + here->VBICircx_Vrcx) = 
+                    *(ckt->CKTstate1 + here->VBICircx_Vrcx);
+            *(ckt->CKTstate0 + here->VBICirbx_Vrbx) = 
+                    *(ckt->CKTstate1 + here->VBICirbx_Vrbx);
+            *(ckt->CKTstate0 + here->VBICirs_Vrs) = 
+                    *(ckt->CKTstate1 + here->VBICirs_Vrs);
+            *(ckt->CKTstate0 + here->VBICire_Vre) = 
+                    *(ckt->CKTstate1 + here->VBICire_Vre);
+        } else {
 #endif /* PREDICTOR */
-                    /*
-                     *   compute new nonlinear branch voltages
-                     */
-                    Vbei = model->VBICtype*(
-                        *(ckt->CKTrhsOld+here->VBICbaseBINode)-
-                        *(ckt->CKTrhsOld+here->VBICemitEINode));
-                    Vbex = model->VBICtype*(
-                        *(ckt->CKTrhsOld+here->VBICbaseBXNode)-
-                        *(ckt->CKTrhsOld+here->VBICemitEINode));
-                    Vbci = model->VBICtype*(
-                        *(ckt->CKTrhsOld+here->VBICbaseBINode)-
-                        *(ckt->CKTrhsOld+here->VBICcollCINode));
-                    Vbcx = model->VBICtype*(
-                        *(ckt->CKTrhsOld+here->VBICbaseBINode)-
-                        *(ckt->CKTrhsOld+here->VBICcollCXNode));
-                    Vbep = model->VBICtype*(
-                        *(ckt->CKTrhsOld+here->VBICbaseBXNode)-
-                        *(ckt->CKTrhsOld+here->VBICbaseBPNode));
-                    Vrci = model->VBICtype*(
-                        *(ckt->CKTrhsOld+here->VBICcollCXNode)-
-                        *(ckt->CKTrhsOld+here->VBICcollCINode));
-                    Vrbi = model->VBICtype*(
-                        *(ckt->CKTrhsOld+here->VBICbaseBXNode)-
-                        *(ckt->CKTrhsOld+here->VBICbaseBINode));
-                    Vrbp = model->VBICtype*(
-                        *(ckt->CKTrhsOld+here->VBICbaseBPNode)-
-                        *(ckt->CKTrhsOld+here->VBICcollCXNode));
-                    Vbcp = model->VBICtype*(
-                        *(ckt->CKTrhsOld+here->VBICsubsSINode)-
-                        *(ckt->CKTrhsOld+here->VBICbaseBPNode));
+            /*
+             *   compute new nonlinear branch voltages
+             */
+            Vbei = model->VBICtype*(
+                *(ckt->CKTrhsOld+here->VBICbaseBINode)-
+                *(ckt->CKTrhsOld+here->VBICemitEINode));
+            Vbex = model->VBICtype*(
+                *(ckt->CKTrhsOld+here->VBICbaseBXNode)-
+                *(ckt->CKTrhsOld+here->VBICemitEINode));
+            Vbci = model->VBICtype*(
+                *(ckt->CKTrhsOld+here->VBICbaseBINode)-
+                *(ckt->CKTrhsOld+here->VBICcollCINode));
+            Vbcx = model->VBICtype*(
+                *(ckt->CKTrhsOld+here->VBICbaseBINode)-
+                *(ckt->CKTrhsOld+here->VBICcollCXNode));
+            Vbep = model->VBICtype*(
+                *(ckt->CKTrhsOld+here->VBICbaseBXNode)-
+                *(ckt->CKTrhsOld+here->VBICbaseBPNode));
+            Vrci = model->VBICtype*(
+                *(ckt->CKTrhsOld+here->VBICcollCXNode)-
+                *(ckt->CKTrhsOld+here->VBICcollCINode));
+            Vrbi = model->VBICtype*(
+                *(ckt->CKTrhsOld+here->VBICbaseBXNode)-
+                *(ckt->CKTrhsOld+here->VBICbaseBINode));
+            Vrbp = model->VBICtype*(
+                *(ckt->CKTrhsOld+here->VBICbaseBPNode)-
+                *(ckt->CKTrhsOld+here->VBICcollCXNode));
+            Vbcp = model->VBICtype*(
+                *(ckt->CKTrhsOld+here->VBICsubsSINode)-
+                *(ckt->CKTrhsOld+here->VBICbaseBPNode));
 #ifndef PREDICTOR
-                }
+        }
 #endif /* PREDICTOR */
-                delvbei = Vbei - *(ckt->CKTstate0 + here->VBICvbei);
-                delvbex = Vbex - *(ckt->CKTstate0 + here->VBICvbex);
-                delvbci = Vbci - *(ckt->CKTstate0 + here->VBICvbci);
-                delvbcx = Vbcx - *(ckt->CKTstate0 + here->VBICvbcx);
-                delvbep = Vbep - *(ckt->CKTstate0 + here->VBICvbep);
-                delvrci = Vrci - *(ckt->CKTstate0 + here->VBICvrci);
-                delvrbi = Vrbi - *(ckt->CKTstate0 + here->VBICvrbi);
-                delvrbp = Vrbp - *(ckt->CKTstate0 + here->VBICvrbp);
-                delvbcp = Vbcp - *(ckt->CKTstate0 + here->VBICvbcp);
-                Vbe = model->VBICtype*(
-                    *(ckt->CKTrhsOld+here->VBICbaseNode)-
-                    *(ckt->CKTrhsOld+here->VBICemitNode));
-                Vbc = model->VBICtype*(
-                    *(ckt->CKTrhsOld+here->VBICbaseNode)-
-                    *(ckt->CKTrhsOld+here->VBICcollNode));
-                Vrcx = model->VBICtype*(
-                    *(ckt->CKTrhsOld+here->VBICcollNode)-
-                    *(ckt->CKTrhsOld+here->VBICcollCXNode));
-                Vrbx = model->VBICtype*(
-                    *(ckt->CKTrhsOld+here->VBICbaseNode)-
-                    *(ckt->CKTrhsOld+here->VBICbaseBXNode));
-                Vre = model->VBICtype*(
-                    *(ckt->CKTrhsOld+here->VBICemitNode)-
-                    *(ckt->CKTrhsOld+here->VBICemitEINode));
-                Vrs = model->VBICtype*(
-                    *(ckt->CKTrhsOld+here->VBICsubsNode)-
-                    *(ckt->CKTrhsOld+here->VBICsubsSINode));
+        delvbei = Vbei - *(ckt->CKTstate0 + here->VBICvbei);
+        delvbex = Vbex - *(ckt->CKTstate0 + here->VBICvbex);
+        delvbci = Vbci - *(ckt->CKTstate0 + here->VBICvbci);
+        delvbcx = Vbcx - *(ckt->CKTstate0 + here->VBICvbcx);
+        delvbep = Vbep - *(ckt->CKTstate0 + here->VBICvbep);
+        delvrci = Vrci - *(ckt->CKTstate0 + here->VBICvrci);
+        delvrbi = Vrbi - *(ckt->CKTstate0 + here->VBICvrbi);
+        delvrbp = Vrbp - *(ckt->CKTstate0 + here->VBICvrbp);
+        delvbcp = Vbcp - *(ckt->CKTstate0 + here->VBICvbcp);
+        Vbe = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICbaseNode)-
+            *(ckt->CKTrhsOld+here->VBICemitNode));
+        Vbc = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICbaseNode)-
+            *(ckt->CKTrhsOld+here->VBICcollNode));
+        Vrcx = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICcollNode)-
+            *(ckt->CKTrhsOld+here->VBICcollCXNode));
+        Vrbx = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICbaseNode)-
+            *(ckt->CKTrhsOld+here->VBICbaseBXNode));
+        Vre = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICemitNode)-
+            *(ckt->CKTrhsOld+here->VBICemitEINode));
+        Vrs = model->VBICtype*(
+            *(ckt->CKTrhsOld+here->VBICsubsNode)-
+            *(ckt->CKTrhsOld+here->VBICsubsSINode));
 
-                ibehat = *(ckt->CKTstate0 + here->VBICibe) + 
-                         *(ckt->CKTstate0 + here->VBICibe_Vbei)*delvbei;
-                ibexhat = *(ckt->CKTstate0 + here->VBICibex) + 
-                         *(ckt->CKTstate0 + here->VBICibex_Vbex)*delvbex;
-                itzfhat = *(ckt->CKTstate0 + here->VBICitzf) + 
-                         *(ckt->CKTstate0 + here->VBICitzf_Vbei)*delvbei + *(ckt->CKTstate0 + here->VBICitzf_Vbci)*delvbci;
-                itzrhat = *(ckt->CKTstate0 + here->VBICitzr) + 
-                         *(ckt->CKTstate0 + here->VBICitzr_Vbei)*delvbei + *(ckt->CKTstate0 + here->VBICitzr_Vbci)*delvbci;
-                ibchat = *(ckt->CKTstate0 + here->VBICibc) + 
-                         *(ckt->CKTstate0 + here->VBICibc_Vbei)*delvbei + *(ckt->CKTstate0 + here->VBICibc_Vbci)*delvbci;
-                ibephat = *(ckt->CKTstate0 + here->VBICibep) + 
-                         *(ckt->CKTstate0 + here->VBICibep_Vbep)*delvbep;
-                ircihat = *(ckt->CKTstate0 + here->VBICirci) + *(ckt->CKTstate0 + here->VBICirci_Vrci)*delvrci +
-                         *(ckt->CKTstate0 + here->VBICirci_Vbcx)*delvbcx + *(ckt->CKTstate0 + here->VBICirci_Vbci)*delvbci;
-                irbihat = *(ckt->CKTstate0 + here->VBICirbi) + *(ckt->CKTstate0 + here->VBICirbi_Vrbi)*delvrbi +
-                         *(ckt->CKTstate0 + here->VBICirbi_Vbei)*delvbei + *(ckt->CKTstate0 + here->VBICirbi_Vbci)*delvbci;
-                irbphat = *(ckt->CKTstate0 + here->VBICirbp) + *(ckt->CKTstate0 + here->VBICirbp_Vrbp)*delvrbp +
-                         *(ckt->CKTstate0 + here->VBICirbp_Vbep)*delvbep + *(ckt->CKTstate0 + here->VBICirbp_Vbci)*delvbci;
-                ibcphat = *(ckt->CKTstate0 + here->VBICibcp) + 
-                         *(ckt->CKTstate0 + here->VBICibcp_Vbcp)*delvbcp;
-                iccphat = *(ckt->CKTstate0 + here->VBICiccp) + *(ckt->CKTstate0 + here->VBICiccp_Vbep)*delvbep + 
-                         *(ckt->CKTstate0 + here->VBICiccp_Vbci)*delvbci + *(ckt->CKTstate0 + here->VBICiccp_Vbcp)*delvbcp;
-                /*
-                 *    bypass if solution has not changed
-                 */
-                /* the following collections of if's would be just one
-                 * if the average compiler could handle it, but many
-                 * find the expression too complicated, thus the split.
-                 */
-                if( (ckt->CKTbypass) &&
-                        (!(ckt->CKTmode & MODEINITPRED)) &&
-                        (fabs(delvbei) < (ckt->CKTreltol*MAX(fabs(Vbei),
-                            fabs(*(ckt->CKTstate0 + here->VBICvbei)))+
-                            ckt->CKTvoltTol)) )
-                    if( (fabs(delvbex) < ckt->CKTreltol*MAX(fabs(Vbex),
-                            fabs(*(ckt->CKTstate0 + here->VBICvbex)))+
-                            ckt->CKTvoltTol) )
-                    if( (fabs(delvbci) < ckt->CKTreltol*MAX(fabs(Vbci),
-                            fabs(*(ckt->CKTstate0 + here->VBICvbci)))+
-                            ckt->CKTvoltTol) )
-                    if( (fabs(delvbcx) < ckt->CKTreltol*MAX(fabs(Vbcx),
-                            fabs(*(ckt->CKTstate0 + here->VBICvbcx)))+
-                            ckt->CKTvoltTol) )
-                    if( (fabs(delvbep) < ckt->CKTreltol*MAX(fabs(Vbep),
-                            fabs(*(ckt->CKTstate0 + here->VBICvbep)))+
-                            ckt->CKTvoltTol) )
-                    if( (fabs(delvrci) < ckt->CKTreltol*MAX(fabs(Vrci),
-                            fabs(*(ckt->CKTstate0 + here->VBICvrci)))+
-                            ckt->CKTvoltTol) )
-                    if( (fabs(delvrbi) < ckt->CKTreltol*MAX(fabs(Vrbi),
-                            fabs(*(ckt->CKTstate0 + here->VBICvrbi)))+
-                            ckt->CKTvoltTol) )
-                    if( (fabs(delvrbp) < ckt->CKTreltol*MAX(fabs(Vrbp),
-                            fabs(*(ckt->CKTstate0 + here->VBICvrbp)))+
-                            ckt->CKTvoltTol) )
-                    if( (fabs(delvbcp) < ckt->CKTreltol*MAX(fabs(Vbcp),
-                            fabs(*(ckt->CKTstate0 + here->VBICvbcp)))+
-                            ckt->CKTvoltTol) )
-                    if( (fabs(ibehat-*(ckt->CKTstate0 + here->VBICibe)) < 
-                            ckt->CKTreltol* MAX(fabs(ibehat),
-                            fabs(*(ckt->CKTstate0 + here->VBICibe)))+
-                            ckt->CKTabstol) )
-                    if( (fabs(ibexhat-*(ckt->CKTstate0 + here->VBICibex)) < 
-                            ckt->CKTreltol* MAX(fabs(ibexhat),
-                            fabs(*(ckt->CKTstate0 + here->VBICibex)))+
-                            ckt->CKTabstol) )
-                    if( (fabs(itzfhat-*(ckt->CKTstate0 + here->VBICitzf)) < 
-                            ckt->CKTreltol* MAX(fabs(itzfhat),
-                            fabs(*(ckt->CKTstate0 + here->VBICitzf)))+
-                            ckt->CKTabstol) )
-                    if( (fabs(itzrhat-*(ckt->CKTstate0 + here->VBICitzr)) < 
-                            ckt->CKTreltol* MAX(fabs(itzrhat),
-                            fabs(*(ckt->CKTstate0 + here->VBICitzr)))+
-                            ckt->CKTabstol) )
-                    if( (fabs(ibchat-*(ckt->CKTstate0 + here->VBICibc)) < 
-                            ckt->CKTreltol* MAX(fabs(ibchat),
-                            fabs(*(ckt->CKTstate0 + here->VBICibc)))+
-                            ckt->CKTabstol) )
-                    if( (fabs(ibephat-*(ckt->CKTstate0 + here->VBICibep)) < 
-                            ckt->CKTreltol* MAX(fabs(ibephat),
-                            fabs(*(ckt->CKTstate0 + here->VBICibep)))+
-                            ckt->CKTabstol) )
-                    if( (fabs(ircihat-*(ckt->CKTstate0 + here->VBICirci)) < 
-                            ckt->CKTreltol* MAX(fabs(ircihat),
-                            fabs(*(ckt->CKTstate0 + here->VBICirci)))+
-                            ckt->CKTabstol) )
-                    if( (fabs(irbihat-*(ckt->CKTstate0 + here->VBICirbi)) < 
-                            ckt->CKTreltol* MAX(fabs(irbihat),
-                            fabs(*(ckt->CKTstate0 + here->VBICirbi)))+
-                            ckt->CKTabstol) )
-                    if( (fabs(irbphat-*(ckt->CKTstate0 + here->VBICirbp)) < 
-                            ckt->CKTreltol* MAX(fabs(irbphat),
-                            fabs(*(ckt->CKTstate0 + here->VBICirbp)))+
-                            ckt->CKTabstol) )
-                    if( (fabs(ibcphat-*(ckt->CKTstate0 + here->VBICibcp)) < 
-                            ckt->CKTreltol* MAX(fabs(ibcphat),
-                            fabs(*(ckt->CKTstate0 + here->VBICibcp)))+
-                            ckt->CKTabstol) )
-                    if( (fabs(iccphat-*(ckt->CKTstate0 + here->VBICiccp)) < 
-                            ckt->CKTreltol* MAX(fabs(iccphat),
-                            fabs(*(ckt->CKTstate0 + here->VBICiccp)))+
-                            ckt->CKTabstol) ) {
-                    /*
-                     * bypassing....
-                     */
-                    Vbei = *(ckt->CKTstate0 + here->VBICvbei);
-                    Vbex = *(ckt->CKTstate0 + here->VBICvbex);
-                    Vbci = *(ckt->CKTstate0 + here->VBICvbci);
-                    Vbcx = *(ckt->CKTstate0 + here->VBICvbcx);
-                    Vbep = *(ckt->CKTstate0 + here->VBICvbep);
-                    Vrci = *(ckt->CKTstate0 + here->VBICvrci);
-                    Vrbi = *(ckt->CKTstate0 + here->VBICvrbi);
-                    Vrbp = *(ckt->CKTstate0 + here->VBICvrbp);
-                    Vbcp = *(ckt->CKTstate0 + here->VBICvbcp);
-                    Ibe       = *(ckt->CKTstate0 + here->VBICibe);
-                    Ibe_Vbei  = *(ckt->CKTstate0 + here->VBICibe_Vbei);
-                    Ibex      = *(ckt->CKTstate0 + here->VBICibex);
-                    Ibex_Vbex = *(ckt->CKTstate0 + here->VBICibex_Vbex);
-                    Itzf      = *(ckt->CKTstate0 + here->VBICitzf);
-                    Itzf_Vbei = *(ckt->CKTstate0 + here->VBICitzf_Vbei);
-                    Itzf_Vbci = *(ckt->CKTstate0 + here->VBICitzf_Vbci);
-                    Itzr      = *(ckt->CKTstate0 + here->VBICitzr);
-                    Itzr_Vbci = *(ckt->CKTstate0 + here->VBICitzr_Vbci);
-                    Itzr_Vbei = *(ckt->CKTstate0 + here->VBICitzr_Vbei);
-                    Ibc       = *(ckt->CKTstate0 + here->VBICibc);
-                    Ibc_Vbci  = *(ckt->CKTstate0 + here->VBICibc_Vbci);
-                    Ibc_Vbei  = *(ckt->CKTstate0 + here->VBICibc_Vbei);
-                    Ibep      = *(ckt->CKTstate0 + here->VBICibep);
-                    Ibep_Vbep = *(ckt->CKTstate0 + here->VBICibep_Vbep);
-                    Irci      = *(ckt->CKTstate0 + here->VBICirci);
-                    Irci_Vrci = *(ckt->CKTstate0 + here->VBICirci_Vrci);
-                    Irci_Vbci = *(ckt->CKTstate0 + here->VBICirci_Vbci);
-                    Irci_Vbcx = *(ckt->CKTstate0 + here->VBICirci_Vbcx);
-                    Irbi      = *(ckt->CKTstate0 + here->VBICirbi);
-                    Irbi_Vrbi = *(ckt->CKTstate0 + here->VBICirbi_Vrbi);
-                    Irbi_Vbei = *(ckt->CKTstate0 + here->VBICirbi_Vbei);
-                    Irbi_Vbci = *(ckt->CKTstate0 + here->VBICirbi_Vbci);
-                    Irbp      = *(ckt->CKTstate0 + here->VBICirbp);
-                    Irbp_Vrbp = *(ckt->CKTstate0 + here->VBICirbp_Vrbp);
-                    Irbp_Vbep = *(ckt->CKTstate0 + here->VBICirbp_Vbep);
-                    Irbp_Vbci = *(ckt->CKTstate0 + here->VBICirbp_Vbci);
-                    Ibcp      = *(ckt->CKTstate0 + here->VBICibcp);
-                    Ibcp_Vbcp = *(ckt->CKTstate0 + here->VBICibcp_Vbcp);
-                    Iccp      = *(ckt->CKTstate0 + here->VBICiccp);
-                    Iccp_Vbep = *(ckt->CKTstate0 + here->VBICiccp_Vbep);
-                    Iccp_Vbci = *(ckt->CKTstate0 + here->VBICiccp_Vbci);
-                    Iccp_Vbcp = *(ckt->CKTstate0 + here->VBICiccp_Vbcp);
-                    gqbeo     = *(ckt->CKTstate0 + here->VBICgqbeo);
-                    gqbco     = *(ckt->CKTstate0 + here->VBICgqbco);
-                    Ircx_Vrcx = *(ckt->CKTstate0 + here->VBICircx_Vrcx);
-                    Irbx_Vrbx = *(ckt->CKTstate0 + here->VBICirbx_Vrbx);
-                    Irs_Vrs   = *(ckt->CKTstate0 + here->VBICirs_Vrs);
-                    Ire_Vre   = *(ckt->CKTstate0 + here->VBICire_Vre);
-                    goto load;
-                }
-                /*
-                 *   limit nonlinear branch voltages
-                 */
-                ichk1 = 1;
-                Vbei = DEVpnjlim(Vbei,*(ckt->CKTstate0 + here->VBICvbei),vt,
-                        here->VBICtVcrit,&icheck);
-                Vbex = DEVpnjlim(Vbex,*(ckt->CKTstate0 + here->VBICvbex),vt,
-                        here->VBICtVcrit,&ichk1);
-                Vbci = DEVpnjlim(Vbci,*(ckt->CKTstate0 + here->VBICvbci),vt,
-                        here->VBICtVcrit,&ichk2);
-                Vbcx = DEVpnjlim(Vbcx,*(ckt->CKTstate0 + here->VBICvbcx),vt,
-                        here->VBICtVcrit,&ichk3);
-                Vbep = DEVpnjlim(Vbep,*(ckt->CKTstate0 + here->VBICvbep),vt,
-                        here->VBICtVcrit,&ichk4);
-                Vbcp = DEVpnjlim(Vbcp,*(ckt->CKTstate0 + here->VBICvbcp),vt,
-                        here->VBICtVcrit,&ichk5);
-                if ((ichk1 == 1) || (ichk2 == 1) || (ichk3 == 1) || (ichk4 == 1) || (ichk5 == 1)) icheck=1;
-            }
+        ibehat = *(ckt->CKTstate0 + here->VBICibe) + 
+                 *(ckt->CKTstate0 + here->VBICibe_Vbei)*delvbei;
+        ibexhat = *(ckt->CKTstate0 + here->VBICibex) + 
+                 *(ckt->CKTstate0 + here->VBICibex_Vbex)*delvbex;
+        itzfhat = *(ckt->CKTstate0 + here->VBICitzf) + 
+                 *(ckt->CKTstate0 + here->VBICitzf_Vbei)*delvbei + *(ckt->CKTstate0 + here->VBICitzf_Vbci)*delvbci;
+        itzrhat = *(ckt->CKTstate0 + here->VBICitzr) + 
+                 *(ckt->CKTstate0 + here->VBICitzr_Vbei)*delvbei + *(ckt->CKTstate0 + here->VBICitzr_Vbci)*delvbci;
+        ibchat = *(ckt->CKTstate0 + here->VBICibc) + 
+                 *(ckt->CKTstate0 + here->VBICibc_Vbei)*delvbei + *(ckt->CKTstate0 + here->VBICibc_Vbci)*delvbci;
+        ibephat = *(ckt->CKTstate0 + here->VBICibep) + 
+                 *(ckt->CKTstate0 + here->VBICibep_Vbep)*delvbep;
+        ircihat = *(ckt->CKTstate0 + here->VBICirci) + *(ckt->CKTstate0 + here->VBICirci_Vrci)*delvrci +
+                 *(ckt->CKTstate0 + here->VBICirci_Vbcx)*delvbcx + *(ckt->CKTstate0 + here->VBICirci_Vbci)*delvbci;
+        irbihat = *(ckt->CKTstate0 + here->VBICirbi) + *(ckt->CKTstate0 + here->VBICirbi_Vrbi)*delvrbi +
+                 *(ckt->CKTstate0 + here->VBICirbi_Vbei)*delvbei + *(ckt->CKTstate0 + here->VBICirbi_Vbci)*delvbci;
+        irbphat = *(ckt->CKTstate0 + here->VBICirbp) + *(ckt->CKTstate0 + here->VBICirbp_Vrbp)*delvrbp +
+                 *(ckt->CKTstate0 + here->VBICirbp_Vbep)*delvbep + *(ckt->CKTstate0 + here->VBICirbp_Vbci)*delvbci;
+        ibcphat = *(ckt->CKTstate0 + here->VBICibcp) + 
+                 *(ckt->CKTstate0 + here->VBICibcp_Vbcp)*delvbcp;
+        iccphat = *(ckt->CKTstate0 + here->VBICiccp) + *(ckt->CKTstate0 + here->VBICiccp_Vbep)*delvbep + 
+                 *(ckt->CKTstate0 + here->VBICiccp_Vbci)*delvbci + *(ckt->CKTstate0 + here->VBICiccp_Vbcp)*delvbcp;
+        /*
+         *    bypass if solution has not changed
+         */
+        /* the following collections of if's would be just one
+         * if the average compiler could handle it, but many
+         * find the expression too complicated, thus the split.
+         */
+        if( (ckt->CKTbypass) &&
+                (!(ckt->CKTmode & MODEINITPRED)) &&
+                (fabs(delvbei) < (ckt->CKTreltol*MAX(fabs(Vbei),
+                    fabs(*(ckt->CKTstate0 + here->VBICvbei)))+
+                    ckt->CKTvoltTol)) )
+            if( (fabs(delvbex) < ckt->CKTreltol*MAX(fabs(Vbex),
+                    fabs(*(ckt->CKTstate0 + here->VBICvbex)))+
+                    ckt->CKTvoltTol) )
+            if( (fabs(delvbci) < ckt->CKTreltol*MAX(fabs(Vbci),
+                    fabs(*(ckt->CKTstate0 + here->VBICvbci)))+
+                    ckt->CKTvoltTol) )
+            if( (fabs(delvbcx) < ckt->CKTreltol*MAX(fabs(Vbcx),
+                    fabs(*(ckt->CKTstate0 + here->VBICvbcx)))+
+                    ckt->CKTvoltTol) )
+            if( (fabs(delvbep) < ckt->CKTreltol*MAX(fabs(Vbep),
+                    fabs(*(ckt->CKTstate0 + here->VBICvbep)))+
+                    ckt->CKTvoltTol) )
+            if( (fabs(delvrci) < ckt->CKTreltol*MAX(fabs(Vrci),
+                    fabs(*(ckt->CKTstate0 + here->VBICvrci)))+
+                    ckt->CKTvoltTol) )
+            if( (fabs(delvrbi) < ckt->CKTreltol*MAX(fabs(Vrbi),
+                    fabs(*(ckt->CKTstate0 + here->VBICvrbi)))+
+                    ckt->CKTvoltTol) )
+            if( (fabs(delvrbp) < ckt->CKTreltol*MAX(fabs(Vrbp),
+                    fabs(*(ckt->CKTstate0 + here->VBICvrbp)))+
+                    ckt->CKTvoltTol) )
+            if( (fabs(delvbcp) < ckt->CKTreltol*MAX(fabs(Vbcp),
+                    fabs(*(ckt->CKTstate0 + here->VBICvbcp)))+
+                    ckt->CKTvoltTol) )
+            if( (fabs(ibehat-*(ckt->CKTstate0 + here->VBICibe)) < 
+                    ckt->CKTreltol* MAX(fabs(ibehat),
+                    fabs(*(ckt->CKTstate0 + here->VBICibe)))+
+                    ckt->CKTabstol) )
+            if( (fabs(ibexhat-*(ckt->CKTstate0 + here->VBICibex)) < 
+                    ckt->CKTreltol* MAX(fabs(ibexhat),
+                    fabs(*(ckt->CKTstate0 + here->VBICibex)))+
+                    ckt->CKTabstol) )
+            if( (fabs(itzfhat-*(ckt->CKTstate0 + here->VBICitzf)) < 
+                    ckt->CKTreltol* MAX(fabs(itzfhat),
+                    fabs(*(ckt->CKTstate0 + here->VBICitzf)))+
+                    ckt->CKTabstol) )
+            if( (fabs(itzrhat-*(ckt->CKTstate0 + here->VBICitzr)) < 
+                    ckt->CKTreltol* MAX(fabs(itzrhat),
+                    fabs(*(ckt->CKTstate0 + here->VBICitzr)))+
+                    ckt->CKTabstol) )
+            if( (fabs(ibchat-*(ckt->CKTstate0 + here->VBICibc)) < 
+                    ckt->CKTreltol* MAX(fabs(ibchat),
+                    fabs(*(ckt->CKTstate0 + here->VBICibc)))+
+                    ckt->CKTabstol) )
+            if( (fabs(ibephat-*(ckt->CKTstate0 + here->VBICibep)) < 
+                    ckt->CKTreltol* MAX(fabs(ibephat),
+                    fabs(*(ckt->CKTstate0 + here->VBICibep)))+
+                    ckt->CKTabstol) )
+            if( (fabs(ircihat-*(ckt->CKTstate0 + here->VBICirci)) < 
+                    ckt->CKTreltol* MAX(fabs(ircihat),
+                    fabs(*(ckt->CKTstate0 + here->VBICirci)))+
+                    ckt->CKTabstol) )
+            if( (fabs(irbihat-*(ckt->CKTstate0 + here->VBICirbi)) < 
+                    ckt->CKTreltol* MAX(fabs(irbihat),
+                    fabs(*(ckt->CKTstate0 + here->VBICirbi)))+
+                    ckt->CKTabstol) )
+            if( (fabs(irbphat-*(ckt->CKTstate0 + here->VBICirbp)) < 
+                    ckt->CKTreltol* MAX(fabs(irbphat),
+                    fabs(*(ckt->CKTstate0 + here->VBICirbp)))+
+                    ckt->CKTabstol) )
+            if( (fabs(ibcphat-*(ckt->CKTstate0 + here->VBICibcp)) < 
+                    ckt->CKTreltol* MAX(fabs(ibcphat),
+                    fabs(*(ckt->CKTstate0 + here->VBICibcp)))+
+                    ckt->CKTabstol) )
+            if( (fabs(iccphat-*(ckt->CKTstate0 + here->VBICiccp)) < 
+                    ckt->CKTreltol* MAX(fabs(iccphat),
+                    fabs(*(ckt->CKTstate0 + here->VBICiccp)))+
+                    ckt->CKTabstol) ) {
             /*
-             *   determine dc current and derivitives
+             * bypassing....
              */
+            Vbei = *(ckt->CKTstate0 + here->VBICvbei);
+            Vbex = *(ckt->CKTstate0 + here->VBICvbex);
+            Vbci = *(ckt->CKTstate0 + here->VBICvbci);
+            Vbcx = *(ckt->CKTstate0 + here->VBICvbcx);
+            Vbep = *(ckt->CKTstate0 + here->VBICvbep);
+            Vrci = *(ckt->CKTstate0 + here->VBICvrci);
+            Vrbi = *(ckt->CKTstate0 + here->VBICvrbi);
+            Vrbp = *(ckt->CKTstate0 + here->VBICvrbp);
+            Vbcp = *(ckt->CKTstate0 + here->VBICvbcp);
+            Ibe       = *(ckt->CKTstate0 + here->VBICibe);
+            Ibe_Vbei  = *(ckt->CKTstate0 + here->VBICibe_Vbei);
+            Ibex      = *(ckt->CKTstate0 + here->VBICibex);
+            Ibex_Vbex = *(ckt->CKTstate0 + here->VBICibex_Vbex);
+            Itzf      = *(ckt->CKTstate0 + here->VBICitzf);
+            Itzf_Vbei = *(ckt->CKTstate0 + here->VBICitzf_Vbei);
+            Itzf_Vbci = *(ckt->CKTstate0 + here->VBICitzf_Vbci);
+            Itzr      = *(ckt->CKTstate0 + here->VBICitzr);
+            Itzr_Vbci = *(ckt->CKTstate0 + here->VBICitzr_Vbci);
+            Itzr_Vbei = *(ckt->CKTstate0 + here->VBICitzr_Vbei);
+            Ibc       = *(ckt->CKTstate0 + here->VBICibc);
+            Ibc_Vbci  = *(ckt->CKTstate0 + here->VBICibc_Vbci);
+            Ibc_Vbei  = *(ckt->CKTstate0 + here->VBICibc_Vbei);
+            Ibep      = *(ckt->CKTstate0 + here->VBICibep);
+            Ibep_Vbep = *(ckt->CKTstate0 + here->VBICibep_Vbep);
+            Irci      = *(ckt->CKTstate0 + here->VBICirci);
+            Irci_Vrci = *(ckt->CKTstate0 + here->VBICirci_Vrci);
+            Irci_Vbci = *(ckt->CKTstate0 + here->VBICirci_Vbci);
+            Irci_Vbcx = *(ckt->CKTstate0 + here->VBICirci_Vbcx);
+            Irbi      = *(ckt->CKTstate0 + here->VBICirbi);
+            Irbi_Vrbi = *(ckt->CKTstate0 + here->VBICirbi_Vrbi);
+            Irbi_Vbei = *(ckt->CKTstate0 + here->VBICirbi_Vbei);
+            Irbi_Vbci = *(ckt->CKTstate0 + here->VBICirbi_Vbci);
+            Irbp      = *(ckt->CKTstate0 + here->VBICirbp);
+            Irbp_Vrbp = *(ckt->CKTstate0 + here->VBICirbp_Vrbp);
+            Irbp_Vbep = *(ckt->CKTstate0 + here->VBICirbp_Vbep);
+            Irbp_Vbci = *(ckt->CKTstate0 + here->VBICirbp_Vbci);
+            Ibcp      = *(ckt->CKTstate0 + here->VBICibcp);
+            Ibcp_Vbcp = *(ckt->CKTstate0 + here->VBICibcp_Vbcp);
+            Iccp      = *(ckt->CKTstate0 + here->VBICiccp);
+            Iccp_Vbep = *(ckt->CKTstate0 + here->VBICiccp_Vbep);
+            Iccp_Vbci = *(ckt->CKTstate0 + here->VBICiccp_Vbci);
+            Iccp_Vbcp = *(ckt->CKTstate0 + here->VBICiccp_Vbcp);
+            gqbeo     = *(ckt->CKTstate0 + here->VBICgqbeo);
+            gqbco     = *(ckt->CKTstate0 + here->VBICgqbco);
+            Ircx_Vrcx = *(ckt->CKTstate0 + here->VBICircx_Vrcx);
+            Irbx_Vrbx = *(ckt->CKTstate0 + here->VBICirbx_Vrbx);
+            Irs_Vrs   = *(ckt->CKTstate0 + here->VBICirs_Vrs);
+            Ire_Vre   = *(ckt->CKTstate0 + here->VBICire_Vre);
+            goto load;
+        }
+        /*
+         *   limit nonlinear branch voltages
+         */
+        ichk1 = 1;
+        Vbei = DEVpnjlim(Vbei,*(ckt->CKTstate0 + here->VBICvbei),vt,
+                here->VBICtVcrit,&icheck);
+        Vbex = DEVpnjlim(Vbex,*(ckt->CKTstate0 + here->VBICvbex),vt,
+                here->VBICtVcrit,&ichk1);
+        Vbci = DEVpnjlim(Vbci,*(ckt->CKTstate0 + here->VBICvbci),vt,
+                here->VBICtVcrit,&ichk2);
+        Vbcx = DEVpnjlim(Vbcx,*(ckt->CKTstate0 + here->VBICvbcx),vt,
+                here->VBICtVcrit,&ichk3);
+        Vbep = DEVpnjlim(Vbep,*(ckt->CKTstate0 + here->VBICvbep),vt,
+                here->VBICtVcrit,&ichk4);
+        Vbcp = DEVpnjlim(Vbcp,*(ckt->CKTstate0 + here->VBICvbcp),vt,
+                here->VBICtVcrit,&ichk5);
+        if ((ichk1 == 1) || (ichk2 == 1) || (ichk3 == 1) || (ichk4 == 1) || (ichk5 == 1)) icheck=1;
+    }
+    /*
+     *   determine dc current and derivitives
+     */
 next1:      
-            iret = vbic_4T_it_cf_fj(p
-            ,&Vbei,&Vbex,&Vbci,&Vbep,&Vbcp,&Vrcx
-            ,&Vbcx,&Vrci,&Vrbx,&Vrbi,&Vre,&Vrbp,&Vrs
-            ,&Vbe,&Vbc,&Ibe,&Ibe_Vbei,&Ibex,&Ibex_Vbex,&Itzf
-            ,&Itzf_Vbei,&Itzf_Vbci,&Itzr,&Itzr_Vbci,&Itzr_Vbei,&Ibc,&Ibc_Vbci
-            ,&Ibc_Vbei,&Ibep,&Ibep_Vbep,&Ircx,&Ircx_Vrcx,&Irci,&Irci_Vrci
-            ,&Irci_Vbci,&Irci_Vbcx,&Irbx,&Irbx_Vrbx,&Irbi,&Irbi_Vrbi,&Irbi_Vbei
-            ,&Irbi_Vbci,&Ire,&Ire_Vre,&Irbp,&Irbp_Vrbp,&Irbp_Vbep,&Irbp_Vbci
-            ,&Qbe,&Qbe_Vbei,&Qbe_Vbci,&Qbex,&Qbex_Vbex,&Qbc,&Qbc_Vbci
-            ,&Qbcx,&Qbcx_Vbcx,&Qbep,&Qbep_Vbep,&Qbep_Vbci,&Qbeo,&Qbeo_Vbe
-            ,&Qbco,&Qbco_Vbc,&Ibcp,&Ibcp_Vbcp,&Iccp,&Iccp_Vbep,&Iccp_Vbci
-            ,&Iccp_Vbcp,&Irs,&Irs_Vrs,&Qbcp,&Qbcp_Vbcp,&SCALE);
-          
-            Ibe += ckt->CKTgmin*Vbei;
-            Ibe_Vbei += ckt->CKTgmin;
-            Ibex += ckt->CKTgmin*Vbex;
-            Ibex_Vbex += ckt->CKTgmin;
-            Ibc += ckt->CKTgmin*Vbci;
-            Ibc_Vbci += ckt->CKTgmin;
-            Ibep += ckt->CKTgmin*Vbep;
-            Ibep_Vbep += ckt->CKTgmin;
-            Irci += ckt->CKTgmin*Vrci;
-            Irci_Vrci += ckt->CKTgmin;
-            Irci_Vbci += ckt->CKTgmin;
-            Irci_Vbcx += ckt->CKTgmin;
-            Ibcp += ckt->CKTgmin*Vbcp;
-            Ibcp_Vbcp += ckt->CKTgmin;
+    iret = vbic_4T_it_cf_fj(p
+    ,&Vbei,&Vbex,&Vbci,&Vbep,&Vbcp,&Vrcx
+    ,&Vbcx,&Vrci,&Vrbx,&Vrbi,&Vre,&Vrbp,&Vrs
+    ,&Vbe,&Vbc,&Ibe,&Ibe_Vbei,&Ibex,&Ibex_Vbex,&Itzf
+    ,&Itzf_Vbei,&Itzf_Vbci,&Itzr,&Itzr_Vbci,&Itzr_Vbei,&Ibc,&Ibc_Vbci
+    ,&Ibc_Vbei,&Ibep,&Ibep_Vbep,&Ircx,&Ircx_Vrcx,&Irci,&Irci_Vrci
+    ,&Irci_Vbci,&Irci_Vbcx,&Irbx,&Irbx_Vrbx,&Irbi,&Irbi_Vrbi,&Irbi_Vbei
+    ,&Irbi_Vbci,&Ire,&Ire_Vre,&Irbp,&Irbp_Vrbp,&Irbp_Vbep,&Irbp_Vbci
+    ,&Qbe,&Qbe_Vbei,&Qbe_Vbci,&Qbex,&Qbex_Vbex,&Qbc,&Qbc_Vbci
+    ,&Qbcx,&Qbcx_Vbcx,&Qbep,&Qbep_Vbep,&Qbep_Vbci,&Qbeo,&Qbeo_Vbe
+    ,&Qbco,&Qbco_Vbc,&Ibcp,&Ibcp_Vbcp,&Iccp,&Iccp_Vbep,&Iccp_Vbci
+    ,&Iccp_Vbcp,&Irs,&Irs_Vrs,&Qbcp,&Qbcp_Vbcp,&SCALE);
+  
+    Ibe += ckt->CKTgmin*Vbei;
+    Ibe_Vbei += ckt->CKTgmin;
+    Ibex += ckt->CKTgmin*Vbex;
+    Ibex_Vbex += ckt->CKTgmin;
+    Ibc += ckt->CKTgmin*Vbci;
+    Ibc_Vbci += ckt->CKTgmin;
+    Ibep += ckt->CKTgmin*Vbep;
+    Ibep_Vbep += ckt->CKTgmin;
+    Irci += ckt->CKTgmin*Vrci;
+    Irci_Vrci += ckt->CKTgmin;
+    Irci_Vbci += ckt->CKTgmin;
+    Irci_Vbcx += ckt->CKTgmin;
+    Ibcp += ckt->CKTgmin*Vbcp;
+    Ibcp_Vbcp += ckt->CKTgmin;
 
-            if( (ckt->CKTmode & (MODETRAN | MODEAC)) ||
-                    ((ckt->CKTmode & MODETRANOP) && (ckt->CKTmode & MODEUIC)) ||
-                    (ckt->CKTmode & MODEINITSMSIG)) {
-                /*
-                 *   charge storage elements
-                 */
+    if( (ckt->CKTmode & (MODETRAN | MODEAC)) ||
+            ((ckt->CKTmode & MODETRANOP) && (ckt->CKTmode & MODEUIC)) ||
+            (ckt->CKTmode & MODEINITSMSIG)) {
+        /*
+         *   charge storage elements
+         */
 
-                *(ckt->CKTstate0 + here->VBICqbe)  = Qbe;
-                *(ckt->CKTstate0 + here->VBICqbex) = Qbex;
-                *(ckt->CKTstate0 + here->VBICqbc)  = Qbc;
-                *(ckt->CKTstate0 + here->VBICqbcx) = Qbcx;
-                *(ckt->CKTstate0 + here->VBICqbep) = Qbep;
-                *(ckt->CKTstate0 + here->VBICqbeo) = Qbeo;
-                *(ckt->CKTstate0 + here->VBICqbco) = Qbco;
-                *(ckt->CKTstate0 + here->VBICqbcp) = Qbcp;
+        *(ckt->CKTstate0 + here->VBICqbe)  = Qbe;
+        *(ckt->CKTstate0 + here->VBICqbex) = Qbex;
+        *(ckt->CKTstate0 + here->VBICqbc)  = Qbc;
+        *(ckt->CKTstate0 + here->VBICqbcx) = Qbcx;
+        *(ckt->CKTstate0 + here->VBICqbep) = Qbep;
+        *(ckt->CKTstate0 + here->VBICqbeo) = Qbeo;
+        *(ckt->CKTstate0 + here->VBICqbco) = Qbco;
+        *(ckt->CKTstate0 + here->VBICqbcp) = Qbcp;
 
-                here->VBICcapbe = Qbe_Vbei;
-                here->VBICcapbex = Qbex_Vbex;
-                here->VBICcapbc = Qbc_Vbci;
-                here->VBICcapbcx = Qbcx_Vbcx;
-                here->VBICcapbep = Qbep_Vbep;
-                here->VBICcapbcp = Qbcp_Vbcp;
+        here->VBICcapbe = Qbe_Vbei;
+        here->VBICcapbex = Qbex_Vbex;
+        here->VBICcapbc = Qbc_Vbci;
+        here->VBICcapbcx = Qbcx_Vbcx;
+        here->VBICcapbep = Qbep_Vbep;
+        here->VBICcapbcp = Qbcp_Vbcp;
 
-                /*
-                 *   store small-signal parameters
-                 */
-                if ( (!(ckt->CKTmode & MODETRANOP))||
-                        (!(ckt->CKTmode & MODEUIC)) ) {
-                    if(ckt->CKTmode & MODEINITSMSIG) {
-                        *(ckt->CKTstate0 + here->VBICcqbe)  = Qbe_Vbei;
-                        *(ckt->CKTstate0 + here->VBICcqbeci) = Qbe_Vbci;
-                        *(ckt->CKTstate0 + here->VBICcqbex) = Qbex_Vbex;
-                        *(ckt->CKTstate0 + here->VBICcqbc)  = Qbc_Vbci;
-                        *(ckt->CKTstate0 + here->VBICcqbcx) = Qbcx_Vbcx;
-                        *(ckt->CKTstate0 + here->VBICcqbep) = Qbep_Vbep;
-                        *(ckt->CKTstate0 + here->VBICcqbepci) = Qbep_Vbci;
-                        *(ckt->CKTstate0 + here->VBICcqbeo) = Qbeo_Vbe;
-                        *(ckt->CKTstate0 + here->VBICcqbco) = Qbco_Vbc;
-                        *(ckt->CKTstate0 + here->VBICcqbcp) = Qbcp_Vbcp;
-                        if(SenCond) {
-                            *(ckt->CKTstate0 + here->VBICibe)       = Ibe;
-                            *(ckt->CKTstate0 + here->VBICibe_Vbei)  = Ibe_Vbei;
-                            *(ckt->CKTstate0 + here->VBICibex)      = Ibex;
-                            *(ckt->CKTstate0 + here->VBICibex_Vbex) = Ibex_Vbex;
-                            *(ckt->CKTstate0 + here->VBICitzf)      = Itzf;
-                            *(ckt->CKTstate0 + here->VBICitzf_Vbei) = Itzf_Vbei;
-                            *(ckt->CKTstate0 + here->VBICitzf_Vbci) = Itzf_Vbci;
-                            *(ckt->CKTstate0 + here->VBICitzr)      = Itzr;
-                            *(ckt->CKTstate0 + here->VBICitzr_Vbci) = Itzr_Vbci;
-                            *(ckt->CKTstate0 + here->VBICitzr_Vbei) = Itzr_Vbei;
-                            *(ckt->CKTstate0 + here->VBICibc)       = Ibc;
-                            *(ckt->CKTstate0 + here->VBICibc_Vbci)  = Ibc_Vbci;
-                            *(ckt->CKTstate0 + here->VBICibc_Vbei)  = Ibc_Vbei;
-                            *(ckt->CKTstate0 + here->VBICibep)      = Ibep;
-                            *(ckt->CKTstate0 + here->VBICibep_Vbep) = Ibep_Vbep;
-                            *(ckt->CKTstate0 + here->VBICirci)      = Irci;
-                            *(ckt->CKTstate0 + here->VBICirci_Vrci) = Irci_Vrci;
-                            *(ckt->CKTstate0 + here->VBICirci_Vbci) = Irci_Vbci;
-                            *(ckt->CKTstate0 + here->VBICirci_Vbcx) = Irci_Vbcx;
-                            *(ckt->CKTstate0 + here->VBICirbi)      = Irbi;
-                            *(ckt->CKTstate0 + here->VBICirbi_Vrbi) = Irbi_Vrbi;
-                            *(ckt->CKTstate0 + here->VBICirbi_Vbei) = Irbi_Vbei;
-                            *(ckt->CKTstate0 + here->VBICirbi_Vbci) = Irbi_Vbci;
-                            *(ckt->CKTstate0 + here->VBICirbp)      = Irbp;
-                            *(ckt->CKTstate0 + here->VBICirbp_Vrbp) = Irbp_Vrbp;
-                            *(ckt->CKTstate0 + here->VBICirbp_Vbep) = Irbp_Vbep;
-                            *(ckt->CKTstate0 + here->VBICirbp_Vbci) = Irbp_Vbci;
-                            *(ckt->CKTstate0 + here->VBICibcp)      = Ibcp;
-                            *(ckt->CKTstate0 + here->VBICibcp_Vbcp) = Ibcp_Vbcp;
-                            *(ckt->CKTstate0 + here->VBICiccp)      = Iccp;
-                            *(ckt->CKTstate0 + here->VBICiccp_Vbep) = Iccp_Vbep;
-                            *(ckt->CKTstate0 + here->VBICiccp_Vbci) = Iccp_Vbci;
-                            *(ckt->CKTstate0 + here->VBICiccp_Vbcp) = Iccp_Vbcp;
-                            *(ckt->CKTstate0 + here->VBICgqbeo)     = gqbeo;
-                            *(ckt->CKTstate0 + here->VBICgqbco)     = gqbco;
-                            *(ckt->CKTstate0 + here->VBICircx_Vrcx) = Ircx_Vrcx;
-                            *(ckt->CKTstate0 + here->VBICirbx_Vrbx) = Irbx_Vrbx;
-                            *(ckt->CKTstate0 + here->VBICirs_Vrs)   = Irs_Vrs;  
-                            *(ckt->CKTstate0 + here->VBICire_Vre)   = Ire_Vre;  
-                        }
+        /*
+         *   store small-signal parameters
+         */
+        if ( (!(ckt->CKTmode & MODETRANOP))||
+                (!(ckt->CKTmode & MODEUIC)) ) {
+            if(ckt->CKTmode & MODEINITSMSIG) {
+                *(ckt->CKTstate0 + here->VBICcqbe)  = Qbe_Vbei;
+                *(ckt->CKTstate0 + here->VBICcqbeci) = Qbe_Vbci;
+                *(ckt->CKTstate0 + here->VBICcqbex) = Qbex_Vbex;
+                *(ckt->CKTstate0 + here->VBICcqbc)  = Qbc_Vbci;
+                *(ckt->CKTstate0 + here->VBICcqbcx) = Qbcx_Vbcx;
+                *(ckt->CKTstate0 + here->VBICcqbep) = Qbep_Vbep;
+                *(ckt->CKTstate0 + here->VBICcqbepci) = Qbep_Vbci;
+                *(ckt->CKTstate0 + here->VBICcqbeo) = Qbeo_Vbe;
+                *(ckt->CKTstate0 + here->VBICcqbco) = Qbco_Vbc;
+                *(ckt->CKTstate0 + here->VBICcqbcp) = Qbcp_Vbcp;
+                if(SenCond) {
+                    *(ckt->CKTstate0 + here->VBICibe)       = Ibe;
+                    *(ckt->CKTstate0 + here->VBICibe_Vbei)  = Ibe_Vbei;
+                    *(ckt->CKTstate0 + here->VBICibex)      = Ibex;
+                    *(ckt->CKTstate0 + here->VBICibex_Vbex) = Ibex_Vbex;
+                    *(ckt->CKTstate0 + here->VBICitzf)      = Itzf;
+                    *(ckt->CKTstate0 + here->VBICitzf_Vbei) = Itzf_Vbei;
+                    *(ckt->CKTstate0 + here->VBICitzf_Vbci) = Itzf_Vbci;
+                    *(ckt->CKTstate0 + here->VBICitzr)      = Itzr;
+                    *(ckt->CKTstate0 + here->VBICitzr_Vbci) = Itzr_Vbci;
+                    *(ckt->CKTstate0 + here->VBICitzr_Vbei) = Itzr_Vbei;
+                    *(ckt->CKTstate0 + here->VBICibc)       = Ibc;
+                    *(ckt->CKTstate0 + here->VBICibc_Vbci)  = Ibc_Vbci;
+                    *(ckt->CKTstate0 + here->VBICibc_Vbei)  = Ibc_Vbei;
+                    *(ckt->CKTstate0 + here->VBICibep)      = Ibep;
+                    *(ckt->CKTstate0 + here->VBICibep_Vbep) = Ibep_Vbep;
+                    *(ckt->CKTstate0 + here->VBICirci)      = Irci;
+                    *(ckt->CKTstate0 + here->VBICirci_Vrci) = Irci_Vrci;
+                    *(ckt->CKTstate0 + here->VBICirci_Vbci) = Irci_Vbci;
+                    *(ckt->CKTstate0 + here->VBICirci_Vbcx) = Irci_Vbcx;
+                    *(ckt->CKTstate0 + here->VBICirbi)      = Irbi;
+                    *(ckt->CKTstate0 + here->VBICirbi_Vrbi) = Irbi_Vrbi;
+                    *(ckt->CKTstate0 + here->VBICirbi_Vbei) = Irbi_Vbei;
+                    *(ckt->CKTstate0 + here->VBICirbi_Vbci) = Irbi_Vbci;
+                    *(ckt->CKTstate0 + here->VBICirbp)      = Irbp;
+                    *(ckt->CKTstate0 + here->VBICirbp_Vrbp) = Irbp_Vrbp;
+                    *(ckt->CKTstate0 + here->VBICirbp_Vbep) = Irbp_Vbep;
+                    *(ckt->CKTstate0 + here->VBICirbp_Vbci) = Irbp_Vbci;
+                    *(ckt->CKTstate0 + here->VBICibcp)      = Ibcp;
+                    *(ckt->CKTstate0 + here->VBICibcp_Vbcp) = Ibcp_Vbcp;
+                    *(ckt->CKTstate0 + here->VBICiccp)      = Iccp;
+                    *(ckt->CKTstate0 + here->VBICiccp_Vbep) = Iccp_Vbep;
+                    *(ckt->CKTstate0 + here->VBICiccp_Vbci) = Iccp_Vbci;
+                    *(ckt->CKTstate0 + here->VBICiccp_Vbcp) = Iccp_Vbcp;
+                    *(ckt->CKTstate0 + here->VBICgqbeo)     = gqbeo;
+                    *(ckt->CKTstate0 + here->VBICgqbco)     = gqbco;
+                    *(ckt->CKTstate0 + here->VBICircx_Vrcx) = Ircx_Vrcx;
+                    *(ckt->CKTstate0 + here->VBICirbx_Vrbx) = Irbx_Vrbx;
+                    *(ckt->CKTstate0 + here->VBICirs_Vrs)   = Irs_Vrs;  
+                    *(ckt->CKTstate0 + here->VBICire_Vre)   = Ire_Vre;  
+                }
 #ifdef SENSDEBUG
-                        printf("storing small signal parameters for op\n");
-                        printf("Cbe = %.7e, Cbex = %.7e\n", Qbe_Vbei, Qbex_Vbex);
-                        printf("Cbc = %.7e, Cbcx = %.7e\n", Qbc_Vbci, Qbcx_Vbcx);
-                        printf("gpi = %.7e\n", Ibe_Vbei);
-                        printf("gmu = %.7e, gm = %.7e\n", Ibc_Vbci, Itzf_Vbei);
-                        printf("go = %.7e, gx = %.7e\n", Itzf_Vbci, Irbi_Vrbi);
-                        printf("cc = %.7e, cb = %.7e\n", Ibe+Itzf, Ibe);
+                printf("storing small signal parameters for op\n");
+                printf("Cbe = %.7e, Cbex = %.7e\n", Qbe_Vbei, Qbex_Vbex);
+                printf("Cbc = %.7e, Cbcx = %.7e\n", Qbc_Vbci, Qbcx_Vbcx);
+                printf("gpi = %.7e\n", Ibe_Vbei);
+                printf("gmu = %.7e, gm = %.7e\n", Ibc_Vbci, Itzf_Vbei);
+                printf("go = %.7e, gx = %.7e\n", Itzf_Vbci, Irbi_Vrbi);
+                printf("cc = %.7e, cb = %.7e\n", Ibe+Itzf, Ibe);
 #endif /* SENSDEBUG */
-                        continue; /* go to 1000 */
-                    }
-                    /*
-                     *   transient analysis
-                     */
-                    if(SenCond && ckt->CKTsenInfo->SENmode == TRANSEN) {
-                        *(ckt->CKTstate0 + here->VBICibe)  = Ibe;
-                        *(ckt->CKTstate0 + here->VBICibex) = Ibex;
-                        *(ckt->CKTstate0 + here->VBICitzf) = Itzf;
-                        *(ckt->CKTstate0 + here->VBICitzr) = Itzr;
-                        *(ckt->CKTstate0 + here->VBICibc)  = Ibc;
-                        *(ckt->CKTstate0 + here->VBICibep) = Ibep;
-                        *(ckt->CKTstate0 + here->VBICirci) = Irci;
-                        *(ckt->CKTstate0 + here->VBICirbi) = Irbi;
-                        *(ckt->CKTstate0 + here->VBICirbp) = Irbp;
-                        *(ckt->CKTstate0 + here->VBICibcp) = Ibcp;
-                        *(ckt->CKTstate0 + here->VBICiccp) = Iccp;
-                        continue;
-                    }
+                return(OK); /* go to 1000 */
+            }
+            /*
+             *   transient analysis
+             */
+            if(SenCond && ckt->CKTsenInfo->SENmode == TRANSEN) {
+                *(ckt->CKTstate0 + here->VBICibe)  = Ibe;
+                *(ckt->CKTstate0 + here->VBICibex) = Ibex;
+                *(ckt->CKTstate0 + here->VBICitzf) = Itzf;
+                *(ckt->CKTstate0 + here->VBICitzr) = Itzr;
+                *(ckt->CKTstate0 + here->VBICibc)  = Ibc;
+                *(ckt->CKTstate0 + here->VBICibep) = Ibep;
+                *(ckt->CKTstate0 + here->VBICirci) = Irci;
+                *(ckt->CKTstate0 + here->VBICirbi) = Irbi;
+                *(ckt->CKTstate0 + here->VBICirbp) = Irbp;
+                *(ckt->CKTstate0 + here->VBICibcp) = Ibcp;
+                *(ckt->CKTstate0 + here->VBICiccp) = Iccp;
+                return(OK);
+            }
 
-                    if(ckt->CKTmode & MODEINITTRAN) {
-                        *(ckt->CKTstate1 + here->VBICqbe) =
-                                *(ckt->CKTstate0 + here->VBICqbe) ;
-                        *(ckt->CKTstate1 + here->VBICqbex) =
-                                *(ckt->CKTstate0 + here->VBICqbex) ;
-                        *(ckt->CKTstate1 + here->VBICqbc) =
-                                *(ckt->CKTstate0 + here->VBICqbc) ;
-                        *(ckt->CKTstate1 + here->VBICqbcx) =
-                                *(ckt->CKTstate0 + here->VBICqbcx) ;
-                        *(ckt->CKTstate1 + here->VBICqbep) =
-                                *(ckt->CKTstate0 + here->VBICqbep) ;
-                        *(ckt->CKTstate1 + here->VBICqbeo) =
-                                *(ckt->CKTstate0 + here->VBICqbeo) ;
-                        *(ckt->CKTstate1 + here->VBICqbco) =
-                                *(ckt->CKTstate0 + here->VBICqbco) ;
-                        *(ckt->CKTstate1 + here->VBICqbcp) =
-                                *(ckt->CKTstate0 + here->VBICqbcp) ;
-                    }
-                    error = NIintegrate(ckt,&geq,&ceq,Qbe_Vbei,here->VBICqbe);
-                    if(error) return(error);
-                    Ibe_Vbei = Ibe_Vbei + geq;
-                    Ibe = Ibe + *(ckt->CKTstate0 + here->VBICcqbe);
+            if(ckt->CKTmode & MODEINITTRAN) {
+                *(ckt->CKTstate1 + here->VBICqbe) =
+                        *(ckt->CKTstate0 + here->VBICqbe) ;
+                *(ckt->CKTstate1 + here->VBICqbex) =
+                        *(ckt->CKTstate0 + here->VBICqbex) ;
+                *(ckt->CKTstate1 + here->VBICqbc) =
+                        *(ckt->CKTstate0 + here->VBICqbc) ;
+                *(ckt->CKTstate1 + here->VBICqbcx) =
+                        *(ckt->CKTstate0 + here->VBICqbcx) ;
+                *(ckt->CKTstate1 + here->VBICqbep) =
+                        *(ckt->CKTstate0 + here->VBICqbep) ;
+                *(ckt->CKTstate1 + here->VBICqbeo) =
+                        *(ckt->CKTstate0 + here->VBICqbeo) ;
+                *(ckt->CKTstate1 + here->VBICqbco) =
+                        *(ckt->CKTstate0 + here->VBICqbco) ;
+                *(ckt->CKTstate1 + here->VBICqbcp) =
+                        *(ckt->CKTstate0 + here->VBICqbcp) ;
+            }
+            error = NIintegrate(ckt,&geq,&ceq,Qbe_Vbei,here->VBICqbe);
+            if(error) return(error);
+            Ibe_Vbei = Ibe_Vbei + geq;
+            Ibe = Ibe + *(ckt->CKTstate0 + here->VBICcqbe);
 
-                    error = NIintegrate(ckt,&geq,&ceq,Qbex_Vbex,here->VBICqbex);
-                    if(error) return(error);
-                    Ibex_Vbex = Ibex_Vbex + geq;
-                    Ibex = Ibex + *(ckt->CKTstate0 + here->VBICcqbex);
+            error = NIintegrate(ckt,&geq,&ceq,Qbex_Vbex,here->VBICqbex);
+            if(error) return(error);
+            Ibex_Vbex = Ibex_Vbex + geq;
+            Ibex = Ibex + *(ckt->CKTstate0 + here->VBICcqbex);
 
-                    error = NIintegrate(ckt,&geq,&ceq,Qbc_Vbci,here->VBICqbc);
-                    if(error) return(error);
-                    Ibc_Vbci = Ibc_Vbci + geq;
-                    Ibc = Ibc + *(ckt->CKTstate0 + here->VBICcqbc);
+            error = NIintegrate(ckt,&geq,&ceq,Qbc_Vbci,here->VBICqbc);
+            if(error) return(error);
+            Ibc_Vbci = Ibc_Vbci + geq;
+            Ibc = Ibc + *(ckt->CKTstate0 + here->VBICcqbc);
 
-                    error = NIintegrate(ckt,&geq,&ceq,Qbcx_Vbcx,here->VBICqbcx);
-                    if(error) return(error);
-                    gbcx = geq;
-                    cbcx = *(ckt->CKTstate0 + here->VBICcqbcx);
+            error = NIintegrate(ckt,&geq,&ceq,Qbcx_Vbcx,here->VBICqbcx);
+            if(error) return(error);
+            gbcx = geq;
+            cbcx = *(ckt->CKTstate0 + here->VBICcqbcx);
 
-                    error = NIintegrate(ckt,&geq,&ceq,Qbep_Vbep,here->VBICqbep);
-                    if(error) return(error);
-                    Ibep_Vbep = Ibep_Vbep + geq;
-                    Ibep = Ibep + *(ckt->CKTstate0 + here->VBICcqbep);
+            error = NIintegrate(ckt,&geq,&ceq,Qbep_Vbep,here->VBICqbep);
+            if(error) return(error);
+            Ibep_Vbep = Ibep_Vbep + geq;
+            Ibep = Ibep + *(ckt->CKTstate0 + here->VBICcqbep);
 
-                    error = NIintegrate(ckt,&geq,&ceq,Qbcp_Vbcp,here->VBICqbcp);
-                    if(error) return(error);
-                    Ibcp_Vbcp = Ibcp_Vbcp + geq;
-                    Ibcp = Ibcp + *(ckt->CKTstate0 + here->VBICcqbcp);
+            error = NIintegrate(ckt,&geq,&ceq,Qbcp_Vbcp,here->VBICqbcp);
+            if(error) return(error);
+            Ibcp_Vbcp = Ibcp_Vbcp + geq;
+            Ibcp = Ibcp + *(ckt->CKTstate0 + here->VBICcqbcp);
 
-                    if(ckt->CKTmode & MODEINITTRAN) {
-                        *(ckt->CKTstate1 + here->VBICcqbe) =
-                                *(ckt->CKTstate0 + here->VBICcqbe);
-                        *(ckt->CKTstate1 + here->VBICcqbex) =
-                                *(ckt->CKTstate0 + here->VBICcqbex);
-                        *(ckt->CKTstate1 + here->VBICcqbc) =
-                                *(ckt->CKTstate0 + here->VBICcqbc);
-                        *(ckt->CKTstate1 + here->VBICcqbcx) =
-                                *(ckt->CKTstate0 + here->VBICcqbcx);
-                        *(ckt->CKTstate1 + here->VBICcqbep) =
-                                *(ckt->CKTstate0 + here->VBICcqbep);
-                        *(ckt->CKTstate1 + here->VBICcqbcp) =
-                                *(ckt->CKTstate0 + here->VBICcqbcp);
-                    }
-                }
+            if(ckt->CKTmode & MODEINITTRAN) {
+                *(ckt->CKTstate1 + here->VBICcqbe) =
+                        *(ckt->CKTstate0 + here->VBICcqbe);
+                *(ckt->CKTstate1 + here->VBICcqbex) =
+                        *(ckt->CKTstate0 + here->VBICcqbex);
+                *(ckt->CKTstate1 + here->VBICcqbc) =
+                        *(ckt->CKTstate0 + here->VBICcqbc);
+                *(ckt->CKTstate1 + here->VBICcqbcx) =
+                        *(ckt->CKTstate0 + here->VBICcqbcx);
+                *(ckt->CKTstate1 + here->VBICcqbep) =
+                        *(ckt->CKTstate0 + here->VBICcqbep);
+                *(ckt->CKTstate1 + here->VBICcqbcp) =
+                        *(ckt->CKTstate0 + here->VBICcqbcp);
             }
+        }
+    }
 
-            if(SenCond) goto next2;
+    if(SenCond) goto next2;
 
-            /*
-             *   check convergence
-             */
-            if ( (!(ckt->CKTmode & MODEINITFIX))||(!(here->VBICoff))) {
-                if (icheck == 1) {
-                    ckt->CKTnoncon++;
-                    ckt->CKTtroubleElt = (GENinstance *) here;
-                }
-            }
+    /*
+     *   check convergence
+     */
+    if ( (!(ckt->CKTmode & MODEINITFIX))||(!(here->VBICoff))) {
+        if (icheck == 1) {
+            st->noncon++;
+        }
+    }
 
-            /*
-             *      charge storage for outer b-e and b-c junctions
-             */
-            if(ckt->CKTmode & (MODETRAN | MODEAC)) {
-                error = NIintegrate(ckt,&gqbeo,&cqbeo,Qbeo_Vbe,here->VBICqbeo);
-                if(error) return(error);
-                error = NIintegrate(ckt,&gqbco,&cqbco,Qbco_Vbc,here->VBICqbco);
-                if(error) return(error);
-                if(ckt->CKTmode & MODEINITTRAN) {
-                    *(ckt->CKTstate1 + here->VBICcqbeo) =
-                            *(ckt->CKTstate0 + here->VBICcqbeo);
-                    *(ckt->CKTstate1 + here->VBICcqbco) =
-                            *(ckt->CKTstate0 + here->VBICcqbco);
-                }
-            }
+    /*
+     *      charge storage for outer b-e and b-c junctions
+     */
+    if(ckt->CKTmode & (MODETRAN | MODEAC)) {
+        error = NIintegrate(ckt,&gqbeo,&cqbeo,Qbeo_Vbe,here->VBICqbeo);
+        if(error) return(error);
+        error = NIintegrate(ckt,&gqbco,&cqbco,Qbco_Vbc,here->VBICqbco);
+        if(error) return(error);
+        if(ckt->CKTmode & MODEINITTRAN) {
+            *(ckt->CKTstate1 + here->VBICcqbeo) =
+                    *(ckt->CKTstate0 + here->VBICcqbeo);
+            *(ckt->CKTstate1 + here->VBICcqbco) =
+                    *(ckt->CKTstate0 + here->VBICcqbco);
+        }
+    }
 next2:
-            *(ckt->CKTstate0 + here->VBICvbei)      = Vbei;
-            *(ckt->CKTstate0 + here->VBICvbex)      = Vbex;
-            *(ckt->CKTstate0 + here->VBICvbci)      = Vbci;
-            *(ckt->CKTstate0 + here->VBICvbcx)      = Vbcx;
-            *(ckt->CKTstate0 + here->VBICvbep)      = Vbep;
-            *(ckt->CKTstate0 + here->VBICvrci)      = Vrci;
-            *(ckt->CKTstate0 + here->VBICvrbi)      = Vrbi;
-            *(ckt->CKTstate0 + here->VBICvrbp)      = Vrbp;
-            *(ckt->CKTstate0 + here->VBICvbcp)      = Vbcp;
+    *(ckt->CKTstate0 + here->VBICvbei)      = Vbei;
+    *(ckt->CKTstate0 + here->VBICvbex)      = Vbex;
+    *(ckt->CKTstate0 + here->VBICvbci)      = Vbci;
+    *(ckt->CKTstate0 + here->VBICvbcx)      = Vbcx;
+    *(ckt->CKTstate0 + here->VBICvbep)      = Vbep;
+    *(ckt->CKTstate0 + here->VBICvrci)      = Vrci;
+    *(ckt->CKTstate0 + here->VBICvrbi)      = Vrbi;
+    *(ckt->CKTstate0 + here->VBICvrbp)      = Vrbp;
+    *(ckt->CKTstate0 + here->VBICvbcp)      = Vbcp;
 
-            *(ckt->CKTstate0 + here->VBICibe)       = Ibe;
-            *(ckt->CKTstate0 + here->VBICibe_Vbei)  = Ibe_Vbei;
-            *(ckt->CKTstate0 + here->VBICibex)      = Ibex;
-            *(ckt->CKTstate0 + here->VBICibex_Vbex) = Ibex_Vbex;
-            *(ckt->CKTstate0 + here->VBICitzf)      = Itzf;
-            *(ckt->CKTstate0 + here->VBICitzf_Vbei) = Itzf_Vbei;
-            *(ckt->CKTstate0 + here->VBICitzf_Vbci) = Itzf_Vbci;
-            *(ckt->CKTstate0 + here->VBICitzr)      = Itzr;
-            *(ckt->CKTstate0 + here->VBICitzr_Vbci) = Itzr_Vbci;
-            *(ckt->CKTstate0 + here->VBICitzr_Vbei) = Itzr_Vbei;
-            *(ckt->CKTstate0 + here->VBICibc)       = Ibc;
-            *(ckt->CKTstate0 + here->VBICibc_Vbci)  = Ibc_Vbci;
-            *(ckt->CKTstate0 + here->VBICibc_Vbei)  = Ibc_Vbei;
-            *(ckt->CKTstate0 + here->VBICibep)      = Ibep;
-            *(ckt->CKTstate0 + here->VBICibep_Vbep) = Ibep_Vbep;
-            *(ckt->CKTstate0 + here->VBICirci)      = Irci;
-            *(ckt->CKTstate0 + here->VBICirci_Vrci) = Irci_Vrci;
-            *(ckt->CKTstate0 + here->VBICirci_Vbci) = Irci_Vbci;
-            *(ckt->CKTstate0 + here->VBICirci_Vbcx) = Irci_Vbcx;
-            *(ckt->CKTstate0 + here->VBICirbi)      = Irbi;
-            *(ckt->CKTstate0 + here->VBICirbi_Vrbi) = Irbi_Vrbi;
-            *(ckt->CKTstate0 + here->VBICirbi_Vbei) = Irbi_Vbei;
-            *(ckt->CKTstate0 + here->VBICirbi_Vbci) = Irbi_Vbci;
-            *(ckt->CKTstate0 + here->VBICirbp)      = Irbp;
-            *(ckt->CKTstate0 + here->VBICirbp_Vrbp) = Irbp_Vrbp;
-            *(ckt->CKTstate0 + here->VBICirbp_Vbep) = Irbp_Vbep;
-            *(ckt->CKTstate0 + here->VBICirbp_Vbci) = Irbp_Vbci;
-            *(ckt->CKTstate0 + here->VBICibcp)      = Ibcp;
-            *(ckt->CKTstate0 + here->VBICibcp_Vbcp) = Ibcp_Vbcp;
-            *(ckt->CKTstate0 + here->VBICiccp)      = Iccp;
-            *(ckt->CKTstate0 + here->VBICiccp_Vbep) = Iccp_Vbep;
-            *(ckt->CKTstate0 + here->VBICiccp_Vbci) = Iccp_Vbci;
-            *(ckt->CKTstate0 + here->VBICiccp_Vbcp) = Iccp_Vbcp;
-            *(ckt->CKTstate0 + here->VBICgqbeo)     = gqbeo;
-            *(ckt->CKTstate0 + here->VBICgqbco)     = gqbco;
-            *(ckt->CKTstate0 + here->VBICircx_Vrcx) = Ircx_Vrcx;
-            *(ckt->CKTstate0 + here->VBICirbx_Vrbx) = Irbx_Vrbx;
-            *(ckt->CKTstate0 + here->VBICirs_Vrs)   = Irs_Vrs;  
-            *(ckt->CKTstate0 + here->VBICire_Vre)   = Ire_Vre;  
+    *(ckt->CKTstate0 + here->VBICibe)       = Ibe;
+    *(ckt->CKTstate0 + here->VBICibe_Vbei)  = Ibe_Vbei;
+    *(ckt->CKTstate0 + here->VBICibex)      = Ibex;
+    *(ckt->CKTstate0 + here->VBICibex_Vbex) = Ibex_Vbex;
+    *(ckt->CKTstate0 + here->VBICitzf)      = Itzf;
+    *(ckt->CKTstate0 + here->VBICitzf_Vbei) = Itzf_Vbei;
+    *(ckt->CKTstate0 + here->VBICitzf_Vbci) = Itzf_Vbci;
+    *(ckt->CKTstate0 + here->VBICitzr)      = Itzr;
+    *(ckt->CKTstate0 + here->VBICitzr_Vbci) = Itzr_Vbci;
+    *(ckt->CKTstate0 + here->VBICitzr_Vbei) = Itzr_Vbei;
+    *(ckt->CKTstate0 + here->VBICibc)       = Ibc;
+    *(ckt->CKTstate0 + here->VBICibc_Vbci)  = Ibc_Vbci;
+    *(ckt->CKTstate0 + here->VBICibc_Vbei)  = Ibc_Vbei;
+    *(ckt->CKTstate0 + here->VBICibep)      = Ibep;
+    *(ckt->CKTstate0 + here->VBICibep_Vbep) = Ibep_Vbep;
+    *(ckt->CKTstate0 + here->VBICirci)      = Irci;
+    *(ckt->CKTstate0 + here->VBICirci_Vrci) = Irci_Vrci;
+    *(ckt->CKTstate0 + here->VBICirci_Vbci) = Irci_Vbci;
+    *(ckt->CKTstate0 + here->VBICirci_Vbcx) = Irci_Vbcx;
+    *(ckt->CKTstate0 + here->VBICirbi)      = Irbi;
+    *(ckt->CKTstate0 + here->VBICirbi_Vrbi) = Irbi_Vrbi;
+    *(ckt->CKTstate0 + here->VBICirbi_Vbei) = Irbi_Vbei;
+    *(ckt->CKTstate0 + here->VBICirbi_Vbci) = Irbi_Vbci;
+    *(ckt->CKTstate0 + here->VBICirbp)      = Irbp;
+    *(ckt->CKTstate0 + here->VBICirbp_Vrbp) = Irbp_Vrbp;
+    *(ckt->CKTstate0 + here->VBICirbp_Vbep) = Irbp_Vbep;
+    *(ckt->CKTstate0 + here->VBICirbp_Vbci) = Irbp_Vbci;
+    *(ckt->CKTstate0 + here->VBICibcp)      = Ibcp;
+    *(ckt->CKTstate0 + here->VBICibcp_Vbcp) = Ibcp_Vbcp;
+    *(ckt->CKTstate0 + here->VBICiccp)      = Iccp;
+    *(ckt->CKTstate0 + here->VBICiccp_Vbep) = Iccp_Vbep;
+    *(ckt->CKTstate0 + here->VBICiccp_Vbci) = Iccp_Vbci;
+    *(ckt->CKTstate0 + here->VBICiccp_Vbcp) = Iccp_Vbcp;
+    *(ckt->CKTstate0 + here->VBICgqbeo)     = gqbeo;
+    *(ckt->CKTstate0 + here->VBICgqbco)     = gqbco;
+    *(ckt->CKTstate0 + here->VBICircx_Vrcx) = Ircx_Vrcx;
+    *(ckt->CKTstate0 + here->VBICirbx_Vrbx) = Irbx_Vrbx;
+    *(ckt->CKTstate0 + here->VBICirs_Vrs)   = Irs_Vrs;  
+    *(ckt->CKTstate0 + here->VBICire_Vre)   = Ire_Vre;  
 
-            /* Do not load the Jacobian and the rhs if
-               perturbation is being carried out */
-            if(SenCond) continue;
+    /* Do not load the Jacobian and the rhs if
+       perturbation is being carried out */
+    if(SenCond) return(OK);
 load:
-            /*
-             *  load current excitation vector and matrix
-             */
-            rhs_current = model->VBICtype * (*(ckt->CKTstate0 + here->VBICcqbeo) - Vbe * gqbeo);
-            *(ckt->CKTrhs + here->VBICbaseNode) += -rhs_current;
-            *(ckt->CKTrhs + here->VBICemitNode) +=  rhs_current;
-            *(here->VBICbaseBasePtr) +=  gqbeo;
-            *(here->VBICemitEmitPtr) +=  gqbeo;
-            *(here->VBICbaseEmitPtr) += -gqbeo;
-            *(here->VBICemitBasePtr) += -gqbeo;
+    /*
+     *  load current excitation vector and matrix
+     */
+    rhs_current = model->VBICtype * (*(ckt->CKTstate0 + here->VBICcqbeo) - Vbe * gqbeo);
+    CKTstampRhs(st, here->VBICbaseNode, -rhs_current);
+    CKTstampRhs(st, here->VBICemitNode, rhs_current);
+    CKTstampMat(st, here->VBICbaseBasePtr, gqbeo);
+    CKTstampMat(st, here->VBICemitEmitPtr, gqbeo);
+    CKTstampMat(st, here->VBICbaseEmitPtr, -gqbeo);
+    CKTstampMat(st, here->VBICemitBasePtr, -gqbeo);
 
-            rhs_current = model->VBICtype * (*(ckt->CKTstate0 + here->VBICcqbco) - Vbc * gqbco);
-            *(ckt->CKTrhs + here->VBICbaseNode) += -rhs_current;
-            *(ckt->CKTrhs + here->VBICcollNode) +=  rhs_current;
-            *(here->VBICbaseBasePtr) +=  gqbco;
-            *(here->VBICcollCollPtr) +=  gqbco;
-            *(here->VBICbaseCollPtr) += -gqbco;
-            *(here->VBICcollBasePtr) += -gqbco;
+    rhs_current = model->VBICtype * (*(ckt->CKTstate0 + here->VBICcqbco) - Vbc * gqbco);
+    CKTstampRhs(st, here->VBICbaseNode, -rhs_current);
+    CKTstampRhs(st, here->VBICcollNode, rhs_current);
+    CKTstampMat(st, here->VBICbaseBasePtr, gqbco);
+    CKTstampMat(st, here->VBICcollCollPtr, gqbco);
+    CKTstampMat(st, here->VBICbaseCollPtr, -gqbco);
+    CKTstampMat(st, here->VBICcollBasePtr, -gqbco);
 
-            *(ckt->CKTrhs + here->VBICbaseBINode) += -cbcx;
-            *(ckt->CKTrhs + here->VBICcollCXNode) +=  cbcx;
-            *(here->VBICbaseBIBaseBIPtr) +=  gbcx;
-            *(here->VBICcollCXCollCXPtr) +=  gbcx;
-            *(here->VBICbaseBICollCXPtr) += -gbcx;
-            *(here->VBICcollCXBaseBIPtr) += -gbcx;
+    CKTstampRhs(st, here->VBICbaseBINode, -cbcx);
+    CKTstampRhs(st, here->VBICcollCXNode, cbcx);
+    CKTstampMat(st, here->VBICbaseBIBaseBIPtr, gbcx);
+    CKTstampMat(st, here->VBICcollCXCollCXPtr, gbcx);
+    CKTstampMat(st, here->VBICbaseBICollCXPtr, -gbcx);
+    CKTstampMat(st, here->VBICcollCXBaseBIPtr, -gbcx);
 
 /*
 c           KCL at internal nodes
 c
 c           Stamp element: Ibe
 */
-            rhs_current = model->VBICtype * (Ibe - Ibe_Vbei*Vbei);
-            *(ckt->CKTrhs + here->VBICbaseBINode) += -rhs_current;
-            *(here->VBICbaseBIBaseBIPtr) +=  Ibe_Vbei;
-            *(here->VBICbaseBIEmitEIPtr) += -Ibe_Vbei;
-            *(ckt->CKTrhs + here->VBICemitEINode) +=  rhs_current;
-            *(here->VBICemitEIBaseBIPtr) += -Ibe_Vbei;
-            *(here->VBICemitEIEmitEIPtr) +=  Ibe_Vbei;
+    rhs_current = model->VBICtype * (Ibe - Ibe_Vbei*Vbei);
+    CKTstampRhs(st, here->VBICbaseBINode, -rhs_current);
+    CKTstampMat(st, here->VBICbaseBIBaseBIPtr, Ibe_Vbei);
+    CKTstampMat(st, here->VBICbaseBIEmitEIPtr, -Ibe_Vbei);
+    CKTstampRhs(st, here->VBICemitEINode, rhs_current);
+    CKTstampMat(st, here->VBICemitEIBaseBIPtr, -Ibe_Vbei);
+    CKTstampMat(st, here->VBICemitEIEmitEIPtr, Ibe_Vbei);
 /*
 c           Stamp element: Ibex
 */
-            rhs_current = model->VBICtype * (Ibex - Ibex_Vbex*Vbex);
-            *(ckt->CKTrhs + here->VBICbaseBXNode) += -rhs_current;
-            *(here->VBICbaseBXBaseBXPtr) +=  Ibex_Vbex;
-            *(here->VBICbaseBXEmitEIPtr) += -Ibex_Vbex;
-            *(ckt->CKTrhs + here->VBICemitEINode) +=  rhs_current;
-            *(here->VBICemitEIBaseBXPtr) += -Ibex_Vbex;
-            *(here->VBICemitEIEmitEIPtr) +=  Ibex_Vbex;
+    rhs_current = model->VBICtype * (Ibex - Ibex_Vbex*Vbex);
+    CKTstampRhs(st, here->VBICbaseBXNode, -rhs_current);
+    CKTstampMat(st, here->VBICbaseBXBaseBXPtr, Ibex_Vbex);
+    CKTstampMat(st, here->VBICbaseBXEmitEIPtr, -Ibex_Vbex);
+    CKTstampRhs(st, here->VBICemitEINode, rhs_current);
+    CKTstampMat(st, here->VBICemitEIBaseBXPtr, -Ibex_Vbex);
+    CKTstampMat(st, here->VBICemitEIEmitEIPtr, Ibex_Vbex);
 
 /*
 c           Stamp element: Itzf
 */
-            rhs_current = model->VBICtype * (Itzf - Itzf_Vbei*Vbei - Itzf_Vbci*Vbci);
-            *(ckt->CKTrhs + here->VBICcollCINode) += -rhs_current;
-            *(here->VBICcollCIBaseBIPtr) +=  Itzf_Vbei;
-            *(here->VBICcollCIEmitEIPtr) += -Itzf_Vbei;
-            *(here->VBICcollCIBaseBIPtr) +=  Itzf_Vbci;
-            *(here->VBICcollCICollCIPtr) += -Itzf_Vbci;
-            *(ckt->CKTrhs + here->VBICemitEINode) +=  rhs_current;
-            *(here->VBICemitEIBaseBIPtr) += -Itzf_Vbei;
-            *(here->VBICemitEIEmitEIPtr) +=  Itzf_Vbei;
-            *(here->VBICemitEIBaseBIPtr) += -Itzf_Vbci;
-            *(here->VBICemitEICollCIPtr) +=  Itzf_Vbci;
+    rhs_current = model->VBICtype * (Itzf - Itzf_Vbei*Vbei - Itzf_Vbci*Vbci);
+    CKTstampRhs(st, here->VBICcollCINode, -rhs_current);
+    CKTstampMat(st, here->VBICcollCIBaseBIPtr, Itzf_Vbei);
+    CKTstampMat(st, here->VBICcollCIEmitEIPtr, -Itzf_Vbei);
+    CKTstampMat(st, here->VBICcollCIBaseBIPtr, Itzf_Vbci);
+    CKTstampMat(st, here->VBICcollCICollCIPtr, -Itzf_Vbci);
+    CKTstampRhs(st, here->VBICemitEINode, rhs_current);
+    CKTstampMat(st, here->VBICemitEIBaseBIPtr, -Itzf_Vbei);
+    CKTstampMat(st, here->VBICemitEIEmitEIPtr, Itzf_Vbei);
+    CKTstampMat(st, here->VBICemitEIBaseBIPtr, -Itzf_Vbci);
+    CKTstampMat(st, here->VBICemitEICollCIPtr, Itzf_Vbci);
 /*
 c           Stamp element: Itzr
 */
-            rhs_current = model->VBICtype * (Itzr - Itzr_Vbei*Vbei - Itzr_Vbci*Vbci);
-            *(ckt->CKTrhs + here->VBICemitEINode) += -rhs_current;
-            *(here->VBICemitEIBaseBIPtr) +=  Itzr_Vbei;
-            *(here->VBICemitEIEmitEIPtr) += -Itzr_Vbei;
-            *(here->VBICemitEIBaseBIPtr) +=  Itzr_Vbci;
-            *(here->VBICemitEICollCIPtr) += -Itzr_Vbci;
-            *(ckt->CKTrhs + here->VBICcollCINode) +=  rhs_current;
-            *(here->VBICcollCIBaseBIPtr) += -Itzr_Vbei;
-            *(here->VBICcollCIEmitEIPtr) +=  Itzr_Vbei;
-            *(here->VBICcollCIBaseBIPtr) += -Itzr_Vbci;
-            *(here->VBICcollCICollCIPtr) +=  Itzr_Vbci;
+    rhs_current = model->VBICtype * (Itzr - Itzr_Vbei*Vbei - Itzr_Vbci*Vbci);
+    CKTstampRhs(st, here->VBICemitEINode, -rhs_current);
+    CKTstampMat(st, here->VBICemitEIBaseBIPtr, Itzr_Vbei);
+    CKTstampMat(st, here->VBICemitEIEmitEIPtr, -Itzr_Vbei);
+    CKTstampMat(st, here->VBICemitEIBaseBIPtr, Itzr_Vbci);
+    CKTstampMat(st, here->VBICemitEICollCIPtr, -Itzr_Vbci);
+    CKTstampRhs(st, here->VBICcollCINode, rhs_current);
+    CKTstampMat(st, here->VBICcollCIBaseBIPtr, -Itzr_Vbei);
+    CKTstampMat(st, here->VBICcollCIEmitEIPtr, Itzr_Vbei);
+    CKTstampMat(st, here->VBICcollCIBaseBIPtr, -Itzr_Vbci);
+    CKTstampMat(st, here->VBICcollCICollCIPtr, Itzr_Vbci);
 /*
 c           Stamp element: Ibc
 */
-            rhs_current = model->VBICtype * (Ibc - Ibc_Vbci*Vbci - Ibc_Vbei*Vbei);
-            *(ckt->CKTrhs + here->VBICbaseBINode) += -rhs_current;
-            *(here->VBICbaseBIBaseBIPtr) +=  Ibc_Vbci;
-            *(here->VBICbaseBICollCIPtr) += -Ibc_Vbci;
-            *(here->VBICbaseBIBaseBIPtr) +=  Ibc_Vbei;
-            *(here->VBICbaseBIEmitEIPtr) += -Ibc_Vbei;
-            *(ckt->CKTrhs + here->VBICcollCINode) +=  rhs_current;
-            *(here->VBICcollCIBaseBIPtr) += -Ibc_Vbci;
-            *(here->VBICcollCICollCIPtr) +=  Ibc_Vbci;
-            *(here->VBICcollCIBaseBIPtr) += -Ibc_Vbei;
-            *(here->VBICcollCIEmitEIPtr) +=  Ibc_Vbei;
+    rhs_current = model->VBICtype * (Ibc - Ibc_Vbci*Vbci - Ibc_Vbei*Vbei);
+    CKTstampRhs(st, here->VBICbaseBINode, -rhs_current);
+    CKTstampMat(st, here->VBICbaseBIBaseBIPtr, Ibc_Vbci);
+    CKTstampMat(st, here->VBICbaseBICollCIPtr, -Ibc_Vbci);
+    CKTstampMat(st, here->VBICbaseBIBaseBIPtr, Ibc_Vbei);
+    CKTstampMat(st, here->VBICbaseBIEmitEIPtr, -Ibc_Vbei);
+    CKTstampRhs(st, here->VBICcollCINode, rhs_current);
+    CKTstampMat(st, here->VBICcollCIBaseBIPtr, -Ibc_Vbci);
+    CKTstampMat(st, here->VBICcollCICollCIPtr, Ibc_Vbci);
+    CKTstampMat(st, here->VBICcollCIBaseBIPtr, -Ibc_Vbei);
+    CKTstampMat(st, here->VBICcollCIEmitEIPtr, Ibc_Vbei);
 /*
 c           Stamp element: Ibep
 */
-            rhs_current = model->VBICtype * (Ibep - Ibep_Vbep*Vbep);
-            *(ckt->CKTrhs + here->VBICbaseBXNode) += -rhs_current;
-            *(here->VBICbaseBXBaseBXPtr) +=  Ibep_Vbep;
-            *(here->VBICbaseBXBaseBPPtr) += -Ibep_Vbep;
-            *(ckt->CKTrhs + here->VBICbaseBPNode) +=  rhs_current;
-            *(here->VBICbaseBPBaseBXPtr) += -Ibep_Vbep;
-            *(here->VBICbaseBPBaseBPPtr) +=  Ibep_Vbep;
+    rhs_current = model->VBICtype * (Ibep - Ibep_Vbep*Vbep);
+    CKTstampRhs(st, here->VBICbaseBXNode, -rhs_current);
+    CKTstampMat(st, here->VBICbaseBXBaseBXPtr, Ibep_Vbep);
+    CKTstampMat(st, here->VBICbaseBXBaseBPPtr, -Ibep_Vbep);
+    CKTstampRhs(st, here->VBICbaseBPNode, rhs_current);
+    CKTstampMat(st, here->VBICbaseBPBaseBXPtr, -Ibep_Vbep);
+    CKTstampMat(st, here->VBICbaseBPBaseBPPtr, Ibep_Vbep);
 /*
 c           Stamp element: Rcx
 */
-            *(here->VBICcollCollPtr) +=  Ircx_Vrcx;
-            *(here->VBICcollCXCollCXPtr) +=  Ircx_Vrcx;
-            *(here->VBICcollCXCollPtr) +=  -Ircx_Vrcx;
-            *(here->VBICcollCollCXPtr) +=  -Ircx_Vrcx;
+    CKTstampMat(st, here->VBICcollCollPtr, Ircx_Vrcx);
+    CKTstampMat(st, here->VBICcollCXCollCXPtr, Ircx_Vrcx);
+    CKTstampMat(st, here->VBICcollCXCollPtr, -Ircx_Vrcx);
+    CKTstampMat(st, here->VBICcollCollCXPtr, -Ircx_Vrcx);
 /*
 c           Stamp element: Irci
 */
-            rhs_current = model->VBICtype * (Irci - Irci_Vrci*Vrci - Irci_Vbci*Vbci - Irci_Vbcx*Vbcx);
-            *(ckt->CKTrhs + here->VBICcollCXNode) += -rhs_current;
-            *(here->VBICcollCXCollCXPtr) +=  Irci_Vrci;
-            *(here->VBICcollCXCollCIPtr) += -Irci_Vrci;
-            *(here->VBICcollCXBaseBIPtr) +=  Irci_Vbci;
-            *(here->VBICcollCXCollCIPtr) += -Irci_Vbci;
-            *(here->VBICcollCXBaseBIPtr) +=  Irci_Vbcx;
-            *(here->VBICcollCXCollCXPtr) += -Irci_Vbcx;
-            *(ckt->CKTrhs + here->VBICcollCINode) +=  rhs_current;
-            *(here->VBICcollCICollCXPtr) += -Irci_Vrci;
-            *(here->VBICcollCICollCIPtr) +=  Irci_Vrci;
-            *(here->VBICcollCIBaseBIPtr) += -Irci_Vbci;
-            *(here->VBICcollCICollCIPtr) +=  Irci_Vbci;
-            *(here->VBICcollCIBaseBIPtr) += -Irci_Vbcx;
-            *(here->VBICcollCICollCXPtr) +=  Irci_Vbcx;
+    rhs_current = model->VBICtype * (Irci - Irci_Vrci*Vrci - Irci_Vbci*Vbci - Irci_Vbcx*Vbcx);
+    CKTstampRhs(st, here->VBICcollCXNode, -rhs_current);
+    CKTstampMat(st, here->VBICcollCXCollCXPtr, Irci_Vrci);
+    CKTstampMat(st, here->VBICcollCXCollCIPtr, -Irci_Vrci);
+    CKTstampMat(st, here->VBICcollCXBaseBIPtr, Irci_Vbci);
+    CKTstampMat(st, here->VBICcollCXCollCIPtr, -Irci_Vbci);
+    CKTstampMat(st, here->VBICcollCXBaseBIPtr, Irci_Vbcx);
+    CKTstampMat(st, here->VBICcollCXCollCXPtr, -Irci_Vbcx);
+    CKTstampRhs(st, here->VBICcollCINode, rhs_current);
+    CKTstampMat(st, here->VBICcollCICollCXPtr, -Irci_Vrci);
+    CKTstampMat(st, here->VBICcollCICollCIPtr, Irci_Vrci);
+    CKTstampMat(st, here->VBICcollCIBaseBIPtr, -Irci_Vbci);
+    CKTstampMat(st, here->VBICcollCICollCIPtr, Irci_Vbci);
+    CKTstampMat(st, here->VBICcollCIBaseBIPtr, -Irci_Vbcx);
+    CKTstampMat(st, here->VBICcollCICollCXPtr, Irci_Vbcx);
 /*
 c           Stamp element: Rbx
 */
-            *(here->VBICbaseBasePtr) +=  Irbx_Vrbx;
-            *(here->VBICbaseBXBaseBXPtr) +=  Irbx_Vrbx;
-            *(here->VBICbaseBXBasePtr) += -Irbx_Vrbx;
-            *(here->VBICbaseBaseBXPtr) += -Irbx_Vrbx;
+    CKTstampMat(st, here->VBICbaseBasePtr, Irbx_Vrbx);
+    CKTstampMat(st, here->VBICbaseBXBaseBXPtr, Irbx_Vrbx);
+    CKTstampMat(st, here->VBICbaseBXBasePtr, -Irbx_Vrbx);
+    CKTstampMat(st, here->VBICbaseBaseBXPtr, -Irbx_Vrbx);
 /*
 c           Stamp element: Irbi
 */
-            rhs_current = model->VBICtype * (Irbi - Irbi_Vrbi*Vrbi - Irbi_Vbei*Vbei - Irbi_Vbci*Vbci);
-            *(ckt->CKTrhs + here->VBICbaseBXNode) += -rhs_current;
-            *(here->VBICbaseBXBaseBXPtr) +=  Irbi_Vrbi;
-            *(here->VBICbaseBXBaseBIPtr) += -Irbi_Vrbi;
-            *(here->VBICbaseBXBaseBIPtr) +=  Irbi_Vbei;
-            *(here->VBICbaseBXEmitEIPtr) += -Irbi_Vbei;
-            *(here->VBICbaseBXBaseBIPtr) +=  Irbi_Vbci;
-            *(here->VBICbaseBXCollCIPtr) += -Irbi_Vbci;
-            *(ckt->CKTrhs + here->VBICbaseBINode) +=  rhs_current;
-            *(here->VBICbaseBIBaseBXPtr) += -Irbi_Vrbi;
-            *(here->VBICbaseBIBaseBIPtr) +=  Irbi_Vrbi;
-            *(here->VBICbaseBIBaseBIPtr) += -Irbi_Vbei;
-            *(here->VBICbaseBIEmitEIPtr) +=  Irbi_Vbei;
-            *(here->VBICbaseBIBaseBIPtr) += -Irbi_Vbci;
-            *(here->VBICbaseBICollCIPtr) +=  Irbi_Vbci;
+    rhs_current = model->VBICtype * (Irbi - Irbi_Vrbi*Vrbi - Irbi_Vbei*Vbei - Irbi_Vbci*Vbci);
+    CKTstampRhs(st, here->VBICbaseBXNode, -rhs_current);
+    CKTstampMat(st, here->VBICbaseBXBaseBXPtr, Irbi_Vrbi);
+    CKTstampMat(st, here->VBICbaseBXBaseBIPtr, -Irbi_Vrbi);
+    CKTstampMat(st, here->VBICbaseBXBaseBIPtr, Irbi_Vbei);
+    CKTstampMat(st, here->VBICbaseBXEmitEIPtr, -Irbi_Vbei);
+    CKTstampMat(st, here->VBICbaseBXBaseBIPtr, Irbi_Vbci);
+    CKTstampMat(st, here->VBICbaseBXCollCIPtr, -Irbi_Vbci);
+    CKTstampRhs(st, here->VBICbaseBINode, rhs_current);
+    CKTstampMat(st, here->VBICbaseBIBaseBXPtr, -Irbi_Vrbi);
+    CKTstampMat(st, here->VBICbaseBIBaseBIPtr, Irbi_Vrbi);
+    CKTstampMat(st, here->VBICbaseBIBaseBIPtr, -Irbi_Vbei);
+    CKTstampMat(st, here->VBICbaseBIEmitEIPtr, Irbi_Vbei);
+    CKTstampMat(st, here->VBICbaseBIBaseBIPtr, -Irbi_Vbci);
+    CKTstampMat(st, here->VBICbaseBICollCIPtr, Irbi_Vbci);
 /*
 c           Stamp element: Re
 */
-            *(here->VBICemitEmitPtr) +=  Ire_Vre;
-            *(here->VBICemitEIEmitEIPtr) +=  Ire_Vre;
-            *(here->VBICemitEIEmitPtr) += -Ire_Vre;
-            *(here->VBICemitEmitEIPtr) += -Ire_Vre;
+    CKTstampMat(st, here->VBICemitEmitPtr, Ire_Vre);
+    CKTstampMat(st, here->VBICemitEIEmitEIPtr, Ire_Vre);
+    CKTstampMat(st, here->VBICemitEIEmitPtr, -Ire_Vre);
+    CKTstampMat(st, here->VBICemitEmitEIPtr, -Ire_Vre);
 /*
 c           Stamp element: Irbp
 */
-            rhs_current = model->VBICtype * (Irbp - Irbp_Vrbp*Vrbp - Irbp_Vbep*Vbep - Irbp_Vbci*Vbci);
-            *(ckt->CKTrhs + here->VBICbaseBPNode) += -rhs_current;
-            *(here->VBICbaseBPBaseBPPtr) +=  Irbp_Vrbp;
-            *(here->VBICbaseBPCollCXPtr) += -Irbp_Vrbp;
-            *(here->VBICbaseBPBaseBXPtr) +=  Irbp_Vbep;
-            *(here->VBICbaseBPBaseBPPtr) += -Irbp_Vbep;
-            *(here->VBICbaseBPBaseBIPtr) +=  Irbp_Vbci;
-            *(here->VBICbaseBPCollCIPtr) += -Irbp_Vbci;
-            *(ckt->CKTrhs + here->VBICcollCXNode) +=  rhs_current;
-            *(here->VBICcollCXBaseBPPtr) += -Irbp_Vrbp;
-            *(here->VBICcollCXCollCXPtr) +=  Irbp_Vrbp;
-            *(here->VBICcollCXBaseBXPtr) += -Irbp_Vbep;
-            *(here->VBICcollCXBaseBPPtr) +=  Irbp_Vbep;
-            *(here->VBICcollCXBaseBIPtr) += -Irbp_Vbci;
-            *(here->VBICcollCXCollCIPtr) +=  Irbp_Vbci;
+    rhs_current = model->VBICtype * (Irbp - Irbp_Vrbp*Vrbp - Irbp_Vbep*Vbep - Irbp_Vbci*Vbci);
+    CKTstampRhs(st, here->VBICbaseBPNode, -rhs_current);
+    CKTstampMat(st, here->VBICbaseBPBaseBPPtr, Irbp_Vrbp);
+    CKTstampMat(st, here->VBICbaseBPCollCXPtr, -Irbp_Vrbp);
+    CKTstampMat(st, here->VBICbaseBPBaseBXPtr, Irbp_Vbep);
+    CKTstampMat(st, here->VBICbaseBPBaseBPPtr, -Irbp_Vbep);
+    CKTstampMat(st, here->VBICbaseBPBaseBIPtr, Irbp_Vbci);
+    CKTstampMat(st, here->VBICbaseBPCollCIPtr, -Irbp_Vbci);
+    CKTstampRhs(st, here->VBICcollCXNode, rhs_current);
+    CKTstampMat(st, here->VBICcollCXBaseBPPtr, -Irbp_Vrbp);
+    CKTstampMat(st, here->VBICcollCXCollCXPtr, Irbp_Vrbp);
+    CKTstampMat(st, here->VBICcollCXBaseBXPtr, -Irbp_Vbep);
+    CKTstampMat(st, here->VBICcollCXBaseBPPtr, Irbp_Vbep);
+    CKTstampMat(st, here->VBICcollCXBaseBIPtr, -Irbp_Vbci);
+    CKTstampMat(st, here->VBICcollCXCollCIPtr, Irbp_Vbci);
 /*
 c           Stamp element: Ibcp
 */
-            rhs_current = model->VBICtype * (Ibcp - Ibcp_Vbcp*Vbcp);
-            *(ckt->CKTrhs + here->VBICsubsSINode) += -rhs_current;
-            *(here->VBICsubsSISubsSIPtr) +=  Ibcp_Vbcp;
-            *(here->VBICsubsSIBaseBPPtr) += -Ibcp_Vbcp;
-            *(ckt->CKTrhs + here->VBICbaseBPNode) +=  rhs_current;
-            *(here->VBICbaseBPSubsSIPtr) += -Ibcp_Vbcp;
-            *(here->VBICbaseBPBaseBPPtr) +=  Ibcp_Vbcp;
+    rhs_current = model->VBICtype * (Ibcp - Ibcp_Vbcp*Vbcp);
+    CKTstampRhs(st, here->VBICsubsSINode, -rhs_current);
+    CKTstampMat(st, here->VBICsubsSISubsSIPtr, Ibcp_Vbcp);
+    CKTstampMat(st, here->VBICsubsSIBaseBPPtr, -Ibcp_Vbcp);
+    CKTstampRhs(st, here->VBICbaseBPNode, rhs_current);
+    CKTstampMat(st, here->VBICbaseBPSubsSIPtr, -Ibcp_Vbcp);
+    CKTstampMat(st, here->VBICbaseBPBaseBPPtr, Ibcp_Vbcp);
 /*
 c           Stamp element: Iccp
 */
-            rhs_current = model->VBICtype * (Iccp - Iccp_Vbep*Vbep - Iccp_Vbci*Vbci - Iccp_Vbcp*Vbcp);
-            *(ckt->CKTrhs + here->VBICbaseBXNode) += -rhs_current;
-            *(here->VBICbaseBXBaseBXPtr) +=  Iccp_Vbep;
-            *(here->VBICbaseBXBaseBPPtr) += -Iccp_Vbep;
-            *(here->VBICbaseBXBaseBIPtr) +=  Iccp_Vbci;
-            *(here->VBICbaseBXCollCIPtr) += -Iccp_Vbci;
-            *(here->VBICbaseBXSubsSIPtr) +=  Iccp_Vbcp;
-            *(here->VBICbaseBXBaseBPPtr) += -Iccp_Vbcp;
-            *(ckt->CKTrhs + here->VBICsubsSINode) +=  rhs_current;
-            *(here->VBICsubsSIBaseBXPtr) += -Iccp_Vbep;
-            *(here->VBICsubsSIBaseBPPtr) +=  Iccp_Vbep;
-            *(here->VBICsubsSIBaseBIPtr) += -Iccp_Vbci;
-            *(here->VBICsubsSICollCIPtr) +=  Iccp_Vbci;
-            *(here->VBICsubsSISubsSIPtr) += -Iccp_Vbcp;
-            *(here->VBICsubsSIBaseBPPtr) +=  Iccp_Vbcp;
+    rhs_current = model->VBICtype * (Iccp - Iccp_Vbep*Vbep - Iccp_Vbci*Vbci - Iccp_Vbcp*Vbcp);
+    CKTstampRhs(st, here->VBICbaseBXNode, -rhs_current);
+    CKTstampMat(st, here->VBICbaseBXBaseBXPtr, Iccp_Vbep);
+    CKTstampMat(st, here->VBICbaseBXBaseBPPtr, -Iccp_Vbep);
+    CKTstampMat(st, here->VBICbaseBXBaseBIPtr, Iccp_Vbci);
+    CKTstampMat(st, here->VBICbaseBXCollCIPtr, -Iccp_Vbci);
+    CKTstampMat(st, here->VBICbaseBXSubsSIPtr, Iccp_Vbcp);
+    CKTstampMat(st, here->VBICbaseBXBaseBPPtr, -Iccp_Vbcp);
+    CKTstampRhs(st, here->VBICsubsSINode, rhs_current);
+    CKTstampMat(st, here->VBICsubsSIBaseBXPtr, -Iccp_Vbep);
+    CKTstampMat(st, here->VBICsubsSIBaseBPPtr, Iccp_Vbep);
+    CKTstampMat(st, here->VBICsubsSIBaseBIPtr, -Iccp_Vbci);
+    CKTstampMat(st, here->VBICsubsSICollCIPtr, Iccp_Vbci);
+    CKTstampMat(st, here->VBICsubsSISubsSIPtr, -Iccp_Vbcp);
+    CKTstampMat(st, here->VBICsubsSIBaseBPPtr, Iccp_Vbcp);
 /*
 c           Stamp element: Rs
 */
-            *(here->VBICsubsSubsPtr) +=  Irs_Vrs;
-            *(here->VBICsubsSISubsSIPtr) +=  Irs_Vrs;
-            *(here->VBICsubsSISubsPtr) += -Irs_Vrs;
-            *(here->VBICsubsSubsSIPtr) += -Irs_Vrs;
+    CKTstampMat(st, here->VBICsubsSubsPtr, Irs_Vrs);
+    CKTstampMat(st, here->VBICsubsSISubsSIPtr, Irs_Vrs);
+    CKTstampMat(st, here->VBICsubsSISubsPtr, -Irs_Vrs);
+    CKTstampMat(st, here->VBICsubsSubsSIPtr, -Irs_Vrs);
 
-        }
-
-    }
     return(OK);
 }
 
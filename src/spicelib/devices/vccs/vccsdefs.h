@@ -64,6 +64,8 @@ typedef struct sVCCSmodel {       /* model structure for a source */
 
     /* --- end of generic struct GENmodel --- */
 
+
+    CKTlinear *VCCSlinear;   /* the instances in arrays, for the load */
 } VCCSmodel;
 
 /* device parameters */
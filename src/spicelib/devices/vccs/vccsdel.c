@@ -6,6 +6,7 @@ Author: 1985 Thomas L. Quarles
  */
 
 #include "ngspice/ngspice.h"
+#include "ngspice/cktlinear.h"
 #include "vccsdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -24,6 +25,7 @@ VCCSdelete(GENmodel *inModel, IFuid name, GENinstance **inst)
         for(here = *prev; here ; here = *prev) {
             if(here->VCCSname == name || (fast && here==*fast) ) {
                 *prev= here->VCCSnextInstance;
+                CKTlinearFree(&model->VCCSlinear);
                 FREE(here);
                 return(OK);
             }
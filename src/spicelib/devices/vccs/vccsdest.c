@@ -6,6 +6,7 @@ Author: 1985 Thomas L. Quarles
  */
 
 #include "ngspice/ngspice.h"
+#include "ngspice/cktlinear.h"
 #include "vccsdefs.h"
 #include "ngspice/suffix.h"
 
@@ -22,6 +23,7 @@ VCCSdestroy(GENmodel **inModel)
     for( ; mod ; mod = mod->VCCSnextModel) {
         if(oldmod) FREE(oldmod);
         oldmod = mod;
+        CKTlinearFree(&mod->VCCSlinear);
         prev = NULL;
         for(here = mod->VCCSinstances ; here ; here = here->VCCSnextInstance) {
             if(prev) FREE(prev);
@@ -73,7 +73,10 @@ SPICEdev VCCSinfo = {
  /* DEVacct       */ NULL,
 #endif                        
  /* DEVinstSize   */ &VCCSiSize,
- /* DEVmodSize    */ &VCCSmSize
+ /* DEVmodSize    */ &VCCSmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 
 };
@@ -7,11 +7,45 @@ Author: 1985 Thomas L. Quarles
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktlinear.h"
 #include "vccsdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
 
 
+/* copy the coefficients and matrix pointers of the instances of a
+ * model into arrays */
+static CKTlinear *
+VCCSlinearMake(VCCSmodel *model)
+{
+    VCCSinstance *here;
+    CKTlinear *lin;
+    double **elt;
+    int k;
+
+    k = 0;
+    for (here = model->VCCSinstances; here != NULL ;
+            here=here->VCCSnextInstance)
+        k++;
+
+    lin = CKTlinearNew(k, 4);
+    elt = lin->elt;
+
+    /* the stamp of a conductance from the controlling nodes */
+    k = 0;
+    for (here = model->VCCSinstances; here != NULL ;
+            here=here->VCCSnextInstance) {
+        lin->val[k++] = here->VCCScoeff;
+        *elt++ = here->VCCSposContPosptr;
+        *elt++ = here->VCCSnegContNegptr;
+        *elt++ = here->VCCSposContNegptr;
+        *elt++ = here->VCCSnegContPosptr;
+    }
+
+    return lin;
+}
+
+
 /*ARGSUSED*/
 int
 VCCSload(GENmodel *inModel, CKTcircuit *ckt)
@@ -20,22 +54,14 @@ VCCSload(GENmodel *inModel, CKTcircuit *ckt)
          */
 {
     VCCSmodel *model = (VCCSmodel *)inModel;
-    VCCSinstance *here;
 
     NG_IGNORE(ckt);
 
     /*  loop through all the source models */
     for( ; model != NULL; model = model->VCCSnextModel ) {
-
-        /* loop through all the instances of the model */
-        for (here = model->VCCSinstances; here != NULL ;
-                here=here->VCCSnextInstance) {
-            
-            *(here->VCCSposContPosptr) += here->VCCScoeff ;
-            *(here->VCCSposContNegptr) -= here->VCCScoeff ;
-            *(here->VCCSnegContPosptr) -= here->VCCScoeff ;
-            *(here->VCCSnegContNegptr) += here->VCCScoeff ;
-        }
+        if (!model->VCCSlinear)
+            model->VCCSlinear = VCCSlinearMake(model);
+        CKTlinearStamp(model->VCCSlinear);
     }
     return(OK);
 }
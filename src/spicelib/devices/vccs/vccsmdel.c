@@ -6,6 +6,7 @@ Author: 1985 Thomas L. Quarles
  */
 
 #include "ngspice/ngspice.h"
+#include "ngspice/cktlinear.h"
 #include "vccsdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -34,6 +35,7 @@ delgot:
         prev = here;
     }
     if(prev) FREE(prev);
+    CKTlinearFree(&(*model)->VCCSlinear);
     FREE(*model);
     return(OK);
 
@@ -12,6 +12,7 @@ Author: 1985 Thomas L. Quarles
 #include "ngspice/ngspice.h"
 #include "ngspice/smpdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktlinear.h"
 #include "vccsdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -30,6 +31,8 @@ VCCSsetup(SMPmatrix *matrix, GENmodel *inModel, CKTcircuit *ckt, int *states)
     /*  loop through all the current source models */
     for( ; model != NULL; model = model->VCCSnextModel ) {
 
+        CKTlinearFree(&model->VCCSlinear);
+
         /* loop through all the instances of the model */
         for (here = model->VCCSinstances; here != NULL ;
                 here=here->VCCSnextInstance) {
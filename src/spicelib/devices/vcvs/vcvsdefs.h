@@ -68,6 +68,8 @@ typedef struct sVCVSmodel {       /* model structure for a source */
 
     /* --- end of generic struct GENmodel --- */
 
+
+    CKTlinear *VCVSlinear;   /* the instances in arrays, for the load */
 } VCVSmodel;
 
 /* device parameters */
@@ -6,6 +6,7 @@ Author: 1985 Thomas L. Quarles
  */
 
 #include "ngspice/ngspice.h"
+#include "ngspice/cktlinear.h"
 #include "vcvsdefs.h"
 #include "ngspice/suffix.h"
 
@@ -22,6 +23,7 @@ VCVSdestroy(GENmodel **inModel)
     for( ; mod ; mod = mod->VCVSnextModel) {
         if(oldmod) FREE(oldmod);
         oldmod = mod;
+        CKTlinearFree(&mod->VCVSlinear);
         prev = NULL;
         for(here = mod->VCVSinstances ; here ; here = here->VCVSnextInstance) {
             if(prev) FREE(prev);
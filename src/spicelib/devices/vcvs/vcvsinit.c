@@ -73,7 +73,10 @@ SPICEdev VCVSinfo = {
  /* DEVacct       */ NULL,
 #endif                          
  /* DEVinstSize   */ &VCVSiSize,
- /* DEVmodSize    */ &VCVSmSize
+ /* DEVmodSize    */ &VCVSmSize,
+ /* DEVloadInst   */ NULL,
+ /* DEVstampMat   */ 0,
+ /* DEVstampRhs   */ 0
 
 };
 
@@ -7,11 +7,46 @@ Author: 1985 Thomas L. Quarles
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktlinear.h"
 #include "vcvsdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
 
 
+/* copy the coefficients and matrix pointers of the instances of a
+ * model into arrays */
+static CKTlinear *
+VCVSlinearMake(VCVSmodel *model)
+{
+    VCVSinstance *here;
+    CKTlinear *lin;
+    double **elt;
+    int k;
+
+    k = 0;
+    for (here = model->VCVSinstances; here != NULL ;
+            here=here->VCVSnextInstance)
+        k++;
+
+    lin = CKTlinearNew(k, 6);
+    elt = lin->elt;
+
+    k = 0;
+    for (here = model->VCVSinstances; here != NULL ;
+            here=here->VCVSnextInstance) {
+        lin->val[k++] = here->VCVScoeff;
+        *elt++ = here->VCVSposIbrptr;
+        *elt++ = here->VCVSnegIbrptr;
+        *elt++ = here->VCVSibrPosptr;
+        *elt++ = here->VCVSibrNegptr;
+        *elt++ = here->VCVSibrContPosptr;
+        *elt++ = here->VCVSibrContNegptr;
+    }
+
+    return lin;
+}
+
+
 /*ARGSUSED*/
 int
 VCVSload(GENmodel *inModel, CKTcircuit *ckt)
@@ -20,23 +55,27 @@ VCVSload(GENmodel *inModel, CKTcircuit *ckt)
          */
 {
     VCVSmodel *model = (VCVSmodel *)inModel;
-    VCVSinstance *here;
+    CKTlinear *lin;
+    double **elt;
+    int k;
 
     NG_IGNORE(ckt);
 
     /*  loop through all the voltage source models */
     for( ; model != NULL; model = model->VCVSnextModel ) {
 
-        /* loop through all the instances of the model */
-        for (here = model->VCVSinstances; here != NULL ;
-                here=here->VCVSnextInstance) {
-            
-            *(here->VCVSposIbrptr) += 1.0 ;
-            *(here->VCVSnegIbrptr) -= 1.0 ;
-            *(here->VCVSibrPosptr) += 1.0 ;
-            *(here->VCVSibrNegptr) -= 1.0 ;
-            *(here->VCVSibrContPosptr) -= here->VCVScoeff ;
-            *(here->VCVSibrContNegptr) += here->VCVScoeff ;
+        if (!model->VCVSlinear)
+            model->VCVSlinear = VCVSlinearMake(model);
+        lin = model->VCVSlinear;
+
+        elt = lin->elt;
+        for (k = 0; k < lin->count; k++, elt += 6) {
+            *(elt[0]) += 1.0 ;
+            *(elt[1]) -= 1.0 ;
+            *(elt[2]) += 1.0 ;
+            *(elt[3]) -= 1.0 ;
+            *(elt[4]) -= lin->val[k] ;
+            *(elt[5]) += lin->val[k] ;
         }
     }
     return(OK);
@@ -7,6 +7,7 @@ Author: 1985 Thomas L. Quarles
 
 #include "ngspice/ngspice.h"
 #include "ngspice/ifsim.h"
+#include "ngspice/cktlinear.h"
 #include "vcvsdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -20,6 +21,9 @@ VCVSparam(int param, IFvalue *value, GENinstance *inst, IFvalue *select)
 
     NG_IGNORE(select);
 
+    /* the load has its own copy of the parameters */
+    CKTlinearFree(&here->VCVSmodPtr->VCVSlinear);
+
     switch(param) {
         case VCVS_GAIN:
             here->VCVScoeff = value->rValue;
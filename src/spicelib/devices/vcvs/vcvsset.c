@@ -10,6 +10,7 @@ Author: 1985 Thomas L. Quarles
 #include "ngspice/ngspice.h"
 #include "ngspice/smpdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/cktlinear.h"
 #include "vcvsdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -28,6 +29,8 @@ VCVSsetup(SMPmatrix *matrix, GENmodel *inModel, CKTcircuit *ckt, int *states)
     /*  loop through all the voltage source models */
     for( ; model != NULL; model = model->VCVSnextModel ) {
 
+        CKTlinearFree(&model->VCVSlinear);
+
         /* loop through all the instances of the model */
         for (here = model->VCVSinstances; here != NULL ;
                 here=here->VCVSnextInstance) {
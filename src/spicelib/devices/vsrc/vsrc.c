@@ -39,7 +39,9 @@ IFparm VSRCpTable[] = { /* parameters */
  IP  ("r",       VSRC_R,         IF_REAL,   "pwl repeat value"),
  IP  ("td",      VSRC_TD,        IF_REAL,   "pwl delay value"),
  IP  ("distof1", VSRC_D_F1,      IF_REALVEC,"f1 input for distortion"),
- IP  ("distof2", VSRC_D_F2,      IF_REALVEC,"f2 input for distortion")
+ IP  ("distof2", VSRC_D_F2,      IF_REALVEC,"f2 input for distortion"),
+ IP  ("file",    VSRC_PWL_FILE,   IF_STRING, "pwl stimulus file"),
+ IP  ("column",  VSRC_PWL_COLUMN, IF_INTEGER,"pwl stimulus file channel")
 };
 
 char *VSRCnames[] = {
@@ -5,6 +5,7 @@ Author: 1985 Thomas L. Quarles
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "vsrcdefs.h"
 #include "ngspice/trandefs.h"
 #include "ngspice/sperror.h"
@@ -165,19 +166,27 @@ VSRCaccept(CKTcircuit *ckt, GENmodel *inModel)
                     break;
 
                     case PWL: {
-                        int i;
+                        int i, exact;
+                        int npts = here->VSRCfunctionOrder/2;
                         if(ckt->CKTtime < *(here->VSRCcoeffs)) {
                             if(ckt->CKTbreak) {
                                 error = CKTsetBreak(ckt,*(here->VSRCcoeffs));
                                 break;
                             }
                         }
-                        for(i=0;i<(here->VSRCfunctionOrder/2)-1;i++) {
-                            if ( ckt->CKTbreak && AlmostEqualUlps(*(here->VSRCcoeffs+2*i), ckt->CKTtime, 3 ) ) {
-                                error = CKTsetBreak(ckt, *(here->VSRCcoeffs+2*i+2));
-                                if(error) return(error);
-                                goto bkptset;
-                            }
+                        if(!ckt->CKTbreak)
+                            break;
+                        /* a table time at CKTtime, not just a segment */
+                        i = -1;
+                        do
+                            i = DEVpwlFind(here->VSRCcoeffs, npts, i+1, 0.0,
+                                           ckt->CKTtime, 3, here->VSRCpwlSorted,
+                                           &here->VSRCpwlIndex, &exact);
+                        while(i >= 0 && !exact);
+                        if(i >= 0) {
+                            error = CKTsetBreak(ckt, *(here->VSRCcoeffs+2*i+2));
+                            if(error) return(error);
+                            goto bkptset;
                         }
                         break;
                     }
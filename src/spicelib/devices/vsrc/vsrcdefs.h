@@ -36,6 +36,9 @@ typedef struct sVSRCinstance {
     int VSRCfunctionOrder;  /* order of the function for the source */
     int VSRCrBreakpt;       /* pwl repeat breakpoint index */
     double *VSRCcoeffs; /* pointer to array of coefficients */
+    int VSRCpwlIndex;      /* pwl segment found last */
+    char *VSRCpwlFile;     /* pwl stimulus file */
+    int VSRCpwlColumn;     /* channel of the stimulus file */
 
     double VSRCdcValue; /* DC and TRANSIENT value of source */
 
@@ -74,6 +77,7 @@ typedef struct sVSRCinstance {
     unsigned VSRCdGiven      :1 ;  /* flag to indicate source is a distortion input */
     unsigned VSRCdF1given    :1 ;  /* flag to indicate source is an f1 distortion input */
     unsigned VSRCdF2given    :1 ;  /* flag to indicate source is an f2 distortion input */
+    unsigned VSRCpwlSorted   :1 ;  /* flag to indicate pwl times do not decrease */
     unsigned VSRCrGiven      :1 ;  /* flag to indicate repeating pwl */
 } VSRCinstance ;
 
@@ -134,6 +138,8 @@ typedef struct sVSRCmodel {
 #define VSRC_TRNOISE 25
 #define VSRC_TRRANDOM 26
 #define VSRC_EXTERNAL 27
+#define VSRC_PWL_FILE 28
+#define VSRC_PWL_COLUMN 29
 
 /* model parameters */
 
@@ -26,6 +26,7 @@ VSRCdestroy(GENmodel **inModel)
         for(here = mod->VSRCinstances ; here ; here = here->VSRCnextInstance) {
             if(prev) {
                 tfree(prev->VSRCcoeffs);
+                tfree(prev->VSRCpwlFile);
                 FREE(prev);
             }
             prev = here;
@@ -6,6 +6,7 @@ Modified: 2000 AlansFixes
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/devdefs.h"
 #include "vsrcdefs.h"
 #include "ngspice/trandefs.h"
 #include "ngspice/sperror.h"
@@ -293,43 +294,49 @@ VSRCload(GENmodel *inModel, CKTcircuit *ckt)
                     break;
 
                     case PWL: {
-                        int i = 0, num_repeat = 0, ii = 0;
-                        double foo, repeat_time = 0, end_time, breakpt_time, itime;
+                        int i, exact, num_repeat = 0;
+                        int npts = here->VSRCfunctionOrder/2;
+                        double *coeffs = here->VSRCcoeffs;
+                        double repeat_time = 0, end_time, breakpt_time, period;
 
                         time -= here->VSRCrdelay;
 
                         if(time < *(here->VSRCcoeffs)) {
-                            foo = *(here->VSRCcoeffs + 1) ;
-                            value = foo;
+                            value = *(here->VSRCcoeffs + 1) ;
                             goto loadDone;
                         }
 
-                        do {
-                            for(i=ii ; i<(here->VSRCfunctionOrder/2)-1; i++ ) {
-                                itime = *(here->VSRCcoeffs+2*i);
-                                if (  AlmostEqualUlps(itime+repeat_time, time, 3 )) {
-                                    foo   = *(here->VSRCcoeffs+2*i+1);
-                                    value = foo;
-                                    goto loadDone;
-                                } else if ( (*(here->VSRCcoeffs+2*i)+repeat_time < time)
-                                   && (*(here->VSRCcoeffs+2*(i+1))+repeat_time > time) ) {
-                                    foo   = *(here->VSRCcoeffs+2*i+1) + (((time-(*(here->VSRCcoeffs+2*i)+repeat_time))/
-                                       (*(here->VSRCcoeffs+2*(i+1)) - *(here->VSRCcoeffs+2*i))) *
-                                       (*(here->VSRCcoeffs+2*i+3)    - *(here->VSRCcoeffs+2*i+1)));
-                                    value = foo;
-                                    goto loadDone;
-                                }
+                        i = DEVpwlFind(coeffs, npts, 0, 0.0, time, 3,
+                                       here->VSRCpwlSorted, &here->VSRCpwlIndex,
+                                       &exact);
+
+                        if (i < 0 && here->VSRCrGiven) {
+                            end_time = coeffs[here->VSRCfunctionOrder-2];
+                            breakpt_time = coeffs[here->VSRCrBreakpt];
+                            period = end_time - breakpt_time;
+                            if (period > 0) {
+                                /* skip the repetitions ending before time */
+                                num_repeat = (int) floor((time - end_time) / period) - 1;
+                                if (num_repeat < 0)
+                                    num_repeat = 0;
+                                do {
+                                    repeat_time = end_time + (end_time - breakpt_time)*num_repeat++ - breakpt_time;
+                                    i = DEVpwlFind(coeffs, npts, here->VSRCrBreakpt/2,
+                                                   repeat_time, time, 3,
+                                                   here->VSRCpwlSorted,
+                                                   &here->VSRCpwlIndex, &exact);
+                                } while (i < 0);
                             }
-                            foo = *(here->VSRCcoeffs+ here->VSRCfunctionOrder-1) ;
-                            value = foo;
-
-                            if ( !here->VSRCrGiven ) goto loadDone;
+                        }
 
-                            end_time = *(here->VSRCcoeffs + here->VSRCfunctionOrder-2);
-                            breakpt_time = *(here->VSRCcoeffs + here->VSRCrBreakpt);
-                            repeat_time  = end_time + (end_time - breakpt_time)*num_repeat++ - breakpt_time;
-                            ii            = here->VSRCrBreakpt/2;
-                        } while ( here->VSRCrGiven );
+                        if (i < 0)
+                            value = coeffs[here->VSRCfunctionOrder-1];
+                        else if (exact)
+                            value = coeffs[2*i+1];
+                        else
+                            value = coeffs[2*i+1] + (((time-(coeffs[2*i]+repeat_time))/
+                                (coeffs[2*(i+1)] - coeffs[2*i])) *
+                                (coeffs[2*i+3] - coeffs[2*i+1]));
                         break;
                     }
 
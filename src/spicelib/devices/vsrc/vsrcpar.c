@@ -8,6 +8,7 @@ Modified: 2000 AlansFixes
 
 #include "ngspice/ngspice.h"
 #include "ngspice/ifsim.h"
+#include "ngspice/devdefs.h"
 #include "vsrcdefs.h"
 #include "ngspice/sperror.h"
 #include "ngspice/suffix.h"
@@ -29,6 +30,44 @@ static void copy_coeffs(VSRCinstance *here, IFvalue *value)
 }
 
 
+/* note if the pwl time points do not decrease, for DEVpwlFind() */
+static void pwl_check(VSRCinstance *here)
+{
+    int i;
+
+    here->VSRCpwlIndex = 0;
+    here->VSRCpwlSorted = TRUE;
+    for (i=0; i<(here->VSRCfunctionOrder/2)-1; i++) {
+          if (*(here->VSRCcoeffs+2*(i+1))<*(here->VSRCcoeffs+2*i))
+             here->VSRCpwlSorted = FALSE;
+          if (*(here->VSRCcoeffs+2*(i+1))<=*(here->VSRCcoeffs+2*i)) {
+             fprintf(stderr, "Warning : voltage source %s",
+                                                       here->VSRCname);
+             fprintf(stderr, " has non-increasing PWL time points.\n");
+          }
+    }
+}
+
+
+/* the pwl table from a channel of a binary stimulus file */
+static int pwl_file(VSRCinstance *here)
+{
+    int error;
+
+    error = DEVpwlFile(here->VSRCpwlFile,
+                       here->VSRCpwlColumn ? here->VSRCpwlColumn : 1,
+                       &here->VSRCcoeffs, &here->VSRCfunctionOrder);
+    if(error)
+        return(error);
+
+    here->VSRCfunctionType = PWL;
+    here->VSRCfuncTGiven = TRUE;
+    here->VSRCcoeffsGiven = TRUE;
+    pwl_check(here);
+    return(OK);
+}
+
+
 /* ARGSUSED */
 int
 VSRCparam(int param, IFvalue *value, GENinstance *inst, IFvalue *select)
@@ -98,20 +137,29 @@ VSRCparam(int param, IFvalue *value, GENinstance *inst, IFvalue *select)
             break;
 
         case VSRC_PWL:
+            /* 'pwl file=...', the table is checked in VSRCtemp() */
+            if(value->v.numValue == 0) {
+                here->VSRCfunctionType = PWL;
+                here->VSRCfuncTGiven = TRUE;
+                break;
+            }
             if(value->v.numValue < 2)
                 return(E_BADPARM);
             here->VSRCfunctionType = PWL;
             here->VSRCfuncTGiven = TRUE;
             copy_coeffs(here, value);
+            pwl_check(here);
+            break;
 
-            for (i=0; i<(here->VSRCfunctionOrder/2)-1; i++) {
-                  if (*(here->VSRCcoeffs+2*(i+1))<=*(here->VSRCcoeffs+2*i)) {
-                     fprintf(stderr, "Warning : voltage source %s",
-                                                               here->VSRCname);
-                     fprintf(stderr, " has non-increasing PWL time points.\n");
-                  }
-            }
+        case VSRC_PWL_FILE:
+            tfree(here->VSRCpwlFile);
+            here->VSRCpwlFile = value->sValue;
+            return pwl_file(here);
 
+        case VSRC_PWL_COLUMN:
+            here->VSRCpwlColumn = value->iValue;
+            if(here->VSRCpwlFile)
+                return pwl_file(here);
             break;
 
         case VSRC_TD:
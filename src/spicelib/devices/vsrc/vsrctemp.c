@@ -29,6 +29,13 @@ VSRCtemp(GENmodel *inModel, CKTcircuit *ckt)
         for (here = model->VSRCinstances; here != NULL ;
                 here=here->VSRCnextInstance) {
 
+            /* 'pwl' without time points and without 'file=' */
+            if(here->VSRCfunctionType == PWL && !here->VSRCcoeffsGiven) {
+                SPfrontEnd->IFerrorf (ERR_FATAL,
+                        "%s: pwl has no time points", here->VSRCname);
+                return(E_BADPARM);
+            }
+
             if(here->VSRCacGiven && !here->VSRCacMGiven) {
                 here->VSRCacMag = 1;
             }
@@ -38,6 +38,12 @@ IFeval(IFparseTree * tree, double gmin, double *result, double *vals,
 	printf("\tvar%d = %lg\n", i, vals[i]);
 #endif
 
+    /* the compiled code reports no errors, the trees are walked again
+     * to print the diagnostics */
+    if (myTree->code &&
+        PTevalCode(myTree->code, gmin, result, vals, derivs) == OK)
+        goto done;
+
     if ((err = PTeval(myTree->tree, gmin, result, vals)) != OK) {
         if (ft_ngdebug) {
             INPptPrint("calling PTeval, tree = ", tree);
@@ -63,6 +69,7 @@ IFeval(IFparseTree * tree, double gmin, double *result, double *vals,
             return err;
         }
 
+ done:
 #ifdef TRACE
     printf("results: function = %lg\n", *result);
     for (i = 0; i < myTree->p.numVars; i++)
@@ -31,8 +31,6 @@ static int INPfindParm( char *name, IFparm *table, int numParms );
 /* end Cider Integration */
 #endif /* CIDER */
 
-extern INPmodel *modtab;
-
 /*
   code moved from INPgetMod
  */
@@ -187,16 +185,92 @@ in_range( double value, double min, double max )
   else                                return FALSE;
 }
 
+/* L/W range of a binned model, the INPranges of INPmodBins */
+struct INPmodRange {
+  INPmodel* model;
+  int       order;      /* position in model table order */
+  bool      bad;        /* unknown device type, matches any L and W */
+  double    lmin, lmax, wmin, wmax;
+};
+
+static int
+cmp_lmin( const void* a, const void* b )
+{
+  const struct INPmodRange* ra = (const struct INPmodRange*) a;
+  const struct INPmodRange* rb = (const struct INPmodRange*) b;
+
+  if ( ra->lmin < rb->lmin ) return -1;
+  if ( ra->lmin > rb->lmin ) return 1;
+  return ra->order - rb->order;
+}
+
+/* parse the L/W limits of the binnable models once, sorted by lmin */
+static void
+setup_ranges( INPmodBins* bins )
+{
+  static char* model_tokens[] = { "lmin", "lmax", "wmin", "wmax" };
+  double       parse_values[4];
+  bool         parse_found[4];
+  struct INPmodRange* r;
+  INPmodel*    modtmp;
+  int          i, n = 0;
+
+  bins->INPranges = r = TMALLOC(struct INPmodRange, bins->INPnumMods);
+
+  for ( i = 0; i < bins->INPnumMods; i++ ) {
+
+    modtmp = bins->INPmods[i];
+
+    if ( /* This is the list of binable models */
+           modtmp->INPmodType != INPtypelook ("BSIM3")
+        && modtmp->INPmodType != INPtypelook ("BSIM3v32")
+        && modtmp->INPmodType != INPtypelook ("BSIM3v0")
+        && modtmp->INPmodType != INPtypelook ("BSIM3v1")
+        && modtmp->INPmodType != INPtypelook ("BSIM4")
+        && modtmp->INPmodType != INPtypelook ("BSIM4v5")
+        && modtmp->INPmodType != INPtypelook ("BSIM4v6")
+        && modtmp->INPmodType != INPtypelook ("BSIM4v7")
+        && modtmp->INPmodType != INPtypelook ("HiSIM2")
+        && modtmp->INPmodType != INPtypelook ("HiSIMHV1")
+        && modtmp->INPmodType != INPtypelook ("HiSIMHV2")
+       ) continue; /* We skip the model if it is not in the list */
+
+    r[n].model = modtmp;
+    r[n].order = i;
+
+    if (modtmp->INPmodType < 0) {
+      /* illegal device type, reported when found first */
+      r[n].bad  = TRUE;
+      r[n].lmin = -HUGE_VAL;
+      n++;
+      continue;
+    }
+
+    if ( parse_line( modtmp->INPmodLine->line, model_tokens, 4, parse_values, parse_found ) != TRUE )
+      continue;
+
+    r[n].bad  = FALSE;
+    r[n].lmin = parse_values[0]; r[n].lmax = parse_values[1];
+    r[n].wmin = parse_values[2]; r[n].wmax = parse_values[3];
+    n++;
+  }
+
+  qsort( r, (size_t) n, sizeof(struct INPmodRange), cmp_lmin );
+  bins->INPnumRanges = n;
+}
+
 char*
 INPgetModBin( CKTcircuit* ckt, char* name, INPmodel** model, INPtables* tab, char* line )
 {
   INPmodel*    modtmp;
-  double       l, w, lmin, lmax, wmin, wmax;
+  INPmodBins*  bins;
+  struct INPmodRange* r;
+  struct INPmodRange* found = NULL;
+  double       l, w;
   double       parse_values[4];
   bool         parse_found[4];
   static char* instance_tokens[] = { "l", "w" };
-  static char* model_tokens[]    = { "lmin", "lmax", "wmin", "wmax" };
-  int          error;
+  int          error, lo, hi;
   double       scale;
   char *err = NULL;
 
@@ -211,47 +285,48 @@ INPgetModBin( CKTcircuit* ckt, char* name, INPmodel** model, INPtables* tab, cha
   l = parse_values[0]*scale;
   w = parse_values[1]*scale;
 
-  for ( modtmp = modtab; modtmp != NULL; modtmp = modtmp->INPnextModel ) {
-
-    if ( model_name_match(name, modtmp->INPmodName) < 2 )
-        continue;
+  bins = INPlookModBins( name );
+  if ( !bins )
+    return NULL;
+  if ( bins->INPnumRanges < 0 )
+    setup_ranges( bins );
+
+  /* only ranges with lmin not above l may contain l */
+  r  = bins->INPranges;
+  lo = 0;
+  hi = bins->INPnumRanges;
+  while ( lo < hi ) {
+    int mid = lo + (hi - lo) / 2;
+    if ( r[mid].lmin < l + 1e-15 )
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
 
-    if ( /* This is the list of binable models */
-           modtmp->INPmodType != INPtypelook ("BSIM3")
-        && modtmp->INPmodType != INPtypelook ("BSIM3v32")
-        && modtmp->INPmodType != INPtypelook ("BSIM3v0")
-        && modtmp->INPmodType != INPtypelook ("BSIM3v1")
-        && modtmp->INPmodType != INPtypelook ("BSIM4")
-        && modtmp->INPmodType != INPtypelook ("BSIM4v5")
-        && modtmp->INPmodType != INPtypelook ("BSIM4v6")
-        && modtmp->INPmodType != INPtypelook ("BSIM4v7")
-        && modtmp->INPmodType != INPtypelook ("HiSIM2")
-        && modtmp->INPmodType != INPtypelook ("HiSIMHV1")
-        && modtmp->INPmodType != INPtypelook ("HiSIMHV2")
-       ) continue; /* We left the loop if the model is not in the list */
+  /* the first matching model in model table order */
+  for ( ; --lo >= 0; )
+    if ( ( r[lo].bad || ( in_range( l, r[lo].lmin, r[lo].lmax ) &&
+                          in_range( w, r[lo].wmin, r[lo].wmax ) ) ) &&
+         ( !found || r[lo].order < found->order ) )
+      found = r + lo;
 
-    if (modtmp->INPmodType < 0) {  /* First check for illegal model type */
-      /* illegal device type, so can't handle */
-      *model = NULL;
-      err = tprintf("Unknown device type for model %s \n", name);
-      return (err);
-    } /* end of checking for illegal model */
+  if ( !found )
+    return NULL;
 
-    if ( parse_line( modtmp->INPmodLine->line, model_tokens, 4, parse_values, parse_found ) != TRUE )
-      continue;
+  modtmp = found->model;
 
-    lmin = parse_values[0]; lmax = parse_values[1];
-    wmin = parse_values[2]; wmax = parse_values[3];
+  if (modtmp->INPmodType < 0) {  /* First check for illegal model type */
+    /* illegal device type, so can't handle */
+    *model = NULL;
+    err = tprintf("Unknown device type for model %s \n", name);
+    return (err);
+  } /* end of checking for illegal model */
 
-    if ( in_range( l, lmin, lmax ) && in_range( w, wmin, wmax ) ) {
-        if ( !modtmp->INPmodfast ) {
-            error = create_model( ckt, modtmp, tab );
-            if ( error ) return NULL;
-        }
-        *model = modtmp;
-        return NULL;
-    }
+  if ( !modtmp->INPmodfast ) {
+    error = create_model( ckt, modtmp, tab );
+    if ( error ) return NULL;
   }
+  *model = modtmp;
   return NULL;
 }
 
@@ -266,14 +341,9 @@ char *INPgetMod(CKTcircuit *ckt, char *name, INPmodel ** model, INPtables * tab)
   printf("In INPgetMod, examining model %s . . . \n", name);
 #endif
 
-  for (modtmp = modtab; modtmp != NULL; modtmp = modtmp->INPnextModel) {
-
-#ifdef TRACE
-    /* SDB debug statement */
-    printf("In INPgetMod, comparing %s against stored model %s . . . \n", name, modtmp->INPmodName);
-#endif
+  modtmp = INPlookMod(name);
 
-    if (strcmp(modtmp->INPmodName, name) == 0) {
+  if (modtmp) {
       /* found the model in question - now instantiate if necessary */
       /* and return an appropriate pointer to it */
 
@@ -296,7 +366,6 @@ char *INPgetMod(CKTcircuit *ckt, char *name, INPmodel ** model, INPtables * tab)
       }
       *model = modtmp;
       return (NULL);
-    }
   }
   /* didn't find model - ERROR  - return model */
   *model = NULL;
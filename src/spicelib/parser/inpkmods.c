@@ -26,6 +26,7 @@ void INPkillMods(void)
     }
     if (prev)
 	FREE(prev);
+    INPkillModIndex();
     modtab = NULL;
     ft_curckt->ci_modtab = NULL;
 }
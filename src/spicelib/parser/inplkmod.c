@@ -5,11 +5,108 @@ Author: 1985 Thomas L. Quarles
 
 #include "ngspice/ngspice.h"
 #include "ngspice/inpdefs.h"
+#include "ngspice/hash.h"
 #include <string.h>
 
 extern INPmodel *modtab;
 
 
+/*-----------------------------------------------------------------
+ * Hash index into the model table, by model name and, for binned
+ * models 'name.<digits>', by the base name 'name'.
+ * The index belongs to the list starting at modIndexHead.  The
+ * frontend switches modtab between circuits, so a different head
+ * leads to a rebuild.  INPappendMod() keeps the index up to date,
+ * INPkillMods() drops it together with the models.
+ *----------------------------------------------------------------*/
+
+static INPmodel *modIndexHead = NULL;
+static INPmodel *modIndexTail = NULL;
+static NGHASHPTR modNames = NULL;       /* INPmodel * by name */
+static NGHASHPTR modBins = NULL;        /* INPmodBins * by base name */
+
+
+static void
+free_bins(void *data)
+{
+    INPmodBins *bins = (INPmodBins *) data;
+
+    tfree(bins->INPmods);
+    tfree(bins->INPranges);
+    tfree(bins);
+}
+
+
+void
+INPkillModIndex(void)
+{
+    if (modNames)
+        nghash_free(modNames, NULL, NULL);
+    if (modBins)
+        nghash_free(modBins, free_bins, NULL);
+    modNames = modBins = NULL;
+    modIndexHead = modIndexTail = NULL;
+}
+
+
+/* enter a model at the end of the index */
+static void
+index_model(INPmodel *mod)
+{
+    char *name = mod->INPmodName;
+    char *dot = strrchr(name, '.');
+    char *p, *base;
+    INPmodBins *bins;
+
+    if (!nghash_find(modNames, name))
+        nghash_insert(modNames, name, mod);
+    modIndexTail = mod;
+
+    /* binned model: base name, a dot and digits only */
+    if (!dot || dot == name || dot[1] == '\0')
+        return;
+    for (p = dot + 1; *p; p++)
+        if (!isdigit((unsigned char) *p))
+            return;
+
+    base = copy_substring(name, dot);
+    bins = (INPmodBins *) nghash_find(modBins, base);
+    if (!bins) {
+        bins = TMALLOC(INPmodBins, 1);
+        bins->INPnumRanges = -1;
+        nghash_insert(modBins, base, bins);
+    }
+    tfree(base);
+
+    if (bins->INPnumMods == bins->INPmodsSize) {
+        bins->INPmodsSize = bins->INPmodsSize ? 2 * bins->INPmodsSize : 4;
+        bins->INPmods = TREALLOC(INPmodel *, bins->INPmods, bins->INPmodsSize);
+    }
+    bins->INPmods[bins->INPnumMods++] = mod;
+    /* set up the ranges anew */
+    bins->INPnumRanges = -1;
+    tfree(bins->INPranges);
+}
+
+
+/* make sure the index describes the current modtab */
+static void
+check_index(void)
+{
+    INPmodel *mod;
+
+    if (modNames && modIndexHead == modtab)
+        return;
+
+    INPkillModIndex();
+    modNames = nghash_init(NGHASH_MIN_SIZE);
+    modBins = nghash_init(NGHASH_MIN_SIZE);
+    modIndexHead = modtab;
+    for (mod = modtab; mod; mod = mod->INPnextModel)
+        index_model(mod);
+}
+
+
 /*-----------------------------------------------------------------
  * This fcn accepts a pointer to the model name, and returns
  * the INPmodel * if it exist in the model table.
@@ -18,11 +115,36 @@ extern INPmodel *modtab;
 INPmodel *
 INPlookMod(const char *name)
 {
-    INPmodel *i;
+    check_index();
+    return (INPmodel *) nghash_find(modNames, (void *) name);
+}
+
+
+/*-----------------------------------------------------------------
+ * Returns the binned models 'name.<digits>' of base name 'name',
+ * NULL if there are none.
+ *----------------------------------------------------------------*/
+
+INPmodBins *
+INPlookModBins(const char *name)
+{
+    check_index();
+    return (INPmodBins *) nghash_find(modBins, (void *) name);
+}
 
-    for (i = modtab; i; i = i->INPnextModel)
-        if (strcmp(i->INPmodName, name) == 0)
-            return i;
 
-    return NULL;
+/*-----------------------------------------------------------------
+ * Append a new model to the model table and the index.
+ *----------------------------------------------------------------*/
+
+void
+INPappendMod(INPmodel *mod)
+{
+    check_index();
+    mod->INPnextModel = NULL;
+    if (modIndexTail)
+        modIndexTail->INPnextModel = mod;
+    else
+        modtab = modIndexHead = mod;
+    index_model(mod);
 }
@@ -21,15 +21,12 @@ INPmodel *modtab = NULL;
 
 int INPmakeMod(char *token, int type, card * line)
 {
-   register INPmodel **i;
+   INPmodel *newmod;
 
-   /* First cycle through model table and see if model name
-      already exists in there.  If it does, just return. */
-   for (i = &modtab; *i != NULL; i = &((*i)->INPnextModel)) {
-      if (strcmp((*i)->INPmodName, token) == 0) {
-         return (OK);
-      }
-   }
+   /* First look up the model name in the model table.
+      If it already exists in there, just return. */
+   if (INPlookMod(token))
+      return (OK);
 
    /* Model name was not already in model table.  Therefore stick
       it in the model table. Then return.  */
@@ -39,15 +36,15 @@ int INPmakeMod(char *token, int type, card * line)
    printf("In INPmakeMod, about to insert new model name = %s . . .\n", token);
 #endif
 
-   *i = TMALLOC(INPmodel, 1);
-   if (*i == NULL)
+   newmod = TMALLOC(INPmodel, 1);
+   if (newmod == NULL)
       return (E_NOMEM);
 
-   (*i)->INPmodName = token;                 /* model name */
-   (*i)->INPmodType = type;                  /* model type */
-   (*i)->INPnextModel = NULL;   /* pointer to next model (end of list) */
-   (*i)->INPmodLine = line;                  /* model line */
-   (*i)->INPmodfast = NULL;
+   newmod->INPmodName = token;                 /* model name */
+   newmod->INPmodType = type;                  /* model type */
+   newmod->INPnextModel = NULL;   /* pointer to next model (end of list) */
+   newmod->INPmodLine = line;                  /* model line */
+   newmod->INPmodfast = NULL;
+   INPappendMod(newmod);
    return (OK);
 }
-
@@ -233,6 +233,7 @@ INPgetTree(char **line, INPparseTree ** pt, CKTcircuit *ckt, INPtables * tab)
         for (i = 0; i < numvalues; i++)
             (*pt)->derivs[i] = inc_usage(PTdifferentiate(p, i));
 
+        (*pt)->code = PTcompile(*pt);
     }
 
     values = NULL;
@@ -1417,6 +1418,7 @@ void INPfreeTree(IFparseTree *ptree)
 
     dec_usage(pt->tree);
 
+    PTfreeCode(pt->code);
     txfree(pt->derivs);
     txfree(pt->p.varTypes);
     txfree(pt->p.vars);
@@ -0,0 +1,604 @@
+/*
+ * Compile the parse tree of a B source, and the parse trees of its
+ * derivatives, into one linear instruction stream.
+ *
+ * Every value gets a register of its own.  Values are numbered while
+ * the trees are walked: a subtree which is shared between the trees, or
+ * a node computing the same function of the same registers as an earlier
+ * one, reuses the earlier register (common subexpression elimination).
+ * Nodes whose operands are all constant are evaluated right away and
+ * become constant registers (constant folding).
+ *
+ * The instructions call the very same functions PTeval() calls, in the
+ * same way, so the results are bit-identical to the tree walk.  Only the
+ * selected branch of a ternary is computed, values computed inside a
+ * branch are not reused outside of it.
+ */
+
+#include "ngspice/ngspice.h"
+#include "ngspice/ifsim.h"
+#include "ngspice/iferrmsg.h"
+#include "ngspice/inpptree.h"
+#include "ngspice/cktdefs.h"
+
+
+extern double PTfudge_factor;
+
+/* instruction codes */
+enum {
+    PTI_VAR,            /* r[dst] = vals[a] */
+    PTI_TIME,           /* r[dst] = circuit time, temperature, frequency */
+    PTI_TEMPERATURE,
+    PTI_FREQUENCY,
+    PTI_PLUS,           /* r[dst] = r[a] op r[b] */
+    PTI_MINUS,
+    PTI_TIMES,
+    PTI_DIVIDE,
+    PTI_BINARY,         /* r[dst] = function(r[a], r[b]) */
+    PTI_UNARY,          /* r[dst] = function(r[a]) */
+    PTI_UNARY_DATA,     /* r[dst] = function(r[a], data) */
+    PTI_JUMPZ,          /* if r[a] == 0, continue at instruction b */
+    PTI_JUMP,           /* continue at instruction b */
+    PTI_MOVE            /* r[dst] = r[a] */
+};
+
+typedef struct PTinstr {
+    int op;
+    int dst, a, b;
+    void (*function)(void);
+    void *data;
+} PTinstr;
+
+struct PTcode {
+    int ninstr;
+    PTinstr *instr;
+    int nregs;
+    double *regs;       /* constants, and room for all other values */
+    int nout;
+    int *out;           /* registers of the value and the derivatives */
+};
+
+
+/* A value number: the register holding a node, a constant, or the
+ * result of an operation on registers.  Keys are chained in hash
+ * buckets, newest first, so the keys of a ternary branch can be dropped
+ * again by popping them off the end of the list.
+ */
+
+enum { PTK_NODE, PTK_CONST, PTK_OP };
+
+typedef struct PTkey {
+    int kind;
+    int op, a, b;
+    const void *ptr;    /* node, or function */
+    void *data;
+    double constant;
+    int reg;
+    int next;
+} PTkey;
+
+typedef struct PTcomp {
+    PTcode *code;
+    int maxinstr, maxregs;
+    char *isconst;      /* per register */
+    PTkey *keys;
+    int nkeys, maxkeys;
+    int *buckets;
+    int nbuckets;
+} PTcomp;
+
+
+static int compile(PTcomp *c, INPparseNode *p);
+
+
+static unsigned int
+key_hash(PTcomp *c, const PTkey *k)
+{
+    union {
+        double d;
+        unsigned char b[sizeof(double)];
+    } u;
+    size_t h = (size_t) k->kind * 31u + (size_t) k->op;
+    size_t i;
+
+    h = h * 1000003u + (size_t) k->a;
+    h = h * 1000003u + (size_t) k->b;
+    h = h * 1000003u + (size_t) k->ptr;
+    h = h * 1000003u + (size_t) k->data;
+    u.d = k->constant;
+    for (i = 0; i < sizeof(double); i++)
+        h = h * 31u + u.b[i];
+
+    return (unsigned int) (h ^ (h >> 15)) & (unsigned int) (c->nbuckets - 1);
+}
+
+
+static int
+key_equal(const PTkey *x, const PTkey *y)
+{
+    return x->kind == y->kind && x->op == y->op &&
+        x->a == y->a && x->b == y->b &&
+        x->ptr == y->ptr && x->data == y->data &&
+        memcmp(&x->constant, &y->constant, sizeof(double)) == 0;
+}
+
+
+static int
+key_find(PTcomp *c, const PTkey *k)
+{
+    int i;
+
+    for (i = c->buckets[key_hash(c, k)]; i >= 0; i = c->keys[i].next)
+        if (key_equal(&c->keys[i], k))
+            return c->keys[i].reg;
+
+    return -1;
+}
+
+
+static void
+key_add(PTcomp *c, PTkey *k, int reg)
+{
+    unsigned int h;
+    int i;
+
+    if (c->nkeys >= c->maxkeys) {
+        c->maxkeys *= 2;
+        c->keys = TREALLOC(PTkey, c->keys, c->maxkeys);
+    }
+
+    /* keep the chains short, rehashing preserves the newest first order */
+    if (c->nkeys >= 2 * c->nbuckets) {
+        c->nbuckets *= 2;
+        c->buckets = TREALLOC(int, c->buckets, c->nbuckets);
+        for (i = 0; i < c->nbuckets; i++)
+            c->buckets[i] = -1;
+        for (i = 0; i < c->nkeys; i++) {
+            h = key_hash(c, &c->keys[i]);
+            c->keys[i].next = c->buckets[h];
+            c->buckets[h] = i;
+        }
+    }
+
+    k->reg = reg;
+    h = key_hash(c, k);
+    k->next = c->buckets[h];
+    c->buckets[h] = c->nkeys;
+    c->keys[c->nkeys++] = *k;
+}
+
+
+/* Forget all keys added after the first n of them */
+
+static void
+key_pop(PTcomp *c, int n)
+{
+    while (c->nkeys > n) {
+        PTkey *k = &c->keys[--c->nkeys];
+        c->buckets[key_hash(c, k)] = k->next;
+    }
+}
+
+
+static int
+new_reg(PTcomp *c)
+{
+    if (c->code->nregs >= c->maxregs) {
+        c->maxregs *= 2;
+        c->code->regs = TREALLOC(double, c->code->regs, c->maxregs);
+        c->isconst = TREALLOC(char, c->isconst, c->maxregs);
+    }
+
+    c->isconst[c->code->nregs] = 0;
+    return c->code->nregs++;
+}
+
+
+static PTinstr *
+new_instr(PTcomp *c, int op)
+{
+    PTinstr *ip;
+
+    if (c->code->ninstr >= c->maxinstr) {
+        c->maxinstr *= 2;
+        c->code->instr = TREALLOC(PTinstr, c->code->instr, c->maxinstr);
+    }
+
+    ip = &c->code->instr[c->code->ninstr++];
+    ZERO(ip, PTinstr);
+    ip->op = op;
+    ip->dst = -1;
+    return ip;
+}
+
+
+static int
+const_reg(PTcomp *c, double value)
+{
+    PTkey k;
+    int reg;
+
+    ZERO(&k, PTkey);
+    k.kind = PTK_CONST;
+    k.constant = value;
+    if ((reg = key_find(c, &k)) >= 0)
+        return reg;
+
+    reg = new_reg(c);
+    c->code->regs[reg] = value;
+    c->isconst[reg] = 1;
+    key_add(c, &k, reg);
+    return reg;
+}
+
+
+/* An instruction computing op from registers a and b, unless the same
+ * has been computed before or the operands are constant. */
+
+static int
+op_reg(PTcomp *c, int op, int a, int b, void (*function)(void), void *data)
+{
+    PTkey k;
+    PTinstr *ip;
+    int reg;
+
+    ZERO(&k, PTkey);
+    k.kind = PTK_OP;
+    k.op = op;
+    k.a = a;
+    k.b = b;
+    k.ptr = (const void *) function;
+    k.data = data;
+    if ((reg = key_find(c, &k)) >= 0)
+        return reg;
+
+    /* PTdivide depends on gmin, it is not folded */
+    if (a >= 0 && c->isconst[a] && (b < 0 || c->isconst[b])) {
+        double *r = c->code->regs, value;
+        int fold = 1;
+        switch (op) {
+        case PTI_PLUS:
+            value = r[a] + r[b];
+            break;
+        case PTI_MINUS:
+            value = r[a] - r[b];
+            break;
+        case PTI_TIMES:
+            value = r[a] * r[b];
+            break;
+        case PTI_BINARY:
+            value = PTbinary(function) (r[a], r[b]);
+            break;
+        case PTI_UNARY:
+            value = PTunary(function) (r[a]);
+            break;
+        case PTI_UNARY_DATA:
+            value = PTunary_with_private(function) (r[a], data);
+            break;
+        default:
+            value = 0.0;
+            fold = 0;
+            break;
+        }
+        /* out of range is reported at run time */
+        if (fold && value != HUGE)
+            return const_reg(c, value);
+    }
+
+    reg = new_reg(c);
+    ip = new_instr(c, op);
+    ip->dst = reg;
+    ip->a = a;
+    ip->b = b;
+    ip->function = function;
+    ip->data = data;
+
+    key_add(c, &k, reg);
+    return reg;
+}
+
+
+static int
+compile_tern(PTcomp *c, INPparseNode *p)
+{
+    INPparseNode *arg2 = p->right->left;
+    INPparseNode *arg3 = p->right->right;
+    PTinstr *ip;
+    int cond, reg, r, jumpz, jump, scope;
+
+    if ((cond = compile(c, p->left)) < 0)
+        return -1;
+
+    /*FIXME > 0.0, >= 0.5, != 0.0 or what ? */
+    if (c->isconst[cond])
+        return compile(c, (c->code->regs[cond] != 0.0) ? arg2 : arg3);
+
+    reg = new_reg(c);
+
+    jumpz = c->code->ninstr;
+    ip = new_instr(c, PTI_JUMPZ);
+    ip->a = cond;
+
+    scope = c->nkeys;
+    if ((r = compile(c, arg2)) < 0)
+        return -1;
+    ip = new_instr(c, PTI_MOVE);
+    ip->dst = reg;
+    ip->a = r;
+    key_pop(c, scope);
+
+    jump = c->code->ninstr;
+    new_instr(c, PTI_JUMP);
+    c->code->instr[jumpz].b = c->code->ninstr;
+
+    if ((r = compile(c, arg3)) < 0)
+        return -1;
+    ip = new_instr(c, PTI_MOVE);
+    ip->dst = reg;
+    ip->a = r;
+    key_pop(c, scope);
+
+    c->code->instr[jump].b = c->code->ninstr;
+
+    return reg;
+}
+
+
+/* Returns the register holding the value of p, -1 if p can't be compiled */
+
+static int
+compile(PTcomp *c, INPparseNode *p)
+{
+    PTkey k;
+    int reg, a, b;
+
+    ZERO(&k, PTkey);
+    k.kind = PTK_NODE;
+    k.ptr = p;
+    if ((reg = key_find(c, &k)) >= 0)
+        return reg;
+
+    switch (p->type) {
+    case PT_CONSTANT:
+        reg = const_reg(c, p->constant);
+        break;
+
+    case PT_VAR:
+        /* the operand is an index into vals, not a register */
+        k.kind = PTK_OP;
+        k.op = PTI_VAR;
+        k.a = p->valueIndex;
+        k.b = -1;
+        k.ptr = NULL;
+        if ((reg = key_find(c, &k)) < 0) {
+            PTinstr *ip;
+            reg = new_reg(c);
+            ip = new_instr(c, PTI_VAR);
+            ip->dst = reg;
+            ip->a = p->valueIndex;
+            key_add(c, &k, reg);
+        }
+        ZERO(&k, PTkey);
+        k.kind = PTK_NODE;
+        k.ptr = p;
+        break;
+
+    case PT_TIME:
+        reg = op_reg(c, PTI_TIME, -1, -1, NULL, p->data);
+        break;
+
+    case PT_TEMPERATURE:
+        reg = op_reg(c, PTI_TEMPERATURE, -1, -1, NULL, p->data);
+        break;
+
+    case PT_FREQUENCY:
+        reg = op_reg(c, PTI_FREQUENCY, -1, -1, NULL, p->data);
+        break;
+
+    case PT_FUNCTION:
+        switch (p->funcnum) {
+        case PTF_POW:
+        case PTF_PWR:
+        case PTF_MIN:
+        case PTF_MAX:
+            if ((a = compile(c, p->left->left)) < 0 ||
+                (b = compile(c, p->left->right)) < 0)
+                return -1;
+            reg = op_reg(c, PTI_BINARY, a, b, p->function, NULL);
+            break;
+        default:
+            if ((a = compile(c, p->left)) < 0)
+                return -1;
+            if (p->data == NULL)
+                reg = op_reg(c, PTI_UNARY, a, -1, p->function, NULL);
+            else
+                reg = op_reg(c, PTI_UNARY_DATA, a, -1, p->function, p->data);
+            break;
+        }
+        break;
+
+    case PT_TERN:
+        reg = compile_tern(c, p);
+        break;
+
+    case PT_PLUS:
+    case PT_MINUS:
+    case PT_TIMES:
+    case PT_DIVIDE:
+    case PT_POWER:
+        if ((a = compile(c, p->left)) < 0 || (b = compile(c, p->right)) < 0)
+            return -1;
+        switch (p->type) {
+        case PT_PLUS:
+            reg = op_reg(c, PTI_PLUS, a, b, p->function, NULL);
+            break;
+        case PT_MINUS:
+            reg = op_reg(c, PTI_MINUS, a, b, p->function, NULL);
+            break;
+        case PT_TIMES:
+            reg = op_reg(c, PTI_TIMES, a, b, p->function, NULL);
+            break;
+        case PT_DIVIDE:
+            reg = op_reg(c, PTI_DIVIDE, a, b, p->function, NULL);
+            break;
+        default:
+            reg = op_reg(c, PTI_BINARY, a, b, p->function, NULL);
+            break;
+        }
+        break;
+
+    default:
+        return -1;
+    }
+
+    if (reg >= 0)
+        key_add(c, &k, reg);
+
+    return reg;
+}
+
+
+/* Compile the value and derivative trees of pt, NULL if not possible */
+
+PTcode *
+PTcompile(INPparseTree *pt)
+{
+    PTcomp comp, *c = &comp;
+    PTcode *code;
+    int i, ok = 1;
+
+    code = TMALLOC(PTcode, 1);
+    code->nout = pt->p.numVars + 1;
+    code->out = TMALLOC(int, code->nout);
+
+    c->code = code;
+    c->maxinstr = 16;
+    c->maxregs = 16;
+    c->maxkeys = 64;
+    c->nbuckets = 64;
+    code->instr = TMALLOC(PTinstr, c->maxinstr);
+    code->regs = TMALLOC(double, c->maxregs);
+    c->isconst = TMALLOC(char, c->maxregs);
+    c->keys = TMALLOC(PTkey, c->maxkeys);
+    c->nkeys = 0;
+    c->buckets = TMALLOC(int, c->nbuckets);
+    for (i = 0; i < c->nbuckets; i++)
+        c->buckets[i] = -1;
+
+    if ((code->out[0] = compile(c, pt->tree)) < 0)
+        ok = 0;
+    for (i = 0; ok && i < pt->p.numVars; i++)
+        if ((code->out[i + 1] = compile(c, pt->derivs[i])) < 0)
+            ok = 0;
+
+    tfree(c->isconst);
+    tfree(c->keys);
+    tfree(c->buckets);
+
+    if (!ok) {
+        PTfreeCode(code);
+        return NULL;
+    }
+
+    return code;
+}
+
+
+void
+PTfreeCode(PTcode *code)
+{
+    if (!code)
+        return;
+
+    tfree(code->instr);
+    tfree(code->regs);
+    tfree(code->out);
+    tfree(code);
+}
+
+
+/* Evaluate the function and all its derivatives in one pass.
+ * Nothing is printed on errors, IFeval() leaves that to PTeval().
+ * The registers live in the code, so this is not reentrant. */
+
+int
+PTevalCode(PTcode *code, double gmin, double *result, double *vals,
+           double *derivs)
+{
+    double *r = code->regs;
+    PTinstr *instr = code->instr;
+    int pc = 0, i;
+
+    PTfudge_factor = gmin * 1.0e-20; /* defaults to 1e-32, should be small enough */
+
+    while (pc < code->ninstr) {
+        PTinstr *ip = &instr[pc++];
+        switch (ip->op) {
+        case PTI_VAR:
+            r[ip->dst] = vals[ip->a];
+            continue;
+
+        case PTI_TIME:
+            r[ip->dst] = ((CKTcircuit *) ip->data) -> CKTtime;
+            continue;
+
+        case PTI_TEMPERATURE:
+            r[ip->dst] = ((CKTcircuit *) ip->data) -> CKTtemp - CONSTCtoK;
+            continue;
+
+        case PTI_FREQUENCY:
+            r[ip->dst] = (((CKTcircuit *) ip->data) -> CKTomega)/2./M_PI;
+            continue;
+
+        case PTI_PLUS:
+            r[ip->dst] = r[ip->a] + r[ip->b];
+            break;
+
+        case PTI_MINUS:
+            r[ip->dst] = r[ip->a] - r[ip->b];
+            break;
+
+        case PTI_TIMES:
+            r[ip->dst] = r[ip->a] * r[ip->b];
+            break;
+
+        case PTI_DIVIDE:
+        case PTI_BINARY:
+            r[ip->dst] = PTbinary(ip->function) (r[ip->a], r[ip->b]);
+            break;
+
+        case PTI_UNARY:
+            r[ip->dst] = PTunary(ip->function) (r[ip->a]);
+            break;
+
+        case PTI_UNARY_DATA:
+            r[ip->dst] = PTunary_with_private(ip->function) (r[ip->a], ip->data);
+            break;
+
+        case PTI_JUMPZ:
+            if (r[ip->a] == 0.0)
+                pc = ip->b;
+            continue;
+
+        case PTI_JUMP:
+            pc = ip->b;
+            continue;
+
+        case PTI_MOVE:
+            r[ip->dst] = r[ip->a];
+            continue;
+
+        default:
+            return (E_PANIC);
+        }
+
+        if (r[ip->dst] == HUGE)
+            return (E_PARMVAL);
+    }
+
+    *result = r[code->out[0]];
+    for (i = 1; i < code->nout; i++)
+        derivs[i - 1] = r[code->out[i]];
+
+    return (OK);
+}
@@ -374,6 +374,7 @@ static void append (char *str)
 %token TOK_TOTAL_LOAD
 %token TOK_MESSAGE
 %token TOK_CALL_TYPE
+%token TOK_CALLBACK
 
 %start mod_file
 
@@ -434,6 +435,8 @@ macro			: TOK_INIT
 			   {fprintf (mod_yyout, "mif_private->circuit.anal_init");}
 			| TOK_CALL_TYPE
 			   {fprintf (mod_yyout, "mif_private->circuit.call_type");}
+			| TOK_CALLBACK
+			   {fprintf (mod_yyout, "*(mif_private->callback)");}
 			| TOK_TIME
 			   {fprintf (mod_yyout, "mif_private->circuit.time");}
 			| TOK_RAD_FREQ
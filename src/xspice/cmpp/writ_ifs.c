@@ -952,6 +952,9 @@ static void  write_SPICEdev(
 
     fprintf(fp, "&val_sizeofMIFinstance,\n");
     fprintf(fp, "&val_sizeofMIFmodel,\n");
+    fprintf(fp, "NULL,          \n");  /* DEVloadInst */
+    fprintf(fp, "0,             \n");  /* DEVstampMat */
+    fprintf(fp, "0,             \n");  /* DEVstampRhs */
     fprintf(fp, "\n");
     fprintf(fp, "};\n");
     fprintf(fp, "\n");
@@ -390,7 +390,6 @@ static void EVTbackup_inst_queue(
     int         j;
 
     int         num_modified;
-    int         num_pending;
     int         inst_index;
 
     Evt_Inst_Queue_t    *inst_queue;
@@ -398,9 +397,6 @@ static void EVTbackup_inst_queue(
     Evt_Inst_Event_t    **inst_ptr;
     Evt_Inst_Event_t    *inst;
 
-    double              next_time;
-    double              event_time;
-
 
     /* Get pointers for quick access */
     inst_queue = &(ckt->evt->queue.inst);
@@ -447,38 +443,43 @@ static void EVTbackup_inst_queue(
         inst_queue->current[inst_index] = inst_ptr;
     }
 
-    /* Add set of items modified to set of items pending before updating the */
-    /* pending list because things may have been pulled from the pending list */
+    /* Update the pending heap for the items modified, since only their */
+    /* current pointers have changed, by seeing if there is anything at */
+    /* the location pointed to by current */
     for(i = 0; i < num_modified; i++) {
-        j = inst_queue->modified_index[i];
-        if(! inst_queue->pending[j]) {
-            inst_queue->pending[j] = MIF_TRUE;
-            inst_queue->pending_index[(inst_queue->num_pending)++] = j;
-        }
-    }
-
-    /* Update the pending list and the next time by seeing if there */
-    /* is anything at the location pointed to by current */
-    next_time = 1e30;
-    num_pending = inst_queue->num_pending;
-    for(i = 0, j = 0; i < num_pending; i++) {
-        inst_index = inst_queue->pending_index[i];
+        inst_index = inst_queue->modified_index[i];
         inst = *(inst_queue->current[inst_index]);
-        /* If nothing in queue at last_step, remove this index from the pending list */
+        /* If nothing in queue at current, remove this index from the pending heap */
         if(! inst) {
-            inst_queue->pending[inst_index] = MIF_FALSE;
-            (inst_queue->num_pending)--;
+            if(inst_queue->pending[inst_index]) {
+                inst_queue->pending[inst_index] = MIF_FALSE;
+                EVTqueue_heap_remove(inst_queue->pending_index,
+                        inst_queue->pending_pos, inst_queue->pending_time,
+                        &(inst_queue->num_pending), inst_index);
+            }
         }
-        /* else, keep the index and update the next time */
+        /* else, add or move the index to the time at current */
         else {
-            inst_queue->pending_index[j] = inst_queue->pending_index[i];
-            j++;
-            event_time = inst->event_time;
-            if(event_time < next_time)
-                next_time = event_time;
+            inst_queue->pending_time[inst_index] = inst->event_time;
+            if(! inst_queue->pending[inst_index]) {
+                inst_queue->pending[inst_index] = MIF_TRUE;
+                EVTqueue_heap_insert(inst_queue->pending_index,
+                        inst_queue->pending_pos, inst_queue->pending_time,
+                        &(inst_queue->num_pending), inst_index);
+            }
+            else {
+                EVTqueue_heap_update(inst_queue->pending_index,
+                        inst_queue->pending_pos, inst_queue->pending_time,
+                        inst_queue->num_pending, inst_index);
+            }
         }
     }
-    inst_queue->next_time = next_time;
+
+    /* Update the next time */
+    if(inst_queue->num_pending > 0)
+        inst_queue->next_time = inst_queue->pending_time[inst_queue->pending_index[0]];
+    else
+        inst_queue->next_time = 1e30;
 
     /* Update the modified list by looking for any queued events */
     /* with posted time > last_time */
@@ -525,7 +526,6 @@ static void EVTbackup_output_queue(
     int         j;
 
     int         num_modified;
-    int         num_pending;
 
    int         output_index;
 
@@ -534,9 +534,6 @@ static void EVTbackup_output_queue(
     Evt_Output_Event_t    **output_ptr;
     Evt_Output_Event_t    *output;
 
-    double              next_time;
-    double              event_time;
-
 
     /* Get pointers for quick access */
     output_queue = &(ckt->evt->queue.output);
@@ -586,38 +583,43 @@ static void EVTbackup_output_queue(
         output_queue->current[output_index] = output_ptr;
     }
 
-    /* Add set of items modified to set of items pending before updating the */
-    /* pending list because things may have been pulled from the pending list */
+    /* Update the pending heap for the items modified, since only their */
+    /* current pointers have changed, by seeing if there is anything at */
+    /* the location pointed to by current */
     for(i = 0; i < num_modified; i++) {
-        j = output_queue->modified_index[i];
-        if(! output_queue->pending[j]) {
-            output_queue->pending[j] = MIF_TRUE;
-            output_queue->pending_index[(output_queue->num_pending)++] = j;
-        }
-    }
-
-    /* Update the pending list and the next time by seeing if there */
-    /* is anything at the location pointed to by current */
-    next_time = 1e30;
-    num_pending = output_queue->num_pending;
-    for(i = 0, j = 0; i < num_pending; i++) {
-        output_index = output_queue->pending_index[i];
+        output_index = output_queue->modified_index[i];
         output = *(output_queue->current[output_index]);
-        /* If nothing in queue at last_step, remove this index from the pending list */
+        /* If nothing in queue at current, remove this index from the pending heap */
         if(! output) {
-            output_queue->pending[output_index] = MIF_FALSE;
-            (output_queue->num_pending)--;
+            if(output_queue->pending[output_index]) {
+                output_queue->pending[output_index] = MIF_FALSE;
+                EVTqueue_heap_remove(output_queue->pending_index,
+                        output_queue->pending_pos, output_queue->pending_time,
+                        &(output_queue->num_pending), output_index);
+            }
         }
-        /* else, keep the index and update the next time */
+        /* else, add or move the index to the time at current */
         else {
-            output_queue->pending_index[j] = output_queue->pending_index[i];
-            j++;
-            event_time = output->event_time;
-            if(event_time < next_time)
-                next_time = event_time;
+            output_queue->pending_time[output_index] = output->event_time;
+            if(! output_queue->pending[output_index]) {
+                output_queue->pending[output_index] = MIF_TRUE;
+                EVTqueue_heap_insert(output_queue->pending_index,
+                        output_queue->pending_pos, output_queue->pending_time,
+                        &(output_queue->num_pending), output_index);
+            }
+            else {
+                EVTqueue_heap_update(output_queue->pending_index,
+                        output_queue->pending_pos, output_queue->pending_time,
+                        output_queue->num_pending, output_index);
+            }
         }
     }
-    output_queue->next_time = next_time;
+
+    /* Update the next time */
+    if(output_queue->num_pending > 0)
+        output_queue->next_time = output_queue->pending_time[output_queue->pending_index[0]];
+    else
+        output_queue->next_time = 1e30;
 
     /* Update the modified list by looking for any queued events */
     /* with posted time > last_time */
@@ -97,15 +97,7 @@ static void EVTdequeue_output(
     double      time)          /* The event time of the events to dequeue */
 {
 
-    int         i;
-    int         j;
-
-    int         num_pending;
     int         index;
-    int         output_index;
-
-    double      next_time;
-    double      event_time;
 
     Evt_Output_Queue_t  *output_queue;
 
@@ -123,19 +115,19 @@ static void EVTdequeue_output(
     if(output_queue->next_time != time)
         return;
 
-    /* Scan the list of outputs pending */
-    num_pending = output_queue->num_pending;
-    for(i = 0; i < num_pending; i++) {
+    /* Take the outputs with events at this time off the top of the heap */
+    /* of outputs pending, in order of their indexes */
+    while(output_queue->num_pending > 0) {
 
         /* Get the index of the output */
-        index = output_queue->pending_index[i];
+        index = output_queue->pending_index[0];
 
         /* Get pointer to next event in queue at this index */
         output = *(output_queue->current[index]);
 
-        /* If event time does not match current time, skip */
+        /* If event time does not match current time, we are done */
         if(output->event_time != time)
-            continue;
+            break;
 
         /* It must match, so pull the event from the queue and process it */
         EVTprocess_output(ckt, index, output->value);
@@ -156,29 +148,29 @@ static void EVTdequeue_output(
             output_queue->modified[index] = MIF_TRUE;
             output_queue->modified_index[(output_queue->num_modified)++] = index;
         }
-    }
 
-
-    /* Update/compact the pending list and update the next_time */
-    next_time = 1e30;
-    for(i = 0, j = 0; i < num_pending; i++) {
-        output_index = output_queue->pending_index[i];
-        output = *(output_queue->current[output_index]);
-        /* If nothing in queue at last_step, remove this index from the pending list */
+        /* If nothing left in queue, remove this index from the pending heap */
         if(! output) {
-            output_queue->pending[output_index] = MIF_FALSE;
-            (output_queue->num_pending)--;
+            output_queue->pending[index] = MIF_FALSE;
+            EVTqueue_heap_remove(output_queue->pending_index,
+                    output_queue->pending_pos, output_queue->pending_time,
+                    &(output_queue->num_pending), index);
         }
-        /* else, keep the index and update the next time */
+        /* else, move it down to the time of its next event */
         else {
-            output_queue->pending_index[j] = output_queue->pending_index[i];
-            j++;
-            event_time = output->event_time;
-            if(event_time < next_time)
-                next_time = event_time;
+            output_queue->pending_time[index] = output->event_time;
+            EVTqueue_heap_update(output_queue->pending_index,
+                    output_queue->pending_pos, output_queue->pending_time,
+                    output_queue->num_pending, index);
         }
     }
-    output_queue->next_time = next_time;
+
+    /* Update the next_time */
+    if(output_queue->num_pending > 0)
+        output_queue->next_time =
+                output_queue->pending_time[output_queue->pending_index[0]];
+    else
+        output_queue->next_time = 1e30;
 
 
 }
@@ -198,15 +190,7 @@ void EVTdequeue_inst(
     double      time)    /* The event time of the events to dequeue */
 {
 
-    int         i;
-    int         j;
-
-    int         num_pending;
     int         index;
-    int         inst_index;
-
-    double      next_time;
-    double      event_time;
 
     Evt_Inst_Queue_t  *inst_queue;
 
@@ -223,19 +207,19 @@ void EVTdequeue_inst(
     if(inst_queue->next_time != time)
         return;
 
-    /* Scan the list of insts pending */
-    num_pending = inst_queue->num_pending;
-    for(i = 0; i < num_pending; i++) {
+    /* Take the insts with events at this time off the top of the heap */
+    /* of insts pending, in order of their indexes */
+    while(inst_queue->num_pending > 0) {
 
         /* Get the index of the inst */
-        index = inst_queue->pending_index[i];
+        index = inst_queue->pending_index[0];
 
         /* Get pointer to next event in queue at this index */
         inst = *(inst_queue->current[index]);
 
-        /* If event time does not match current time, skip */
+        /* If event time does not match current time, we are done */
         if(inst->event_time != time)
-            continue;
+            break;
 
         /* It must match, so pull the event from the queue and process it */
         if(! inst_queue->to_call[index]) {
@@ -252,29 +236,30 @@ void EVTdequeue_inst(
             inst_queue->modified[index] = MIF_TRUE;
             inst_queue->modified_index[(inst_queue->num_modified)++] = index;
         }
-    }
-
 
-    /* Update/compact the pending list and update the next_time */
-    next_time = 1e30;
-    for(i = 0, j = 0; i < num_pending; i++) {
-        inst_index = inst_queue->pending_index[i];
-        inst = *(inst_queue->current[inst_index]);
-        /* If nothing in queue at last_step, remove this index from the pending list */
+        /* If nothing left in queue, remove this index from the pending heap */
+        inst = *(inst_queue->current[index]);
         if(! inst) {
-            inst_queue->pending[inst_index] = MIF_FALSE;
-            (inst_queue->num_pending)--;
+            inst_queue->pending[index] = MIF_FALSE;
+            EVTqueue_heap_remove(inst_queue->pending_index,
+                    inst_queue->pending_pos, inst_queue->pending_time,
+                    &(inst_queue->num_pending), index);
         }
-        /* else, keep the index and update the next time */
+        /* else, move it down to the time of its next event */
         else {
-            inst_queue->pending_index[j] = inst_queue->pending_index[i];
-            j++;
-            event_time = inst->event_time;
-            if(event_time < next_time)
-                next_time = event_time;
+            inst_queue->pending_time[index] = inst->event_time;
+            EVTqueue_heap_update(inst_queue->pending_index,
+                    inst_queue->pending_pos, inst_queue->pending_time,
+                    inst_queue->num_pending, index);
         }
     }
-    inst_queue->next_time = next_time;
+
+    /* Update the next_time */
+    if(inst_queue->num_pending > 0)
+        inst_queue->next_time =
+                inst_queue->pending_time[inst_queue->pending_index[0]];
+    else
+        inst_queue->next_time = 1e30;
 
 
 
@@ -361,6 +361,8 @@ static int EVTinit_queue(
     CKALLOC(inst_queue->modified, num_insts, Mif_Boolean_t)
     CKALLOC(inst_queue->pending_index, num_insts, int)
     CKALLOC(inst_queue->pending, num_insts, Mif_Boolean_t)
+    CKALLOC(inst_queue->pending_pos, num_insts, int)
+    CKALLOC(inst_queue->pending_time, num_insts, double)
     CKALLOC(inst_queue->to_call_index, num_insts, int)
     CKALLOC(inst_queue->to_call, num_insts, Mif_Boolean_t)
 
@@ -389,6 +391,8 @@ static int EVTinit_queue(
     CKALLOC(output_queue->modified, num_outputs, Mif_Boolean_t)
     CKALLOC(output_queue->pending_index, num_outputs, int)
     CKALLOC(output_queue->pending, num_outputs, Mif_Boolean_t)
+    CKALLOC(output_queue->pending_pos, num_outputs, int)
+    CKALLOC(output_queue->pending_time, num_outputs, double)
     CKALLOC(output_queue->changed_index, num_outputs, int)
     CKALLOC(output_queue->changed, num_outputs, Mif_Boolean_t)
 
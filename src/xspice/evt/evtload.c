@@ -225,6 +225,7 @@ int EVTload(
     cm_data.param = inst->param;
     cm_data.num_inst_var = inst->num_inst_var;
     cm_data.inst_var = inst->inst_var;
+    cm_data.callback = &(inst->callback);
 
 
     /* ******************* */
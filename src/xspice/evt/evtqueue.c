@@ -21,7 +21,8 @@ MODIFICATIONS
 SUMMARY
 
     This file contains functions that place new events into the output and
-    instance queues.
+    instance queues, and the functions that maintain the heaps of
+    outputs and instances with events pending.
 
 INTERFACES
 
@@ -39,6 +40,27 @@ INTERFACES
         double     posted_time,
         double     event_time)
 
+    void EVTqueue_heap_insert(
+        int        *heap,
+        int        *pos,
+        double     *time,
+        int        *num,
+        int        index)
+
+    void EVTqueue_heap_update(
+        int        *heap,
+        int        *pos,
+        double     *time,
+        int        num,
+        int        index)
+
+    void EVTqueue_heap_remove(
+        int        *heap,
+        int        *pos,
+        double     *time,
+        int        *num,
+        int        index)
+
 REFERENCED FILES
 
     None.
@@ -105,11 +127,6 @@ void EVTqueue_output(
     new_event->posted_time = posted_time;
     new_event->removed = MIF_FALSE;
 
-    /* Update next_time in output queue */
-    if((output_queue->num_pending <= 0) ||
-            (event_time < output_queue->next_time))
-        output_queue->next_time = event_time;
-
     /* Find location at which to insert event */
     splice = MIF_FALSE;
     here = output_queue->current[output_index];
@@ -149,12 +166,25 @@ void EVTqueue_output(
                 output_index;
     }
 
-    /* Add to the list of outputs with events pending */
+    /* Add to the heap of outputs with events pending, or move it up */
+    /* if the new event went to the head of its list */
+    output_queue->pending_time[output_index] =
+            (*(output_queue->current[output_index]))->event_time;
     if(! output_queue->pending[output_index]) {
         output_queue->pending[output_index] = MIF_TRUE;
-        output_queue->pending_index[(output_queue->num_pending)++] =
-                output_index;
+        EVTqueue_heap_insert(output_queue->pending_index,
+                output_queue->pending_pos, output_queue->pending_time,
+                &(output_queue->num_pending), output_index);
     }
+    else {
+        EVTqueue_heap_update(output_queue->pending_index,
+                output_queue->pending_pos, output_queue->pending_time,
+                output_queue->num_pending, output_index);
+    }
+
+    /* Update next_time in output queue */
+    output_queue->next_time =
+            output_queue->pending_time[output_queue->pending_index[0]];
 }
 
 
@@ -192,11 +222,6 @@ void EVTqueue_inst(
     /* Get pointers for fast access */
     inst_queue = &(ckt->evt->queue.inst);
 
-    /* Update next_time in inst queue */
-    if((inst_queue->num_pending <= 0) ||
-            (event_time < inst_queue->next_time))
-        inst_queue->next_time = event_time;
-
     /* Create a new event or get one from the free list and copy in data */
     if(inst_queue->free[inst_index]) {
         new_event = inst_queue->free[inst_index];
@@ -246,10 +271,135 @@ void EVTqueue_inst(
                 inst_index;
     }
 
-    /* Add to the list of insts with events pending */
+    /* Add to the heap of insts with events pending, or move it up */
+    /* if the new event went to the head of its list */
+    inst_queue->pending_time[inst_index] =
+            (*(inst_queue->current[inst_index]))->event_time;
     if(! inst_queue->pending[inst_index]) {
         inst_queue->pending[inst_index] = MIF_TRUE;
-        inst_queue->pending_index[(inst_queue->num_pending)++] =
-                inst_index;
+        EVTqueue_heap_insert(inst_queue->pending_index,
+                inst_queue->pending_pos, inst_queue->pending_time,
+                &(inst_queue->num_pending), inst_index);
+    }
+    else {
+        EVTqueue_heap_update(inst_queue->pending_index,
+                inst_queue->pending_pos, inst_queue->pending_time,
+                inst_queue->num_pending, inst_index);
+    }
+
+    /* Update next_time in inst queue */
+    inst_queue->next_time =
+            inst_queue->pending_time[inst_queue->pending_index[0]];
+}
+
+
+
+/*
+EVTqueue_heap_insert, EVTqueue_heap_update, EVTqueue_heap_remove
+
+The indexes of the outputs and insts with events pending are kept
+in pending_index as a binary heap, ordered by the time of the event
+at 'current' for each index (pending_time), and by the index itself
+for equal times.  pending_pos records the position of each index
+in the heap.  The earliest event is thus found at pending_index[0],
+and adding, rescheduling or removing an index takes O(log n) steps
+instead of a scan over all pending indexes.
+*/
+
+
+#define HEAP_BEFORE(a, b) \
+    ((time[a] < time[b]) || ((time[a] == time[b]) && ((a) < (b))))
+
+
+static void EVTqueue_heap_up(
+    int        *heap,     /* The heap of indexes */
+    int        *pos,      /* Position of each index in the heap */
+    double     *time,     /* Sort key of each index */
+    int        i)         /* The position to move up from */
+{
+    int  index = heap[i];
+    int  parent;
+
+    while(i > 0) {
+        parent = (i - 1) / 2;
+        if(! HEAP_BEFORE(index, heap[parent]))
+            break;
+        heap[i] = heap[parent];
+        pos[heap[i]] = i;
+        i = parent;
+    }
+    heap[i] = index;
+    pos[index] = i;
+}
+
+
+static void EVTqueue_heap_down(
+    int        *heap,     /* The heap of indexes */
+    int        *pos,      /* Position of each index in the heap */
+    double     *time,     /* Sort key of each index */
+    int        num,       /* Number of indexes in the heap */
+    int        i)         /* The position to move down from */
+{
+    int  index = heap[i];
+    int  child;
+
+    for(;;) {
+        child = 2 * i + 1;
+        if(child >= num)
+            break;
+        if((child + 1 < num) && HEAP_BEFORE(heap[child + 1], heap[child]))
+            child++;
+        if(! HEAP_BEFORE(heap[child], index))
+            break;
+        heap[i] = heap[child];
+        pos[heap[i]] = i;
+        i = child;
+    }
+    heap[i] = index;
+    pos[index] = i;
+}
+
+
+void EVTqueue_heap_insert(
+    int        *heap,     /* The heap of indexes */
+    int        *pos,      /* Position of each index in the heap */
+    double     *time,     /* Sort key of each index */
+    int        *num,      /* Number of indexes in the heap */
+    int        index)     /* The index to add */
+{
+    heap[*num] = index;
+    EVTqueue_heap_up(heap, pos, time, (*num)++);
+}
+
+
+void EVTqueue_heap_update(
+    int        *heap,     /* The heap of indexes */
+    int        *pos,      /* Position of each index in the heap */
+    double     *time,     /* Sort key of each index */
+    int        num,       /* Number of indexes in the heap */
+    int        index)     /* The index whose key has changed */
+{
+    int  i = pos[index];
+
+    EVTqueue_heap_up(heap, pos, time, i);
+    if(heap[i] == index)
+        EVTqueue_heap_down(heap, pos, time, num, i);
+}
+
+
+void EVTqueue_heap_remove(
+    int        *heap,     /* The heap of indexes */
+    int        *pos,      /* Position of each index in the heap */
+    double     *time,     /* Sort key of each index */
+    int        *num,      /* Number of indexes in the heap */
+    int        index)     /* The index to remove */
+{
+    int  i = pos[index];
+    int  last = heap[--(*num)];
+
+    if(last != index) {
+        heap[i] = last;
+        pos[last] = i;
+        EVTqueue_heap_update(heap, pos, time, *num, last);
     }
 }
@@ -49,6 +49,8 @@ NON-STANDARD FEATURES
 #include <stdlib.h>
 #include <string.h>
 
+#include "ngspice/stimfile.h"
+
 /*=== CONSTANTS ========================*/
 
 
@@ -73,6 +75,8 @@ struct filesource_state {
     FILE *fp;
     long pos;
     unsigned char atend;
+    STIMfile *stim;     /* binary stimulus file, instead of fp */
+    size_t row;         /* next row of stim */
 };
 
 
@@ -94,6 +98,34 @@ typedef struct {
 
 
 
+/* Release the file, the mapped stimulus and the static storage
+   when the instance is deleted. */
+
+static void
+cm_filesource_callback(ARGS, Mif_Callback_Reason_t reason)
+{
+    switch (reason) {
+    case MIF_CB_DESTROY: {
+        Local_Data_t *loc = STATIC_VAR (locdata);
+        if (!loc)
+            break;
+        if (loc->state) {
+            if (loc->state->fp)
+                fclose(loc->state->fp);
+            if (loc->state->stim)
+                stim_close(loc->state->stim);
+            free(loc->state);
+        }
+        free(loc->amplinterval);
+        free(loc->timeinterval);
+        free(loc);
+        STATIC_VAR (locdata) = NULL;
+        break;
+    }
+    }
+}
+
+
 
                    
 /*==============================================================================
@@ -157,6 +189,7 @@ void cm_filesource(ARGS)   /* structure holding parms, inputs, outputs, etc.
         /*** allocate static storage for *loc ***/
         STATIC_VAR (locdata) = calloc (1 , sizeof ( Local_Data_t ));
         loc = STATIC_VAR (locdata);
+        CALLBACK = cm_filesource_callback;
 
         /* Allocate storage for internal state */
         loc->timeinterval = (double*)calloc(2, sizeof(double));
@@ -166,16 +199,18 @@ void cm_filesource(ARGS)   /* structure holding parms, inputs, outputs, etc.
         loc->timeinterval[0] = loc->timeinterval[1] = PARAM_NULL(timeoffset) ? 0.0 : PARAM(timeoffset);
         for (i = 0; i < size; ++i)
             loc->amplinterval[2 * i] = loc->amplinterval[2 * i + 1] = PARAM_NULL(amploffset) ? 0.0 : PARAM(amploffset[i]);
-        loc->state->fp = fopen_with_path(PARAM(file), "r");
+        loc->state->fp = fopen_with_path(PARAM(file), "rb");
         loc->state->pos = 0;
         loc->state->atend = 0;
+        loc->state->stim = NULL;
+        loc->state->row = 0;
         if (!loc->state->fp) {
             char *lbuffer, *p;
             lbuffer = getenv("NGSPICE_INPUT_DIR");
             if (lbuffer && *lbuffer) {
                 p = (char*) malloc(strlen(lbuffer) + strlen(DIR_PATHSEP) + strlen(PARAM(file)) + 1);
                 sprintf(p, "%s%s%s", lbuffer, DIR_PATHSEP, PARAM(file));
-                loc->state->fp = fopen(p, "r");
+                loc->state->fp = fopen(p, "rb");
                 free(p);
             } 
             if (!loc->state->fp) {
@@ -185,6 +220,23 @@ void cm_filesource(ARGS)   /* structure holding parms, inputs, outputs, etc.
                 loc->state->atend = 1;
             }
         }
+        if (loc->state->fp) {
+            /* a binary stimulus file is used from memory */
+            const char *errmsg;
+            loc->state->stim = stim_open(loc->state->fp, &errmsg);
+            if (loc->state->stim || errmsg) {
+                fclose(loc->state->fp);
+                loc->state->fp = NULL;
+            } else {
+                rewind(loc->state->fp);
+            }
+            if (errmsg) {
+                char msg[512];
+                snprintf(msg, sizeof(msg), "file %s: %s", PARAM(file), errmsg);
+                cm_message_send(msg);
+                loc->state->atend = 1;
+            }
+        }
     }
 
     amplscalesize = PARAM_NULL(amplscale) ? 0 : PARAM_SIZE(amplscale);
@@ -196,6 +248,36 @@ void cm_filesource(ARGS)   /* structure holding parms, inputs, outputs, etc.
         char *cp2;
         double t;
         int i;
+        if (loc->state->stim) {
+            /* the next row of the binary stimulus file */
+            STIMfile *stim = loc->state->stim;
+            const double *row;
+            if (loc->state->row >= stim->rows) {
+                loc->state->atend = 1;
+                break;
+            }
+            row = stim->data + loc->state->row++ * (size_t) stim->columns;
+            t = row[0];
+            if (!PARAM_NULL(timescale))
+                t *= PARAM(timescale);
+            if (!PARAM_NULL(timerelative) && PARAM(timerelative) == MIF_TRUE)
+                t += loc->timeinterval[1];
+            else if (!PARAM_NULL(timeoffset))
+                t += PARAM(timeoffset);
+            loc->timeinterval[0] = loc->timeinterval[1];
+            loc->timeinterval[1] = t;
+            for (i = 0; i < size; ++i)
+                loc->amplinterval[2 * i] = loc->amplinterval[2 * i + 1];
+            for (i = 0; i < size && i + 1 < stim->columns; ++i) {
+                t = row[i + 1];
+                if (i < amplscalesize)
+                    t *= PARAM(amplscale[i]);
+                if (i < amploffssize)
+                    t += PARAM(amploffset[i]);
+                loc->amplinterval[2 * i + 1] = t;
+            }
+            continue;
+        }
         if (ftell(loc->state->fp) != loc->state->pos) {
             clearerr(loc->state->fp);
             fseek(loc->state->fp, loc->state->pos, SEEK_SET);
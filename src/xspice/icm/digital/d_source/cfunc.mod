@@ -58,6 +58,8 @@ NON-STANDARD FEATURES
 #include <stdlib.h>
 #include <string.h>
 
+#include "ngspice/stimfile.h"
+
 
 /*=== CONSTANTS ========================*/
 
@@ -824,6 +826,54 @@ static int cm_read_source(FILE *source, Local_Data_t *loc)
 
 
 
+/*==============================================================================
+
+FUNCTION cm_read_stim()
+
+SUMMARY
+
+    This function takes the timepoints and the bit codes 0 to 11
+    (see cm_source_retrieve()) from a binary stimulus file, as
+    written by the stimconv command.
+
+RETURNED VALUE
+
+    Returns output bits stored in "all_data" array,
+    time values in "all_timepoints" array,
+    return != 0 code if error, as cm_read_source().
+
+==============================================================================*/
+
+static int cm_read_stim(STIMfile *stim, Local_Data_t *loc)
+{
+    const double *row = stim->data;
+    size_t i;
+    int j;
+
+    if (stim->columns != loc->width + 1)
+        return 2;
+
+    for (i = 0; i < stim->rows; i++, row += stim->columns) {
+
+        loc->all_timepoints[i] = row[0];
+        if (i > 0 && loc->all_timepoints[i] <= loc->all_timepoints[i-1])
+            return 3;
+
+        loc->all_data[i] = (char*)malloc(sizeof(char) * loc->width);
+        for (j = 0; j < loc->width; j++) {
+            double value = row[j+1];
+            if (!(value >= 0 && value <= 11) || (double)(int) value != value)
+                return 4;
+            loc->all_data[i][j] = (char) value;
+        }
+    }
+    return 0;
+}
+
+
+
+
+
 /*==============================================================================
 
 FUNCTION cm_d_source()
@@ -925,7 +975,10 @@ void cm_d_source(ARGS)
 
         /*** open file and count the number of vectors in it ***/
         char* filename = PARAM(input_file);
-        source = fopen_with_path( filename, "r");
+        STIMfile *stim = NULL;
+        const char *stim_msg = NULL;
+
+        source = fopen_with_path( filename, "rb");
 
         if (!source) {
             char *lbuffer, *p;
@@ -933,7 +986,7 @@ void cm_d_source(ARGS)
             if (lbuffer && *lbuffer) {
                 p = (char*) malloc(strlen(lbuffer) + strlen(DIR_PATHSEP) + strlen(PARAM(input_file)) + 1);
                 sprintf(p, "%s%s%s", lbuffer, DIR_PATHSEP, PARAM(input_file));
-                source = fopen(p, "r");
+                source = fopen(p, "rb");
                 free(p);
             }
             if (!source) {
@@ -943,9 +996,18 @@ void cm_d_source(ARGS)
             }
         }
 
+        /* a binary stimulus file instead of the text table? */
+        if (source) {
+            stim = stim_open(source, &stim_msg);
+            rewind(source);
+        }
+
         /* increment counter if not a comment until EOF reached... */
         i = 0;
-        if (source) {
+        if (stim) {
+          i = (int) stim->rows;
+        }
+        else if (source && !stim_msg) {
           s = temp;
           while ( fgets(s,MAX_STRING_SIZE,source) != NULL) {
               if ( '*' != s[0] ) {
@@ -992,7 +1054,10 @@ void cm_d_source(ARGS)
         /* vectors will be loaded and the width and depth       */
         /* values supplied.                                     */
 
-        if (source) {
+        if (stim) {
+          err = cm_read_stim(stim, loc);
+          stim_close(stim);
+        } else if (source && !stim_msg) {
           rewind(source);
           err = cm_read_source(source, loc);
         } else {
@@ -1002,6 +1067,11 @@ void cm_d_source(ARGS)
         if (err) { /* problem occurred in load...send error msg. */
             cm_message_send(loading_error);
 
+            if (stim_msg) {
+                cm_message_send((char *) stim_msg);
+                cm_message_send("\n");
+            }
+
             switch (err)
             {
             case 2:
@@ -80,6 +80,8 @@ MIFdelete(
     int         num_port;
     int         num_inst_var;
 
+    Mif_Private_t  cm_data;
+
 
     /* Convert generic pointers in arg list to MIF specific pointers */
     model = (MIFmodel *) inModel;
@@ -115,6 +117,21 @@ MIFdelete(
     /* Free the instance structure */
     /*******************************/
 
+    /* Let the code model release what its static variables */
+    /* refer to, before the instance variables are freed    */
+
+    if(here->callback) {
+        memset(&cm_data, 0, sizeof(cm_data));
+        cm_data.num_conn = here->num_conn;
+        cm_data.conn = here->conn;
+        cm_data.num_param = here->num_param;
+        cm_data.param = here->param;
+        cm_data.num_inst_var = here->num_inst_var;
+        cm_data.inst_var = here->inst_var;
+        cm_data.callback = &(here->callback);
+        here->callback(&cm_data, MIF_CB_DESTROY);
+    }
+
     /* Loop through all connections on the instance */
     /* and dismantle the stuff allocated during readin/setup */
     /* in MIFinit_inst, MIFget_port, and MIFsetup   */